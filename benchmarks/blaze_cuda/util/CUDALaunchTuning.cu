@@ -0,0 +1,65 @@
+// Tunes the launch configurations of the transform and reduction kernels (see CUDALaunchTable)
+// for sizes from 2^10 to 2^30, and writes them to the file given as argument, or else to the
+// file named by BLAZE_CUDA_LAUNCH_TABLE.
+#define BLAZE_CUDA_NO_THRUST
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include <cuda_runtime.h>
+
+#include <blaze_cuda/util/CUDALaunchTuning.h>
+#include <blaze_cuda/util/algorithms/CUDAReduce.h>
+#include <blaze_cuda/util/algorithms/CUDATransform.h>
+
+namespace bz = blaze;
+
+template<typename T>
+void tune_case( char const* name )
+{
+   for( auto i = size_t(10); i < size_t(31); i++ )
+   {
+      size_t const size = size_t(1) << i;
+
+      // The binary transform needs three ranges
+      size_t free_bytes, total_bytes;
+      cudaMemGetInfo( &free_bytes, &total_bytes );
+
+      if( 3 * size * sizeof(T) > free_bytes / 2 ) {
+         std::cout << name << ": Size = 2^" << i << " skipped\n";
+         continue;
+      }
+
+      bz::cuda_tune_transform<T>( size );
+      bz::cuda_tune_reduce<T>( size );
+      bz::cuda_device_memory_pool().trim();
+
+      bz::CUDALaunchConfig c{ 0, 0 };
+      bz::cuda_launch_table().find( "reduce", bz::cuda_launch_type_name<T>(), size, c );
+
+      std::cout << name << ": Size = 2^" << i << "; Reduce = " << c.blockSize << "x" << c.unroll;
+
+      bz::cuda_launch_table().find( "binary_transform", bz::cuda_launch_type_name<T>(), size, c );
+
+      std::cout << "; Transform = " << c.blockSize << "x" << c.unroll << '\n';
+   }
+}
+
+int main( int argc, char** argv )
+{
+   std::string const path( argc > 1 ? argv[1] : bz::cuda_launch_table().path() );
+
+   tune_case<float >( "float" );
+   tune_case<double>( "double" );
+
+   if( path.empty() ) {
+      std::cout << "No launch table file given, the configurations are not saved\n";
+   }
+   else if( !bz::cuda_launch_table().save( path ) ) {
+      std::cerr << "Could not write " << path << '\n';
+      return 1;
+   }
+
+   return 0;
+}
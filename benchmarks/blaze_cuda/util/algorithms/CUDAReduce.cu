@@ -46,11 +46,42 @@ void bench_case( Exec const& )
    }
 }
 
+// Reductions reusing a workspace, with the result kept on the device
+void bench_workspace_case()
+{
+   using elmt_t = float;
+   using nanos  = std::chrono::nanoseconds;
+   using op     = bz::Add;
+
+   bz::CUDAReduceWorkspace<elmt_t> workspace;
+
+   for( auto i = size_t(10); i < size_t(31); i++ )
+   {
+      bz::CUDADynamicVector<elmt_t> a( size_t(1) << i, i );
+
+      auto t = bm::bench_avg( [&]() {
+         bz::cuda_reduce_into( a.begin(), a.end(), elmt_t(0), op()
+                             , workspace.result(), workspace );
+         bm::no_optimize( workspace.value() );
+      } );
+
+      // Calculating results
+      auto const gb   = sizeof(elmt_t) * float(a.size()) / 1000000000.f;
+      auto const s    = float(nanos(t).count()) / 1000000000.f;
+      auto const gb_s = gb / s;
+
+      std::cout << "Size = 2^" << i << "; Bandwidth = " << gb_s << "GB/s\n";
+   }
+}
+
 int main( int, char** )
 {
    std::cout << "- GPU :\n";
    bench_case( bm::exec::gpu() );
 
+   std::cout << "- GPU (workspace) :\n";
+   bench_workspace_case();
+
    std::cout << "- CPU :\n";
    bench_case( bm::exec::cpu() );
 
@@ -0,0 +1,65 @@
+#define BLAZE_CUDA_HOST_BACKEND
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/iostreams.hpp>
+
+#include <iostream>
+#include <type_traits>
+
+#include <benchmark.h>
+
+#include <blaze_cuda/Blaze.h>
+
+namespace bm = benchmark;
+namespace bz = blaze;
+
+// Compares Blaze's own CPU kernels with the host execution backend of blaze_cuda
+// (BLAZE_CUDA_HOST_BACKEND) on CUDA containers.
+template<typename Exec>
+void bench_case( Exec const& )
+{
+   bool constexpr RunsOnBlaze = std::is_same_v<Exec, bm::exec::cpu>;
+
+   using elmt_t = float;
+   using nanos  = std::chrono::nanoseconds;
+
+   using v_t = std::conditional_t< RunsOnBlaze
+                                 , bz::DynamicVector<elmt_t>
+                                 , bz::CUDADynamicVector<elmt_t> >;
+
+   for( auto i = size_t(10); i < size_t(31); i++ )
+   {
+      v_t a( size_t(1) << i, i );
+
+      auto t_map = bm::bench_avg( [&]() {
+         a = bz::map( a, bz::Pow2() );
+         bm::no_optimize(a);
+      } );
+
+      auto t_red = bm::bench_avg( [&]() {
+         if constexpr ( RunsOnBlaze )
+            bm::no_optimize( bz::reduce( a, bz::Add() ) );
+         else
+            bm::no_optimize( bz::cuda_reduce( a, elmt_t(0), bz::Add() ) );
+      } );
+
+      // Calculating results
+      auto const gb       = sizeof(elmt_t) * float(a.size()) / 1000000000.f;
+      auto const s_map    = float(nanos(t_map).count()) / 1000000000.f;
+      auto const s_red    = float(nanos(t_red).count()) / 1000000000.f;
+
+      std::cout << "Size = 2^" << i
+                << "; Map bandwidth = "    << 2 * gb / s_map << "GB/s"
+                << "; Reduce bandwidth = " << gb / s_red     << "GB/s\n";
+   }
+}
+
+int main( int, char** ) {
+   std::cout << "- Host backend :\n";
+   bench_case( bm::exec::gpu() );
+
+   std::cout << "- Blaze :\n";
+   bench_case( bm::exec::cpu() );
+
+   return 0;
+}
@@ -43,6 +43,8 @@
 #include <blaze_cuda/math/CUDA.h>
 #include <blaze_cuda/math/CUDADynamicMatrix.h>
 #include <blaze_cuda/math/CUDADynamicVector.h>
+#include <blaze_cuda/math/CUDAMirroredMatrix.h>
+#include <blaze_cuda/math/CUDAMirroredVector.h>
 #include <blaze_cuda/math/DynamicMatrix.h>
 #include <blaze_cuda/math/DynamicVector.h>
 #include <blaze_cuda/math/TypeTraits.h>
@@ -43,7 +43,13 @@
 #include <blaze_cuda/util/Algorithms.h>
 #include <blaze_cuda/util/CUDAAllocator.h>
 #include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAFuture.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 #include <blaze_cuda/util/CUDAManagedAllocator.h>
+#include <blaze_cuda/util/CUDAMemoryPool.h>
+#include <blaze_cuda/util/CUDAMirroredArray.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
 #include <blaze_cuda/util/CUDAValue.h>
 #include <blaze_cuda/util/Memory.h>
 
@@ -40,7 +40,14 @@
 // Includes
 //*************************************************************************************************
 
+#include <blaze_cuda/math/cuda/Async.h>
+#include <blaze_cuda/math/cuda/BatchedGemm.h>
+#include <blaze_cuda/math/cuda/Compact.h>
 #include <blaze_cuda/math/cuda/DenseMatrix.h>
 #include <blaze_cuda/math/cuda/DenseVector.h>
+#include <blaze_cuda/math/cuda/ExpressionFusion.h>
+#include <blaze_cuda/math/cuda/RankKUpdate.h>
+#include <blaze_cuda/math/cuda/Scan.h>
+#include <blaze_cuda/math/cuda/Sort.h>
 
 #endif
@@ -0,0 +1,181 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/CUDAMirroredVector.h
+//  \brief Header file for the complete CUDAMirroredVector implementation
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_CUDAMIRROREDVECTOR_H_
+#define _BLAZE_CUDA_MATH_CUDAMIRROREDVECTOR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/CustomVector.h>
+#include <blaze/util/Random.h>
+
+#include <blaze_cuda/math/dense/CUDAMirroredVector.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  RAND SPECIALIZATION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Specialization of the Rand class template for CUDAMirroredVector.
+// \ingroup random
+//
+// This specialization of the Rand class creates random instances of CUDAMirroredVector. The elements are
+// randomized on the host mirror, which is uploaded in one copy by the next device access.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+class Rand< CUDAMirroredVector<Type,TF> >
+{
+ public:
+   //**Generate functions**************************************************************************
+   /*!\name Generate functions */
+   //@{
+   inline const CUDAMirroredVector<Type,TF> generate( size_t n ) const;
+
+   template< typename Arg >
+   inline const CUDAMirroredVector<Type,TF> generate( size_t n, const Arg& min, const Arg& max ) const;
+   //@}
+   //**********************************************************************************************
+
+   //**Randomize functions*************************************************************************
+   /*!\name Randomize functions */
+   //@{
+   inline void randomize( CUDAMirroredVector<Type,TF>& vector ) const;
+
+   template< typename Arg >
+   inline void randomize( CUDAMirroredVector<Type,TF>& vector, const Arg& min, const Arg& max ) const;
+   //@}
+   //**********************************************************************************************
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Generation of a random CUDAMirroredVector.
+//
+// \param n The size of the random vector.
+// \return The generated random vector.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline const CUDAMirroredVector<Type,TF> Rand< CUDAMirroredVector<Type,TF> >::generate( size_t n ) const
+{
+   CUDAMirroredVector<Type,TF> vector( n );
+   randomize( vector );
+   return vector;
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Generation of a random CUDAMirroredVector.
+//
+// \param n The size of the random vector.
+// \param min The smallest possible value for a vector element.
+// \param max The largest possible value for a vector element.
+// \return The generated random vector.
+*/
+template< typename Type   // Data type of the vector
+        , bool TF >       // Transpose flag
+template< typename Arg >  // Min/max argument type
+inline const CUDAMirroredVector<Type,TF>
+   Rand< CUDAMirroredVector<Type,TF> >::generate( size_t n, const Arg& min, const Arg& max ) const
+{
+   CUDAMirroredVector<Type,TF> vector( n );
+   randomize( vector, min, max );
+   return vector;
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Randomization of a CUDAMirroredVector.
+//
+// \param vector The vector to be randomized.
+// \return void
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline void Rand< CUDAMirroredVector<Type,TF> >::randomize( CUDAMirroredVector<Type,TF>& vector ) const
+{
+   using blaze::randomize;
+
+   auto host( vector.host() );
+   randomize( host );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Randomization of a CUDAMirroredVector.
+//
+// \param vector The vector to be randomized.
+// \param min The smallest possible value for a vector element.
+// \param max The largest possible value for a vector element.
+// \return void
+*/
+template< typename Type   // Data type of the vector
+        , bool TF >       // Transpose flag
+template< typename Arg >  // Min/max argument type
+inline void Rand< CUDAMirroredVector<Type,TF> >::randomize( CUDAMirroredVector<Type,TF>& vector,
+                                    const Arg& min, const Arg& max ) const
+{
+   using blaze::randomize;
+
+   auto host( vector.host() );
+   randomize( host, min, max );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
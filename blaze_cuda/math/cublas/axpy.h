@@ -40,7 +40,8 @@
 // Includes
 //*************************************************************************************************
 
-#include <cublas.h>
+#include <blaze_cuda/util/CUBLASHandle.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 
 #include <blaze/math/Aliases.h>
 #include <blaze/math/constraints/BLASCompatible.h>
@@ -107,10 +108,12 @@ BLAZE_ALWAYS_INLINE void axpy( const CUDADynamicVector<VT1,TF1>& x, const CUDADy
 BLAZE_ALWAYS_INLINE void cuaxpy( int n, float alpha, const float* x,
                                  int incX, float* y, int incY )
 {
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cuaxpy" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 3UL * std::size_t( n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasSaxpy( handle, n, alpha, x, incX, y, incY );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
@@ -136,10 +139,12 @@ BLAZE_ALWAYS_INLINE void cuaxpy( int n, float alpha, const float* x,
 BLAZE_ALWAYS_INLINE void cuaxpy( int n, double alpha, const double* x,
                                  int incX, double* y, int incY )
 {
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cuaxpy" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 3UL * std::size_t( n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasDaxpy( handle, n, alpha, x, incX, y, incY );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
@@ -167,11 +172,13 @@ BLAZE_ALWAYS_INLINE void cuaxpy( int n, complex<float> alpha, const complex<floa
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<float> ) == 2UL*sizeof( float ) );
 
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cuaxpy" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 3UL * std::size_t( n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasCaxpy( handle, n, reinterpret_cast<const float*>( &alpha ),
                 reinterpret_cast<const float*>( x ), incX, reinterpret_cast<float*>( y ), incY );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
@@ -199,11 +206,13 @@ BLAZE_ALWAYS_INLINE void cuaxpy( int n, complex<double> alpha, const complex<dou
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<double> ) == 2UL*sizeof( double ) );
 
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cuaxpy" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 3UL * std::size_t( n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasZaxpy( handle, n, reinterpret_cast<const double*>( &alpha ),
                 reinterpret_cast<const double*>( x ), incX, reinterpret_cast<double*>( y ), incY );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
@@ -40,7 +40,8 @@
 // Includes
 //*************************************************************************************************
 
-#include <cublas.h>
+#include <blaze_cuda/util/CUBLASHandle.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 
 #include <blaze/math/Aliases.h>
 #include <blaze/math/constraints/BLASCompatible.h>
@@ -105,10 +106,12 @@ BLAZE_ALWAYS_INLINE ElementType_t<VT1> dotc( const CUDADynamicVector<VT1,TF1>& x
 */
 BLAZE_ALWAYS_INLINE float cudotc( int n, const float* x, int incX, const float* y, int incY )
 {
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cudotc" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 2UL * std::size_t( n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    auto ret = cublasSdot( handle, n, x, incX, y, incY );
-   cublasDestroy( handle );
    return ret;
 }
 #endif
@@ -133,10 +136,12 @@ BLAZE_ALWAYS_INLINE float cudotc( int n, const float* x, int incX, const float*
 */
 BLAZE_ALWAYS_INLINE double cudotc( int n, const double* x, int incX, const double* y, int incY )
 {
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cudotc" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 2UL * std::size_t( n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    auto ret = cublasDdot( handle, n, x, incX, y, incY );
-   cublasDestroy( handle );
    return ret;
 }
 #endif
@@ -166,11 +171,13 @@ BLAZE_ALWAYS_INLINE complex<float> cudotc( int n, const complex<float>* x, int i
    BLAZE_STATIC_ASSERT( sizeof( complex<float> ) == 2UL*sizeof( float ) );
 
    complex<float> tmp;
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cudotc" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 2UL * std::size_t( n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasCdotc_sub( handle, n, reinterpret_cast<const float*>( x ), incX,
                     reinterpret_cast<const float*>( y ), incY, &tmp );
-   cublasDestroy( handle );
    return tmp;
 }
 #endif
@@ -201,11 +208,13 @@ BLAZE_ALWAYS_INLINE complex<double> cudotc( int n, const complex<double>* x, int
 
    complex<double> tmp;
 
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cudotc" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 2UL * std::size_t( n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasZdotc_sub( handle, n, reinterpret_cast<const double*>( x ), incX,
                     reinterpret_cast<const double*>( y ), incY, &tmp );
-   cublasDestroy( handle );
    return tmp;
 }
 #endif
@@ -40,7 +40,8 @@
 // Includes
 //*************************************************************************************************
 
-#include <cublas.h>
+#include <blaze_cuda/util/CUBLASHandle.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 
 #include <blaze/math/Aliases.h>
 #include <blaze/math/constraints/BLASCompatible.h>
@@ -105,10 +106,12 @@ BLAZE_ALWAYS_INLINE ElementType_t<VT1> dotu( const CUDADynamicVector<VT1,TF1>& x
 */
 BLAZE_ALWAYS_INLINE float cudotu( int n, const float* x, int incX, const float* y, int incY )
 {
-   cudaHandle_t handle;
-   cublasCreate( &handle );
-   auto ret = cublasSdot( &handle, n, x, incX, y, incY );
-   cublasDestroy( handle );
+   BLAZE_CUDA_RANGE( "cudotu" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 2UL * std::size_t( n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   auto ret = cublasSdot( handle, n, x, incX, y, incY );
    return ret;
 }
 #endif
@@ -133,10 +136,12 @@ BLAZE_ALWAYS_INLINE float cudotu( int n, const float* x, int incX, const float*
 */
 BLAZE_ALWAYS_INLINE double cudotu( int n, const double* x, int incX, const double* y, int incY )
 {
-   cudaHandle_t handle;
-   cublasCreate( &handle );
-   auto ret = cublasDdot( &handle, n, x, incX, y, incY );
-   cublasDestroy( handle );
+   BLAZE_CUDA_RANGE( "cudotu" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 2UL * std::size_t( n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   auto ret = cublasDdot( handle, n, x, incX, y, incY );
    return ret;
 }
 #endif
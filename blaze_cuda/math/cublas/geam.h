@@ -40,7 +40,8 @@
 // Includes
 //*************************************************************************************************
 
-#include <cublas_v2.h>
+#include <blaze_cuda/util/CUBLASHandle.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 
 #include <blaze/math/Aliases.h>
 #include <blaze/math/constraints/BLASCompatible.h>
@@ -133,8 +134,11 @@ BLAZE_ALWAYS_INLINE void cugeam( cublasOperation_t transa, cublasOperation_t tra
                                  const float beta , const float *B, int ldb,
                                                           float *C, int ldc )
 {
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugeam" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 3UL * std::size_t( m ) * std::size_t( n ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
 
    // NB: Parameter numbering starts from handle = 0
    auto status = cublasSgeam( handle, transa, transb, m, n,
@@ -143,8 +147,6 @@ BLAZE_ALWAYS_INLINE void cugeam( cublasOperation_t transa, cublasOperation_t tra
               C, ldc );
 
    CUBLAS_ERROR_CHECK( status );
-
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
@@ -179,8 +181,11 @@ BLAZE_ALWAYS_INLINE void cugeam( cublasOperation_t transa, cublasOperation_t tra
                                  const double beta , const double *B, int ldb,
                                                            double *C, int ldc )
 {
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugeam" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 3UL * std::size_t( m ) * std::size_t( n ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
 
    // NB: Parameter numbering starts from handle = 0
    auto status = cublasDgeam( handle, transa, transb, m, n,
@@ -189,8 +194,6 @@ BLAZE_ALWAYS_INLINE void cugeam( cublasOperation_t transa, cublasOperation_t tra
               C, ldc );
 
    CUBLAS_ERROR_CHECK( status );
-
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
@@ -227,8 +230,11 @@ BLAZE_ALWAYS_INLINE void cugeam( cublasOperation_t transa, cublasOperation_t tra
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<float> ) == 2UL*sizeof( float ) );
 
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugeam" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 3UL * std::size_t( m ) * std::size_t( n ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
 
    // NB: Parameter numbering starts from handle = 0
    auto status = cublasCgeam( handle, transa, transb, m, n,
@@ -239,8 +245,6 @@ BLAZE_ALWAYS_INLINE void cugeam( cublasOperation_t transa, cublasOperation_t tra
       reinterpret_cast<      cuFloatComplex*>( C ), ldc );
 
    CUBLAS_ERROR_CHECK( status );
-
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
@@ -277,8 +281,11 @@ BLAZE_ALWAYS_INLINE void cugeam( cublasOperation_t transa, cublasOperation_t tra
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<double> ) == 2UL*sizeof( double ) );
 
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugeam" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, 3UL * std::size_t( m ) * std::size_t( n ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
 
    // NB: Parameter numbering starts from handle = 0
    auto status = cublasZgeam( handle, transa, transb, m, n,
@@ -289,13 +296,11 @@ BLAZE_ALWAYS_INLINE void cugeam( cublasOperation_t transa, cublasOperation_t tra
       reinterpret_cast<      cuDoubleComplex*>( C ), ldc );
 
    CUBLAS_ERROR_CHECK( status );
-
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
 
-cublasOperation_t invertCublasOperation( cublasOperation_t const& op ) {
+inline cublasOperation_t invertCublasOperation( cublasOperation_t const& op ) {
    if ( op == CUBLAS_OP_T ) return CUBLAS_OP_N;
    if ( op == CUBLAS_OP_N ) return CUBLAS_OP_T;
    return CUBLAS_OP_C;
@@ -40,7 +40,8 @@
 // Includes
 //*************************************************************************************************
 
-#include <cublas_v2.h>
+#include <blaze_cuda/util/CUBLASHandle.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 
 #include <blaze/math/Aliases.h>
 #include <blaze/math/constraints/BLASCompatible.h>
@@ -142,10 +143,12 @@ BLAZE_ALWAYS_INLINE void cugemm( cublasOperation_t transA, cublasOperation_t tra
                                  float beta,
                                        float* C, int ldc )
 {
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugemm" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasSgemm( handle, transA, transB, m, n, k, &alpha, A, lda, B, ldb, &beta, C, ldc );
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
@@ -181,10 +184,12 @@ BLAZE_ALWAYS_INLINE void cugemm( cublasOperation_t transA, cublasOperation_t tra
                                  double beta,
                                        double* C, int ldc )
 {
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugemm" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasDgemm( handle, transA, transB, m, n, k, &alpha, A, lda, B, ldb, &beta, C, ldc );
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
@@ -222,15 +227,17 @@ BLAZE_ALWAYS_INLINE void cugemm( cublasOperation_t transA, cublasOperation_t tra
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<float> ) == 2UL*sizeof( float ) );
 
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugemm" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasCgemm( handle, transA, transB, m, n, k,
       reinterpret_cast<const cuComplex*>( &alpha ),
       reinterpret_cast<const cuComplex*>( A ), lda,
       reinterpret_cast<const cuComplex*>( B ), ldb,
       reinterpret_cast<const cuComplex*>( &beta ),
       reinterpret_cast<      cuComplex*>( C ), ldc );
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
@@ -268,15 +275,17 @@ BLAZE_ALWAYS_INLINE void cugemm( cublasOperation_t transA, cublasOperation_t tra
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<double> ) == 2UL*sizeof( double ) );
 
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugemm" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasZgemm( handle, transA, transB, m, n, k,
       reinterpret_cast<const cuDoubleComplex*>( &alpha ),
       reinterpret_cast<const cuDoubleComplex*>( A ), lda,
       reinterpret_cast<const cuDoubleComplex*>( B ), ldb,
       reinterpret_cast<const cuDoubleComplex*>( &beta ),
       reinterpret_cast<      cuDoubleComplex*>( C ), ldc );
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
@@ -0,0 +1,497 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/cublas/gemmbatched.h
+//  \brief Header file for batched BLAS matrix/matrix multiplication functions (gemmBatched)
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_CUBLAS_GEMMBATCHED_H_
+#define _BLAZE_CUDA_MATH_CUBLAS_GEMMBATCHED_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze_cuda/util/CUBLASHandle.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+#include <blaze/system/Inline.h>
+#include <blaze/util/Complex.h>
+#include <blaze/util/StaticAssert.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  BLAS WRAPPER FUNCTIONS (GEMM BATCHED)
+//
+//  Both families compute count products C[b] = alpha*op(A[b])*op(B[b]) + beta*C[b] of matrices
+//  of identical sizes and leading dimensions, in a single cuBLAS call. The strided variants take
+//  the first matrix of each operand and the distance between two consecutive matrices, the
+//  pointer array variants take device arrays holding the address of each matrix.
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\name BLAS wrapper functions (gemmStridedBatched, gemmBatched) */
+//@{
+BLAZE_ALWAYS_INLINE void cugemm_strided_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                                 int m, int n, int k, float alpha,
+                                                 const float* A, int lda, long long strideA,
+                                                 const float* B, int ldb, long long strideB,
+                                                 float beta,
+                                                       float* C, int ldc, long long strideC,
+                                                 int count );
+
+BLAZE_ALWAYS_INLINE void cugemm_strided_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                                 int m, int n, int k, double alpha,
+                                                 const double* A, int lda, long long strideA,
+                                                 const double* B, int ldb, long long strideB,
+                                                 double beta,
+                                                       double* C, int ldc, long long strideC,
+                                                 int count );
+
+BLAZE_ALWAYS_INLINE void cugemm_strided_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                                 int m, int n, int k, complex<float> alpha,
+                                                 const complex<float>* A, int lda, long long strideA,
+                                                 const complex<float>* B, int ldb, long long strideB,
+                                                 complex<float> beta,
+                                                       complex<float>* C, int ldc, long long strideC,
+                                                 int count );
+
+BLAZE_ALWAYS_INLINE void cugemm_strided_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                                 int m, int n, int k, complex<double> alpha,
+                                                 const complex<double>* A, int lda, long long strideA,
+                                                 const complex<double>* B, int ldb, long long strideB,
+                                                 complex<double> beta,
+                                                       complex<double>* C, int ldc, long long strideC,
+                                                 int count );
+
+BLAZE_ALWAYS_INLINE void cugemm_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                         int m, int n, int k, float alpha,
+                                         const float* const* A, int lda,
+                                         const float* const* B, int ldb,
+                                         float beta,
+                                               float* const* C, int ldc,
+                                         int count );
+
+BLAZE_ALWAYS_INLINE void cugemm_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                         int m, int n, int k, double alpha,
+                                         const double* const* A, int lda,
+                                         const double* const* B, int ldb,
+                                         double beta,
+                                               double* const* C, int ldc,
+                                         int count );
+
+BLAZE_ALWAYS_INLINE void cugemm_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                         int m, int n, int k, complex<float> alpha,
+                                         const complex<float>* const* A, int lda,
+                                         const complex<float>* const* B, int ldb,
+                                         complex<float> beta,
+                                               complex<float>* const* C, int ldc,
+                                         int count );
+
+BLAZE_ALWAYS_INLINE void cugemm_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                         int m, int n, int k, complex<double> alpha,
+                                         const complex<double>* const* A, int lda,
+                                         const complex<double>* const* B, int ldb,
+                                         complex<double> beta,
+                                               complex<double>* const* C, int ldc,
+                                         int count );
+//@}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Strided batched BLAS kernel for single precision matrices (\f$ C_b=\alpha*A_b*B_b+\beta*C_b \f$).
+// \ingroup blas
+//
+// \param transA Specifies whether to transpose the matrices \a A (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param transB Specifies whether to transpose the matrices \a B (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param m The number of rows of the matrices \a A and \a C \f$[0..\infty)\f$.
+// \param n The number of columns of the matrices \a B and \a C \f$[0..\infty)\f$.
+// \param k The number of columns of \a A and rows of \a B \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ A_b*B_b \f$.
+// \param A Pointer to the first element of the first matrix \a A.
+// \param lda The leading dimension of the matrices \a A.
+// \param strideA The number of elements between two consecutive matrices \a A.
+// \param B Pointer to the first element of the first matrix \a B.
+// \param ldb The leading dimension of the matrices \a B.
+// \param strideB The number of elements between two consecutive matrices \a B.
+// \param beta The scaling factor for \f$ C_b \f$.
+// \param C Pointer to the first element of the first matrix \a C.
+// \param ldc The leading dimension of the matrices \a C.
+// \param strideC The number of elements between two consecutive matrices \a C.
+// \param count The number of products.
+// \return void
+//
+// This function is based on the cuBLAS cublasSgemmStridedBatched() function.
+*/
+BLAZE_ALWAYS_INLINE void cugemm_strided_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                                 int m, int n, int k, float alpha,
+                                                 const float* A, int lda, long long strideA,
+                                                 const float* B, int ldb, long long strideB,
+                                                 float beta,
+                                                       float* C, int ldc, long long strideC,
+                                                 int count )
+{
+   BLAZE_CUDA_RANGE( "cugemm_batched" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( count ) * ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( alpha ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasSgemmStridedBatched( handle, transA, transB, m, n, k, &alpha, A, lda, strideA,
+                              B, ldb, strideB, &beta, C, ldc, strideC, count );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Strided batched BLAS kernel for double precision matrices (\f$ C_b=\alpha*A_b*B_b+\beta*C_b \f$).
+// \ingroup blas
+//
+// \param transA Specifies whether to transpose the matrices \a A (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param transB Specifies whether to transpose the matrices \a B (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param m The number of rows of the matrices \a A and \a C \f$[0..\infty)\f$.
+// \param n The number of columns of the matrices \a B and \a C \f$[0..\infty)\f$.
+// \param k The number of columns of \a A and rows of \a B \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ A_b*B_b \f$.
+// \param A Pointer to the first element of the first matrix \a A.
+// \param lda The leading dimension of the matrices \a A.
+// \param strideA The number of elements between two consecutive matrices \a A.
+// \param B Pointer to the first element of the first matrix \a B.
+// \param ldb The leading dimension of the matrices \a B.
+// \param strideB The number of elements between two consecutive matrices \a B.
+// \param beta The scaling factor for \f$ C_b \f$.
+// \param C Pointer to the first element of the first matrix \a C.
+// \param ldc The leading dimension of the matrices \a C.
+// \param strideC The number of elements between two consecutive matrices \a C.
+// \param count The number of products.
+// \return void
+//
+// This function is based on the cuBLAS cublasDgemmStridedBatched() function.
+*/
+BLAZE_ALWAYS_INLINE void cugemm_strided_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                                 int m, int n, int k, double alpha,
+                                                 const double* A, int lda, long long strideA,
+                                                 const double* B, int ldb, long long strideB,
+                                                 double beta,
+                                                       double* C, int ldc, long long strideC,
+                                                 int count )
+{
+   BLAZE_CUDA_RANGE( "cugemm_batched" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( count ) * ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( alpha ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasDgemmStridedBatched( handle, transA, transB, m, n, k, &alpha, A, lda, strideA,
+                              B, ldb, strideB, &beta, C, ldc, strideC, count );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Strided batched BLAS kernel for single precision complex matrices (\f$ C_b=\alpha*A_b*B_b+\beta*C_b \f$).
+// \ingroup blas
+//
+// \param transA Specifies whether to transpose the matrices \a A (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param transB Specifies whether to transpose the matrices \a B (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param m The number of rows of the matrices \a A and \a C \f$[0..\infty)\f$.
+// \param n The number of columns of the matrices \a B and \a C \f$[0..\infty)\f$.
+// \param k The number of columns of \a A and rows of \a B \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ A_b*B_b \f$.
+// \param A Pointer to the first element of the first matrix \a A.
+// \param lda The leading dimension of the matrices \a A.
+// \param strideA The number of elements between two consecutive matrices \a A.
+// \param B Pointer to the first element of the first matrix \a B.
+// \param ldb The leading dimension of the matrices \a B.
+// \param strideB The number of elements between two consecutive matrices \a B.
+// \param beta The scaling factor for \f$ C_b \f$.
+// \param C Pointer to the first element of the first matrix \a C.
+// \param ldc The leading dimension of the matrices \a C.
+// \param strideC The number of elements between two consecutive matrices \a C.
+// \param count The number of products.
+// \return void
+//
+// This function is based on the cuBLAS cublasCgemmStridedBatched() function.
+*/
+BLAZE_ALWAYS_INLINE void cugemm_strided_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                                 int m, int n, int k, complex<float> alpha,
+                                                 const complex<float>* A, int lda, long long strideA,
+                                                 const complex<float>* B, int ldb, long long strideB,
+                                                 complex<float> beta,
+                                                       complex<float>* C, int ldc, long long strideC,
+                                                 int count )
+{
+   BLAZE_STATIC_ASSERT( sizeof( complex<float> ) == 2UL*sizeof( float ) );
+
+   BLAZE_CUDA_RANGE( "cugemm_batched" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( count ) * ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( alpha ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasCgemmStridedBatched( handle, transA, transB, m, n, k,
+      reinterpret_cast<const cuComplex*>( &alpha ),
+      reinterpret_cast<const cuComplex*>( A ), lda, strideA,
+      reinterpret_cast<const cuComplex*>( B ), ldb, strideB,
+      reinterpret_cast<const cuComplex*>( &beta ),
+      reinterpret_cast<      cuComplex*>( C ), ldc, strideC, count );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Strided batched BLAS kernel for double precision complex matrices (\f$ C_b=\alpha*A_b*B_b+\beta*C_b \f$).
+// \ingroup blas
+//
+// \param transA Specifies whether to transpose the matrices \a A (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param transB Specifies whether to transpose the matrices \a B (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param m The number of rows of the matrices \a A and \a C \f$[0..\infty)\f$.
+// \param n The number of columns of the matrices \a B and \a C \f$[0..\infty)\f$.
+// \param k The number of columns of \a A and rows of \a B \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ A_b*B_b \f$.
+// \param A Pointer to the first element of the first matrix \a A.
+// \param lda The leading dimension of the matrices \a A.
+// \param strideA The number of elements between two consecutive matrices \a A.
+// \param B Pointer to the first element of the first matrix \a B.
+// \param ldb The leading dimension of the matrices \a B.
+// \param strideB The number of elements between two consecutive matrices \a B.
+// \param beta The scaling factor for \f$ C_b \f$.
+// \param C Pointer to the first element of the first matrix \a C.
+// \param ldc The leading dimension of the matrices \a C.
+// \param strideC The number of elements between two consecutive matrices \a C.
+// \param count The number of products.
+// \return void
+//
+// This function is based on the cuBLAS cublasZgemmStridedBatched() function.
+*/
+BLAZE_ALWAYS_INLINE void cugemm_strided_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                                 int m, int n, int k, complex<double> alpha,
+                                                 const complex<double>* A, int lda, long long strideA,
+                                                 const complex<double>* B, int ldb, long long strideB,
+                                                 complex<double> beta,
+                                                       complex<double>* C, int ldc, long long strideC,
+                                                 int count )
+{
+   BLAZE_STATIC_ASSERT( sizeof( complex<double> ) == 2UL*sizeof( double ) );
+
+   BLAZE_CUDA_RANGE( "cugemm_batched" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( count ) * ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( alpha ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasZgemmStridedBatched( handle, transA, transB, m, n, k,
+      reinterpret_cast<const cuDoubleComplex*>( &alpha ),
+      reinterpret_cast<const cuDoubleComplex*>( A ), lda, strideA,
+      reinterpret_cast<const cuDoubleComplex*>( B ), ldb, strideB,
+      reinterpret_cast<const cuDoubleComplex*>( &beta ),
+      reinterpret_cast<      cuDoubleComplex*>( C ), ldc, strideC, count );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Pointer array batched BLAS kernel for single precision matrices (\f$ C_b=\alpha*A_b*B_b+\beta*C_b \f$).
+// \ingroup blas
+//
+// \param transA Specifies whether to transpose the matrices \a A (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param transB Specifies whether to transpose the matrices \a B (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param m The number of rows of the matrices \a A and \a C \f$[0..\infty)\f$.
+// \param n The number of columns of the matrices \a B and \a C \f$[0..\infty)\f$.
+// \param k The number of columns of \a A and rows of \a B \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ A_b*B_b \f$.
+// \param A Device array of pointers to the matrices \a A.
+// \param lda The leading dimension of the matrices \a A.
+// \param B Device array of pointers to the matrices \a B.
+// \param ldb The leading dimension of the matrices \a B.
+// \param beta The scaling factor for \f$ C_b \f$.
+// \param C Device array of pointers to the matrices \a C.
+// \param ldc The leading dimension of the matrices \a C.
+// \param count The number of products.
+// \return void
+//
+// This function is based on the cuBLAS cublasSgemmBatched() function.
+*/
+BLAZE_ALWAYS_INLINE void cugemm_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                         int m, int n, int k, float alpha,
+                                         const float* const* A, int lda,
+                                         const float* const* B, int ldb,
+                                         float beta,
+                                               float* const* C, int ldc,
+                                         int count )
+{
+   BLAZE_CUDA_RANGE( "cugemm_batched" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( count ) * ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( alpha ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasSgemmBatched( handle, transA, transB, m, n, k, &alpha, A, lda, B, ldb, &beta, C, ldc, count );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Pointer array batched BLAS kernel for double precision matrices (\f$ C_b=\alpha*A_b*B_b+\beta*C_b \f$).
+// \ingroup blas
+//
+// \param transA Specifies whether to transpose the matrices \a A (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param transB Specifies whether to transpose the matrices \a B (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param m The number of rows of the matrices \a A and \a C \f$[0..\infty)\f$.
+// \param n The number of columns of the matrices \a B and \a C \f$[0..\infty)\f$.
+// \param k The number of columns of \a A and rows of \a B \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ A_b*B_b \f$.
+// \param A Device array of pointers to the matrices \a A.
+// \param lda The leading dimension of the matrices \a A.
+// \param B Device array of pointers to the matrices \a B.
+// \param ldb The leading dimension of the matrices \a B.
+// \param beta The scaling factor for \f$ C_b \f$.
+// \param C Device array of pointers to the matrices \a C.
+// \param ldc The leading dimension of the matrices \a C.
+// \param count The number of products.
+// \return void
+//
+// This function is based on the cuBLAS cublasDgemmBatched() function.
+*/
+BLAZE_ALWAYS_INLINE void cugemm_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                         int m, int n, int k, double alpha,
+                                         const double* const* A, int lda,
+                                         const double* const* B, int ldb,
+                                         double beta,
+                                               double* const* C, int ldc,
+                                         int count )
+{
+   BLAZE_CUDA_RANGE( "cugemm_batched" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( count ) * ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( alpha ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasDgemmBatched( handle, transA, transB, m, n, k, &alpha, A, lda, B, ldb, &beta, C, ldc, count );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Pointer array batched BLAS kernel for single precision complex matrices (\f$ C_b=\alpha*A_b*B_b+\beta*C_b \f$).
+// \ingroup blas
+//
+// \param transA Specifies whether to transpose the matrices \a A (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param transB Specifies whether to transpose the matrices \a B (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param m The number of rows of the matrices \a A and \a C \f$[0..\infty)\f$.
+// \param n The number of columns of the matrices \a B and \a C \f$[0..\infty)\f$.
+// \param k The number of columns of \a A and rows of \a B \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ A_b*B_b \f$.
+// \param A Device array of pointers to the matrices \a A.
+// \param lda The leading dimension of the matrices \a A.
+// \param B Device array of pointers to the matrices \a B.
+// \param ldb The leading dimension of the matrices \a B.
+// \param beta The scaling factor for \f$ C_b \f$.
+// \param C Device array of pointers to the matrices \a C.
+// \param ldc The leading dimension of the matrices \a C.
+// \param count The number of products.
+// \return void
+//
+// This function is based on the cuBLAS cublasCgemmBatched() function.
+*/
+BLAZE_ALWAYS_INLINE void cugemm_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                         int m, int n, int k, complex<float> alpha,
+                                         const complex<float>* const* A, int lda,
+                                         const complex<float>* const* B, int ldb,
+                                         complex<float> beta,
+                                               complex<float>* const* C, int ldc,
+                                         int count )
+{
+   BLAZE_STATIC_ASSERT( sizeof( complex<float> ) == 2UL*sizeof( float ) );
+
+   BLAZE_CUDA_RANGE( "cugemm_batched" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( count ) * ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( alpha ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasCgemmBatched( handle, transA, transB, m, n, k,
+      reinterpret_cast<const cuComplex*>( &alpha ),
+      reinterpret_cast<const cuComplex* const*>( A ), lda,
+      reinterpret_cast<const cuComplex* const*>( B ), ldb,
+      reinterpret_cast<const cuComplex*>( &beta ),
+      reinterpret_cast<      cuComplex* const*>( C ), ldc, count );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Pointer array batched BLAS kernel for double precision complex matrices (\f$ C_b=\alpha*A_b*B_b+\beta*C_b \f$).
+// \ingroup blas
+//
+// \param transA Specifies whether to transpose the matrices \a A (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param transB Specifies whether to transpose the matrices \a B (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param m The number of rows of the matrices \a A and \a C \f$[0..\infty)\f$.
+// \param n The number of columns of the matrices \a B and \a C \f$[0..\infty)\f$.
+// \param k The number of columns of \a A and rows of \a B \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ A_b*B_b \f$.
+// \param A Device array of pointers to the matrices \a A.
+// \param lda The leading dimension of the matrices \a A.
+// \param B Device array of pointers to the matrices \a B.
+// \param ldb The leading dimension of the matrices \a B.
+// \param beta The scaling factor for \f$ C_b \f$.
+// \param C Device array of pointers to the matrices \a C.
+// \param ldc The leading dimension of the matrices \a C.
+// \param count The number of products.
+// \return void
+//
+// This function is based on the cuBLAS cublasZgemmBatched() function.
+*/
+BLAZE_ALWAYS_INLINE void cugemm_batched( cublasOperation_t transA, cublasOperation_t transB,
+                                         int m, int n, int k, complex<double> alpha,
+                                         const complex<double>* const* A, int lda,
+                                         const complex<double>* const* B, int ldb,
+                                         complex<double> beta,
+                                               complex<double>* const* C, int ldc,
+                                         int count )
+{
+   BLAZE_STATIC_ASSERT( sizeof( complex<double> ) == 2UL*sizeof( double ) );
+
+   BLAZE_CUDA_RANGE( "cugemm_batched" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( count ) * ( std::size_t( m ) * k + std::size_t( k ) * n + std::size_t( m ) * n ) * sizeof( alpha ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasZgemmBatched( handle, transA, transB, m, n, k,
+      reinterpret_cast<const cuDoubleComplex*>( &alpha ),
+      reinterpret_cast<const cuDoubleComplex* const*>( A ), lda,
+      reinterpret_cast<const cuDoubleComplex* const*>( B ), ldb,
+      reinterpret_cast<const cuDoubleComplex*>( &beta ),
+      reinterpret_cast<      cuDoubleComplex* const*>( C ), ldc, count );
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -40,7 +40,8 @@
 // Includes
 //*************************************************************************************************
 
-#include <cublas_v2.h>
+#include <blaze_cuda/util/CUBLASHandle.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 
 #include <blaze/math/Aliases.h>
 #include <blaze/math/constraints/BLASCompatible.h>
@@ -53,6 +54,7 @@
 #include <blaze/util/Complex.h>
 #include <blaze/util/NumericCast.h>
 #include <blaze/util/StaticAssert.h>
+#include <blaze/util/algorithms/Max.h>
 
 #include <blaze_cuda/math/DenseMatrix.h>
 #include <blaze_cuda/math/DenseVector.h>
@@ -128,10 +130,12 @@ BLAZE_ALWAYS_INLINE void cugemv( cublasOperation_t transA, int m, int n,
                                  float alpha, const float* A, int lda, const float* x, int incX,
                                  float beta, float* y, int incY )
 {
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugemv" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( m ) * n + m + n ) * sizeof( *y ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasSgemv( handle, transA, m, n, &alpha, A, lda, x, incX, &beta, y, incY );
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
@@ -162,10 +166,12 @@ BLAZE_ALWAYS_INLINE void cugemv( cublasOperation_t transA, int m, int n,
                                  double alpha, const double* A, int lda, const double* x, int incX,
                                  double beta, double* y, int incY )
 {
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugemv" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( m ) * n + m + n ) * sizeof( *y ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasDgemv( handle, transA, m, n, &alpha, A, lda, x, incX, &beta, y, incY );
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
@@ -199,15 +205,17 @@ BLAZE_ALWAYS_INLINE void cugemv( cublasOperation_t transA, int m, int n,
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<float> ) == 2UL*sizeof( float ) );
 
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugemv" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( m ) * n + m + n ) * sizeof( *y ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasCgemv( handle, transA, m, n,
       reinterpret_cast<const cuFloatComplex*>( &alpha ),
       reinterpret_cast<const cuFloatComplex*>( A ), lda,
       reinterpret_cast<const cuFloatComplex*>( x ), incX,
       reinterpret_cast<const cuFloatComplex*>( &beta ),
       reinterpret_cast<cuFloatComplex*>( y ), incY );
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
@@ -241,15 +249,17 @@ BLAZE_ALWAYS_INLINE void cugemv( cublasOperation_t transA, int m, int n,
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<double> ) == 2UL*sizeof( double ) );
 
-   cublasHandle_t handle;
-   cublasCreate_v2( &handle );
+   BLAZE_CUDA_RANGE( "cugemv" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( m ) * n + m + n ) * sizeof( *y ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasZgemv( handle, transA, m, n,
       reinterpret_cast<const cuDoubleComplex*>( &alpha ),
       reinterpret_cast<const cuDoubleComplex*>( A ), lda,
       reinterpret_cast<const cuDoubleComplex*>( x ), incX,
       reinterpret_cast<const cuDoubleComplex*>( &beta ),
       reinterpret_cast<cuDoubleComplex*>( y ), incY );
-   cublasDestroy_v2( handle );
 }
 //*************************************************************************************************
 
@@ -292,9 +302,10 @@ BLAZE_ALWAYS_INLINE void cugemv( DenseVector<VT1,false>& y,
    //BLAZE_CONSTRAINT_MUST_BE_CUBLAS_COMPATIBLE_TYPE( ElementType_t<MT1> );
    //BLAZE_CONSTRAINT_MUST_BE_CUBLAS_COMPATIBLE_TYPE( ElementType_t<VT2> );
 
+   // A row-major matrix is seen by cuBLAS as its column-major transpose
    const int m  ( numeric_cast<int>( SO == blaze::columnMajor ? (~A).rows() : (~A).columns() ) );
    const int n  ( numeric_cast<int>( SO == blaze::columnMajor ? (~A).columns() : (~A).rows() ) );
-   const int lda( numeric_cast<int>( n ) );
+   const int lda( numeric_cast<int>( max( (~A).spacing(), 1UL ) ) );
 
    cugemv( SO == blaze::columnMajor ? CUBLAS_OP_N : CUBLAS_OP_T, m, n, alpha,
            (~A).data(), lda, (~x).data(), 1, beta, (~y).data(), 1 );
@@ -340,11 +351,12 @@ BLAZE_ALWAYS_INLINE void cugemv( DenseVector<VT1,true>& y,
    //BLAZE_CONSTRAINT_MUST_BE_CUBLAS_COMPATIBLE_TYPE( ElementType_t<MT1> );
    //BLAZE_CONSTRAINT_MUST_BE_CUBLAS_COMPATIBLE_TYPE( ElementType_t<VT2> );
 
+   // y^T = x^T*A is computed as y = A^T*x
    const int m  ( numeric_cast<int>( SO == blaze::columnMajor ? (~A).rows() : (~A).columns() ) );
    const int n  ( numeric_cast<int>( SO == blaze::columnMajor ? (~A).columns() : (~A).rows() ) );
-   const int lda( numeric_cast<int>( m ) );
+   const int lda( numeric_cast<int>( max( (~A).spacing(), 1UL ) ) );
 
-   cugemv( SO == blaze::columnMajor ? CUBLAS_OP_N : CUBLAS_OP_T, m, n, alpha,
+   cugemv( SO == blaze::columnMajor ? CUBLAS_OP_T : CUBLAS_OP_N, m, n, alpha,
            (~A).data(), lda, (~x).data(), 1, beta, (~y).data(), 1 );
 }
 //*************************************************************************************************
@@ -0,0 +1,437 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/cublas/syrk.h
+//  \brief Header file for BLAS symmetric and Hermitian rank-k update functions (syrk, herk)
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_CUBLAS_SYRK_H_
+#define _BLAZE_CUDA_MATH_CUBLAS_SYRK_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze_cuda/util/CUBLASHandle.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/constraints/BLASCompatible.h>
+#include <blaze/math/constraints/Computation.h>
+#include <blaze/math/constraints/ConstDataAccess.h>
+#include <blaze/math/constraints/MutableDataAccess.h>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/system/Inline.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Complex.h>
+#include <blaze/util/NumericCast.h>
+#include <blaze/util/StaticAssert.h>
+#include <blaze/util/algorithms/Max.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  BLAS WRAPPER FUNCTIONS (SYRK, HERK)
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\name BLAS wrapper functions (syrk, herk) */
+//@{
+BLAZE_ALWAYS_INLINE void cusyrk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 float alpha, const float* A, int lda,
+                                 float beta, float* C, int ldc );
+
+BLAZE_ALWAYS_INLINE void cusyrk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 double alpha, const double* A, int lda,
+                                 double beta, double* C, int ldc );
+
+BLAZE_ALWAYS_INLINE void cusyrk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 complex<float> alpha, const complex<float>* A, int lda,
+                                 complex<float> beta, complex<float>* C, int ldc );
+
+BLAZE_ALWAYS_INLINE void cusyrk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 complex<double> alpha, const complex<double>* A, int lda,
+                                 complex<double> beta, complex<double>* C, int ldc );
+
+BLAZE_ALWAYS_INLINE void cuherk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 float alpha, const complex<float>* A, int lda,
+                                 float beta, complex<float>* C, int ldc );
+
+BLAZE_ALWAYS_INLINE void cuherk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 double alpha, const complex<double>* A, int lda,
+                                 double beta, complex<double>* C, int ldc );
+
+template< typename MT1, bool SO1, typename MT2, bool SO2, typename ST >
+BLAZE_ALWAYS_INLINE void cusyrk( DenseMatrix<MT1,SO1>& C, const DenseMatrix<MT2,SO2>& A,
+                                 ST alpha, ST beta, bool lower );
+
+template< typename MT1, bool SO1, typename MT2, bool SO2, typename ST >
+BLAZE_ALWAYS_INLINE void cuherk( DenseMatrix<MT1,SO1>& C, const DenseMatrix<MT2,SO2>& A,
+                                 ST alpha, ST beta, bool lower );
+//@}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief BLAS kernel for a symmetric rank-k update with single precision matrices
+//        (\f$ C=\alpha*op(A)*op(A)^T+\beta*C \f$).
+// \ingroup blas
+//
+// \param uplo Specifies the triangle of \a C to update (\a CUBLAS_FILL_MODE_LOWER or \a _UPPER).
+// \param trans Specifies whether \a op(A) is \a A or \a A^T (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param n The number of rows and columns of matrix \a C \f$[0..\infty)\f$.
+// \param k The number of columns of matrix \a op(A) \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ op(A)*op(A)^T \f$.
+// \param A Pointer to the first element of matrix \a A.
+// \param lda The total number of elements between two columns of matrix \a A \f$[0..\infty)\f$.
+// \param beta The scaling factor for \f$ C \f$.
+// \param C Pointer to the first element of matrix \a C.
+// \param ldc The total number of elements between two columns of matrix \a C \f$[0..\infty)\f$.
+// \return void
+//
+// This function performs the symmetric rank-k update for single precision matrices based on
+// the cublasSsyrk() function. Only the \a uplo triangle of \a C is read and written.
+*/
+BLAZE_ALWAYS_INLINE void cusyrk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 float alpha, const float* A, int lda,
+                                 float beta, float* C, int ldc )
+{
+   BLAZE_CUDA_RANGE( "cusyrk" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( n ) * k + std::size_t( n ) * ( n + 1 ) / 2UL ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasSsyrk( handle, uplo, trans, n, k, &alpha, A, lda, &beta, C, ldc );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief BLAS kernel for a symmetric rank-k update with double precision matrices
+//        (\f$ C=\alpha*op(A)*op(A)^T+\beta*C \f$).
+// \ingroup blas
+//
+// \param uplo Specifies the triangle of \a C to update (\a CUBLAS_FILL_MODE_LOWER or \a _UPPER).
+// \param trans Specifies whether \a op(A) is \a A or \a A^T (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param n The number of rows and columns of matrix \a C \f$[0..\infty)\f$.
+// \param k The number of columns of matrix \a op(A) \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ op(A)*op(A)^T \f$.
+// \param A Pointer to the first element of matrix \a A.
+// \param lda The total number of elements between two columns of matrix \a A \f$[0..\infty)\f$.
+// \param beta The scaling factor for \f$ C \f$.
+// \param C Pointer to the first element of matrix \a C.
+// \param ldc The total number of elements between two columns of matrix \a C \f$[0..\infty)\f$.
+// \return void
+//
+// This function performs the symmetric rank-k update for double precision matrices based on
+// the cublasDsyrk() function. Only the \a uplo triangle of \a C is read and written.
+*/
+BLAZE_ALWAYS_INLINE void cusyrk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 double alpha, const double* A, int lda,
+                                 double beta, double* C, int ldc )
+{
+   BLAZE_CUDA_RANGE( "cusyrk" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( n ) * k + std::size_t( n ) * ( n + 1 ) / 2UL ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasDsyrk( handle, uplo, trans, n, k, &alpha, A, lda, &beta, C, ldc );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief BLAS kernel for a symmetric rank-k update with single precision complex matrices
+//        (\f$ C=\alpha*op(A)*op(A)^T+\beta*C \f$).
+// \ingroup blas
+//
+// \param uplo Specifies the triangle of \a C to update (\a CUBLAS_FILL_MODE_LOWER or \a _UPPER).
+// \param trans Specifies whether \a op(A) is \a A or \a A^T (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param n The number of rows and columns of matrix \a C \f$[0..\infty)\f$.
+// \param k The number of columns of matrix \a op(A) \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ op(A)*op(A)^T \f$.
+// \param A Pointer to the first element of matrix \a A.
+// \param lda The total number of elements between two columns of matrix \a A \f$[0..\infty)\f$.
+// \param beta The scaling factor for \f$ C \f$.
+// \param C Pointer to the first element of matrix \a C.
+// \param ldc The total number of elements between two columns of matrix \a C \f$[0..\infty)\f$.
+// \return void
+//
+// This function performs the symmetric rank-k update for single precision complex matrices
+// based on the cublasCsyrk() function. Only the \a uplo triangle of \a C is read and written.
+*/
+BLAZE_ALWAYS_INLINE void cusyrk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 complex<float> alpha, const complex<float>* A, int lda,
+                                 complex<float> beta, complex<float>* C, int ldc )
+{
+   BLAZE_STATIC_ASSERT( sizeof( complex<float> ) == 2UL*sizeof( float ) );
+
+   BLAZE_CUDA_RANGE( "cusyrk" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( n ) * k + std::size_t( n ) * ( n + 1 ) / 2UL ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasCsyrk( handle, uplo, trans, n, k,
+      reinterpret_cast<const cuComplex*>( &alpha ),
+      reinterpret_cast<const cuComplex*>( A ), lda,
+      reinterpret_cast<const cuComplex*>( &beta ),
+      reinterpret_cast<      cuComplex*>( C ), ldc );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief BLAS kernel for a symmetric rank-k update with double precision complex matrices
+//        (\f$ C=\alpha*op(A)*op(A)^T+\beta*C \f$).
+// \ingroup blas
+//
+// \param uplo Specifies the triangle of \a C to update (\a CUBLAS_FILL_MODE_LOWER or \a _UPPER).
+// \param trans Specifies whether \a op(A) is \a A or \a A^T (\a CUBLAS_OP_N or \a CUBLAS_OP_T).
+// \param n The number of rows and columns of matrix \a C \f$[0..\infty)\f$.
+// \param k The number of columns of matrix \a op(A) \f$[0..\infty)\f$.
+// \param alpha The scaling factor for \f$ op(A)*op(A)^T \f$.
+// \param A Pointer to the first element of matrix \a A.
+// \param lda The total number of elements between two columns of matrix \a A \f$[0..\infty)\f$.
+// \param beta The scaling factor for \f$ C \f$.
+// \param C Pointer to the first element of matrix \a C.
+// \param ldc The total number of elements between two columns of matrix \a C \f$[0..\infty)\f$.
+// \return void
+//
+// This function performs the symmetric rank-k update for double precision complex matrices
+// based on the cublasZsyrk() function. Only the \a uplo triangle of \a C is read and written.
+*/
+BLAZE_ALWAYS_INLINE void cusyrk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 complex<double> alpha, const complex<double>* A, int lda,
+                                 complex<double> beta, complex<double>* C, int ldc )
+{
+   BLAZE_STATIC_ASSERT( sizeof( complex<double> ) == 2UL*sizeof( double ) );
+
+   BLAZE_CUDA_RANGE( "cusyrk" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( n ) * k + std::size_t( n ) * ( n + 1 ) / 2UL ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasZsyrk( handle, uplo, trans, n, k,
+      reinterpret_cast<const cuDoubleComplex*>( &alpha ),
+      reinterpret_cast<const cuDoubleComplex*>( A ), lda,
+      reinterpret_cast<const cuDoubleComplex*>( &beta ),
+      reinterpret_cast<      cuDoubleComplex*>( C ), ldc );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief BLAS kernel for a Hermitian rank-k update with single precision complex matrices
+//        (\f$ C=\alpha*op(A)*op(A)^H+\beta*C \f$).
+// \ingroup blas
+//
+// \param uplo Specifies the triangle of \a C to update (\a CUBLAS_FILL_MODE_LOWER or \a _UPPER).
+// \param trans Specifies whether \a op(A) is \a A or \a A^H (\a CUBLAS_OP_N or \a CUBLAS_OP_C).
+// \param n The number of rows and columns of matrix \a C \f$[0..\infty)\f$.
+// \param k The number of columns of matrix \a op(A) \f$[0..\infty)\f$.
+// \param alpha The real scaling factor for \f$ op(A)*op(A)^H \f$.
+// \param A Pointer to the first element of matrix \a A.
+// \param lda The total number of elements between two columns of matrix \a A \f$[0..\infty)\f$.
+// \param beta The real scaling factor for \f$ C \f$.
+// \param C Pointer to the first element of matrix \a C.
+// \param ldc The total number of elements between two columns of matrix \a C \f$[0..\infty)\f$.
+// \return void
+//
+// This function performs the Hermitian rank-k update for single precision complex matrices
+// based on the cublasCherk() function. Only the \a uplo triangle of \a C is read and written,
+// and the imaginary parts of its diagonal elements are set to zero.
+*/
+BLAZE_ALWAYS_INLINE void cuherk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 float alpha, const complex<float>* A, int lda,
+                                 float beta, complex<float>* C, int ldc )
+{
+   BLAZE_STATIC_ASSERT( sizeof( complex<float> ) == 2UL*sizeof( float ) );
+
+   BLAZE_CUDA_RANGE( "cuherk" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( n ) * k + std::size_t( n ) * ( n + 1 ) / 2UL ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasCherk( handle, uplo, trans, n, k, &alpha,
+      reinterpret_cast<const cuComplex*>( A ), lda, &beta,
+      reinterpret_cast<      cuComplex*>( C ), ldc );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief BLAS kernel for a Hermitian rank-k update with double precision complex matrices
+//        (\f$ C=\alpha*op(A)*op(A)^H+\beta*C \f$).
+// \ingroup blas
+//
+// \param uplo Specifies the triangle of \a C to update (\a CUBLAS_FILL_MODE_LOWER or \a _UPPER).
+// \param trans Specifies whether \a op(A) is \a A or \a A^H (\a CUBLAS_OP_N or \a CUBLAS_OP_C).
+// \param n The number of rows and columns of matrix \a C \f$[0..\infty)\f$.
+// \param k The number of columns of matrix \a op(A) \f$[0..\infty)\f$.
+// \param alpha The real scaling factor for \f$ op(A)*op(A)^H \f$.
+// \param A Pointer to the first element of matrix \a A.
+// \param lda The total number of elements between two columns of matrix \a A \f$[0..\infty)\f$.
+// \param beta The real scaling factor for \f$ C \f$.
+// \param C Pointer to the first element of matrix \a C.
+// \param ldc The total number of elements between two columns of matrix \a C \f$[0..\infty)\f$.
+// \return void
+//
+// This function performs the Hermitian rank-k update for double precision complex matrices
+// based on the cublasZherk() function. Only the \a uplo triangle of \a C is read and written,
+// and the imaginary parts of its diagonal elements are set to zero.
+*/
+BLAZE_ALWAYS_INLINE void cuherk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k,
+                                 double alpha, const complex<double>* A, int lda,
+                                 double beta, complex<double>* C, int ldc )
+{
+   BLAZE_STATIC_ASSERT( sizeof( complex<double> ) == 2UL*sizeof( double ) );
+
+   BLAZE_CUDA_RANGE( "cuherk" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( n ) * k + std::size_t( n ) * ( n + 1 ) / 2UL ) * sizeof( *C ) );
+
+   cublasHandle_t handle( cublas_handle() );
+   cublasZherk( handle, uplo, trans, n, k, &alpha,
+      reinterpret_cast<const cuDoubleComplex*>( A ), lda, &beta,
+      reinterpret_cast<      cuDoubleComplex*>( C ), ldc );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief BLAS kernel for a symmetric rank-k update (\f$ C=\alpha*A*A^T+\beta*C \f$).
+// \ingroup blas
+//
+// \param C The target left-hand side dense matrix.
+// \param A The dense matrix operand.
+// \param alpha The scaling factor for \f$ A*A^T \f$.
+// \param beta The scaling factor for \f$ C \f$.
+// \param lower \a true to update the lower triangle of \a C, \a false for the upper triangle.
+// \return void
+//
+// This function performs the symmetric rank-k update based on the BLAS syrk() functions. Only
+// the selected triangle of the square matrix \a C, including the diagonal, is read and written.
+// Both storage orders are handled without copies: a row-major operand is passed as its
+// transpose and a row-major target by its opposite triangle. Note that the function only
+// works for matrices with \c float, \c double, \c complex<float>, and \c complex<double>
+// element type. The attempt to call the function with matrices of any other element type
+// results in a compile time error.
+*/
+template< typename MT1   // Type of the left-hand side target matrix
+        , bool SO1       // Storage order of the left-hand side target matrix
+        , typename MT2   // Type of the matrix operand
+        , bool SO2       // Storage order of the matrix operand
+        , typename ST >  // Type of the scalar factors
+BLAZE_ALWAYS_INLINE void cusyrk( DenseMatrix<MT1,SO1>& C, const DenseMatrix<MT2,SO2>& A,
+                                 ST alpha, ST beta, bool lower )
+{
+   BLAZE_CONSTRAINT_MUST_NOT_BE_COMPUTATION_TYPE( MT1 );
+   BLAZE_CONSTRAINT_MUST_NOT_BE_COMPUTATION_TYPE( MT2 );
+
+   BLAZE_CONSTRAINT_MUST_HAVE_MUTABLE_DATA_ACCESS( MT1 );
+   BLAZE_CONSTRAINT_MUST_HAVE_CONST_DATA_ACCESS  ( MT2 );
+
+   BLAZE_CONSTRAINT_MUST_BE_BLAS_COMPATIBLE_TYPE( ElementType_t<MT1> );
+   BLAZE_CONSTRAINT_MUST_BE_BLAS_COMPATIBLE_TYPE( ElementType_t<MT2> );
+
+   BLAZE_INTERNAL_ASSERT( (~C).rows() == (~A).rows(), "Invalid number of rows"   );
+   BLAZE_INTERNAL_ASSERT( (~C).rows() == (~C).columns(), "Non-square target matrix" );
+
+   const int n  ( numeric_cast<int>( (~A).rows() )    );
+   const int k  ( numeric_cast<int>( (~A).columns() ) );
+   const int lda( numeric_cast<int>( max( (~A).spacing(), 1UL ) ) );
+   const int ldc( numeric_cast<int>( max( (~C).spacing(), 1UL ) ) );
+
+   cusyrk( ( ( SO1 == columnMajor ) == lower ? CUBLAS_FILL_MODE_LOWER : CUBLAS_FILL_MODE_UPPER ),
+           ( SO2 == columnMajor ? CUBLAS_OP_N : CUBLAS_OP_T ),
+           n, k, alpha, (~A).data(), lda, beta, (~C).data(), ldc );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief BLAS kernel for a Hermitian rank-k update (\f$ C=\alpha*A*A^H+\beta*C \f$).
+// \ingroup blas
+//
+// \param C The target left-hand side dense matrix.
+// \param A The dense matrix operand.
+// \param alpha The real scaling factor for \f$ A*A^H \f$.
+// \param beta The real scaling factor for \f$ C \f$.
+// \param lower \a true to update the lower triangle of \a C, \a false for the upper triangle.
+// \return void
+//
+// This function performs the Hermitian rank-k update based on the BLAS herk() functions. Only
+// the selected triangle of the square matrix \a C, including the diagonal, is read and written.
+// A row-major target is computed as the conjugate of its column-major view, which requires
+// the operand to have the same storage order as the target. Note that the function only works
+// for matrices with \c complex<float> and \c complex<double> element type. The attempt to call
+// the function with matrices of any other element type results in a compile time error.
+*/
+template< typename MT1   // Type of the left-hand side target matrix
+        , bool SO1       // Storage order of the left-hand side target matrix
+        , typename MT2   // Type of the matrix operand
+        , bool SO2       // Storage order of the matrix operand
+        , typename ST >  // Type of the real scalar factors
+BLAZE_ALWAYS_INLINE void cuherk( DenseMatrix<MT1,SO1>& C, const DenseMatrix<MT2,SO2>& A,
+                                 ST alpha, ST beta, bool lower )
+{
+   BLAZE_CONSTRAINT_MUST_NOT_BE_COMPUTATION_TYPE( MT1 );
+   BLAZE_CONSTRAINT_MUST_NOT_BE_COMPUTATION_TYPE( MT2 );
+
+   BLAZE_CONSTRAINT_MUST_HAVE_MUTABLE_DATA_ACCESS( MT1 );
+   BLAZE_CONSTRAINT_MUST_HAVE_CONST_DATA_ACCESS  ( MT2 );
+
+   BLAZE_CONSTRAINT_MUST_BE_BLAS_COMPATIBLE_TYPE( ElementType_t<MT1> );
+   BLAZE_CONSTRAINT_MUST_BE_BLAS_COMPATIBLE_TYPE( ElementType_t<MT2> );
+
+   BLAZE_STATIC_ASSERT_MSG( SO1 == SO2, "Herk requires operands of the same storage order" );
+
+   BLAZE_INTERNAL_ASSERT( (~C).rows() == (~A).rows(), "Invalid number of rows"   );
+   BLAZE_INTERNAL_ASSERT( (~C).rows() == (~C).columns(), "Non-square target matrix" );
+
+   const int n  ( numeric_cast<int>( (~A).rows() )    );
+   const int k  ( numeric_cast<int>( (~A).columns() ) );
+   const int lda( numeric_cast<int>( max( (~A).spacing(), 1UL ) ) );
+   const int ldc( numeric_cast<int>( max( (~C).spacing(), 1UL ) ) );
+
+   cuherk( ( ( SO1 == columnMajor ) == lower ? CUBLAS_FILL_MODE_LOWER : CUBLAS_FILL_MODE_UPPER ),
+           ( SO2 == columnMajor ? CUBLAS_OP_N : CUBLAS_OP_C ),
+           n, k, alpha, (~A).data(), lda, beta, (~C).data(), ldc );
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -40,7 +40,8 @@
 // Includes
 //*************************************************************************************************
 
-#include <cublas.h>
+#include <blaze_cuda/util/CUBLASHandle.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 
 #include <blaze/math/Aliases.h>
 #include <blaze/math/constraints/BLASCompatible.h>
@@ -125,10 +126,12 @@ BLAZE_ALWAYS_INLINE void cutrmv( CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANS
                                  CBLAS_DIAG diag, int n, const float* A, int lda, float* x,
                                  int incX )
 {
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cutrmv" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( n ) * n / 2UL + 2UL * n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasStrmv( handle, order, uplo, transA, diag, n, A, lda, x, incX );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
@@ -158,10 +161,12 @@ BLAZE_ALWAYS_INLINE void cutrmv( CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANS
                                  CBLAS_DIAG diag, int n, const double* A, int lda, double* x,
                                  int incX )
 {
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cutrmv" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( n ) * n / 2UL + 2UL * n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasDtrmv( handle, order, uplo, transA, diag, n, A, lda, x, incX );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
@@ -193,11 +198,13 @@ BLAZE_ALWAYS_INLINE void cutrmv( CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANS
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<float> ) == 2UL*sizeof( float ) );
 
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cutrmv" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( n ) * n / 2UL + 2UL * n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasCtrmv( handle, order, uplo, transA, diag, n, reinterpret_cast<const float*>( A ),
                 lda, reinterpret_cast<float*>( x ), incX );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
@@ -229,11 +236,13 @@ BLAZE_ALWAYS_INLINE void cutrmv( CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANS
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<double> ) == 2UL*sizeof( double ) );
 
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cutrmv" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( n ) * n / 2UL + 2UL * n ) * sizeof( *x ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasZtrmv( handle, order, uplo, transA, diag, n, reinterpret_cast<const double*>( A ),
                 lda, reinterpret_cast<double*>( x ), incX );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
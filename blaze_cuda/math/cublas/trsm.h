@@ -40,7 +40,8 @@
 // Includes
 //*************************************************************************************************
 
-#include <cublas.h>
+#include <blaze_cuda/util/CUBLASHandle.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 
 #include <blaze/math/Aliases.h>
 #include <blaze/math/constraints/BLASCompatible.h>
@@ -131,10 +132,13 @@ BLAZE_ALWAYS_INLINE void cutrsm( CBLAS_ORDER order, CBLAS_SIDE side, CBLAS_UPLO
                                  CBLAS_TRANSPOSE transA, CBLAS_DIAG diag, int m, int n,
                                  float alpha, const float* A, int lda, float* B, int ldb )
 {
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cutrsm" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( side == CblasLeft ? m : n ) * ( side == CblasLeft ? m : n ) / 2UL
+                          + 2UL * std::size_t( m ) * n ) * sizeof( *B ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasStrsm( handle, order, side, uplo, transA, diag, m, n, alpha, A, lda, B, ldb );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
@@ -168,10 +172,13 @@ BLAZE_ALWAYS_INLINE void cutrsm( CBLAS_ORDER order, CBLAS_SIDE side, CBLAS_UPLO
                                  CBLAS_TRANSPOSE transA, CBLAS_DIAG diag, int m, int n,
                                  double alpha, const double* A, int lda, double* B, int ldb )
 {
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cutrsm" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( side == CblasLeft ? m : n ) * ( side == CblasLeft ? m : n ) / 2UL
+                          + 2UL * std::size_t( m ) * n ) * sizeof( *B ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasDtrsm( handle, order, side, uplo, transA, diag, m, n, alpha, A, lda, B, ldb );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
@@ -208,11 +215,14 @@ BLAZE_ALWAYS_INLINE void cutrsm( CBLAS_ORDER order, CBLAS_SIDE side, CBLAS_UPLO
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<float> ) == 2UL*sizeof( float ) );
 
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cutrsm" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( side == CblasLeft ? m : n ) * ( side == CblasLeft ? m : n ) / 2UL
+                          + 2UL * std::size_t( m ) * n ) * sizeof( *B ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasCtrsm( handle, order, side, uplo, transA, diag, m, n, reinterpret_cast<const float*>( &alpha ),
                 reinterpret_cast<const float*>( A ), lda, reinterpret_cast<float*>( B ), ldb );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
@@ -249,11 +259,14 @@ BLAZE_ALWAYS_INLINE void cutrsm( CBLAS_ORDER order, CBLAS_SIDE side, CBLAS_UPLO
 {
    BLAZE_STATIC_ASSERT( sizeof( complex<double> ) == 2UL*sizeof( double ) );
 
-   cublasHandle_t handle;
-   cublasCreate( &handle );
+   BLAZE_CUDA_RANGE( "cutrsm" );
+   BLAZE_CUDA_COUNT( cublasCalls, 1UL );
+   BLAZE_CUDA_COUNT( bytes, ( std::size_t( side == CblasLeft ? m : n ) * ( side == CblasLeft ? m : n ) / 2UL
+                          + 2UL * std::size_t( m ) * n ) * sizeof( *B ) );
+
+   cublasHandle_t handle( cublas_handle() );
    cublasZtrsm( handle, order, side, uplo, transA, diag, m, n, reinterpret_cast<const double*>( &alpha ),
                 reinterpret_cast<const double*>( A ), lda, reinterpret_cast<double*>( B ), ldb );
-   cublasDestroy( handle );
 }
 #endif
 //*************************************************************************************************
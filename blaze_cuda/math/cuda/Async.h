@@ -0,0 +1,184 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/cuda/Async.h
+//  \brief Header file for the asynchronous CUDA assignments and reductions
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_CUDA_ASYNC_H_
+#define _BLAZE_CUDA_MATH_CUDA_ASYNC_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <future>
+
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/math/expressions/Matrix.h>
+#include <blaze/math/expressions/Vector.h>
+#include <blaze/util/FunctionTrace.h>
+
+#include <blaze_cuda/util/algorithms/CUDAReduce.h>
+#include <blaze_cuda/util/CUDAFuture.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  ASYNCHRONOUS ASSIGNMENTS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Asynchronous assignment of a vector to a dense vector.
+// \ingroup cuda
+//
+// \param lhs The target left-hand side dense vector.
+// \param rhs The right-hand side vector to be assigned.
+// \return Future becoming ready once \a lhs holds the result.
+//
+// The assignment is enqueued on the device and the function returns without waiting for it.
+// \a lhs (and the operands of \a rhs) must not be accessed from the host before the future is
+// ready. The future type is selected by \a Promise, e.g.
+// \c async_assign<CUDAHPXPromise>( a, b + c ) returns a \c hpx::future<void>.
+*/
+template< template< typename > class Promise = std::promise  // Type of the promise
+        , typename VT1                                        // Type of the left-hand side dense vector
+        , bool TF1                                            // Transpose flag of the left-hand side dense vector
+        , typename VT2                                        // Type of the right-hand side vector
+        , bool TF2 >                                          // Transpose flag of the right-hand side vector
+inline auto async_assign( DenseVector<VT1,TF1>& lhs, const Vector<VT2,TF2>& rhs )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   (~lhs) = (~rhs);
+
+   return cuda_completion_future<Promise>();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Asynchronous assignment of a matrix to a dense matrix.
+// \ingroup cuda
+//
+// \param lhs The target left-hand side dense matrix.
+// \param rhs The right-hand side matrix to be assigned.
+// \return Future becoming ready once \a lhs holds the result.
+//
+// See the dense vector overload for the synchronization rules.
+*/
+template< template< typename > class Promise = std::promise  // Type of the promise
+        , typename MT1                                        // Type of the left-hand side dense matrix
+        , bool SO1                                            // Storage order of the left-hand side dense matrix
+        , typename MT2                                        // Type of the right-hand side matrix
+        , bool SO2 >                                          // Storage order of the right-hand side matrix
+inline auto async_assign( DenseMatrix<MT1,SO1>& lhs, const Matrix<MT2,SO2>& rhs )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   (~lhs) = (~rhs);
+
+   return cuda_completion_future<Promise>();
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  ASYNCHRONOUS REDUCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Asynchronous reduction of the range [begin, end).
+// \ingroup cuda
+//
+// \param begin Iterator to the first element.
+// \param end Iterator one past the last element.
+// \param init The initial value, an identity of \a op.
+// \param op The binary reduction operation.
+// \return Future of the reduced value.
+//
+// The reduction runs as a single kernel into a recycled managed memory slot. The future is
+// fulfilled from a stream callback, so no host thread waits for the device.
+*/
+template< template< typename > class Promise = std::promise  // Type of the promise
+        , typename Input                                      // Type of the input iterators
+        , typename T                                          // Type of the reduced values
+        , typename OP >                                       // Type of the reduction operation
+inline auto async_reduce( Input begin, Input end, T init, OP op )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   T* const slot( cuda_result_slots<T>().acquire() );
+
+   try {
+      cuda_reduce_into( begin, end, init, op, slot, cuda_reduce_workspace<T>() );
+   }
+   catch( ... ) {
+      cuda_result_slots<T>().release( slot );
+      throw;
+   }
+
+   return cuda_value_future<Promise>( slot );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Asynchronous reduction of a dense vector.
+// \ingroup cuda
+//
+// \param vec The dense vector to be reduced.
+// \param init The initial value, an identity of \a op.
+// \param op The binary reduction operation.
+// \return Future of the reduced value.
+*/
+template< template< typename > class Promise = std::promise  // Type of the promise
+        , typename VT                                         // Type of the dense vector
+        , bool TF                                             // Transpose flag of the dense vector
+        , typename T                                          // Type of the reduced values
+        , typename OP >                                       // Type of the reduction operation
+inline auto async_reduce( const DenseVector<VT,TF>& vec, T init, OP op )
+{
+   return async_reduce<Promise>( (~vec).begin(), (~vec).end(), init, op );
+}
+//*************************************************************************************************
+
+}  // namespace blaze
+
+#endif
@@ -0,0 +1,307 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/cuda/BatchedGemm.h
+//  \brief Header file for the batched CUDA matrix/matrix multiplication
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_CUDA_BATCHEDGEMM_H_
+#define _BLAZE_CUDA_MATH_CUDA_BATCHEDGEMM_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <iterator>
+#include <type_traits>
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/Exception.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/math/typetraits/HasConstDataAccess.h>
+#include <blaze/math/typetraits/HasMutableDataAccess.h>
+#include <blaze/math/typetraits/IsDenseMatrix.h>
+#include <blaze/math/typetraits/IsRowMajorMatrix.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/NumericCast.h>
+#include <blaze/util/Types.h>
+
+#include <blaze_cuda/math/cublas/gemmbatched.h>
+#include <blaze_cuda/math/dense/CUDAMatrixBatch.h>
+#include <blaze_cuda/util/CUDAMirroredArray.h>
+#include <blaze_cuda/util/algorithms/CUDABatchedGemm.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  BATCHED MATRIX/MATRIX MULTIPLICATION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Backend of the batched multiplication for matrices of at most cuda_small_gemm_max
+//        rows and columns.
+// \ingroup cuda
+//
+// The storage orders \a SO1, \a SO2 and \a SO3 of C, A and B are expressed as the row and column
+// strides expected by cuda_gemm_batched_small().
+*/
+template< bool SO1           // Storage order of the target matrices
+        , bool SO2           // Storage order of the left-hand side operands
+        , bool SO3           // Storage order of the right-hand side operands
+        , typename ET        // Element type of the matrices
+        , typename CBatch    // Batch accessor of the target matrices
+        , typename ABatch    // Batch accessor of the left-hand side operands
+        , typename BBatch >  // Batch accessor of the right-hand side operands
+inline void cudaBatchedGemmSmall( size_t count, size_t m, size_t n, size_t k, const ET& alpha
+                                , ABatch a, size_t lda, BBatch b, size_t ldb
+                                , const ET& beta, CBatch c, size_t ldc )
+{
+   cuda_gemm_batched_small( count, m, n, k, alpha
+                          , a, ( SO2 == rowMajor ? lda : 1UL ), ( SO2 == rowMajor ? 1UL : lda )
+                          , b, ( SO3 == rowMajor ? ldb : 1UL ), ( SO3 == rowMajor ? 1UL : ldb )
+                          , beta
+                          , c, ( SO1 == rowMajor ? ldc : 1UL ), ( SO1 == rowMajor ? 1UL : ldc ) );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Batched dense matrix multiplication (\f$ C_b=\alpha*A_b*B_b+\beta*C_b \f$).
+// \ingroup cuda
+//
+// \param C The batch of target matrices.
+// \param A The batch of left-hand side operands.
+// \param B The batch of right-hand side operands.
+// \param alpha The scaling factor for \f$ A_b*B_b \f$.
+// \param beta The scaling factor for \f$ C_b \f$.
+// \return void
+// \exception std::invalid_argument Matrix sizes do not match.
+//
+// All products are computed by a single launch. If no dimension exceeds cuda_small_gemm_max,
+// a register blocked kernel processing several products per thread block is used, otherwise
+// the products are delegated to cuBLAS gemmStridedBatched(). The storage orders of the three
+// batches may differ.
+*/
+template< typename Type      // Element type of the matrices
+        , bool SO1           // Storage order of the target matrices
+        , bool SO2           // Storage order of the left-hand side operands
+        , bool SO3           // Storage order of the right-hand side operands
+        , typename ST=Type >  // Type of the scalar factors
+inline void batched_gemm( CUDAMatrixBatch<Type,SO1>& C
+                        , const CUDAMatrixBatch<Type,SO2>& A
+                        , const CUDAMatrixBatch<Type,SO3>& B
+                        , ST alpha = ST(1), ST beta = ST(0) )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if( A.size() != B.size() || C.size() != A.size() || A.columns() != B.rows() ||
+       C.rows() != A.rows() || C.columns() != B.columns() ) {
+      BLAZE_THROW_INVALID_ARGUMENT( "Matrix sizes do not match" );
+   }
+
+   const size_t count( C.size() );
+   const size_t m( A.rows() );
+   const size_t n( B.columns() );
+   const size_t k( A.columns() );
+
+   if( count == 0UL || m == 0UL || n == 0UL ) return;
+
+   const Type a( alpha );
+   const Type b( beta );
+
+   if( m <= cuda_small_gemm_max && n <= cuda_small_gemm_max && k <= cuda_small_gemm_max ) {
+      cudaBatchedGemmSmall<SO1,SO2,SO3>( count, m, n, k, a
+                                       , CUDAStridedBatch<const Type>{ A.data(), A.stride() }, A.spacing()
+                                       , CUDAStridedBatch<const Type>{ B.data(), B.stride() }, B.spacing()
+                                       , b, CUDAStridedBatch<Type>{ C.data(), C.stride() }, C.spacing() );
+      return;
+   }
+
+   const int lda( numeric_cast<int>( A.spacing() ) );
+   const int ldb( numeric_cast<int>( B.spacing() ) );
+   const int ldc( numeric_cast<int>( C.spacing() ) );
+
+   if( SO1 == columnMajor ) {
+      cugemm_strided_batched( ( SO2 ? CUBLAS_OP_N : CUBLAS_OP_T ),
+                              ( SO3 ? CUBLAS_OP_N : CUBLAS_OP_T ),
+                              numeric_cast<int>( m ), numeric_cast<int>( n ), numeric_cast<int>( k ), a,
+                              A.data(), lda, A.stride(),
+                              B.data(), ldb, B.stride(),
+                              b,
+                              C.data(), ldc, C.stride(), numeric_cast<int>( count ) );
+   }
+   else {
+      cugemm_strided_batched( ( SO3 ? CUBLAS_OP_T : CUBLAS_OP_N ),
+                              ( SO2 ? CUBLAS_OP_T : CUBLAS_OP_N ),
+                              numeric_cast<int>( n ), numeric_cast<int>( m ), numeric_cast<int>( k ), a,
+                              B.data(), ldb, B.stride(),
+                              A.data(), lda, A.stride(),
+                              b,
+                              C.data(), ldc, C.stride(), numeric_cast<int>( count ) );
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Batched dense matrix multiplication of ranges of matrices (\f$ C_b=\alpha*A_b*B_b+\beta*C_b \f$).
+// \ingroup cuda
+//
+// \param C The range of target matrices (e.g. a \c std::vector of CUDADynamicMatrix).
+// \param A The range of left-hand side operands.
+// \param B The range of right-hand side operands.
+// \param alpha The scaling factor for \f$ A_b*B_b \f$.
+// \param beta The scaling factor for \f$ C_b \f$.
+// \return void
+// \exception std::invalid_argument Matrix sizes do not match.
+//
+// The matrices may be located anywhere in memory, but all matrices of a range must have the
+// same size and spacing. The addresses of the matrices are gathered into device arrays (one
+// host to device copy), then the products are computed by a single launch: the kernel for
+// small matrices of batched_gemm(), or cuBLAS gemmBatched().
+*/
+template< typename CR    // Type of the range of target matrices
+        , typename AR    // Type of the range of left-hand side operands
+        , typename BR    // Type of the range of right-hand side operands
+        , typename MT1 = std::decay_t< decltype( *std::begin( std::declval<CR&>() ) ) >
+        , typename MT2 = std::decay_t< decltype( *std::begin( std::declval<const AR&>() ) ) >
+        , typename MT3 = std::decay_t< decltype( *std::begin( std::declval<const BR&>() ) ) >
+        , typename ST = ElementType_t<MT1> >  // Type of the scalar factors
+inline auto batched_gemm( CR& C, const AR& A, const BR& B, ST alpha = ST(1), ST beta = ST(0) )
+   -> EnableIf_t< IsDenseMatrix_v<MT1> && IsDenseMatrix_v<MT2> && IsDenseMatrix_v<MT3> &&
+                  HasMutableDataAccess_v<MT1> && HasConstDataAccess_v<MT2> && HasConstDataAccess_v<MT3> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   using ET = ElementType_t<MT1>;
+
+   static_assert( std::is_same< ET, ElementType_t<MT2> >::value &&
+                  std::is_same< ET, ElementType_t<MT3> >::value, "Mixed element types" );
+
+   constexpr bool SO1( !IsRowMajorMatrix_v<MT1> );
+   constexpr bool SO2( !IsRowMajorMatrix_v<MT2> );
+   constexpr bool SO3( !IsRowMajorMatrix_v<MT3> );
+
+   const size_t count( std::distance( std::begin( C ), std::end( C ) ) );
+
+   if( size_t( std::distance( std::begin( A ), std::end( A ) ) ) != count ||
+       size_t( std::distance( std::begin( B ), std::end( B ) ) ) != count ) {
+      BLAZE_THROW_INVALID_ARGUMENT( "Matrix sizes do not match" );
+   }
+
+   if( count == 0UL ) return;
+
+   const MT1& C0( *std::begin( C ) );
+   const MT2& A0( *std::begin( A ) );
+   const MT3& B0( *std::begin( B ) );
+
+   const size_t m( A0.rows() );
+   const size_t n( B0.columns() );
+   const size_t k( A0.columns() );
+
+   if( A0.columns() != B0.rows() || C0.rows() != m || C0.columns() != n ) {
+      BLAZE_THROW_INVALID_ARGUMENT( "Matrix sizes do not match" );
+   }
+
+   CUDAMirroredArray<const ET*> pa( count );
+   CUDAMirroredArray<const ET*> pb( count );
+   CUDAMirroredArray<ET*>       pc( count );
+
+   {
+      const ET** ha( pa.host() );
+      const ET** hb( pb.host() );
+      ET**       hc( pc.host() );
+
+      auto c( std::begin( C ) );
+      auto a( std::begin( A ) );
+      auto b( std::begin( B ) );
+
+      for( size_t i=0UL; i<count; ++i, ++c, ++a, ++b )
+      {
+         if( (*a).rows() != m || (*a).columns() != k || (*a).spacing() != A0.spacing() ||
+             (*b).rows() != k || (*b).columns() != n || (*b).spacing() != B0.spacing() ||
+             (*c).rows() != m || (*c).columns() != n || (*c).spacing() != C0.spacing() ) {
+            BLAZE_THROW_INVALID_ARGUMENT( "Matrix sizes do not match" );
+         }
+
+         ha[i] = (*a).data();
+         hb[i] = (*b).data();
+         hc[i] = (*c).data();
+      }
+   }
+
+   if( m == 0UL || n == 0UL ) return;
+
+   const ET alpha_( alpha );
+   const ET beta_ ( beta  );
+
+   if( m <= cuda_small_gemm_max && n <= cuda_small_gemm_max && k <= cuda_small_gemm_max ) {
+      cudaBatchedGemmSmall<SO1,SO2,SO3>( count, m, n, k, alpha_
+                                       , CUDAPointerBatch<const ET>{ pa.cdevice() }, A0.spacing()
+                                       , CUDAPointerBatch<const ET>{ pb.cdevice() }, B0.spacing()
+                                       , beta_, CUDAPointerBatch<ET>{ pc.cdevice() }, C0.spacing() );
+      return;
+   }
+
+   const int lda( numeric_cast<int>( A0.spacing() ) );
+   const int ldb( numeric_cast<int>( B0.spacing() ) );
+   const int ldc( numeric_cast<int>( C0.spacing() ) );
+
+   if( SO1 == columnMajor ) {
+      cugemm_batched( ( SO2 ? CUBLAS_OP_N : CUBLAS_OP_T ),
+                      ( SO3 ? CUBLAS_OP_N : CUBLAS_OP_T ),
+                      numeric_cast<int>( m ), numeric_cast<int>( n ), numeric_cast<int>( k ), alpha_,
+                      pa.cdevice(), lda,
+                      pb.cdevice(), ldb,
+                      beta_,
+                      pc.cdevice(), ldc, numeric_cast<int>( count ) );
+   }
+   else {
+      cugemm_batched( ( SO3 ? CUBLAS_OP_T : CUBLAS_OP_N ),
+                      ( SO2 ? CUBLAS_OP_T : CUBLAS_OP_N ),
+                      numeric_cast<int>( n ), numeric_cast<int>( m ), numeric_cast<int>( k ), alpha_,
+                      pb.cdevice(), ldb,
+                      pa.cdevice(), lda,
+                      beta_,
+                      pc.cdevice(), ldc, numeric_cast<int>( count ) );
+   }
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
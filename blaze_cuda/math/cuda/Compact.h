@@ -0,0 +1,134 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/cuda/Compact.h
+//  \brief Header file for the CUDA-based compaction of dense vectors
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_CUDA_COMPACT_H_
+#define _BLAZE_CUDA_MATH_CUDA_COMPACT_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/math/typetraits/HasConstDataAccess.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/Types.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/algorithms/CUDACompact.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  COMPACTION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the elements of a CUDA-assignable dense vector satisfying a predicate.
+// \ingroup cuda
+//
+// \param dv The dense vector.
+// \param pred The device callable selection predicate.
+// \return The selected elements of \a dv, in order.
+//
+// The elements are counted and then compacted on the device, only the number of selected
+// elements is transferred to the host. Expressions are evaluated beforehand.
+*/
+template< typename VT      // Type of the dense vector
+        , bool TF          // Transpose flag of the dense vector
+        , typename Pred >  // Type of the predicate
+inline auto compact( const DenseVector<VT,TF>& dv, Pred pred )
+   -> EnableIf_t< IsCUDAAssignable_v<VT>, ResultType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<VT> ) {
+      const ResultType_t<VT> tmp( ~dv );
+      return compact( tmp, pred );
+   }
+   else {
+      const auto begin( (~dv).data() );
+
+      CUDACompaction compaction;
+      ResultType_t<VT> res( compaction.count( begin, begin + (~dv).size(), pred ) );
+      compaction.copy( begin, res.data(), pred );
+
+      return res;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the indices of the elements of a CUDA-assignable dense vector satisfying a
+//        predicate.
+// \ingroup cuda
+//
+// \param dv The dense vector.
+// \param pred The device callable selection predicate.
+// \return The indices of the selected elements of \a dv, in increasing order.
+*/
+template< typename VT      // Type of the dense vector
+        , bool TF          // Transpose flag of the dense vector
+        , typename Pred >  // Type of the predicate
+inline auto find_indices( const DenseVector<VT,TF>& dv, Pred pred )
+   -> EnableIf_t< IsCUDAAssignable_v<VT>, CUDADynamicVector<size_t,TF> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<VT> ) {
+      const ResultType_t<VT> tmp( ~dv );
+      return find_indices( tmp, pred );
+   }
+   else {
+      const auto begin( (~dv).data() );
+
+      CUDACompaction compaction;
+      CUDADynamicVector<size_t,TF> res( compaction.count( begin, begin + (~dv).size(), pred ) );
+      compaction.copyIndices( begin, res.data(), pred );
+
+      return res;
+   }
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
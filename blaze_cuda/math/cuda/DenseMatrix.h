@@ -44,8 +44,17 @@
 #include <blaze/math/AlignmentFlag.h>
 #include <blaze/math/expressions/DenseMatrix.h>
 #include <blaze/math/expressions/DMatDMatAddExpr.h>
+#include <blaze/math/expressions/DMatDMatMapExpr.h>
+#include <blaze/math/expressions/DMatDMatSchurExpr.h>
+#include <blaze/math/expressions/DMatDMatSubExpr.h>
+#include <blaze/math/expressions/DMatMapExpr.h>
+#include <blaze/math/expressions/DMatScalarDivExpr.h>
+#include <blaze/math/expressions/DMatScalarMultExpr.h>
+#include <blaze/math/expressions/DMatSerialExpr.h>
+#include <blaze/math/expressions/DMatTransExpr.h>
 #include <blaze/math/expressions/SparseMatrix.h>
 #include <blaze/math/StorageOrder.h>
+#include <blaze/math/typetraits/HasConstDataAccess.h>
 #include <blaze/math/typetraits/IsCUDAAssignable.h>
 #include <blaze/math/typetraits/IsDenseMatrix.h>
 #include <blaze/math/typetraits/IsOperation.h>
@@ -57,8 +66,12 @@
 #include <blaze/util/StaticAssert.h>
 #include <blaze/util/Types.h>
 
+#include <blaze_cuda/math/cuda/PackedAssign.h>
 #include <blaze_cuda/util/algorithms/CUDATransform.h>
+#include <blaze_cuda/util/algorithms/CUDATransform2D.h>
+#include <blaze_cuda/util/algorithms/CUDATranspose.h>
 #include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 
 
 namespace blaze {
@@ -69,6 +82,153 @@ namespace blaze {
 //
 //=================================================================================================
 
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the distance between the first elements of two consecutive rows/columns.
+// \ingroup cuda
+//
+// \param dm The dense matrix or dense matrix expression.
+// \return The spacing between two rows (row-major) or columns (column-major).
+//
+// For matrices with data access this is the spacing() of the matrix. For expressions it is the
+// distance between the iterators of the first two rows/columns, which the expression iterators
+// compute from their left-most operand only. The expression can therefore only be traversed with
+// this spacing if all of its operands share it (see cudaIsUniformlySpaced()).
+*/
+template< typename MT  // Type of the dense matrix
+        , bool SO >    // Storage order of the dense matrix
+inline size_t cudaSpacing( const DenseMatrix<MT,SO>& dm )
+{
+   if constexpr( HasConstDataAccess_v<MT> ) {
+      return (~dm).spacing();
+   }
+   else {
+      const size_t lines( SO == rowMajor ? (~dm).rows() : (~dm).columns() );
+
+      if( lines < 2UL )
+         return 0UL;
+
+      const size_t spacing( (~dm).begin(1UL) - (~dm).begin(0UL) );
+
+      BLAZE_INTERNAL_ASSERT( (~dm).begin(0UL) + ( lines - 1UL ) * spacing == (~dm).begin(lines-1UL)
+                           , "Operands with different spacings" );
+
+      return spacing;
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns whether all operands of a dense matrix expression have the given spacing.
+// \ingroup cuda
+//
+// \param dm The dense matrix or dense matrix expression.
+// \param spacing The expected spacing between two rows/columns.
+// \return \a true if every operand of \a dm has data access, storage order \a SO0 and \a spacing.
+//
+// The element-wise expressions are traversed down to their operands. Any other expression is
+// conservatively reported as not uniformly spaced.
+*/
+template< bool SO0      // Storage order of the traversed expression
+        , typename MT   // Type of the dense matrix
+        , bool SO >     // Storage order of the dense matrix
+inline bool cudaHasSpacing( const DenseMatrix<MT,SO>& dm, size_t spacing )
+{
+   if constexpr( SO == SO0 && HasConstDataAccess_v<MT> ) {
+      return (~dm).spacing() == spacing;
+   }
+   else {
+      return false;
+   }
+}
+
+template< bool SO0, typename MT1, typename MT2, bool SO >
+inline bool cudaHasSpacing( const DMatDMatAddExpr<MT1,MT2,SO>& dm, size_t spacing )
+{
+   return cudaHasSpacing<SO0>( dm.leftOperand(), spacing ) && cudaHasSpacing<SO0>( dm.rightOperand(), spacing );
+}
+
+template< bool SO0, typename MT1, typename MT2, bool SO >
+inline bool cudaHasSpacing( const DMatDMatSubExpr<MT1,MT2,SO>& dm, size_t spacing )
+{
+   return cudaHasSpacing<SO0>( dm.leftOperand(), spacing ) && cudaHasSpacing<SO0>( dm.rightOperand(), spacing );
+}
+
+template< bool SO0, typename MT1, typename MT2, bool SO >
+inline bool cudaHasSpacing( const DMatDMatSchurExpr<MT1,MT2,SO>& dm, size_t spacing )
+{
+   return cudaHasSpacing<SO0>( dm.leftOperand(), spacing ) && cudaHasSpacing<SO0>( dm.rightOperand(), spacing );
+}
+
+template< bool SO0, typename MT1, typename MT2, typename OP, bool SO >
+inline bool cudaHasSpacing( const DMatDMatMapExpr<MT1,MT2,OP,SO>& dm, size_t spacing )
+{
+   return cudaHasSpacing<SO0>( dm.leftOperand(), spacing ) && cudaHasSpacing<SO0>( dm.rightOperand(), spacing );
+}
+
+template< bool SO0, typename MT, typename OP, bool SO >
+inline bool cudaHasSpacing( const DMatMapExpr<MT,OP,SO>& dm, size_t spacing )
+{
+   return cudaHasSpacing<SO0>( dm.operand(), spacing );
+}
+
+template< bool SO0, typename MT, typename ST, bool SO >
+inline bool cudaHasSpacing( const DMatScalarMultExpr<MT,ST,SO>& dm, size_t spacing )
+{
+   return cudaHasSpacing<SO0>( dm.leftOperand(), spacing );
+}
+
+template< bool SO0, typename MT, typename ST, bool SO >
+inline bool cudaHasSpacing( const DMatScalarDivExpr<MT,ST,SO>& dm, size_t spacing )
+{
+   return cudaHasSpacing<SO0>( dm.leftOperand(), spacing );
+}
+
+template< bool SO0, typename MT, bool SO >
+inline bool cudaHasSpacing( const DMatSerialExpr<MT,SO>& dm, size_t spacing )
+{
+   return cudaHasSpacing<SO0>( dm.operand(), spacing );
+}
+
+template< bool SO0, typename MT, bool SO >
+inline bool cudaHasSpacing( const DMatTransExpr<MT,SO>& dm, size_t spacing )
+{
+   return cudaHasSpacing<!SO0>( dm.operand(), spacing );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns whether a dense matrix can be traversed with the spacing of cudaSpacing().
+// \ingroup cuda
+//
+// \param dm The dense matrix or dense matrix expression.
+// \return \a true if all the operands of \a dm are stored with the same spacing.
+//
+// Expressions whose operands have different spacings (e.g. a padded custom matrix next to a
+// dynamic matrix) must be traversed row by row (resp. column by column) instead.
+*/
+template< typename MT  // Type of the dense matrix
+        , bool SO >    // Storage order of the dense matrix
+inline bool cudaIsUniformlySpaced( const DenseMatrix<MT,SO>& dm )
+{
+   if constexpr( HasConstDataAccess_v<MT> ) {
+      return true;
+   }
+   else {
+      const size_t lines( SO == rowMajor ? (~dm).rows() : (~dm).columns() );
+      return lines < 2UL || cudaHasSpacing<SO>( ~dm, cudaSpacing( ~dm ) );
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
 //*************************************************************************************************
 /*! \cond BLAZE_INTERNAL */
 /*!\brief Backend of the CUDA-based (compound) assignment of a dense matrix to a dense matrix.
@@ -80,7 +240,11 @@ namespace blaze {
 // \return auto
 //
 // This function is the backend implementation of the CUDA-based assignment of a dense
-// matrix to a dense matrix.\n
+// matrix to a dense matrix. The whole matrix is processed by a single cuda_transform_2d()
+// launch, or by cuda_packed_transform() for unpadded contiguous operands. Operands of different
+// storage orders are combined by cuda_transpose(), which reads \a rhs along its own rows or
+// columns. Expressions whose operands have different spacings are processed one row (resp.
+// column) at a time.\n
 // This function must \b NOT be called explicitly! It is used internally for the performance
 // optimized evaluation of expression templates. Calling this function explicitly might result
 // in erroneous results and/or in compilation errors. Instead of using this function use the
@@ -94,11 +258,47 @@ template< typename MT1   // Type of the left-hand side dense matrix
 auto cudaAssign( DenseMatrix<MT1,SO1>& lhs, const DenseMatrix<MT2,SO2>& rhs, OP op )
 {
    BLAZE_FUNCTION_TRACE;
-
-   for( auto i = size_t( 0 ); i < (~lhs).rows(); i++ ) {
-      cuda_transform( (~lhs).begin(i), (~lhs).end(i), (~rhs).begin(i), (~lhs).begin(i), op );
+   BLAZE_CUDA_FUNCTION_RANGE;
+
+   const size_t lines ( SO1 == rowMajor ? (~lhs).rows()    : (~lhs).columns() );
+   const size_t length( SO1 == rowMajor ? (~lhs).columns() : (~lhs).rows()    );
+
+   if( lines == 0UL || length == 0UL )
+      return;
+
+   const bool uniform( cudaIsUniformlySpaced( ~rhs ) );
+
+   if constexpr( SO1 != SO2 ) {
+      if( uniform ) {
+         cuda_transpose( length, lines, (~rhs).begin(0UL), cudaSpacing( ~rhs )
+                       , (~lhs).begin(0UL), cudaSpacing( ~lhs ), op );
+      }
+      else {
+         for( size_t i = 0UL; i < length; ++i )
+            cuda_transpose( 1UL, lines, (~rhs).begin(i), 0UL
+                          , (~lhs).begin(0UL) + i, cudaSpacing( ~lhs ), op );
+      }
+      BLAZE_CUDA_ERROR_CHECK;
+   }
+   else if( !uniform ) {
+      for( size_t i = 0UL; i < lines; ++i )
+         cuda_transform_2d( 1UL, length, (~lhs).begin(i), 0UL, (~rhs).begin(i), 0UL
+                          , (~lhs).begin(i), 0UL, op );
+      BLAZE_CUDA_ERROR_CHECK;
+   }
+   else {
+      if( cudaPackedAssign( ~lhs, ~rhs, op ) )
+         return;
+
+      const size_t lhsSpacing( cudaSpacing( ~lhs ) );
+
+      cuda_transform_2d( lines, length
+                       , (~lhs).begin(0UL), lhsSpacing
+                       , (~rhs).begin(0UL), cudaSpacing( ~rhs )
+                       , (~lhs).begin(0UL), lhsSpacing
+                       , op );
+      BLAZE_CUDA_ERROR_CHECK;
    }
-   BLAZE_CUDA_ERROR_CHECK;
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -176,7 +376,7 @@ inline auto cudaAssign( DenseMatrix<MT1,SO1>& lhs, const DenseMatrix<MT2,SO2>& r
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == (~rhs).columns(), "Invalid number of columns" );
 
-   cudaAssign( ~lhs, ~rhs, [] BLAZE_DEVICE_CALLABLE ( auto const&, auto const& e ) { return e; } );
+   cudaAssign( ~lhs, ~rhs, CUDAAssign() );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -315,7 +515,9 @@ inline auto cudaSchurAssign( DenseMatrix<MT1,SO1>& lhs, const DenseMatrix<MT2,SO
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == (~rhs).rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == (~rhs).columns(), "Invalid number of columns" );
 
-   /* TODO */  // cudaAssign( ~lhs, ~rhs, SchurAssign() );
+   cudaAssign( ~lhs, ~rhs, [] BLAZE_DEVICE_CALLABLE ( auto const& l, auto const& r ) {
+      return l * r;
+   } );
 }
 /*! \endcond */
 //*************************************************************************************************
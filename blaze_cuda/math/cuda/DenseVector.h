@@ -49,6 +49,7 @@
 #include <blaze/math/typetraits/IsDenseVector.h>
 #include <blaze/math/typetraits/IsCUDAAssignable.h>
 #include <blaze/math/views/Subvector.h>
+#include <blaze/system/HostDevice.h>
 #include <blaze/system/SMP.h>
 #include <blaze/util/algorithms/Min.h>
 #include <blaze/util/Assert.h>
@@ -57,8 +58,10 @@
 #include <blaze/util/StaticAssert.h>
 #include <blaze/util/Types.h>
 
+#include <blaze_cuda/math/cuda/PackedAssign.h>
 #include <blaze_cuda/util/algorithms/CUDATransform.h>
 #include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 
 
 namespace blaze {
@@ -80,7 +83,8 @@ namespace blaze {
 // \return void
 //
 // This function is the backend implementation of the CUDA-based assignment of a dense
-// vector to a dense vector.\n
+// vector to a dense vector. Contiguous operands, and element-wise operations on contiguous
+// operands, are accessed through their raw data by cuda_packed_transform().\n
 // This function must \b NOT be called explicitly! It is used internally for the performance
 // optimized evaluation of expression templates. Calling this function explicitly might result
 // in erroneous results and/or in compilation errors. Instead of using this function use the
@@ -94,6 +98,10 @@ template< typename VT1   // Type of the left-hand side dense vector
 inline void cudaAssign( DenseVector<VT1,TF1>& lhs, const DenseVector<VT2,TF2>& rhs, OP op )
 {
    BLAZE_FUNCTION_TRACE;
+   BLAZE_CUDA_FUNCTION_RANGE;
+
+   if( cudaPackedAssign( ~lhs, ~rhs, op ) )
+      return;
 
    cuda_transform( (~lhs).begin(), (~lhs).end(), (~rhs).begin(), (~lhs).begin(), op );
 
@@ -149,7 +157,7 @@ inline auto cudaAssign( DenseVector<VT1,TF1>& lhs, const DenseVector<VT2,TF2>& r
 {
    BLAZE_FUNCTION_TRACE;
 
-   cudaAssign( ~lhs, ~rhs, [] __device__ ( auto const&, auto const& r ) { return r; } );
+   cudaAssign( ~lhs, ~rhs, CUDAAssign() );
 }
 
 
@@ -189,7 +197,7 @@ inline auto cudaAddAssign( DenseVector<VT1,TF1>& lhs, const DenseVector<VT2,TF2>
 
    BLAZE_INTERNAL_ASSERT( (~lhs).size() == (~rhs).size(), "Invalid vector sizes" );
 
-   cudaAssign( ~lhs, ~rhs, [] __device__ ( auto const& l, auto const& r ) { return l + r; } );
+   cudaAssign( ~lhs, ~rhs, [] BLAZE_DEVICE_CALLABLE ( auto const& l, auto const& r ) { return l + r; } );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -231,7 +239,7 @@ inline auto cudaSubAssign( DenseVector<VT1,TF1>& lhs, const DenseVector<VT2,TF2>
 
    BLAZE_INTERNAL_ASSERT( (~lhs).size() == (~rhs).size(), "Invalid vector sizes" );
 
-   cudaAssign( ~lhs, ~rhs, [] __device__ ( auto const& l, auto const& r ) { return l - r; } );
+   cudaAssign( ~lhs, ~rhs, [] BLAZE_DEVICE_CALLABLE ( auto const& l, auto const& r ) { return l - r; } );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -273,7 +281,7 @@ inline auto cudaMultAssign( DenseVector<VT1,TF1>& lhs, const DenseVector<VT2,TF2
 
    BLAZE_INTERNAL_ASSERT( (~lhs).size() == (~rhs).size(), "Invalid vector sizes" );
 
-   cudaAssign( ~lhs, ~rhs, [] __device__ ( auto const& l, auto const& r ) { return l * r; } );
+   cudaAssign( ~lhs, ~rhs, [] BLAZE_DEVICE_CALLABLE ( auto const& l, auto const& r ) { return l * r; } );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -315,7 +323,7 @@ inline auto cudaDivAssign( DenseVector<VT1,TF1>& lhs, const DenseVector<VT2,TF2>
 
    BLAZE_INTERNAL_ASSERT( (~lhs).size() == (~rhs).size(), "Invalid vector sizes" );
 
-   cudaAssign( ~lhs, ~rhs, [] __device__ ( auto const& l, auto const& r ) { return l / r; } );
+   cudaAssign( ~lhs, ~rhs, [] BLAZE_DEVICE_CALLABLE ( auto const& l, auto const& r ) { return l / r; } );
 }
 /*! \endcond */
 //*************************************************************************************************
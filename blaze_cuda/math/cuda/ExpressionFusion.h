@@ -0,0 +1,935 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/cuda/ExpressionFusion.h
+//  \brief Fused evaluation of element-wise dense matrix expression trees
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_CUDA_EXPRESSIONFUSION_H_
+#define _BLAZE_CUDA_MATH_CUDA_EXPRESSIONFUSION_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <memory>
+#include <vector>
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/expressions/DMatDMatAddExpr.h>
+#include <blaze/math/expressions/DMatDMatMapExpr.h>
+#include <blaze/math/expressions/DMatDMatMultExpr.h>
+#include <blaze/math/expressions/DMatDMatSchurExpr.h>
+#include <blaze/math/expressions/DMatDMatSubExpr.h>
+#include <blaze/math/expressions/DMatMapExpr.h>
+#include <blaze/math/expressions/DMatScalarMultExpr.h>
+#include <blaze/math/expressions/DMatTDMatMultExpr.h>
+#include <blaze/math/expressions/DVecExpandExpr.h>
+#include <blaze/math/expressions/TDMatDMatMultExpr.h>
+#include <blaze/math/expressions/TDMatTDMatMultExpr.h>
+#include <blaze/math/functors/Add.h>
+#include <blaze/math/functors/Mult.h>
+#include <blaze/math/functors/Sub.h>
+#include <blaze/math/shims/IsSame.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/math/typetraits/HasMutableDataAccess.h>
+#include <blaze/math/typetraits/IsBLASCompatible.h>
+#include <blaze/math/typetraits/IsOperation.h>
+#include <blaze/math/typetraits/IsRowMajorMatrix.h>
+#include <blaze/math/TransposeFlag.h>
+#include <blaze/system/HostDevice.h>
+#include <blaze/system/Inline.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/IntegralConstant.h>
+#include <blaze/util/Types.h>
+#include <blaze/util/typetraits/IsSame.h>
+#include <blaze/util/typetraits/RemoveCV.h>
+#include <blaze/util/typetraits/RemoveReference.h>
+
+#include <blaze_cuda/math/cublas/gemm.h>
+#include <blaze_cuda/math/cuda/DenseMatrix.h>
+#include <blaze_cuda/math/cuda/RankKUpdate.h>
+#include <blaze_cuda/math/typetraits/RequiresCUDAEvaluation.h>
+#include <blaze_cuda/util/algorithms/CUDAGemm.h>
+#include <blaze_cuda/util/algorithms/CUDATransform2D.h>
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  FUSED EVALUATORS
+//
+//  An element-wise expression tree (additions, subtractions, Schur products, unary and binary
+//  maps and scalar multiplications) is turned into a tree of small, device-copyable evaluators.
+//  Each evaluator returns element (i,j) of its subexpression, so the whole tree is evaluated
+//  by a single cuda_generate_2d() launch that reads every operand and writes the target exactly
+//  once.
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Leaf of a fused expression: an operand traversed through an iterator and a spacing.
+// \ingroup cuda
+*/
+template< typename IteratorType >
+struct CUDAFusedOperand
+{
+   IteratorType it_;  //!< Iterator to the first element of the operand.
+   size_t spacing_;   //!< Distance between two consecutive rows/columns.
+
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE auto operator()( size_t i, size_t j ) const {
+      return *( it_ + i * spacing_ + j );
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Unary node of a fused expression.
+// \ingroup cuda
+*/
+template< typename ET    // Type of the operand evaluator
+        , typename OP >  // Type of the unary operation
+struct CUDAFusedUnary
+{
+   ET operand_;  //!< Evaluator of the operand.
+   OP op_;       //!< The unary operation.
+
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE auto operator()( size_t i, size_t j ) const {
+      return op_( operand_( i, j ) );
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Binary node of a fused expression.
+// \ingroup cuda
+*/
+template< typename LT    // Type of the left-hand side evaluator
+        , typename RT    // Type of the right-hand side evaluator
+        , typename OP >  // Type of the binary operation
+struct CUDAFusedBinary
+{
+   LT lhs_;  //!< Evaluator of the left-hand side operand.
+   RT rhs_;  //!< Evaluator of the right-hand side operand.
+   OP op_;   //!< The binary operation.
+
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE auto operator()( size_t i, size_t j ) const {
+      return op_( lhs_( i, j ), rhs_( i, j ) );
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Scalar multiplication node of a fused expression.
+// \ingroup cuda
+*/
+template< typename ET    // Type of the operand evaluator
+        , typename ST >  // Type of the scalar
+struct CUDAFusedScalarMult
+{
+   ET operand_;  //!< Evaluator of the operand.
+   ST scalar_;   //!< The scalar factor.
+
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE auto operator()( size_t i, size_t j ) const {
+      return operand_( i, j ) * scalar_;
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Leaf of a fused expression: a vector broadcast along the rows or columns of a matrix.
+// \ingroup cuda
+//
+// Element (i,j) is element \a i of the vector if \a Lines is \a true, element \a j otherwise.
+*/
+template< typename IteratorType  // Type of the iterator over the vector
+        , bool Lines >           // Whether the vector is indexed by the line index
+struct CUDAFusedBroadcast
+{
+   IteratorType it_;  //!< Iterator to the first element of the vector.
+
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE auto operator()( size_t i, size_t j ) const {
+      return *( it_ + ( Lines ? i : j ) );
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  FUSION CONTEXT
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief State of a fused evaluation.
+// \ingroup cuda
+//
+// Leaves that require an evaluation (e.g. matrix products) cannot be expressed element-wise.
+// They are evaluated before the fused launch, either directly into the target matrix (if the
+// target is not read by the expression and has the matching type) or into a temporary that is
+// kept alive by the context until the launch has been issued.
+*/
+template< typename MT >  // Type of the target dense matrix
+class CUDAFusionContext
+{
+ public:
+   explicit inline CUDAFusionContext( MT& target, bool targetAvailable )
+      : target_( target )
+      , targetAvailable_( targetAvailable )
+   {}
+
+   template< typename ET >
+   inline auto evaluate( const ET& expr );
+
+   template< typename ET >
+   inline const ResultType_t<ET>& temporary( const ET& expr );
+
+ private:
+   MT&  target_;           //!< The target of the fused assignment.
+   bool targetAvailable_;  //!< Whether the target can hold an evaluated leaf.
+
+   std::vector< std::shared_ptr<const void> > temporaries_;  //!< Evaluated leaves.
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Evaluates a leaf of the expression tree and returns its evaluator.
+//
+// \param expr The leaf expression to be evaluated.
+// \return The evaluator of the evaluated leaf.
+*/
+template< typename MT >  // Type of the target dense matrix
+template< typename ET >  // Type of the leaf expression
+inline auto CUDAFusionContext<MT>::evaluate( const ET& expr )
+{
+   using RT = ResultType_t<ET>;
+
+   if constexpr( IsSame_v< RT, RemoveCV_t<MT> > ) {
+      if( targetAvailable_ ) {
+         targetAvailable_ = false;
+         cudaAssign( target_, expr );
+
+         const MT& target( target_ );
+         return CUDAFusedOperand< ConstIterator_t<RT> >{ target.begin(0UL), cudaSpacing( target ) };
+      }
+   }
+
+   const RT& tmp( temporary( expr ) );
+
+   return CUDAFusedOperand< ConstIterator_t<RT> >{ tmp.begin(0UL), cudaSpacing( tmp ) };
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Evaluates an expression into a temporary kept alive until the fused launch is issued.
+//
+// \param expr The (vector or matrix) expression to be evaluated.
+// \return Reference to the evaluated expression.
+*/
+template< typename MT >  // Type of the target dense matrix
+template< typename ET >  // Type of the expression
+inline const ResultType_t<ET>& CUDAFusionContext<MT>::temporary( const ET& expr )
+{
+   auto tmp( std::make_shared<const ResultType_t<ET>>( serial( expr ) ) );
+   temporaries_.push_back( tmp );
+
+   return *tmp;
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  EXPRESSION TREE TRAVERSAL
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the evaluator of a leaf of the expression tree.
+// \ingroup cuda
+*/
+template< typename MT   // Type of the dense matrix
+        , bool SO       // Storage order
+        , typename CT > // Type of the fusion context
+inline auto cudaFuse( const DenseMatrix<MT,SO>& dm, CT& ctx )
+{
+   if constexpr( RequiresCUDAEvaluation_v<MT> ) {
+      return ctx.evaluate( ~dm );
+   }
+   else {
+      return CUDAFusedOperand< ConstIterator_t<MT> >{ (~dm).begin(0UL), cudaSpacing( ~dm ) };
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the evaluator of a dense matrix-dense matrix addition.
+// \ingroup cuda
+*/
+template< typename MT1, typename MT2, bool SO, typename CT >
+inline auto cudaFuse( const DMatDMatAddExpr<MT1,MT2,SO>& expr, CT& ctx )
+{
+   auto lhs( cudaFuse( expr.leftOperand() , ctx ) );
+   auto rhs( cudaFuse( expr.rightOperand(), ctx ) );
+   return CUDAFusedBinary< decltype(lhs), decltype(rhs), Add >{ lhs, rhs, Add() };
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the evaluator of a dense matrix-dense matrix subtraction.
+// \ingroup cuda
+*/
+template< typename MT1, typename MT2, bool SO, typename CT >
+inline auto cudaFuse( const DMatDMatSubExpr<MT1,MT2,SO>& expr, CT& ctx )
+{
+   auto lhs( cudaFuse( expr.leftOperand() , ctx ) );
+   auto rhs( cudaFuse( expr.rightOperand(), ctx ) );
+   return CUDAFusedBinary< decltype(lhs), decltype(rhs), Sub >{ lhs, rhs, Sub() };
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the evaluator of a dense matrix-dense matrix Schur product.
+// \ingroup cuda
+*/
+template< typename MT1, typename MT2, bool SO, typename CT >
+inline auto cudaFuse( const DMatDMatSchurExpr<MT1,MT2,SO>& expr, CT& ctx )
+{
+   auto lhs( cudaFuse( expr.leftOperand() , ctx ) );
+   auto rhs( cudaFuse( expr.rightOperand(), ctx ) );
+   return CUDAFusedBinary< decltype(lhs), decltype(rhs), Mult >{ lhs, rhs, Mult() };
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the evaluator of a binary dense matrix map operation.
+// \ingroup cuda
+*/
+template< typename MT1, typename MT2, typename OP, bool SO, typename CT >
+inline auto cudaFuse( const DMatDMatMapExpr<MT1,MT2,OP,SO>& expr, CT& ctx )
+{
+   auto lhs( cudaFuse( expr.leftOperand() , ctx ) );
+   auto rhs( cudaFuse( expr.rightOperand(), ctx ) );
+   return CUDAFusedBinary< decltype(lhs), decltype(rhs), OP >{ lhs, rhs, expr.operation() };
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the evaluator of a unary dense matrix map operation.
+// \ingroup cuda
+*/
+template< typename MT1, typename OP, bool SO, typename CT >
+inline auto cudaFuse( const DMatMapExpr<MT1,OP,SO>& expr, CT& ctx )
+{
+   auto operand( cudaFuse( expr.operand(), ctx ) );
+   return CUDAFusedUnary< decltype(operand), OP >{ operand, expr.operation() };
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the evaluator of a dense matrix-scalar multiplication.
+// \ingroup cuda
+*/
+template< typename MT1, typename ST, bool SO, typename CT >
+inline auto cudaFuse( const DMatScalarMultExpr<MT1,ST,SO>& expr, CT& ctx )
+{
+   auto operand( cudaFuse( expr.leftOperand(), ctx ) );
+   return CUDAFusedScalarMult< decltype(operand), ST >{ operand, expr.rightOperand() };
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the evaluator of a dense vector expansion (e.g. a broadcast bias).
+// \ingroup cuda
+*/
+template< typename VT, bool TF, size_t... CEAs, typename CT >
+inline auto cudaFuse( const DVecExpandExpr<VT,TF,CEAs...>& expr, CT& ctx )
+{
+   // An expanded column vector is indexed by the row index, an expanded row vector by the column
+   // index, which is the line index of row-major and column-major expansions, respectively
+   constexpr bool lines( ( TF == columnVector ) == IsRowMajorMatrix_v< DVecExpandExpr<VT,TF,CEAs...> > );
+
+   if constexpr( RequiresCUDAEvaluation_v<VT> ) {
+      const auto& tmp( ctx.temporary( expr.operand() ) );
+      return CUDAFusedBroadcast< decltype( tmp.begin() ), lines >{ tmp.begin() };
+   }
+   else {
+      return CUDAFusedBroadcast< ConstIterator_t<VT>, lines >{ expr.operand().begin() };
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  GEMM EPILOGUES
+//
+//  A dense matrix product P is the only operand of a fused expression that cannot be computed
+//  element-wise. In expressions of the form
+//
+//     f( s*P + X ),  f( s*P - X ),  f( X + s*P ),  s*P + X,  ...
+//
+//  where the scalar s, the element-wise expression X (e.g. another matrix or a broadcast bias)
+//  and the unary map f are optional, the whole expression is instead turned into the epilogue
+//  of the product: s is folded into alpha, and X and f are applied by the GEMM kernel when it
+//  stores the result, so the target is written once. Without f, and if X is a plain matrix,
+//  the product is delegated to cuBLAS with X folded into beta.
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Compile time check for products computed by a GEMM epilogue.
+// \ingroup cuda
+//
+// The storage orders of the operands only change the strides the GEMM reads them with.
+*/
+template< typename T >
+struct IsCUDAGemmProduct
+   : public FalseType
+{};
+
+template< typename MT1, typename MT2, bool SF, bool HF, bool LF, bool UF >
+struct IsCUDAGemmProduct< DMatDMatMultExpr<MT1,MT2,SF,HF,LF,UF> >
+   : public TrueType
+{};
+
+template< typename MT1, typename MT2, bool SF, bool HF, bool LF, bool UF >
+struct IsCUDAGemmProduct< DMatTDMatMultExpr<MT1,MT2,SF,HF,LF,UF> >
+   : public TrueType
+{};
+
+template< typename MT1, typename MT2, bool SF, bool HF, bool LF, bool UF >
+struct IsCUDAGemmProduct< TDMatDMatMultExpr<MT1,MT2,SF,HF,LF,UF> >
+   : public TrueType
+{};
+
+template< typename MT1, typename MT2, bool SF, bool HF, bool LF, bool UF >
+struct IsCUDAGemmProduct< TDMatTDMatMultExpr<MT1,MT2,SF,HF,LF,UF> >
+   : public TrueType
+{};
+
+template< typename T >
+constexpr bool IsCUDAGemmProduct_v = IsCUDAGemmProduct<T>::value;
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Compile time check for an optionally scaled product (\f$ P \f$ or \f$ s*P \f$).
+// \ingroup cuda
+*/
+template< typename T >
+struct IsCUDAGemmTerm
+   : public BoolConstant< IsCUDAGemmProduct_v<T> >
+{};
+
+template< typename MT, typename ST, bool SO >
+struct IsCUDAGemmTerm< DMatScalarMultExpr<MT,ST,SO> >
+   : public BoolConstant< IsCUDAGemmProduct_v<MT> >
+{};
+
+template< typename T >
+constexpr bool IsCUDAGemmTerm_v = IsCUDAGemmTerm<T>::value;
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Compile time check for expressions computed by a single GEMM with an epilogue.
+// \ingroup cuda
+*/
+template< typename T >
+struct IsCUDAGemmSum
+   : public IsCUDAGemmTerm<T>
+{};
+
+template< typename MT1, typename MT2, bool SO >
+struct IsCUDAGemmSum< DMatDMatAddExpr<MT1,MT2,SO> >
+   : public BoolConstant< IsCUDAGemmTerm_v<MT1> || IsCUDAGemmTerm_v<MT2> >
+{};
+
+template< typename MT1, typename MT2, bool SO >
+struct IsCUDAGemmSum< DMatDMatSubExpr<MT1,MT2,SO> >
+   : public IsCUDAGemmTerm<MT1>
+{};
+
+template< typename T >
+constexpr bool IsCUDAGemmSum_v = IsCUDAGemmSum<T>::value;
+
+template< typename T >
+struct IsCUDAGemmPattern
+   : public IsCUDAGemmSum<T>
+{};
+
+template< typename MT, typename OP, bool SO >
+struct IsCUDAGemmPattern< DMatMapExpr<MT,OP,SO> >
+   : public IsCUDAGemmSum<MT>
+{};
+
+template< typename T >
+constexpr bool IsCUDAGemmPattern_v = IsCUDAGemmPattern<T>::value;
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Placeholder for the missing addend or map of a GEMM epilogue.
+// \ingroup cuda
+*/
+struct CUDAGemmNone
+{
+   template< typename T >
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE T operator()( const T& a ) const {
+      return a;
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Epilogue of a GEMM: \f$ f( op( \alpha*acc, X(i,j) ) ) \f$.
+// \ingroup cuda
+//
+// The addend is indexed by line and position in storage order \a SO.
+*/
+template< bool SO        // Storage order of the addend evaluator
+        , typename ST    // Type of alpha
+        , typename AE    // Type of the addend evaluator
+        , typename OP    // Type of the binary operation combining the product and the addend
+        , typename F >   // Type of the unary map
+struct CUDAGemmEpilogue
+{
+   ST alpha_;   //!< The scaling factor of the product.
+   AE addend_;  //!< Evaluator of the addend.
+   OP op_;      //!< The binary operation.
+   F  f_;       //!< The unary map.
+
+   template< typename T >
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE auto operator()( size_t i, size_t j, const T& acc ) const {
+      return f_( op_( alpha_ * acc, SO == rowMajor ? addend_( i, j ) : addend_( j, i ) ) );
+   }
+};
+
+template< bool SO, typename ST, typename OP, typename F >
+struct CUDAGemmEpilogue<SO,ST,CUDAGemmNone,OP,F>
+{
+   ST alpha_;             //!< The scaling factor of the product.
+   CUDAGemmNone addend_;  //!< Unused.
+   OP op_;                //!< Unused.
+   F  f_;                 //!< The unary map.
+
+   template< typename T >
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE auto operator()( size_t, size_t, const T& acc ) const {
+      return f_( alpha_ * acc );
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the product of an optionally scaled product.
+// \ingroup cuda
+*/
+template< typename MT >
+inline const MT& cudaGemmProduct( const MT& term )
+{
+   return term;
+}
+
+template< typename MT, typename ST, bool SO >
+inline const MT& cudaGemmProduct( const DMatScalarMultExpr<MT,ST,SO>& term )
+{
+   return term.leftOperand();
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the scaling factor of an optionally scaled product.
+// \ingroup cuda
+*/
+template< typename ET, typename MT >
+inline ET cudaGemmScale( const MT& )
+{
+   return ET(1);
+}
+
+template< typename ET, typename MT, typename ST, bool SO >
+inline ET cudaGemmScale( const DMatScalarMultExpr<MT,ST,SO>& term )
+{
+   return ET( term.rightOperand() );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Computes \f$ f( op( s*P, X ) ) \f$ into the target matrix.
+// \ingroup cuda
+//
+// \param lhs The target dense matrix.
+// \param term The optionally scaled product \f$ s*P \f$.
+// \param addend The addend \f$ X \f$, or CUDAGemmNone.
+// \param op The operation combining the product and the addend (Add or Sub).
+// \param f The unary map, or CUDAGemmNone.
+// \return \a true if the expression was assigned, \a false if the target is aliased by the
+//         operands of the product.
+*/
+template< typename MT  // Type of the target dense matrix
+        , bool SO      // Storage order of the target dense matrix
+        , typename TT  // Type of the scaled product
+        , typename AT  // Type of the addend
+        , typename OP  // Type of the binary operation
+        , typename F > // Type of the unary map
+inline bool cudaGemmAssign( DenseMatrix<MT,SO>& lhs, const TT& term, const AT& addend, OP op, F f )
+{
+   using PT = RemoveCV_t< RemoveReference_t< decltype( cudaGemmProduct( term ) ) > >;
+   using ET = ElementType_t<MT>;
+   using LT = typename PT::LT;
+   using RT = typename PT::RT;
+   using LMT = RemoveCV_t< RemoveReference_t<LT> >;
+   using RMT = RemoveCV_t< RemoveReference_t<RT> >;
+
+   const PT& product( cudaGemmProduct( term ) );
+
+   if( product.isAliased( &(~lhs) ) )
+      return false;
+
+   const size_t m( product.rows()    );
+   const size_t n( product.columns() );
+   const size_t k( product.leftOperand().columns() );
+
+   if( m == 0UL || n == 0UL )
+      return true;
+
+   LT A( product.leftOperand()  );  // Evaluation of the left-hand side dense matrix operand
+   RT B( product.rightOperand() );  // Evaluation of the right-hand side dense matrix operand
+
+   const ET alpha( cudaGemmScale<ET>( term ) );
+
+   constexpr bool noAddend( IsSame_v<AT,CUDAGemmNone> );
+   constexpr bool noMap   ( IsSame_v<F,CUDAGemmNone> );
+
+   constexpr bool blas( IsBLASCompatible_v<ET> &&
+                        IsSame_v< ET, ElementType_t<LMT> > && IsSame_v< ET, ElementType_t<RMT> > &&
+                        HasMutableDataAccess_v<MT> );
+
+   // Without a map, a plain matrix addend is folded into beta and cuBLAS does the rest
+   if constexpr( blas && noMap && ( noAddend || !IsOperation_v<AT> ) ) {
+      if( k != 0UL ) {
+         if constexpr( noAddend ) {
+            if( !cudaRankKAssign( ~lhs, product.leftOperand(), product.rightOperand(), alpha ) )
+               cugemm( ~lhs, A, B, alpha, ET(0) );
+         }
+         else {
+            if( !isSame( ~lhs, addend ) )
+               cudaAssign( ~lhs, addend );
+            cugemm( ~lhs, A, B, alpha, IsSame_v<OP,Sub> ? ET(-1) : ET(1) );
+         }
+         return true;
+      }
+   }
+
+   CUDAFusionContext<MT> ctx( ~lhs, false );
+
+   const auto ev( [&]() {
+      if constexpr( noAddend ) return CUDAGemmNone();
+      else return cudaFuse( addend, ctx );
+   }() );
+
+   // The addend is traversed in its own storage order, the operands and the target by strides
+   constexpr bool SOX( noAddend ? SO : !IsRowMajorMatrix_v< RemoveCV_t<AT> > );
+   constexpr bool SOA( !IsRowMajorMatrix_v<LMT> );
+   constexpr bool SOB( !IsRowMajorMatrix_v<RMT> );
+
+   const CUDAGemmEpilogue< SOX, ET, RemoveCV_t<decltype(ev)>, OP, F > epilogue{ alpha, ev, op, f };
+
+   const size_t lda( cudaSpacing( A ) );
+   const size_t ldb( cudaSpacing( B ) );
+   const size_t ldc( cudaSpacing( ~lhs ) );
+
+   cuda_gemm( m, n, k
+            , A.begin(0UL), ( SOA == rowMajor ? lda : 1UL ), ( SOA == rowMajor ? 1UL : lda )
+            , B.begin(0UL), ( SOB == rowMajor ? ldb : 1UL ), ( SOB == rowMajor ? 1UL : ldb )
+            , (~lhs).begin(0UL), ( SO == rowMajor ? ldc : 1UL ), ( SO == rowMajor ? 1UL : ldc )
+            , epilogue );
+   BLAZE_CUDA_ERROR_CHECK;
+
+   return true;
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Splits a GEMM pattern into the scaled product and the addend.
+// \ingroup cuda
+*/
+template< typename MT, bool SO, typename MT1, typename MT2, bool SO1, typename F >
+inline bool cudaGemmAssign( DenseMatrix<MT,SO>& lhs, const DMatDMatAddExpr<MT1,MT2,SO1>& rhs, F f )
+{
+   if constexpr( IsCUDAGemmTerm_v<MT1> )
+      return cudaGemmAssign( ~lhs, rhs.leftOperand(), rhs.rightOperand(), Add(), f );
+   else
+      return cudaGemmAssign( ~lhs, rhs.rightOperand(), rhs.leftOperand(), Add(), f );
+}
+
+template< typename MT, bool SO, typename MT1, typename MT2, bool SO1, typename F >
+inline bool cudaGemmAssign( DenseMatrix<MT,SO>& lhs, const DMatDMatSubExpr<MT1,MT2,SO1>& rhs, F f )
+{
+   return cudaGemmAssign( ~lhs, rhs.leftOperand(), rhs.rightOperand(), Sub(), f );
+}
+
+template< typename MT, bool SO, typename MT1, bool SO1, typename F >
+inline bool cudaGemmAssign( DenseMatrix<MT,SO>& lhs, const DenseMatrix<MT1,SO1>& rhs, F f )
+{
+   return cudaGemmAssign( ~lhs, ~rhs, CUDAGemmNone(), Add(), f );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Assigns a dense matrix expression by a single GEMM with an epilogue, if possible.
+// \ingroup cuda
+//
+// \param lhs The target dense matrix.
+// \param rhs The right-hand side dense matrix expression.
+// \return \a true if the expression was assigned, \a false if it has to be assigned otherwise.
+*/
+template< typename MT1  // Type of the left-hand side dense matrix
+        , bool SO1      // Storage order of the left-hand side dense matrix
+        , typename MT2  // Type of the right-hand side dense matrix expression
+        , bool SO2 >    // Storage order of the right-hand side dense matrix expression
+inline bool cudaGemmAssign( DenseMatrix<MT1,SO1>& lhs, const DenseMatrix<MT2,SO2>& rhs )
+{
+   if constexpr( !IsCUDAGemmPattern_v<MT2> ) {
+      return false;
+   }
+   else if constexpr( IsCUDAGemmSum_v<MT2> ) {
+      return cudaGemmAssign( ~lhs, ~rhs, CUDAGemmNone() );
+   }
+   else {
+      return cudaGemmAssign( ~lhs, (~rhs).operand(), (~rhs).operation() );
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  FUSED ASSIGNMENT
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Fused CUDA-based assignment of an element-wise dense matrix expression.
+// \ingroup cuda
+//
+// \param lhs The target left-hand side dense matrix.
+// \param rhs The right-hand side dense matrix expression to be assigned.
+// \return void
+//
+// The whole expression tree is evaluated by a single kernel launch. Leaves requiring an
+// evaluation are evaluated beforehand, the first one directly into \a lhs when \a lhs is not
+// aliased by \a rhs. Expressions with a storage order different from the target are evaluated
+// into a temporary first, which is then transposed into \a lhs. Products with a scaling, an
+// addend and/or a map applied to them are computed by a single GEMM with an epilogue instead
+// (see cudaGemmAssign()).\n
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates.
+*/
+template< typename MT1  // Type of the left-hand side dense matrix
+        , bool SO1      // Storage order of the left-hand side dense matrix
+        , typename MT2  // Type of the right-hand side dense matrix expression
+        , bool SO2 >    // Storage order of the right-hand side dense matrix expression
+inline void cudaFusedAssign( DenseMatrix<MT1,SO1>& lhs, const DenseMatrix<MT2,SO2>& rhs )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == (~rhs).rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( (~lhs).columns() == (~rhs).columns(), "Invalid number of columns" );
+
+   if( cudaGemmAssign( ~lhs, ~rhs ) )
+      return;
+
+   if constexpr( SO1 != SO2 ) {
+      const ResultType_t<MT2> tmp( serial( ~rhs ) );
+      cudaAssign( ~lhs, tmp );
+   }
+   else {
+      const size_t lines ( SO1 == rowMajor ? (~lhs).rows()    : (~lhs).columns() );
+      const size_t length( SO1 == rowMajor ? (~lhs).columns() : (~lhs).rows()    );
+
+      if( lines == 0UL || length == 0UL )
+         return;
+
+      CUDAFusionContext<MT1> ctx( ~lhs, !(~rhs).isAliased( &(~lhs) ) );
+      auto eval( cudaFuse( ~rhs, ctx ) );
+
+      cuda_generate_2d( lines, length, (~lhs).begin(0UL), cudaSpacing( ~lhs ), eval );
+      BLAZE_CUDA_ERROR_CHECK;
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Fused CUDA-based compound assignment of an element-wise dense matrix expression.
+// \ingroup cuda
+//
+// \param lhs The target left-hand side dense matrix.
+// \param rhs The right-hand side dense matrix expression.
+// \param op The compound assignment operation, applied as \c lhs = op( lhs, rhs ).
+// \return void
+//
+// The target is read as one more operand of the fused expression tree, so each element of
+// \a lhs is read and written exactly once.\n
+// This function must \b NOT be called explicitly! It is used internally for the performance
+// optimized evaluation of expression templates.
+*/
+template< typename MT1  // Type of the left-hand side dense matrix
+        , bool SO1      // Storage order of the left-hand side dense matrix
+        , typename MT2  // Type of the right-hand side dense matrix expression
+        , bool SO2      // Storage order of the right-hand side dense matrix expression
+        , typename OP > // Type of the compound assignment operation
+inline void cudaFusedAssign( DenseMatrix<MT1,SO1>& lhs, const DenseMatrix<MT2,SO2>& rhs, OP op )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == (~rhs).rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( (~lhs).columns() == (~rhs).columns(), "Invalid number of columns" );
+
+   if constexpr( SO1 != SO2 ) {
+      const ResultType_t<MT2> tmp( serial( ~rhs ) );
+      cudaAssign( ~lhs, tmp, op );
+   }
+   else {
+      const size_t lines ( SO1 == rowMajor ? (~lhs).rows()    : (~lhs).columns() );
+      const size_t length( SO1 == rowMajor ? (~lhs).columns() : (~lhs).rows()    );
+
+      if( lines == 0UL || length == 0UL )
+         return;
+
+      CUDAFusionContext<MT1> ctx( ~lhs, false );
+      auto eval( cudaFuse( ~rhs, ctx ) );
+
+      const MT1& target( ~lhs );
+
+      using Target = CUDAFusedOperand< ConstIterator_t<MT1> >;
+      const Target current{ target.begin(0UL), cudaSpacing( target ) };
+
+      cuda_generate_2d( lines, length, (~lhs).begin(0UL), cudaSpacing( ~lhs )
+                      , CUDAFusedBinary< Target, decltype(eval), OP >{ current, eval, op } );
+      BLAZE_CUDA_ERROR_CHECK;
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -0,0 +1,382 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/cuda/PackedAssign.h
+//  \brief Header file for the CUDA assignments of contiguous operands with 128-bit accesses
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_CUDA_PACKEDASSIGN_H_
+#define _BLAZE_CUDA_MATH_CUDA_PACKEDASSIGN_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/math/expressions/DMatDMatAddExpr.h>
+#include <blaze/math/expressions/DMatDMatMapExpr.h>
+#include <blaze/math/expressions/DMatDMatSchurExpr.h>
+#include <blaze/math/expressions/DMatDMatSubExpr.h>
+#include <blaze/math/expressions/DMatMapExpr.h>
+#include <blaze/math/expressions/DVecDVecAddExpr.h>
+#include <blaze/math/expressions/DVecDVecMapExpr.h>
+#include <blaze/math/expressions/DVecDVecMultExpr.h>
+#include <blaze/math/expressions/DVecDVecSubExpr.h>
+#include <blaze/math/expressions/DVecMapExpr.h>
+#include <blaze/math/functors/Add.h>
+#include <blaze/math/functors/Mult.h>
+#include <blaze/math/functors/Sub.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/math/typetraits/HasConstDataAccess.h>
+#include <blaze/math/typetraits/IsRowMajorMatrix.h>
+#include <blaze/math/typetraits/IsView.h>
+#include <blaze/system/HostDevice.h>
+#include <blaze/system/Inline.h>
+#include <blaze/util/IntegralConstant.h>
+#include <blaze/util/Types.h>
+
+#include <blaze_cuda/util/algorithms/CUDAPackedTransform.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  PACKED ASSIGNMENT
+//
+//  The assignment of a contiguous operand, or of a unary or binary element-wise operation on
+//  contiguous operands, is computed by cuda_packed_transform() over the raw data of the target
+//  and of the operands instead of through the expression iterators. The data of vectors and
+//  matrices (but not of views, whose elements may not be adjacent) is contiguous, provided
+//  matrices are not padded. The target is only read by compound assignments: plain assignments,
+//  performed with CUDAAssign, write it without loading it first.
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief The plain assignment operation, which ignores the current value of the target.
+// \ingroup cuda
+*/
+struct CUDAAssign
+{
+   template< typename T, typename U >
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE U operator()( const T&, const U& x ) const { return x; }
+
+   template< typename U >
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE U operator()( const U& x ) const { return x; }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Whether the elements of a vector or matrix type are stored in a single array.
+// \ingroup cuda
+*/
+template< typename T >
+constexpr bool IsCUDAContiguous_v = HasConstDataAccess_v<T> && !IsView_v<T>;
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the data of a contiguous dense vector.
+// \ingroup cuda
+*/
+template< typename VT, bool TF >
+inline auto cudaContiguousData( DenseVector<VT,TF>& dv ) { return (~dv).data(); }
+
+template< typename VT, bool TF >
+inline auto cudaContiguousData( const DenseVector<VT,TF>& dv ) { return (~dv).data(); }
+
+template< typename VT, bool TF >
+inline size_t cudaElementCount( const DenseVector<VT,TF>& dv ) { return (~dv).size(); }
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns the data of a contiguous dense matrix, \c nullptr if the matrix is padded.
+// \ingroup cuda
+*/
+template< typename MT, bool SO >
+inline auto cudaContiguousData( DenseMatrix<MT,SO>& dm )
+{
+   const size_t length( SO == rowMajor ? (~dm).columns() : (~dm).rows() );
+   return (~dm).spacing() == length ? (~dm).data() : nullptr;
+}
+
+template< typename MT, bool SO >
+inline auto cudaContiguousData( const DenseMatrix<MT,SO>& dm )
+{
+   const size_t length( SO == rowMajor ? (~dm).columns() : (~dm).rows() );
+   return (~dm).spacing() == length ? (~dm).data() : nullptr;
+}
+
+template< typename MT, bool SO >
+inline size_t cudaElementCount( const DenseMatrix<MT,SO>& dm ) { return (~dm).rows() * (~dm).columns(); }
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Compound assignment of a unary operation: op( target, map( x ) ).
+// \ingroup cuda
+*/
+template< typename OP, typename MOP >
+struct CUDAPackedUnary
+{
+   OP  op_;   //!< The (compound) assignment operation.
+   MOP map_;  //!< The unary operation.
+
+   template< typename T, typename U >
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE auto operator()( const T& target, const U& x ) const {
+      return op_( target, map_( x ) );
+   }
+};
+
+template< typename MOP >
+struct CUDAPackedUnary<CUDAAssign,MOP>
+{
+   CUDAAssign op_;  //!< The plain assignment operation.
+   MOP map_;        //!< The unary operation.
+
+   template< typename U >
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE auto operator()( const U& x ) const {
+      return map_( x );
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Compound assignment of a binary operation: op( target, map( x, y ) ).
+// \ingroup cuda
+*/
+template< typename OP, typename MOP >
+struct CUDAPackedBinary
+{
+   OP  op_;   //!< The (compound) assignment operation.
+   MOP map_;  //!< The binary operation.
+
+   template< typename T, typename U, typename V >
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE auto operator()( const T& target, const U& x, const V& y ) const {
+      return op_( target, map_( x, y ) );
+   }
+};
+
+template< typename MOP >
+struct CUDAPackedBinary<CUDAAssign,MOP>
+{
+   CUDAAssign op_;  //!< The plain assignment operation.
+   MOP map_;        //!< The binary operation.
+
+   template< typename U, typename V >
+   BLAZE_ALWAYS_INLINE BLAZE_DEVICE_CALLABLE auto operator()( const U& x, const V& y ) const {
+      return map_( x, y );
+   }
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Whether the element-wise operation \a F of a packed assignment reads the target.
+// \ingroup cuda
+*/
+template< typename F >
+struct CUDAReadsTarget : public TrueType
+{};
+
+template<>
+struct CUDAReadsTarget<CUDAAssign> : public FalseType
+{};
+
+template< typename MOP >
+struct CUDAReadsTarget< CUDAPackedUnary<CUDAAssign,MOP> > : public FalseType
+{};
+
+template< typename MOP >
+struct CUDAReadsTarget< CUDAPackedBinary<CUDAAssign,MOP> > : public FalseType
+{};
+
+template< typename F >
+constexpr bool CUDAReadsTarget_v = CUDAReadsTarget<F>::value;
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Computes target = f( target, operands... ) over the raw data of contiguous operands.
+// \ingroup cuda
+//
+// \param lhs The target vector or matrix.
+// \param f The element-wise operation.
+// \param operands The operands.
+// \return \a false if the target or an operand is not contiguous, nothing being computed.
+//
+// The operands of a matrix target must have its storage order. Plain assignments do not read
+// the target (see CUDAReadsTarget), and compute target = f( operands... ) instead.
+*/
+template< typename LT      // Type of the target
+        , typename F       // Type of the element-wise operation
+        , typename... OTs >  // Types of the operands
+inline bool cudaPackedLaunch( LT& lhs, F f, const OTs&... operands )
+{
+   if constexpr( IsCUDAContiguous_v<LT> &&
+                 ( ( IsCUDAContiguous_v<OTs> && IsRowMajorMatrix_v<OTs> == IsRowMajorMatrix_v<LT> ) && ... ) )
+   {
+      const auto out( cudaContiguousData( lhs ) );
+
+      if( out == nullptr || ( ( cudaContiguousData( operands ) == nullptr ) || ... ) )
+         return false;
+
+      if constexpr( CUDAReadsTarget_v<F> ) {
+         cuda_packed_transform( cudaElementCount( lhs ), out, f
+                              , static_cast< const ElementType_t<LT>* >( out )
+                              , cudaContiguousData( operands )... );
+      }
+      else {
+         cuda_packed_transform( cudaElementCount( lhs ), out, f, cudaContiguousData( operands )... );
+      }
+      return true;
+   }
+   else {
+      return false;
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Packed (compound) assignment of a contiguous operand.
+// \ingroup cuda
+//
+// \param lhs The target vector or matrix.
+// \param rhs The right-hand side operand.
+// \param op The (compound) assignment operation.
+// \return \a false if the assignment cannot be computed by cuda_packed_transform().
+//
+// The overloads below handle the element-wise operations on contiguous operands.
+*/
+template< typename LT    // Type of the target
+        , typename RT    // Type of the right-hand side operand
+        , typename OP >  // Type of the assignment operation
+inline bool cudaPackedAssign( LT& lhs, const RT& rhs, OP op )
+{
+   return cudaPackedLaunch( lhs, op, rhs );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+template< typename LT, typename VT, typename MOP, bool TF, typename OP >
+inline bool cudaPackedAssign( LT& lhs, const DVecMapExpr<VT,MOP,TF>& rhs, OP op )
+{
+   return cudaPackedLaunch( lhs, CUDAPackedUnary<OP,MOP>{ op, rhs.operation() }, rhs.operand() );
+}
+
+template< typename LT, typename VT1, typename VT2, typename MOP, bool TF, typename OP >
+inline bool cudaPackedAssign( LT& lhs, const DVecDVecMapExpr<VT1,VT2,MOP,TF>& rhs, OP op )
+{
+   return cudaPackedLaunch( lhs, CUDAPackedBinary<OP,MOP>{ op, rhs.operation() }
+                          , rhs.leftOperand(), rhs.rightOperand() );
+}
+
+template< typename LT, typename VT1, typename VT2, bool TF, typename OP >
+inline bool cudaPackedAssign( LT& lhs, const DVecDVecAddExpr<VT1,VT2,TF>& rhs, OP op )
+{
+   return cudaPackedLaunch( lhs, CUDAPackedBinary<OP,Add>{ op, Add() }, rhs.leftOperand(), rhs.rightOperand() );
+}
+
+template< typename LT, typename VT1, typename VT2, bool TF, typename OP >
+inline bool cudaPackedAssign( LT& lhs, const DVecDVecSubExpr<VT1,VT2,TF>& rhs, OP op )
+{
+   return cudaPackedLaunch( lhs, CUDAPackedBinary<OP,Sub>{ op, Sub() }, rhs.leftOperand(), rhs.rightOperand() );
+}
+
+template< typename LT, typename VT1, typename VT2, bool TF, typename OP >
+inline bool cudaPackedAssign( LT& lhs, const DVecDVecMultExpr<VT1,VT2,TF>& rhs, OP op )
+{
+   return cudaPackedLaunch( lhs, CUDAPackedBinary<OP,Mult>{ op, Mult() }, rhs.leftOperand(), rhs.rightOperand() );
+}
+
+template< typename LT, typename MT, typename MOP, bool SO, typename OP >
+inline bool cudaPackedAssign( LT& lhs, const DMatMapExpr<MT,MOP,SO>& rhs, OP op )
+{
+   return cudaPackedLaunch( lhs, CUDAPackedUnary<OP,MOP>{ op, rhs.operation() }, rhs.operand() );
+}
+
+template< typename LT, typename MT1, typename MT2, typename MOP, bool SO, typename OP >
+inline bool cudaPackedAssign( LT& lhs, const DMatDMatMapExpr<MT1,MT2,MOP,SO>& rhs, OP op )
+{
+   return cudaPackedLaunch( lhs, CUDAPackedBinary<OP,MOP>{ op, rhs.operation() }
+                          , rhs.leftOperand(), rhs.rightOperand() );
+}
+
+template< typename LT, typename MT1, typename MT2, bool SO, typename OP >
+inline bool cudaPackedAssign( LT& lhs, const DMatDMatAddExpr<MT1,MT2,SO>& rhs, OP op )
+{
+   return cudaPackedLaunch( lhs, CUDAPackedBinary<OP,Add>{ op, Add() }, rhs.leftOperand(), rhs.rightOperand() );
+}
+
+template< typename LT, typename MT1, typename MT2, bool SO, typename OP >
+inline bool cudaPackedAssign( LT& lhs, const DMatDMatSubExpr<MT1,MT2,SO>& rhs, OP op )
+{
+   return cudaPackedLaunch( lhs, CUDAPackedBinary<OP,Sub>{ op, Sub() }, rhs.leftOperand(), rhs.rightOperand() );
+}
+
+template< typename LT, typename MT1, typename MT2, bool SO, typename OP >
+inline bool cudaPackedAssign( LT& lhs, const DMatDMatSchurExpr<MT1,MT2,SO>& rhs, OP op )
+{
+   return cudaPackedLaunch( lhs, CUDAPackedBinary<OP,Mult>{ op, Mult() }, rhs.leftOperand(), rhs.rightOperand() );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
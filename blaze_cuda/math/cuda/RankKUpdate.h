@@ -0,0 +1,210 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/cuda/RankKUpdate.h
+//  \brief Header file for the rank-k update of Gram matrix products
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_CUDA_RANKKUPDATE_H_
+#define _BLAZE_CUDA_MATH_CUDA_RANKKUPDATE_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/expressions/DMatMapExpr.h>
+#include <blaze/math/expressions/DMatTransExpr.h>
+#include <blaze/math/functors/Conj.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/math/typetraits/HasConstDataAccess.h>
+#include <blaze/math/typetraits/HasMutableDataAccess.h>
+#include <blaze/math/typetraits/IsBLASCompatible.h>
+#include <blaze/math/typetraits/IsComplex.h>
+#include <blaze/math/typetraits/UnderlyingBuiltin.h>
+#include <blaze/system/HostDevice.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/typetraits/IsSame.h>
+
+#include <blaze_cuda/math/cublas/syrk.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+#include <blaze_cuda/util/algorithms/CUDATranspose.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  RANK-K UPDATES
+//
+//  The Gram matrix products A*trans(A), trans(A)*A and A*ctrans(A) are symmetric (Hermitian),
+//  so only one triangle has to be computed. A product qualifies if its right-hand side operand
+//  refers to the same memory as its left-hand side operand, read in the opposite storage order.
+//  The triangle below the diagonal of the target's storage (line index greater than position
+//  index) is computed by cuBLAS syrk (herk) and then mirrored onto the other triangle by the
+//  cuda_mirror_lower() kernel, which halves the flops of the equivalent gemm. Note that the
+//  detection is structural: declsym() and declherm() of a product are not required, and
+//  the symmetry flags of a product with distinct operands are not exploited.
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Returns whether the dense matrix \a B is the transpose of the dense matrix \a A.
+// \ingroup cuda
+//
+// \param A The left-hand side operand of the product.
+// \param B The right-hand side operand of the product.
+// \return \a true if \a B reads the elements of \a A transposed, \a false if not.
+*/
+template< typename MT1  // Type of the left-hand side operand
+        , bool SO1      // Storage order of the left-hand side operand
+        , typename MT2  // Type of the right-hand side operand
+        , bool SO2 >    // Storage order of the right-hand side operand
+inline bool isCUDATransposeOf( const DenseMatrix<MT1,SO1>& A, const DenseMatrix<MT2,SO2>& B )
+{
+   return SO1 != SO2 &&
+          (~A).rows()    == (~B).columns() &&
+          (~A).columns() == (~B).rows()    &&
+          (~A).spacing() == (~B).spacing() &&
+          static_cast<const void*>( (~A).data() ) == static_cast<const void*>( (~B).data() );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Assigns \f$ \alpha*A*B \f$ by a symmetric rank-k update if \f$ B=A^T \f$.
+// \ingroup cuda
+//
+// \param lhs The target dense matrix.
+// \param A The left-hand side operand of the product.
+// \param B The right-hand side operand of the product.
+// \param alpha The scaling factor of the product.
+// \return \a true if the product was assigned, \a false if it has to be computed by gemm.
+*/
+template< typename MT   // Type of the target dense matrix
+        , bool SO       // Storage order of the target dense matrix
+        , typename MT1  // Type of the left-hand side operand
+        , bool SO1      // Storage order of the left-hand side operand
+        , typename MT2  // Type of the right-hand side operand
+        , bool SO2      // Storage order of the right-hand side operand
+        , typename ST > // Type of the scaling factor
+inline bool cudaRankKAssign( DenseMatrix<MT,SO>& lhs, const DenseMatrix<MT1,SO1>& A
+                           , const DenseMatrix<MT2,SO2>& B, ST alpha )
+{
+   using ET = ElementType_t<MT>;
+
+   if constexpr( SO1 != SO2 && IsBLASCompatible_v<ET> &&
+                 IsSame_v< ET, ElementType_t<MT1> > && IsSame_v< ET, ElementType_t<MT2> > &&
+                 HasMutableDataAccess_v<MT> &&
+                 HasConstDataAccess_v<MT1> && HasConstDataAccess_v<MT2> )
+   {
+      if( !isCUDATransposeOf( ~A, ~B ) || (~A).columns() == 0UL )
+         return false;
+
+      BLAZE_FUNCTION_TRACE;
+      BLAZE_CUDA_FUNCTION_RANGE;
+
+      cusyrk( ~lhs, ~A, ET( alpha ), ET(0), SO == rowMajor );
+      cuda_mirror_lower( (~lhs).rows(), (~lhs).data(), (~lhs).spacing()
+                       , [] BLAZE_DEVICE_CALLABLE ( auto const& e ) { return e; } );
+
+      return true;
+   }
+   else {
+      return false;
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Assigns \f$ \alpha*A*A^H \f$ by a Hermitian rank-k update for \f$ B=ctrans(A) \f$.
+// \ingroup cuda
+//
+// \param lhs The target dense matrix.
+// \param A The left-hand side operand of the product.
+// \param B The conjugate transpose right-hand side operand of the product.
+// \param alpha The scaling factor of the product.
+// \return \a true if the product was assigned, \a false if it has to be computed by gemm.
+//
+// herk can only compute the target in the storage order of \a A, and only with a real
+// scaling factor.
+*/
+template< typename MT   // Type of the target dense matrix
+        , bool SO       // Storage order of the target dense matrix
+        , typename MT1  // Type of the left-hand side operand
+        , bool SO1      // Storage order of the left-hand side operand
+        , typename MT2  // Type of the conjugated dense matrix
+        , bool SO2      // Storage order of the conjugated dense matrix
+        , bool TF       // Storage order of the transpose expression
+        , typename ST > // Type of the scaling factor
+inline bool cudaRankKAssign( DenseMatrix<MT,SO>& lhs, const DenseMatrix<MT1,SO1>& A
+                           , const DMatTransExpr< DMatMapExpr<MT2,Conj,SO2>, TF >& B, ST alpha )
+{
+   using ET = ElementType_t<MT>;
+   using BT = UnderlyingBuiltin_t<ET>;
+
+   if constexpr( SO == SO1 && SO1 == SO2 && IsComplex_v<ET> && IsBLASCompatible_v<ET> &&
+                 IsSame_v< ET, ElementType_t<MT1> > && IsSame_v< ET, ElementType_t<MT2> > &&
+                 HasMutableDataAccess_v<MT> &&
+                 HasConstDataAccess_v<MT1> && HasConstDataAccess_v<MT2> )
+   {
+      const auto& C( B.operand().operand() );
+
+      if( (~A).rows() != C.rows() || (~A).columns() != C.columns() || (~A).columns() == 0UL ||
+          (~A).spacing() != C.spacing() || (~A).data() != C.data() || imag( ET( alpha ) ) != BT(0) )
+         return false;
+
+      BLAZE_FUNCTION_TRACE;
+      BLAZE_CUDA_FUNCTION_RANGE;
+
+      cuherk( ~lhs, ~A, real( ET( alpha ) ), BT(0), SO == rowMajor );
+      cuda_mirror_lower( (~lhs).rows(), (~lhs).data(), (~lhs).spacing()
+                       , [] BLAZE_DEVICE_CALLABLE ( auto const& e ) { return conj( e ); } );
+
+      return true;
+   }
+   else {
+      return false;
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
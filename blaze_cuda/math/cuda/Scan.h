@@ -0,0 +1,146 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/cuda/Scan.h
+//  \brief Header file for the CUDA-based cumulative sums of dense vectors and matrices
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_CUDA_SCAN_H_
+#define _BLAZE_CUDA_MATH_CUDA_SCAN_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/math/functors/Add.h>
+#include <blaze/math/ReductionFlag.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/math/typetraits/HasConstDataAccess.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/FunctionTrace.h>
+
+#include <blaze_cuda/util/algorithms/CUDAScan.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CUMULATIVE SUMS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Computes the cumulative sum of a CUDA-assignable dense vector.
+// \ingroup cuda
+//
+// \param dv The dense vector.
+// \return The vector of the inclusive prefix sums of \a dv.
+//
+// The sums are computed on the device by cuda_inclusive_scan(). Expressions are evaluated into
+// the result first and scanned in place.
+*/
+template< typename VT  // Type of the dense vector
+        , bool TF >    // Transpose flag of the dense vector
+inline auto cumsum( const DenseVector<VT,TF>& dv )
+   -> EnableIf_t< IsCUDAAssignable_v<VT>, ResultType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( HasConstDataAccess_v<VT> ) {
+      ResultType_t<VT> res( (~dv).size() );
+      cuda_inclusive_scan( (~dv).data(), (~dv).data() + (~dv).size(), res.data(), Add() );
+      return res;
+   }
+   else {
+      ResultType_t<VT> res( ~dv );
+      cuda_inclusive_scan( res.data(), res.data() + res.size(), res.data(), Add() );
+      return res;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the row-wise or column-wise cumulative sums of a CUDA-assignable dense matrix.
+// \ingroup cuda
+//
+// \param dm The dense matrix.
+// \return The matrix of the inclusive prefix sums along each row (\a rowwise) or each column
+//         (\a columnwise) of \a dm.
+//
+// Scans along the storage order of \a dm scan each row (resp. column) with a thread block, the
+// other orientation is scanned with one thread per column (resp. row) and coalesced accesses.
+*/
+template< ReductionFlag RF = rowwise  // Scan direction
+        , typename MT                 // Type of the dense matrix
+        , bool SO >                   // Storage order of the dense matrix
+inline auto cumsum( const DenseMatrix<MT,SO>& dm )
+   -> EnableIf_t< IsCUDAAssignable_v<MT>, ResultType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   ResultType_t<MT> res( (~dm).rows(), (~dm).columns() );
+
+   const size_t lines ( SO == rowMajor ? (~dm).rows()    : (~dm).columns() );
+   const size_t length( SO == rowMajor ? (~dm).columns() : (~dm).rows()    );
+
+   auto scan = [&]( auto in, size_t in_spacing )
+   {
+      if( ( RF == rowwise ) == ( SO == rowMajor ) ) {
+         cuda_inclusive_scan_segments( lines, length, in, in_spacing
+                                     , res.data(), res.spacing(), Add() );
+      }
+      else {
+         cuda_inclusive_scan_strided( lines, length, in, in_spacing
+                                    , res.data(), res.spacing(), Add() );
+      }
+   };
+
+   if constexpr( HasConstDataAccess_v<MT> ) {
+      scan( (~dm).data(), (~dm).spacing() );
+   }
+   else {
+      res = ~dm;
+      scan( static_cast<const ElementType_t<MT>*>( res.data() ), res.spacing() );
+   }
+
+   return res;
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -0,0 +1,135 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/cuda/Sort.h
+//  \brief Header file for the CUDA sorting functions
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_CUDA_SORT_H_
+#define _BLAZE_CUDA_MATH_CUDA_SORT_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <utility>
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/math/typetraits/HasConstDataAccess.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/Types.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/algorithms/CUDASort.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  SORTING
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the permutation sorting a CUDA-assignable dense vector.
+// \ingroup cuda
+//
+// \param dv The dense vector.
+// \param descending \a true to sort in decreasing order.
+// \return The indices of the elements of \a dv in increasing (or decreasing) order of value.
+//
+// Equal elements are ordered by index.
+*/
+template< typename VT  // Type of the dense vector
+        , bool TF >    // Transpose flag of the dense vector
+inline auto argsort( const DenseVector<VT,TF>& dv, bool descending = false )
+   -> EnableIf_t< IsCUDAAssignable_v<VT>, CUDADynamicVector<size_t,TF> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<VT> ) {
+      const ResultType_t<VT> tmp( ~dv );
+      return argsort( tmp, descending );
+   }
+   else {
+      const auto begin( (~dv).data() );
+
+      CUDADynamicVector<size_t,TF> res( (~dv).size() );
+      cuda_argsort( begin, begin + (~dv).size(), res.data(), descending );
+
+      return res;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the \a k largest elements of a CUDA-assignable dense vector and their indices.
+// \ingroup cuda
+//
+// \param dv The dense vector.
+// \param k The number of elements to select.
+// \return The min(k, size) largest elements of \a dv in decreasing order, and their indices.
+//
+// The vector is not sorted: the k-th largest element is found by a radix select and only the
+// selected elements are sorted. Equal elements are ordered by index.
+*/
+template< typename VT  // Type of the dense vector
+        , bool TF >    // Transpose flag of the dense vector
+inline auto top_k( const DenseVector<VT,TF>& dv, size_t k )
+   -> EnableIf_t< IsCUDAAssignable_v<VT>
+                , std::pair< ResultType_t<VT>, CUDADynamicVector<size_t,TF> > >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<VT> ) {
+      const ResultType_t<VT> tmp( ~dv );
+      return top_k( tmp, k );
+   }
+   else {
+      const auto begin( (~dv).data() );
+      const size_t n( k < (~dv).size() ? k : (~dv).size() );
+
+      std::pair< ResultType_t<VT>, CUDADynamicVector<size_t,TF> > res( n, n );
+      cuda_top_k( begin, begin + (~dv).size(), n, res.first.data(), res.second.data() );
+
+      return res;
+   }
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
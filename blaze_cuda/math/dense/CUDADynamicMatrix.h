@@ -76,6 +76,7 @@
 #include <blaze/math/typetraits/HighType.h>
 #include <blaze/math/typetraits/IsAligned.h>
 #include <blaze/math/typetraits/IsColumnVector.h>
+#include <blaze/math/typetraits/IsComplex.h>
 #include <blaze/math/typetraits/IsContiguous.h>
 #include <blaze/math/typetraits/IsCUDAAssignable.h>
 #include <blaze/math/typetraits/IsDenseMatrix.h>
@@ -127,8 +128,12 @@
 #include <blaze/util/typetraits/RemoveConst.h>
 
 #include <blaze_cuda/util/Memory.h>
+#include <blaze_cuda/util/algorithms/CUDACompact.h>
 #include <blaze_cuda/util/algorithms/CUDATransform.h>
+#include <blaze_cuda/util/algorithms/CUDATransform2D.h>
+#include <blaze_cuda/util/algorithms/CUDATranspose.h>
 #include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
 #include <blaze_cuda/math/cuda/DenseMatrix.h>
 
 namespace blaze {
@@ -577,11 +582,9 @@ inline CUDADynamicMatrix<Type,SO>::CUDADynamicMatrix( size_t m, size_t n )
    , capacity_( m_*nn_ )                        // The maximum capacity of the matrix
    , v_       ( cuda_managed_allocate<Type>( capacity_ ) )   // The matrix elements
 {
-   for( size_t i=0UL; i<m_; ++i ) {
-      cuda_transform( begin(i), end(i), begin(i),
-         [] BLAZE_DEVICE_CALLABLE ( auto const& ) { return Type(); } );
-   }
-   cudaDeviceSynchronize();
+   cuda_transform_2d( m_, n_, v_, nn_, v_, nn_,
+      [] BLAZE_DEVICE_CALLABLE ( auto const& ) { return Type(); } );
+   cuda_synchronize();
 
    BLAZE_INTERNAL_ASSERT( isIntact(), "Invariant violation detected" );
 }
@@ -602,11 +605,9 @@ template< typename Type  // Data type of the matrix
 inline CUDADynamicMatrix<Type,SO>::CUDADynamicMatrix( size_t m, size_t n, const Type& init )
    : CUDADynamicMatrix( m, n )
 {
-   for( size_t i=0UL; i<m_; ++i ) {
-      cuda_transform( begin(i), end(i), begin(i),
-         [=] BLAZE_DEVICE_CALLABLE ( auto const& ) { return init; } );
-   }
-   cudaDeviceSynchronize();
+   cuda_transform_2d( m_, n_, v_, nn_, v_, nn_,
+      [=] BLAZE_DEVICE_CALLABLE ( auto const& ) { return init; } );
+   cuda_synchronize();
 
    BLAZE_INTERNAL_ASSERT( isIntact(), "Invariant violation detected" );
 }
@@ -1545,19 +1546,15 @@ inline size_t CUDADynamicMatrix<Type,SO>::capacity( size_t i ) const noexcept
 /*!\brief Returns the total number of non-zero elements in the matrix
 //
 // \return The number of non-zero elements in the dense matrix.
+//
+// The elements are counted on the device, padding excluded, with the same relaxed comparison
+// to zero as isDefault().
 */
 template< typename Type  // Data type of the matrix
         , bool SO >      // Storage order
 inline size_t CUDADynamicMatrix<Type,SO>::nonZeros() const
 {
-   size_t nonzeros( 0UL );
-
-   for( size_t i=0UL; i<m_; ++i )
-      for( size_t j=0UL; j<n_; ++j )
-         if( !isDefault( v_[i*nn_+j] ) )
-            ++nonzeros;
-
-   return nonzeros;
+   return cuda_count_if_2d( m_, n_, v_, nn_, CUDAIsNonDefault() );
 }
 //*************************************************************************************************
 
@@ -1579,14 +1576,7 @@ inline size_t CUDADynamicMatrix<Type,SO>::nonZeros( size_t i ) const
 {
    BLAZE_USER_ASSERT( i < rows(), "Invalid row access index" );
 
-   const size_t jend( i*nn_ + n_ );
-   size_t nonzeros( 0UL );
-
-   for( size_t j=i*nn_; j<jend; ++j )
-      if( !isDefault( v_[j] ) )
-         ++nonzeros;
-
-   return nonzeros;
+   return cuda_count_if( v_ + i*nn_, v_ + i*nn_ + n_, CUDAIsNonDefault() );
 }
 //*************************************************************************************************
 
@@ -1847,23 +1837,9 @@ template< typename Type  // Data type of the matrix
         , bool SO >      // Storage order
 inline CUDADynamicMatrix<Type,SO>& CUDADynamicMatrix<Type,SO>::transpose()
 {
-   using std::swap;
-
-   constexpr size_t block( BLOCK_SIZE );
-
    if( m_ == n_ )
    {
-      for( size_t ii=0UL; ii<m_; ii+=block ) {
-         const size_t iend( min( ii+block, m_ ) );
-         for( size_t jj=0UL; jj<=ii; jj+=block ) {
-            for( size_t i=ii; i<iend; ++i ) {
-               const size_t jend( min( jj+block, n_, i ) );
-               for( size_t j=jj; j<jend; ++j ) {
-                  swap( v_[i*nn_+j], v_[j*nn_+i] );
-               }
-            }
-         }
-      }
+      cuda_transpose_inplace( m_, v_, nn_, [] BLAZE_DEVICE_CALLABLE ( auto const& e ) { return e; } );
    }
    else
    {
@@ -1885,27 +1861,13 @@ template< typename Type  // Data type of the matrix
         , bool SO >      // Storage order
 inline CUDADynamicMatrix<Type,SO>& CUDADynamicMatrix<Type,SO>::ctranspose()
 {
-   constexpr size_t block( BLOCK_SIZE );
-
-   if( m_ == n_ )
+   if( !IsComplex_v<Type> )
    {
-      for( size_t ii=0UL; ii<m_; ii+=block ) {
-         const size_t iend( min( ii+block, m_ ) );
-         for( size_t jj=0UL; jj<ii; jj+=block ) {
-            const size_t jend( min( jj+block, n_ ) );
-            for( size_t i=ii; i<iend; ++i ) {
-               for( size_t j=jj; j<jend; ++j ) {
-                  cswap( v_[i*nn_+j], v_[j*nn_+i] );
-               }
-            }
-         }
-         for( size_t i=ii; i<iend; ++i ) {
-            for( size_t j=ii; j<i; ++j ) {
-               cswap( v_[i*nn_+j], v_[j*nn_+i] );
-            }
-            conjugate( v_[i*nn_+i] );
-         }
-      }
+      transpose();
+   }
+   else if( m_ == n_ )
+   {
+      cuda_transpose_inplace( m_, v_, nn_, [] BLAZE_DEVICE_CALLABLE ( auto const& e ) { return conj( e ); } );
    }
    else
    {
@@ -4391,18 +4353,14 @@ inline size_t CUDADynamicMatrix<Type,true>::capacity( size_t j ) const noexcept
 /*!\brief Returns the total number of non-zero elements in the matrix
 //
 // \return The number of non-zero elements in the dense matrix.
+//
+// The elements are counted on the device, padding excluded, with the same relaxed comparison
+// to zero as isDefault().
 */
 template< typename Type >  // Data type of the matrix
 inline size_t CUDADynamicMatrix<Type,true>::nonZeros() const
 {
-   size_t nonzeros( 0UL );
-
-   for( size_t j=0UL; j<n_; ++j )
-      for( size_t i=0UL; i<m_; ++i )
-         if( !isDefault( v_[i+j*mm_] ) )
-            ++nonzeros;
-
-   return nonzeros;
+   return cuda_count_if_2d( n_, m_, v_, mm_, CUDAIsNonDefault() );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -4420,14 +4378,7 @@ inline size_t CUDADynamicMatrix<Type,true>::nonZeros( size_t j ) const
 {
    BLAZE_USER_ASSERT( j < columns(), "Invalid column access index" );
 
-   const size_t iend( j*mm_ + m_ );
-   size_t nonzeros( 0UL );
-
-   for( size_t i=j*mm_; i<iend; ++i )
-      if( !isDefault( v_[i] ) )
-         ++nonzeros;
-
-   return nonzeros;
+   return cuda_count_if( v_ + j*mm_, v_ + j*mm_ + m_, CUDAIsNonDefault() );
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -4695,23 +4646,9 @@ inline void CUDADynamicMatrix<Type,true>::swap( CUDADynamicMatrix& m ) noexcept
 template< typename Type >  // Data type of the matrix
 inline CUDADynamicMatrix<Type,true>& CUDADynamicMatrix<Type,true>::transpose()
 {
-   using std::swap;
-
-   constexpr size_t block( BLOCK_SIZE );
-
    if( m_ == n_ )
    {
-      for( size_t jj=0UL; jj<n_; jj+=block ) {
-         const size_t jend( min( jj+block, n_ ) );
-         for( size_t ii=0UL; ii<=jj; ii+=block ) {
-            for( size_t j=jj; j<jend; ++j ) {
-               const size_t iend( min( ii+block, m_, j ) );
-               for( size_t i=ii; i<iend; ++i ) {
-                  swap( v_[i+j*mm_], v_[j+i*mm_] );
-               }
-            }
-         }
-      }
+      cuda_transpose_inplace( m_, v_, mm_, [] BLAZE_DEVICE_CALLABLE ( auto const& e ) { return e; } );
    }
    else
    {
@@ -4734,27 +4671,13 @@ inline CUDADynamicMatrix<Type,true>& CUDADynamicMatrix<Type,true>::transpose()
 template< typename Type >  // Data type of the matrix
 inline CUDADynamicMatrix<Type,true>& CUDADynamicMatrix<Type,true>::ctranspose()
 {
-   constexpr size_t block( BLOCK_SIZE );
-
-   if( m_ == n_ )
+   if( !IsComplex_v<Type> )
    {
-      for( size_t jj=0UL; jj<n_; jj+=block ) {
-         const size_t jend( min( jj+block, n_ ) );
-         for( size_t ii=0UL; ii<jj; ii+=block ) {
-            const size_t iend( min( ii+block, m_ ) );
-            for( size_t j=jj; j<jend; ++j ) {
-               for( size_t i=ii; i<iend; ++i ) {
-                  cswap( v_[i+j*mm_], v_[j+i*mm_] );
-               }
-            }
-         }
-         for( size_t j=jj; j<jend; ++j ) {
-            for( size_t i=jj; i<j; ++i ) {
-               cswap( v_[i+j*mm_], v_[j+i*mm_] );
-            }
-            conjugate( v_[j+j*mm_] );
-         }
-      }
+      transpose();
+   }
+   else if( m_ == n_ )
+   {
+      cuda_transpose_inplace( m_, v_, mm_, [] BLAZE_DEVICE_CALLABLE ( auto const& e ) { return conj( e ); } );
    }
    else
    {
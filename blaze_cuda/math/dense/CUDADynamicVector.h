@@ -114,8 +114,10 @@
 
 #include <blaze_cuda/math/DenseVector.h>
 #include <blaze_cuda/util/Memory.h>
+#include <blaze_cuda/util/algorithms/CUDACompact.h>
 #include <blaze_cuda/util/algorithms/CUDATransform.h>
 #include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
 
 namespace blaze {
 
@@ -515,7 +517,7 @@ inline CUDADynamicVector<Type,TF>::CUDADynamicVector( size_t n, const Type& init
       return init;
    } );
 
-   cudaDeviceSynchronize();
+   cuda_synchronize();
    BLAZE_CUDA_ERROR_CHECK;
 
    BLAZE_INTERNAL_ASSERT( isIntact(), "Invariant violation detected" );
@@ -1317,20 +1319,14 @@ inline size_t CUDADynamicVector<Type,TF>::capacity() const noexcept
 // \return The number of non-zero elements in the vector.
 //
 // Note that the number of non-zero elements is always less than or equal to the current size
-// of the vector.
+// of the vector. The elements are counted on the device, with the same relaxed comparison
+// to zero as isDefault().
 */
 template< typename Type  // Data type of the vector
         , bool TF >      // Transpose flag
 inline size_t CUDADynamicVector<Type,TF>::nonZeros() const
 {
-   size_t nonzeros( 0 );
-
-   for( size_t i=0UL; i<size_; ++i ) {
-      if( !isDefault( v_[i] ) )
-         ++nonzeros;
-   }
-
-   return nonzeros;
+   return cuda_count_if( v_, v_ + size_, CUDAIsNonDefault() );
 }
 //*************************************************************************************************
 
@@ -0,0 +1,410 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/dense/CUDAMatrixBatch.h
+//  \brief Header file for the implementation of a batch of equally sized CUDA matrices
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_DENSE_CUDAMATRIXBATCH_H_
+#define _BLAZE_CUDA_MATH_DENSE_CUDAMATRIXBATCH_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/AlignmentFlag.h>
+#include <blaze/math/PaddingFlag.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Types.h>
+
+#include <blaze_cuda/math/dense/CUDACustomMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Batch of equally sized dense matrices in a single CUDA allocation.
+// \ingroup dense_matrix
+//
+// The CUDAMatrixBatch class template stores \a size() matrices of \a rows() x \a columns()
+// elements back to back in unified memory, without padding, so that matrix \a b starts at
+// \a data() + b * \a stride(). This is the layout expected by strided batched BLAS kernels
+// (see batched_gemm()). The individual matrices are accessed as unpadded CUDACustomMatrix
+// views:
+
+   \code
+   using blaze::CUDAMatrixBatch;
+
+   CUDAMatrixBatch<float> A( 10000UL, 8UL, 8UL ), B( 10000UL, 8UL, 8UL ), C( 10000UL, 8UL, 8UL );
+   // ... Initialization of A[b] and B[b]
+   batched_gemm( C, A, B );  // C[b] = A[b] * B[b] for all b
+   \endcode
+*/
+template< typename Type                    // Data type of the matrices
+        , bool SO = defaultStorageOrder >  // Storage order of the matrices
+class CUDAMatrixBatch
+{
+ public:
+   //**Type definitions****************************************************************************
+   using ElementType = Type;  //!< Type of the matrix elements.
+
+   //! View on a single matrix of the batch.
+   using MatrixType = CUDACustomMatrix<Type,unaligned,unpadded,SO>;
+
+   //! View on a single constant matrix of the batch.
+   using ConstMatrixType = CUDACustomMatrix<const Type,unaligned,unpadded,SO>;
+   //**********************************************************************************************
+
+   //**Compilation flags***************************************************************************
+   //! Storage order of the matrices.
+   static constexpr bool storageOrder = SO;
+   //**********************************************************************************************
+
+   //**Constructors********************************************************************************
+   /*!\name Constructors */
+   //@{
+   explicit inline CUDAMatrixBatch();
+   explicit inline CUDAMatrixBatch( size_t count, size_t m, size_t n );
+   explicit inline CUDAMatrixBatch( size_t count, size_t m, size_t n, const Type& init );
+   //@}
+   //**********************************************************************************************
+
+   //**Data access functions***********************************************************************
+   /*!\name Data access functions */
+   //@{
+   inline MatrixType      operator[]( size_t b );
+   inline ConstMatrixType operator[]( size_t b ) const;
+   inline Type*           data  () noexcept;
+   inline const Type*     data  () const noexcept;
+   inline Type*           data  ( size_t b ) noexcept;
+   inline const Type*     data  ( size_t b ) const noexcept;
+   //@}
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   inline size_t size   () const noexcept;
+   inline size_t rows   () const noexcept;
+   inline size_t columns() const noexcept;
+   inline size_t spacing() const noexcept;
+   inline size_t stride () const noexcept;
+   inline void   resize ( size_t count, size_t m, size_t n );
+   //@}
+   //**********************************************************************************************
+
+ private:
+   //**Member variables****************************************************************************
+   /*!\name Member variables */
+   //@{
+   size_t count_;                  //!< The number of matrices.
+   size_t m_;                      //!< The number of rows of each matrix.
+   size_t n_;                      //!< The number of columns of each matrix.
+   CUDADynamicVector<Type> data_;  //!< The elements of all matrices.
+   //@}
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CONSTRUCTORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief The default constructor for CUDAMatrixBatch.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline CUDAMatrixBatch<Type,SO>::CUDAMatrixBatch()
+   : count_( 0UL )  // The number of matrices
+   , m_    ( 0UL )  // The number of rows of each matrix
+   , n_    ( 0UL )  // The number of columns of each matrix
+   , data_ ()       // The elements of all matrices
+{}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Constructor for a batch of \a count matrices of size \f$ m \times n \f$.
+//
+// \param count The number of matrices.
+// \param m The number of rows of each matrix.
+// \param n The number of columns of each matrix.
+//
+// The elements are not initialized.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline CUDAMatrixBatch<Type,SO>::CUDAMatrixBatch( size_t count, size_t m, size_t n )
+   : count_( count )          // The number of matrices
+   , m_    ( m )              // The number of rows of each matrix
+   , n_    ( n )              // The number of columns of each matrix
+   , data_ ( count * m * n )  // The elements of all matrices
+{}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Constructor for a batch of \a count homogeneous matrices of size \f$ m \times n \f$.
+//
+// \param count The number of matrices.
+// \param m The number of rows of each matrix.
+// \param n The number of columns of each matrix.
+// \param init The initial value of the matrix elements.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline CUDAMatrixBatch<Type,SO>::CUDAMatrixBatch( size_t count, size_t m, size_t n, const Type& init )
+   : count_( count )                // The number of matrices
+   , m_    ( m )                    // The number of rows of each matrix
+   , n_    ( n )                    // The number of columns of each matrix
+   , data_ ( count * m * n, init )  // The elements of all matrices
+{}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  DATA ACCESS FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Access to a single matrix of the batch.
+//
+// \param b Index of the matrix. The index has to be in the range \f$[0..size-1]\f$.
+// \return View on the matrix.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline typename CUDAMatrixBatch<Type,SO>::MatrixType
+   CUDAMatrixBatch<Type,SO>::operator[]( size_t b )
+{
+   BLAZE_USER_ASSERT( b < count_, "Invalid batch access index" );
+   return MatrixType( data( b ), m_, n_ );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Access to a single constant matrix of the batch.
+//
+// \param b Index of the matrix. The index has to be in the range \f$[0..size-1]\f$.
+// \return View on the matrix.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline typename CUDAMatrixBatch<Type,SO>::ConstMatrixType
+   CUDAMatrixBatch<Type,SO>::operator[]( size_t b ) const
+{
+   BLAZE_USER_ASSERT( b < count_, "Invalid batch access index" );
+   return ConstMatrixType( data( b ), m_, n_ );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Low-level data access to the elements of all matrices.
+//
+// \return Pointer to the first element of the first matrix.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline Type* CUDAMatrixBatch<Type,SO>::data() noexcept
+{
+   return data_.data();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Low-level data access to the elements of all matrices.
+//
+// \return Pointer to the first element of the first matrix.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline const Type* CUDAMatrixBatch<Type,SO>::data() const noexcept
+{
+   return data_.data();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Low-level data access to the elements of a single matrix.
+//
+// \param b Index of the matrix. The index has to be in the range \f$[0..size-1]\f$.
+// \return Pointer to the first element of matrix \a b.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline Type* CUDAMatrixBatch<Type,SO>::data( size_t b ) noexcept
+{
+   BLAZE_USER_ASSERT( b < count_, "Invalid batch access index" );
+   return data_.data() + b * stride();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Low-level data access to the elements of a single matrix.
+//
+// \param b Index of the matrix. The index has to be in the range \f$[0..size-1]\f$.
+// \return Pointer to the first element of matrix \a b.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline const Type* CUDAMatrixBatch<Type,SO>::data( size_t b ) const noexcept
+{
+   BLAZE_USER_ASSERT( b < count_, "Invalid batch access index" );
+   return data_.data() + b * stride();
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the number of matrices of the batch.
+//
+// \return The number of matrices.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline size_t CUDAMatrixBatch<Type,SO>::size() const noexcept
+{
+   return count_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the number of rows of each matrix.
+//
+// \return The number of rows.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline size_t CUDAMatrixBatch<Type,SO>::rows() const noexcept
+{
+   return m_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the number of columns of each matrix.
+//
+// \return The number of columns.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline size_t CUDAMatrixBatch<Type,SO>::columns() const noexcept
+{
+   return n_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the spacing between the beginning of two rows/columns of each matrix.
+//
+// \return The number of columns (row-major) or rows (column-major).
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline size_t CUDAMatrixBatch<Type,SO>::spacing() const noexcept
+{
+   return SO == rowMajor ? n_ : m_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the distance between the first elements of two consecutive matrices.
+//
+// \return The number of elements of each matrix.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline size_t CUDAMatrixBatch<Type,SO>::stride() const noexcept
+{
+   return m_ * n_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Changes the number and size of the matrices.
+//
+// \param count The new number of matrices.
+// \param m The new number of rows of each matrix.
+// \param n The new number of columns of each matrix.
+// \return void
+//
+// The elements are not preserved.
+*/
+template< typename Type  // Data type of the matrices
+        , bool SO >      // Storage order of the matrices
+inline void CUDAMatrixBatch<Type,SO>::resize( size_t count, size_t m, size_t n )
+{
+   data_.resize( count * m * n, false );
+   count_ = count;
+   m_     = m;
+   n_     = n;
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
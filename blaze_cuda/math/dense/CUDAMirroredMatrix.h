@@ -0,0 +1,600 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/dense/CUDAMirroredMatrix.h
+//  \brief Header file for the implementation of a device memory matrix with a host mirror
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_DENSE_CUDAMIRROREDMATRIX_H_
+#define _BLAZE_CUDA_MATH_DENSE_CUDAMIRROREDMATRIX_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <algorithm>
+#include <ostream>
+#include <utility>
+
+#include <blaze/math/AlignmentFlag.h>
+#include <blaze/math/dense/CustomMatrix.h>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/PaddingFlag.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Types.h>
+
+#include <blaze_cuda/math/dense/CUDACustomMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/util/algorithms/CUDATransform.h>
+#include <blaze_cuda/util/algorithms/CUDATransform2D.h>
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAMirroredArray.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\defgroup cuda_mirrored_matrix CUDAMirroredMatrix
+// \ingroup dense_matrix
+*/
+/*!\brief Dense matrix in plain device memory with a lazily synchronized host mirror.
+// \ingroup cuda_mirrored_matrix
+//
+// The CUDAMirroredMatrix class template is the device memory counterpart of CUDADynamicMatrix,
+// following the same scheme as CUDAMirroredVector: the elements are stored unpadded in a
+// CUDAMirroredArray, host accesses (the function call operator, the output operator,
+// randomize()) work on a pinned host mirror and computations are expressed on the
+// CUDACustomMatrix views returned by device() and cdevice():
+
+   \code
+   blaze::CUDAMirroredMatrix<double> A( 100UL, 100UL ), B( 100UL, 100UL );
+
+   blaze::randomize( A );              // Initialized on the host mirror
+   B.device() = trans( A.cdevice() );  // Single upload of A, computed on the device
+   std::cout << B(1,0) << "\n";        // Single download of B
+   \endcode
+*/
+template< typename Type                     // Data type of the matrix
+        , bool SO = defaultStorageOrder >  // Storage order
+class CUDAMirroredMatrix
+{
+ public:
+   //**Type definitions****************************************************************************
+   using ElementType    = Type;                        //!< Type of the matrix elements.
+   using ResultType     = CUDADynamicMatrix<Type,SO>;  //!< Result type of the device views.
+   using Reference      = Type&;                       //!< Reference to a non-constant matrix value.
+   using ConstReference = const Type&;                 //!< Reference to a constant matrix value.
+
+   //! View on the device memory.
+   using DeviceType = CUDACustomMatrix<Type,unaligned,unpadded,SO,ResultType>;
+
+   //! Read-only view on the device memory.
+   using ConstDeviceType = CUDACustomMatrix<const Type,unaligned,unpadded,SO,ResultType>;
+
+   //! View on the host mirror.
+   using HostType = CustomMatrix<Type,unaligned,unpadded,SO>;
+
+   //! Read-only view on the host mirror.
+   using ConstHostType = CustomMatrix<const Type,unaligned,unpadded,SO>;
+   //**********************************************************************************************
+
+   //**Constructors********************************************************************************
+   /*!\name Constructors */
+   //@{
+   explicit inline CUDAMirroredMatrix( size_t m = 0UL, size_t n = 0UL );
+   explicit inline CUDAMirroredMatrix( size_t m, size_t n, const Type& init );
+
+   template< typename MT >
+   explicit inline CUDAMirroredMatrix( const DenseMatrix<MT,SO>& m );
+
+   CUDAMirroredMatrix( const CUDAMirroredMatrix& ) = default;
+   inline CUDAMirroredMatrix( CUDAMirroredMatrix&& m ) noexcept;
+   //@}
+   //**********************************************************************************************
+
+   //**Assignment operators************************************************************************
+   /*!\name Assignment operators */
+   //@{
+   CUDAMirroredMatrix& operator=( const CUDAMirroredMatrix& ) = default;
+   inline CUDAMirroredMatrix& operator=( CUDAMirroredMatrix&& rhs ) noexcept;
+
+   template< typename MT >
+   inline CUDAMirroredMatrix& operator=( const DenseMatrix<MT,SO>& rhs );
+   //@}
+   //**********************************************************************************************
+
+   //**Data access functions***********************************************************************
+   /*!\name Data access functions */
+   //@{
+   inline Reference      operator()( size_t i, size_t j );
+   inline ConstReference operator()( size_t i, size_t j ) const;
+
+   inline DeviceType      device();
+   inline ConstDeviceType device() const;
+   inline ConstDeviceType cdevice() const;
+
+   inline HostType      host();
+   inline ConstHostType host() const;
+   inline ConstHostType chost() const;
+   //@}
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   inline size_t rows() const noexcept { return m_; }
+   inline size_t columns() const noexcept { return n_; }
+   inline bool   hasHostMirror() const noexcept { return v_.hasHostMirror(); }
+
+   inline void resize( size_t m, size_t n, bool preserve=true );
+   inline void releaseHostMirror();
+   inline void swap( CUDAMirroredMatrix& m ) noexcept;
+   //@}
+   //**********************************************************************************************
+
+ private:
+   //**Utility functions***************************************************************************
+   inline size_t index( size_t i, size_t j ) const noexcept;
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   size_t m_;                   //!< The current number of rows of the matrix.
+   size_t n_;                   //!< The current number of columns of the matrix.
+   CUDAMirroredArray<Type> v_;  //!< The matrix elements.
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CONSTRUCTORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Constructor for a matrix of size \f$ m \times n \f$.
+//
+// \param m The number of rows of the matrix.
+// \param n The number of columns of the matrix.
+//
+// The elements are default initialized on the device, no host mirror is allocated.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline CUDAMirroredMatrix<Type,SO>::CUDAMirroredMatrix( size_t m, size_t n )
+   : CUDAMirroredMatrix( m, n, Type() )
+{}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Constructor for a homogeneous initialization of all \f$ m \times n \f$ matrix elements.
+//
+// \param m The number of rows of the matrix.
+// \param n The number of columns of the matrix.
+// \param init The initial value of the matrix elements.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline CUDAMirroredMatrix<Type,SO>::CUDAMirroredMatrix( size_t m, size_t n, const Type& init )
+   : m_( m )    // The current number of rows of the matrix
+   , n_( n )    // The current number of columns of the matrix
+   , v_( m*n )  // The matrix elements
+{
+   Type* d( v_.device() );
+
+   cuda_transform( d, d + m*n, d, [=] BLAZE_DEVICE_CALLABLE ( auto const& ) {
+      return init;
+   } );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Conversion constructor from dense matrices.
+//
+// \param m Dense matrix to be copied.
+//
+// The matrix is evaluated into the device memory.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+template< typename MT >  // Type of the foreign matrix
+inline CUDAMirroredMatrix<Type,SO>::CUDAMirroredMatrix( const DenseMatrix<MT,SO>& m )
+   : m_( (~m).rows() )      // The current number of rows of the matrix
+   , n_( (~m).columns() )   // The current number of columns of the matrix
+   , v_( m_*n_ )            // The matrix elements
+{
+   device() = ~m;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief The move constructor.
+//
+// \param m The matrix to be moved into this instance.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline CUDAMirroredMatrix<Type,SO>::CUDAMirroredMatrix( CUDAMirroredMatrix&& m ) noexcept
+   : m_( m.m_ )               // The current number of rows of the matrix
+   , n_( m.n_ )               // The current number of columns of the matrix
+   , v_( std::move( m.v_ ) )  // The matrix elements
+{
+   m.m_ = 0UL;
+   m.n_ = 0UL;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  ASSIGNMENT OPERATORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Move assignment operator.
+//
+// \param rhs The matrix to be moved into this instance.
+// \return Reference to the assigned matrix.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline CUDAMirroredMatrix<Type,SO>& CUDAMirroredMatrix<Type,SO>::operator=( CUDAMirroredMatrix&& rhs ) noexcept
+{
+   CUDAMirroredMatrix tmp( std::move( rhs ) );
+   swap( tmp );
+   return *this;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Assignment operator for dense matrices.
+//
+// \param rhs Dense matrix to be copied.
+// \return Reference to the assigned matrix.
+//
+// The matrix is resized to the size of \a rhs and \a rhs is evaluated into the device memory.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+template< typename MT >  // Type of the right-hand side matrix
+inline CUDAMirroredMatrix<Type,SO>& CUDAMirroredMatrix<Type,SO>::operator=( const DenseMatrix<MT,SO>& rhs )
+{
+   if( (~rhs).rows() != m_ || (~rhs).columns() != n_ ) {
+      CUDAMirroredMatrix tmp( ~rhs );
+      swap( tmp );
+   }
+   else {
+      device() = ~rhs;
+   }
+
+   return *this;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  DATA ACCESS FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief 2D-access to the matrix elements.
+//
+// \param i Access index for the row. The index has to be in the range \f$[0..M-1]\f$.
+// \param j Access index for the column. The index has to be in the range \f$[0..N-1]\f$.
+// \return Reference to the accessed value in the host mirror.
+//
+// The host mirror is synchronized if necessary and marked as modified.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline typename CUDAMirroredMatrix<Type,SO>::Reference
+   CUDAMirroredMatrix<Type,SO>::operator()( size_t i, size_t j )
+{
+   BLAZE_USER_ASSERT( i < m_, "Invalid row access index"    );
+   BLAZE_USER_ASSERT( j < n_, "Invalid column access index" );
+   return v_.host()[index( i, j )];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief 2D-access to the matrix elements.
+//
+// \param i Access index for the row. The index has to be in the range \f$[0..M-1]\f$.
+// \param j Access index for the column. The index has to be in the range \f$[0..N-1]\f$.
+// \return Reference to the accessed value in the host mirror.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline typename CUDAMirroredMatrix<Type,SO>::ConstReference
+   CUDAMirroredMatrix<Type,SO>::operator()( size_t i, size_t j ) const
+{
+   BLAZE_USER_ASSERT( i < m_, "Invalid row access index"    );
+   BLAZE_USER_ASSERT( j < n_, "Invalid column access index" );
+   return v_.chost()[index( i, j )];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the device memory for modification.
+//
+// \return CUDACustomMatrix over the device memory.
+//
+// The host mirror, if any, is synchronized first and considered outdated afterwards. The view
+// of an empty matrix is an empty CUDACustomMatrix.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline typename CUDAMirroredMatrix<Type,SO>::DeviceType CUDAMirroredMatrix<Type,SO>::device()
+{
+   return v_.size() != 0UL ? DeviceType( v_.device(), m_, n_ ) : DeviceType();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the device memory for reading.
+//
+// \return CUDACustomMatrix over the device memory.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline typename CUDAMirroredMatrix<Type,SO>::ConstDeviceType CUDAMirroredMatrix<Type,SO>::device() const
+{
+   return cdevice();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the device memory for reading.
+//
+// \return CUDACustomMatrix over the device memory.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline typename CUDAMirroredMatrix<Type,SO>::ConstDeviceType CUDAMirroredMatrix<Type,SO>::cdevice() const
+{
+   return v_.size() != 0UL ? ConstDeviceType( v_.cdevice(), m_, n_ ) : ConstDeviceType();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the host mirror for modification.
+//
+// \return CustomMatrix over the host mirror.
+// \exception std::bad_alloc Allocation of the host mirror failed.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline typename CUDAMirroredMatrix<Type,SO>::HostType CUDAMirroredMatrix<Type,SO>::host()
+{
+   return HostType( v_.host(), m_, n_ );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the host mirror for reading.
+//
+// \return CustomMatrix over the host mirror.
+// \exception std::bad_alloc Allocation of the host mirror failed.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline typename CUDAMirroredMatrix<Type,SO>::ConstHostType CUDAMirroredMatrix<Type,SO>::host() const
+{
+   return chost();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the host mirror for reading.
+//
+// \return CustomMatrix over the host mirror.
+// \exception std::bad_alloc Allocation of the host mirror failed.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline typename CUDAMirroredMatrix<Type,SO>::ConstHostType CUDAMirroredMatrix<Type,SO>::chost() const
+{
+   return ConstHostType( v_.chost(), m_, n_ );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Changing the size of the matrix.
+//
+// \param m The new number of rows of the matrix.
+// \param n The new number of columns of the matrix.
+// \param preserve \a true if the old values of the matrix should be preserved, \a false if not.
+// \return void
+//
+// The old values are copied by a single 2D transform on the device and the host mirror is
+// released. New elements are left uninitialized.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline void CUDAMirroredMatrix<Type,SO>::resize( size_t m, size_t n, bool preserve )
+{
+   if( m == m_ && n == n_ )
+      return;
+
+   CUDAMirroredArray<Type> tmp( m*n );
+
+   const size_t lines ( SO == rowMajor ? std::min( m, m_ ) : std::min( n, n_ ) );
+   const size_t length( SO == rowMajor ? std::min( n, n_ ) : std::min( m, m_ ) );
+
+   if( preserve && lines != 0UL && length != 0UL ) {
+      cuda_transform_2d( lines, length
+                       , v_.cdevice(), SO == rowMajor ? n_ : m_
+                       , tmp.device(), SO == rowMajor ? n : m
+                       , [] BLAZE_DEVICE_CALLABLE ( auto const& e ) { return e; } );
+      BLAZE_CUDA_ERROR_CHECK;
+   }
+
+   m_ = m;
+   n_ = n;
+   v_.swap( tmp );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Releases the host mirror after synchronizing the device memory.
+//
+// \return void
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline void CUDAMirroredMatrix<Type,SO>::releaseHostMirror()
+{
+   v_.releaseHostMirror();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Swapping the contents of two matrices.
+//
+// \param m The matrix to be swapped.
+// \return void
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline void CUDAMirroredMatrix<Type,SO>::swap( CUDAMirroredMatrix& m ) noexcept
+{
+   using std::swap;
+
+   swap( m_, m.m_ );
+   swap( n_, m.n_ );
+   v_.swap( m.v_ );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the position of an element in the unpadded storage.
+//
+// \param i The row index of the element.
+// \param j The column index of the element.
+// \return The offset of the element.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline size_t CUDAMirroredMatrix<Type,SO>::index( size_t i, size_t j ) const noexcept
+{
+   return SO == rowMajor ? i*n_ + j : j*m_ + i;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CUDAMIRROREDMATRIX OPERATORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Swapping the contents of two matrices.
+// \ingroup cuda_mirrored_matrix
+//
+// \param a The first matrix to be swapped.
+// \param b The second matrix to be swapped.
+// \return void
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline void swap( CUDAMirroredMatrix<Type,SO>& a, CUDAMirroredMatrix<Type,SO>& b ) noexcept
+{
+   a.swap( b );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Global output operator for mirrored matrices.
+// \ingroup cuda_mirrored_matrix
+//
+// \param os Reference to the output stream.
+// \param m Reference to a constant matrix object.
+// \return Reference to the output stream.
+//
+// The matrix is printed from its host mirror.
+*/
+template< typename Type  // Data type of the matrix
+        , bool SO >      // Storage order
+inline std::ostream& operator<<( std::ostream& os, const CUDAMirroredMatrix<Type,SO>& m )
+{
+   return os << m.chost();
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
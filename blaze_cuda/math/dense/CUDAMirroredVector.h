@@ -0,0 +1,513 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/dense/CUDAMirroredVector.h
+//  \brief Header file for the implementation of a device memory vector with a host mirror
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_DENSE_CUDAMIRROREDVECTOR_H_
+#define _BLAZE_CUDA_MATH_DENSE_CUDAMIRROREDVECTOR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <ostream>
+#include <utility>
+
+#include <blaze/math/AlignmentFlag.h>
+#include <blaze/math/dense/CustomVector.h>
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/math/PaddingFlag.h>
+#include <blaze/system/TransposeFlag.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/Types.h>
+
+#include <blaze_cuda/math/dense/CUDACustomVector.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/algorithms/CUDATransform.h>
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAMirroredArray.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\defgroup cuda_mirrored_vector CUDAMirroredVector
+// \ingroup dense_vector
+*/
+/*!\brief Dense vector in plain device memory with a lazily synchronized host mirror.
+// \ingroup cuda_mirrored_vector
+//
+// The CUDAMirroredVector class template is the device memory counterpart of CUDADynamicVector.
+// Its elements are stored in a CUDAMirroredArray instead of unified memory, so host accesses
+// (the subscript operator, the output operator, randomize()) work on a pinned host mirror and
+// the data crosses the bus in one bulk copy per synchronization instead of one page fault per
+// touched page:
+
+   \code
+   blaze::CUDAMirroredVector<double> x( 1000UL ), y( 1000UL, 1.0 );
+
+   blaze::randomize( x );                          // Initialized on the host mirror
+   y.device() = 2.0 * x.cdevice() + y.cdevice();   // Single upload of x, computed on the device
+   std::cout << y << "\n";                         // Single download of y
+   \endcode
+
+// Computations are expressed on the views returned by device() and cdevice(), which are
+// CUDACustomVector instances over the device memory. The host() and chost() views are
+// CustomVector instances over the host mirror. As for CUDAMirroredArray, the non-const
+// accesses mark their side as modified, and the views stay valid until the other side is
+// accessed, the vector is resized or destroyed.
+*/
+template< typename Type                     // Data type of the vector
+        , bool TF = defaultTransposeFlag >  // Transpose flag
+class CUDAMirroredVector
+{
+ public:
+   //**Type definitions****************************************************************************
+   using ElementType    = Type;                                //!< Type of the vector elements.
+   using ResultType     = CUDADynamicVector<Type,TF>;          //!< Result type of the device views.
+   using Reference      = Type&;                               //!< Reference to a non-constant vector value.
+   using ConstReference = const Type&;                         //!< Reference to a constant vector value.
+
+   //! View on the device memory.
+   using DeviceType = CUDACustomVector<Type,unaligned,unpadded,TF,ResultType>;
+
+   //! Read-only view on the device memory.
+   using ConstDeviceType = CUDACustomVector<const Type,unaligned,unpadded,TF,ResultType>;
+
+   //! View on the host mirror.
+   using HostType = CustomVector<Type,unaligned,unpadded,TF>;
+
+   //! Read-only view on the host mirror.
+   using ConstHostType = CustomVector<const Type,unaligned,unpadded,TF>;
+   //**********************************************************************************************
+
+   //**Constructors********************************************************************************
+   /*!\name Constructors */
+   //@{
+   explicit inline CUDAMirroredVector( size_t n = 0UL );
+   explicit inline CUDAMirroredVector( size_t n, const Type& init );
+
+   template< typename VT >
+   explicit inline CUDAMirroredVector( const DenseVector<VT,TF>& v );
+
+   CUDAMirroredVector( const CUDAMirroredVector& ) = default;
+   CUDAMirroredVector( CUDAMirroredVector&& ) noexcept = default;
+   //@}
+   //**********************************************************************************************
+
+   //**Assignment operators************************************************************************
+   /*!\name Assignment operators */
+   //@{
+   CUDAMirroredVector& operator=( const CUDAMirroredVector& ) = default;
+   CUDAMirroredVector& operator=( CUDAMirroredVector&& ) noexcept = default;
+
+   template< typename VT >
+   inline CUDAMirroredVector& operator=( const DenseVector<VT,TF>& rhs );
+   //@}
+   //**********************************************************************************************
+
+   //**Data access functions***********************************************************************
+   /*!\name Data access functions */
+   //@{
+   inline Reference      operator[]( size_t index );
+   inline ConstReference operator[]( size_t index ) const;
+
+   inline DeviceType      device();
+   inline ConstDeviceType device() const;
+   inline ConstDeviceType cdevice() const;
+
+   inline HostType      host();
+   inline ConstHostType host() const;
+   inline ConstHostType chost() const;
+   //@}
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   /*!\name Utility functions */
+   //@{
+   inline size_t size() const noexcept { return v_.size(); }
+   inline bool   hasHostMirror() const noexcept { return v_.hasHostMirror(); }
+
+   inline void resize( size_t n, bool preserve=true );
+   inline void releaseHostMirror();
+   inline void swap( CUDAMirroredVector& v ) noexcept;
+   //@}
+   //**********************************************************************************************
+
+ private:
+   //**Member variables****************************************************************************
+   CUDAMirroredArray<Type> v_;  //!< The vector elements.
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CONSTRUCTORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Constructor for a vector of size \a n.
+//
+// \param n The size of the vector.
+//
+// The elements are default initialized on the device, no host mirror is allocated.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline CUDAMirroredVector<Type,TF>::CUDAMirroredVector( size_t n )
+   : CUDAMirroredVector( n, Type() )
+{}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Constructor for a homogeneous initialization of all \a n vector elements.
+//
+// \param n The size of the vector.
+// \param init The initial value of the vector elements.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline CUDAMirroredVector<Type,TF>::CUDAMirroredVector( size_t n, const Type& init )
+   : v_( n )  // The vector elements
+{
+   Type* d( v_.device() );
+
+   cuda_transform( d, d + n, d, [=] BLAZE_DEVICE_CALLABLE ( auto const& ) {
+      return init;
+   } );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Conversion constructor from dense vectors.
+//
+// \param v Dense vector to be copied.
+//
+// The vector is evaluated into the device memory.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+template< typename VT >  // Type of the foreign vector
+inline CUDAMirroredVector<Type,TF>::CUDAMirroredVector( const DenseVector<VT,TF>& v )
+   : v_( (~v).size() )  // The vector elements
+{
+   device() = ~v;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  ASSIGNMENT OPERATORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Assignment operator for dense vectors.
+//
+// \param rhs Dense vector to be copied.
+// \return Reference to the assigned vector.
+//
+// The vector is resized to the size of \a rhs and \a rhs is evaluated into the device memory.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+template< typename VT >  // Type of the right-hand side vector
+inline CUDAMirroredVector<Type,TF>& CUDAMirroredVector<Type,TF>::operator=( const DenseVector<VT,TF>& rhs )
+{
+   if( (~rhs).size() != size() ) {
+      CUDAMirroredVector tmp( ~rhs );
+      swap( tmp );
+   }
+   else {
+      device() = ~rhs;
+   }
+
+   return *this;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  DATA ACCESS FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Subscript operator for the direct access to the vector elements.
+//
+// \param index Access index. The index has to be in the range \f$[0..N-1]\f$.
+// \return Reference to the accessed value in the host mirror.
+//
+// The host mirror is synchronized if necessary and marked as modified.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline typename CUDAMirroredVector<Type,TF>::Reference
+   CUDAMirroredVector<Type,TF>::operator[]( size_t index )
+{
+   BLAZE_USER_ASSERT( index < size(), "Invalid vector access index" );
+   return v_.host()[index];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Subscript operator for the direct access to the vector elements.
+//
+// \param index Access index. The index has to be in the range \f$[0..N-1]\f$.
+// \return Reference to the accessed value in the host mirror.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline typename CUDAMirroredVector<Type,TF>::ConstReference
+   CUDAMirroredVector<Type,TF>::operator[]( size_t index ) const
+{
+   BLAZE_USER_ASSERT( index < size(), "Invalid vector access index" );
+   return v_.chost()[index];
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the device memory for modification.
+//
+// \return CUDACustomVector over the device memory.
+//
+// The host mirror, if any, is synchronized first and considered outdated afterwards. The view
+// of an empty vector is an empty CUDACustomVector.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline typename CUDAMirroredVector<Type,TF>::DeviceType CUDAMirroredVector<Type,TF>::device()
+{
+   return size() != 0UL ? DeviceType( v_.device(), size() ) : DeviceType();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the device memory for reading.
+//
+// \return CUDACustomVector over the device memory.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline typename CUDAMirroredVector<Type,TF>::ConstDeviceType CUDAMirroredVector<Type,TF>::device() const
+{
+   return cdevice();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the device memory for reading.
+//
+// \return CUDACustomVector over the device memory.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline typename CUDAMirroredVector<Type,TF>::ConstDeviceType CUDAMirroredVector<Type,TF>::cdevice() const
+{
+   return size() != 0UL ? ConstDeviceType( v_.cdevice(), size() ) : ConstDeviceType();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the host mirror for modification.
+//
+// \return CustomVector over the host mirror.
+// \exception std::bad_alloc Allocation of the host mirror failed.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline typename CUDAMirroredVector<Type,TF>::HostType CUDAMirroredVector<Type,TF>::host()
+{
+   return HostType( v_.host(), size() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the host mirror for reading.
+//
+// \return CustomVector over the host mirror.
+// \exception std::bad_alloc Allocation of the host mirror failed.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline typename CUDAMirroredVector<Type,TF>::ConstHostType CUDAMirroredVector<Type,TF>::host() const
+{
+   return chost();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a view on the host mirror for reading.
+//
+// \return CustomVector over the host mirror.
+// \exception std::bad_alloc Allocation of the host mirror failed.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline typename CUDAMirroredVector<Type,TF>::ConstHostType CUDAMirroredVector<Type,TF>::chost() const
+{
+   return ConstHostType( v_.chost(), size() );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Changing the size of the vector.
+//
+// \param n The new size of the vector.
+// \param preserve \a true if the old values of the vector should be preserved, \a false if not.
+// \return void
+//
+// The old values are copied on the device and the host mirror is released. New elements are
+// left uninitialized.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline void CUDAMirroredVector<Type,TF>::resize( size_t n, bool preserve )
+{
+   v_.resize( n, preserve );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Releases the host mirror after synchronizing the device memory.
+//
+// \return void
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline void CUDAMirroredVector<Type,TF>::releaseHostMirror()
+{
+   v_.releaseHostMirror();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Swapping the contents of two vectors.
+//
+// \param v The vector to be swapped.
+// \return void
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline void CUDAMirroredVector<Type,TF>::swap( CUDAMirroredVector& v ) noexcept
+{
+   v_.swap( v.v_ );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CUDAMIRROREDVECTOR OPERATORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Swapping the contents of two vectors.
+// \ingroup cuda_mirrored_vector
+//
+// \param a The first vector to be swapped.
+// \param b The second vector to be swapped.
+// \return void
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline void swap( CUDAMirroredVector<Type,TF>& a, CUDAMirroredVector<Type,TF>& b ) noexcept
+{
+   a.swap( b );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Global output operator for mirrored vectors.
+// \ingroup cuda_mirrored_vector
+//
+// \param os Reference to the output stream.
+// \param v Reference to a constant vector object.
+// \return Reference to the output stream.
+//
+// The vector is printed from its host mirror.
+*/
+template< typename Type  // Data type of the vector
+        , bool TF >      // Transpose flag
+inline std::ostream& operator<<( std::ostream& os, const CUDAMirroredVector<Type,TF>& v )
+{
+   return os << v.chost();
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
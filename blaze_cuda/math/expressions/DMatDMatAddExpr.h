@@ -43,6 +43,7 @@
 #include <blaze/math/expressions/DMatDMatAddExpr.h>
 #include <blaze/math/traits/DeclSymTrait.h>
 
+#include <blaze_cuda/math/cuda/ExpressionFusion.h>
 #include <blaze_cuda/math/typetraits/RequiresCUDAEvaluation.h>
 
 
@@ -81,13 +82,8 @@ inline auto cudaAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatAddExpr<MT1,MT2,
    else if( !IsOperation_v<MT2> && isSame( ~lhs, rhs.rightOperand() ) ) {
       cudaAddAssign( ~lhs, rhs.leftOperand()  );
    }
-   else if( !RequiresCUDAEvaluation_v<MT2> ) {
-      cudaAssign   ( ~lhs, rhs.rightOperand() );
-      cudaAddAssign( ~lhs, rhs.leftOperand()  );
-   }
    else {
-      cudaAssign   ( ~lhs, rhs.leftOperand()  );
-      cudaAddAssign( ~lhs, rhs.rightOperand() );
+      cudaFusedAssign( ~lhs, rhs );
    }
 }
 /*! \endcond */
@@ -120,14 +116,7 @@ inline auto cudaAddAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatAddExpr<MT1,M
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   if( !RequiresCUDAEvaluation_v<MT2> ) {
-      cudaAddAssign( ~lhs, rhs.rightOperand() );
-      cudaAddAssign( ~lhs, rhs.leftOperand() );
-   }
-   else {
-      cudaAddAssign( ~lhs, rhs.leftOperand() );
-      cudaAddAssign( ~lhs, rhs.rightOperand() );
-   }
+   cudaFusedAssign( ~lhs, rhs, Add() );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -159,14 +148,7 @@ inline auto cudaSubAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatAddExpr<MT1,M
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   if( !RequiresCUDAEvaluation_v<MT2> ) {
-      cudaSubAssign( ~lhs, rhs.rightOperand() );
-      cudaSubAssign( ~lhs, rhs.leftOperand() );
-   }
-   else {
-      cudaSubAssign( ~lhs, rhs.leftOperand() );
-      cudaSubAssign( ~lhs, rhs.rightOperand() );
-   }
+   cudaFusedAssign( ~lhs, rhs, Sub() );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -195,18 +177,10 @@ inline auto cudaSchurAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatAddExpr<MT1
 {
    BLAZE_FUNCTION_TRACE;
 
-   using ExpressionType = DMatDMatAddExpr<MT1,MT2,SO>;
-   using ResultType = typename ExpressionType::ResultType;
-
-   BLAZE_CONSTRAINT_MUST_BE_DENSE_MATRIX_TYPE( ResultType );
-   BLAZE_CONSTRAINT_MUST_BE_MATRIX_WITH_STORAGE_ORDER( ResultType, SO );
-   BLAZE_CONSTRAINT_MUST_NOT_REQUIRE_EVALUATION( ResultType );
-
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   const ResultType tmp( serial( rhs ) );
-   cudaSchurAssign( ~lhs, tmp );
+   cudaFusedAssign( ~lhs, rhs, Mult() );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -42,6 +42,7 @@
 
 #include <blaze/math/expressions/DMatDMatMapExpr.h>
 #include <blaze/math/traits/DeclSymTrait.h>
+#include <blaze_cuda/math/cuda/ExpressionFusion.h>
 #include <blaze_cuda/math/typetraits/RequiresCUDAEvaluation.h>
 
 namespace blaze {
@@ -74,19 +75,7 @@ inline auto cudaAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatMapExpr<MT1,MT2,
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   using ExpressionType = DMatDMatMapExpr<MT1,MT2,OP,SO>;
-
-   typename ExpressionType::LT A( serial( rhs.lhs_ ) );  // Evaluation of the left-hand side dense matrix operand
-   typename ExpressionType::RT B( serial( rhs.rhs_ ) );  // Evaluation of the right-hand side dense matrix operand
-
-   BLAZE_INTERNAL_ASSERT( A.rows()    == rhs.lhs_.rows()   , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( A.columns() == rhs.lhs_.columns(), "Invalid number of columns" );
-   BLAZE_INTERNAL_ASSERT( B.rows()    == rhs.rhs_.rows()   , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( B.columns() == rhs.rhs_.columns(), "Invalid number of columns" );
-   BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).rows()     , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( B.columns() == (~lhs).columns()  , "Invalid number of columns" );
-
-   cudaAssign( ~lhs, map( A, B, rhs.op_ ) );
+   cudaFusedAssign( ~lhs, rhs );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -114,24 +103,12 @@ template< typename MT  // Type of the target dense matrix
 inline auto cudaAddAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatMapExpr<MT1,MT2,OP,SO>& rhs )
     -> EnableIf_t< RequiresCUDAEvaluation_v<MT1> || RequiresCUDAEvaluation_v<MT2> >
 {
-    BLAZE_FUNCTION_TRACE;
+   BLAZE_FUNCTION_TRACE;
 
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   using ExpressionType = DMatDMatMapExpr<MT1,MT2,OP,SO>;
-
-   typename ExpressionType::LT A( serial( rhs.lhs_ ) );  // Evaluation of the left-hand side dense matrix operand
-   typename ExpressionType::RT B( serial( rhs.rhs_ ) );  // Evaluation of the right-hand side dense matrix operand
-
-   BLAZE_INTERNAL_ASSERT( A.rows()    == rhs.lhs_.rows()   , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( A.columns() == rhs.lhs_.columns(), "Invalid number of columns" );
-   BLAZE_INTERNAL_ASSERT( B.rows()    == rhs.rhs_.rows()   , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( B.columns() == rhs.rhs_.columns(), "Invalid number of columns" );
-   BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).rows()     , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( B.columns() == (~lhs).columns()  , "Invalid number of columns" );
-
-   cudaAddAssign( ~lhs, map( A, B, rhs.op_ ) );
+   cudaFusedAssign( ~lhs, rhs, Add() );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -164,19 +141,7 @@ inline auto cudaSubAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatMapExpr<MT1,M
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   using ExpressionType = DMatDMatMapExpr<MT1,MT2,OP,SO>;
-
-   typename ExpressionType::LT A( serial( rhs.lhs_ ) );  // Evaluation of the left-hand side dense matrix operand
-   typename ExpressionType::RT B( serial( rhs.rhs_ ) );  // Evaluation of the right-hand side dense matrix operand
-
-   BLAZE_INTERNAL_ASSERT( A.rows()    == rhs.lhs_.rows()   , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( A.columns() == rhs.lhs_.columns(), "Invalid number of columns" );
-   BLAZE_INTERNAL_ASSERT( B.rows()    == rhs.rhs_.rows()   , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( B.columns() == rhs.rhs_.columns(), "Invalid number of columns" );
-   BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).rows()     , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( B.columns() == (~lhs).columns()  , "Invalid number of columns" );
-
-   cudaSubAssign( ~lhs, map( A, B, rhs.op_ ) );
+   cudaFusedAssign( ~lhs, rhs, Sub() );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -209,19 +174,7 @@ inline auto cudaSchurAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatMapExpr<MT1
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   using ExpressionType = DMatDMatMapExpr<MT1,MT2,OP,SO>;
-
-   typename ExpressionType::LT A( serial( rhs.lhs_ ) );  // Evaluation of the left-hand side dense matrix operand
-   typename ExpressionType::RT B( serial( rhs.rhs_ ) );  // Evaluation of the right-hand side dense matrix operand
-
-   BLAZE_INTERNAL_ASSERT( A.rows()    == rhs.lhs_.rows()   , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( A.columns() == rhs.lhs_.columns(), "Invalid number of columns" );
-   BLAZE_INTERNAL_ASSERT( B.rows()    == rhs.rhs_.rows()   , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( B.columns() == rhs.rhs_.columns(), "Invalid number of columns" );
-   BLAZE_INTERNAL_ASSERT( A.rows()    == (~lhs).rows()     , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( B.columns() == (~lhs).columns()  , "Invalid number of columns" );
-
-   cudaSchurAssign( ~lhs, map( A, B, rhs.op_ ) );
+   cudaFusedAssign( ~lhs, rhs, Mult() );
 }
 /*! \endcond */
 //**********************************************************************************************
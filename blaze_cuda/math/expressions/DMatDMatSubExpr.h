@@ -43,6 +43,7 @@
 #include <blaze/math/expressions/DMatDMatSubExpr.h>
 #include <blaze/math/traits/DeclSymTrait.h>
 
+#include <blaze_cuda/math/cuda/ExpressionFusion.h>
 #include <blaze_cuda/math/typetraits/RequiresCUDAEvaluation.h>
 
 
@@ -72,7 +73,10 @@ inline auto cudaAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatSubExpr<MT1,MT2,
 {
    BLAZE_FUNCTION_TRACE;
 
-   // TODO
+   BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
+
+   cudaFusedAssign( ~lhs, rhs );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -99,9 +103,12 @@ template< typename MT  // Type of the target dense matrix
 inline auto cudaAddAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatSubExpr<MT1,MT2,SO>& rhs )
     -> EnableIf_t< RequiresCUDAEvaluation_v<MT1> || RequiresCUDAEvaluation_v<MT2> >
 {
-    BLAZE_FUNCTION_TRACE;
+   BLAZE_FUNCTION_TRACE;
+
+   BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-    // TODO
+   cudaFusedAssign( ~lhs, rhs, Add() );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -130,7 +137,10 @@ inline auto cudaSubAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatSubExpr<MT1,M
 {
    BLAZE_FUNCTION_TRACE;
 
-   // TODO
+   BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
+
+   cudaFusedAssign( ~lhs, rhs, Sub() );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -159,7 +169,10 @@ inline auto cudaSchurAssign( DenseMatrix<MT,SO2>& lhs, const DMatDMatSubExpr<MT1
 {
    BLAZE_FUNCTION_TRACE;
 
-   // TODO
+   BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
+
+   cudaFusedAssign( ~lhs, rhs, Mult() );
 }
 /*! \endcond */
 //**********************************************************************************************
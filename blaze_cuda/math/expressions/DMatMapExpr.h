@@ -43,6 +43,7 @@
 #include <blaze/math/expressions/DMatMapExpr.h>
 #include <blaze/math/traits/DeclSymTrait.h>
 
+#include <blaze_cuda/math/cuda/ExpressionFusion.h>
 #include <blaze_cuda/math/typetraits/RequiresCUDAEvaluation.h>
 
 
@@ -75,8 +76,7 @@ inline auto cudaAssign( DenseMatrix<MT,SO2>& lhs, const DMatMapExpr<MT1,OP,SO>&
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   assign( ~lhs, rhs.operand() );
-   assign( ~lhs, map( ~lhs, rhs.operation() ) );
+   cudaFusedAssign( ~lhs, rhs );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -108,14 +108,7 @@ inline auto cudaAddAssign( DenseMatrix<MT,SO2>& lhs, const DMatMapExpr<MT1,OP,SO
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   if( !RequiresCUDAEvaluation_v<MT1> ) {
-      cudaAddAssign( ~lhs, rhs.rightOperand() );
-      cudaAddAssign( ~lhs, rhs.leftOperand() );
-   }
-   else {
-      cudaAddAssign( ~lhs, rhs.leftOperand() );
-      cudaAddAssign( ~lhs, rhs.rightOperand() );
-   }
+   cudaFusedAssign( ~lhs, rhs, Add() );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -147,14 +140,7 @@ inline auto cudaSubAssign( DenseMatrix<MT,SO2>& lhs, const DMatMapExpr<MT1,OP,SO
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   if( !RequiresCUDAEvaluation_v<MT1> ) {
-      cudaSubAssign( ~lhs, rhs.rightOperand() );
-      cudaSubAssign( ~lhs, rhs.leftOperand() );
-   }
-   else {
-      cudaSubAssign( ~lhs, rhs.leftOperand() );
-      cudaSubAssign( ~lhs, rhs.rightOperand() );
-   }
+   cudaFusedAssign( ~lhs, rhs, Sub() );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -183,18 +169,10 @@ inline auto cudaSchurAssign( DenseMatrix<MT,SO2>& lhs, const DMatMapExpr<MT1,OP,
 {
    BLAZE_FUNCTION_TRACE;
 
-   using ExpressionType = DMatMapExpr<MT1,OP,SO>;
-   using ResultType = typename ExpressionType::ResultType;
-
-   BLAZE_CONSTRAINT_MUST_BE_DENSE_MATRIX_TYPE( ResultType );
-   BLAZE_CONSTRAINT_MUST_BE_MATRIX_WITH_STORAGE_ORDER( ResultType, SO );
-   BLAZE_CONSTRAINT_MUST_NOT_REQUIRE_EVALUATION( ResultType );
-
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   const ResultType tmp( serial( rhs ) );
-   cudaSchurAssign( ~lhs, tmp );
+   cudaFusedAssign( ~lhs, rhs, Mult() );
 }
 /*! \endcond */
 //**********************************************************************************************
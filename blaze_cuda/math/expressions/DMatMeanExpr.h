@@ -0,0 +1,223 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/expressions/DMatMeanExpr.h
+//  \brief Header file for the dense matrix mean expression
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_EXPRESSIONS_DMATMEANEXPR_H_
+#define _BLAZE_CUDA_MATH_EXPRESSIONS_DMATMEANEXPR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/math/expressions/DMatMeanExpr.h>
+#include <blaze/math/ReductionFlag.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/math/TransposeFlag.h>
+#include <blaze/math/typetraits/HasConstDataAccess.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/math/typetraits/IsDenseMatrix.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/Exception.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/typetraits/IsFloatingPoint.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/algorithms/CUDAWelford.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  WELFORD REDUCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Single pass Welford reduction of a CUDA-assignable dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The dense matrix to be reduced.
+// \return The Welford state (size, mean, sum of squared deviations) of \a dm.
+//
+// The whole matrix, padding excluded, is reduced by a single kernel launch. Operands without
+// data access are evaluated beforehand.
+*/
+template< typename MT  // Type of the dense matrix
+        , bool SO >    // Storage order of the dense matrix
+inline WelfordState< ElementType_t<MT> > cudaWelford( const DenseMatrix<MT,SO>& dm )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<MT> ) {
+      const ResultType_t<MT> tmp( ~dm );
+      return cudaWelford( tmp );
+   }
+   else {
+      const size_t lines ( SO == rowMajor ? (~dm).rows()    : (~dm).columns() );
+      const size_t length( SO == rowMajor ? (~dm).columns() : (~dm).rows()    );
+
+      return cuda_welford_2d< ElementType_t<MT> >( lines, length, (~dm).data(), (~dm).spacing() );
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Rowwise or columnwise Welford reduction of a CUDA-assignable dense matrix.
+// \ingroup dense_matrix
+//
+// \param lhs The target left-hand side dense vector.
+// \param dm The dense matrix to be reduced.
+// \param f The statistic (WelfordMean, WelfordVariance or WelfordStdDev) to be stored.
+// \return void
+//
+// As for the partial reductions of DMatReduceExpr, reductions along the storage order of \a dm
+// reduce contiguous segments and the other orientation is reduced with coalesced accesses. The
+// final states are turned into \a f by the kernel that computes them, so every element is read
+// once and no intermediate vector is materialized.
+*/
+template< ReductionFlag RF  // Reduction flag
+        , typename VT       // Type of the target dense vector
+        , bool TF           // Transpose flag of the target dense vector
+        , typename MT       // Type of the dense matrix
+        , bool SO           // Storage order of the dense matrix
+        , typename F >      // Type of the statistic
+inline void cudaWelfordAssign( DenseVector<VT,TF>& lhs, const DenseMatrix<MT,SO>& dm, F f )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<MT> ) {
+      const ResultType_t<MT> tmp( ~dm );
+      cudaWelfordAssign<RF>( ~lhs, tmp, f );
+   }
+   else {
+      using ET = ElementType_t<MT>;
+
+      const size_t lines ( SO == rowMajor ? (~dm).rows()    : (~dm).columns() );
+      const size_t length( SO == rowMajor ? (~dm).columns() : (~dm).rows()    );
+
+      BLAZE_INTERNAL_ASSERT( (~lhs).size() == ( RF == rowwise ? (~dm).rows() : (~dm).columns() )
+                           , "Invalid vector size" );
+
+      if( ( RF == rowwise ) == ( SO == rowMajor ) ) {
+         cuda_welford_segments<ET>( lines, length, (~dm).data(), (~dm).spacing(), (~lhs).begin(), f );
+      }
+      else {
+         cuda_welford_strided<ET>( lines, length, (~dm).data(), (~dm).spacing(), (~lhs).begin(), f );
+      }
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  GLOBAL FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Computes the mean of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the mean computation.
+// \return The mean of the given matrix.
+// \exception std::invalid_argument Invalid input matrix.
+//
+// The mean is computed by a single Welford reduction over all elements on the device. In case
+// the size of the given matrix is 0, a \a std::invalid_argument is thrown.
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto mean( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ElementType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if( dm.rows() == 0UL || dm.columns() == 0UL ) {
+      BLAZE_THROW_INVALID_ARGUMENT( "Invalid input matrix" );
+   }
+
+   return cudaWelford( dm ).mean;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the row-/columnwise mean of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the mean computation.
+// \return The row-/columnwise means of the given matrix.
+// \exception std::invalid_argument Invalid input matrix.
+//
+// \c mean<rowwise>() returns a column vector with the mean of each row, \c mean<columnwise>()
+// a row vector with the mean of each column. In case the rows (resp. columns) of the given
+// matrix are empty, a \a std::invalid_argument is thrown.
+*/
+template< ReductionFlag RF  // Reduction flag
+        , typename MT >     // Type of the dense matrix
+inline auto mean( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >
+                , CUDADynamicVector< ElementType_t<MT>, RF == rowwise ? columnVector : rowVector > >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if( ( RF == rowwise ? dm.columns() : dm.rows() ) == 0UL ) {
+      BLAZE_THROW_INVALID_ARGUMENT( "Invalid input matrix" );
+   }
+
+   CUDADynamicVector< ElementType_t<MT>, RF == rowwise ? columnVector : rowVector >
+      res( RF == rowwise ? dm.rows() : dm.columns() );
+   cudaWelfordAssign<RF>( res, dm, WelfordMean() );
+
+   return res;
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -0,0 +1,509 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/expressions/DMatNormExpr.h
+//  \brief Header file for the dense matrix norm expression
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_EXPRESSIONS_DMATNORMEXPR_H_
+#define _BLAZE_CUDA_MATH_EXPRESSIONS_DMATNORMEXPR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/expressions/DMatNormExpr.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/math/typetraits/HasConstDataAccess.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/math/typetraits/IsDenseMatrix.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/StaticAssert.h>
+#include <blaze/util/typetraits/IsFloatingPoint.h>
+#include <blaze/util/typetraits/IsNumeric.h>
+
+#include <blaze_cuda/util/algorithms/CUDANorm.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  GLOBAL FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Computes a norm of a CUDA-assignable dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param norm The norm policy.
+// \return The norm of the given matrix.
+//
+// The whole matrix, padding excluded, is reduced by a single kernel launch. Operands without
+// data access are evaluated beforehand.
+*/
+template< typename MT      // Type of the dense matrix
+        , bool SO          // Storage order of the dense matrix
+        , typename Norm >  // Type of the norm policy
+inline auto cudaNorm( const DenseMatrix<MT,SO>& dm, Norm norm )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<MT> ) {
+      const ResultType_t<MT> tmp( ~dm );
+      return cudaNorm( tmp, norm );
+   }
+   else {
+      const size_t lines ( SO == rowMajor ? (~dm).rows()    : (~dm).columns() );
+      const size_t length( SO == rowMajor ? (~dm).columns() : (~dm).rows()    );
+
+      return cuda_norm_2d( lines, length, (~dm).data(), (~dm).spacing(), norm );
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Computes a norm of a CUDA-assignable dense matrix into a device scalar.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param norm The norm policy.
+// \param result The device scalar receiving the norm.
+// \return void
+*/
+template< typename MT      // Type of the dense matrix
+        , bool SO          // Storage order of the dense matrix
+        , typename Norm >  // Type of the norm policy
+inline void cudaNorm( const DenseMatrix<MT,SO>& dm, Norm norm, ElementType_t<MT>* result )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<MT> ) {
+      const ResultType_t<MT> tmp( ~dm );
+      cudaNorm( tmp, norm, result );
+   }
+   else {
+      const size_t lines ( SO == rowMajor ? (~dm).rows()    : (~dm).columns() );
+      const size_t length( SO == rowMajor ? (~dm).columns() : (~dm).rows()    );
+
+      cuda_norm_2d_into( lines, length, (~dm).data(), (~dm).spacing(), norm, result );
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L2 norm of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \return The L2 norm of the given dense matrix.
+//
+// The norm is computed by a single fused reduction on the device.
+//
+// The squares are scaled by the largest absolute value, as in the reference BLAS nrm2, so the
+// result neither overflows nor underflows unless the norm itself does.
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto norm( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ElementType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dm, CUDAL2Norm< ElementType_t<MT> >() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L2 norm of a CUDA-assignable floating point dense matrix into a device
+// scalar.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param result The device (or managed) scalar receiving the L2 norm.
+// \return void
+//
+// The norm is stored by the reduction kernel and the function returns without synchronizing,
+// e.g. to check the convergence of an iterative solver every few iterations only. \a result
+// must not be read on the host before the work submitted to the stream of the current
+// execution context is done.
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto norm( const MT& dm, ElementType_t<MT>* result )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dm, CUDAL2Norm< ElementType_t<MT> >(), result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the squared L2 norm of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \return The squared L2 norm of the given dense matrix.
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto sqrNorm( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ElementType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dm, CUDASqrNorm< ElementType_t<MT> >() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the squared L2 norm of a CUDA-assignable floating point dense matrix
+// into a device scalar.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param result The device (or managed) scalar receiving the squared L2 norm.
+// \return void
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto sqrNorm( const MT& dm, ElementType_t<MT>* result )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dm, CUDASqrNorm< ElementType_t<MT> >(), result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L1 norm of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \return The L1 norm of the given dense matrix.
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto l1Norm( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ElementType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dm, CUDAL1Norm< ElementType_t<MT> >() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L1 norm of a CUDA-assignable floating point dense matrix into a device
+// scalar.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param result The device (or managed) scalar receiving the L1 norm.
+// \return void
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto l1Norm( const MT& dm, ElementType_t<MT>* result )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dm, CUDAL1Norm< ElementType_t<MT> >(), result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L2 norm of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \return The L2 norm of the given dense matrix.
+//
+// This function is equivalent to norm().
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto l2Norm( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ElementType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dm, CUDAL2Norm< ElementType_t<MT> >() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L2 norm of a CUDA-assignable floating point dense matrix into a device
+// scalar.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param result The device (or managed) scalar receiving the L2 norm.
+// \return void
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto l2Norm( const MT& dm, ElementType_t<MT>* result )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dm, CUDAL2Norm< ElementType_t<MT> >(), result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L3 norm of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \return The L3 norm of the given dense matrix.
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto l3Norm( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ElementType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dm, CUDALpNorm< ElementType_t<MT> >{ ElementType_t<MT>( 3 ) } );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L3 norm of a CUDA-assignable floating point dense matrix into a device
+// scalar.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param result The device (or managed) scalar receiving the L3 norm.
+// \return void
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto l3Norm( const MT& dm, ElementType_t<MT>* result )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dm, CUDALpNorm< ElementType_t<MT> >{ ElementType_t<MT>( 3 ) }, result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L4 norm of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \return The L4 norm of the given dense matrix.
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto l4Norm( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ElementType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dm, CUDALpNorm< ElementType_t<MT> >{ ElementType_t<MT>( 4 ) } );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L4 norm of a CUDA-assignable floating point dense matrix into a device
+// scalar.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param result The device (or managed) scalar receiving the L4 norm.
+// \return void
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto l4Norm( const MT& dm, ElementType_t<MT>* result )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dm, CUDALpNorm< ElementType_t<MT> >{ ElementType_t<MT>( 4 ) }, result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the maximum norm of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \return The maximum norm of the given dense matrix.
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto maxNorm( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ElementType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dm, CUDAMaxNorm< ElementType_t<MT> >() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the maximum norm of a CUDA-assignable floating point dense matrix into a device
+// scalar.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param result The device (or managed) scalar receiving the maximum norm.
+// \return void
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto maxNorm( const MT& dm, ElementType_t<MT>* result )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dm, CUDAMaxNorm< ElementType_t<MT> >(), result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the Lp norm of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param p The norm parameter (p > 0).
+// \return The Lp norm of the given dense matrix.
+*/
+template< typename MT    // Type of the dense matrix
+        , typename ST >  // Type of the norm parameter
+inline auto lpNorm( const MT& dm, ST p )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> > && IsNumeric_v<ST>, ElementType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   BLAZE_USER_ASSERT( p > ST( 0 ), "Invalid p for Lp norm detected" );
+   return cudaNorm( dm, CUDALpNorm< ElementType_t<MT> >{ ElementType_t<MT>( p ) } );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the Lp norm of a CUDA-assignable floating point dense matrix into a device
+// scalar.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param p The norm parameter (p > 0).
+// \param result The device (or managed) scalar receiving the Lp norm.
+// \return void
+*/
+template< typename MT    // Type of the dense matrix
+        , typename ST >  // Type of the norm parameter
+inline auto lpNorm( const MT& dm, ST p, ElementType_t<MT>* result )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> > && IsNumeric_v<ST> >
+{
+   BLAZE_FUNCTION_TRACE;
+   BLAZE_USER_ASSERT( p > ST( 0 ), "Invalid p for Lp norm detected" );
+   cudaNorm( dm, CUDALpNorm< ElementType_t<MT> >{ ElementType_t<MT>( p ) }, result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the Lp norm of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \return The Lp norm of the given dense matrix.
+//
+// The L1 and L2 norms use the dedicated reductions of l1Norm() and l2Norm().
+*/
+template< size_t P       // Compile time norm parameter
+        , typename MT >  // Type of the dense matrix
+inline auto lpNorm( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ElementType_t<MT> >
+{
+   BLAZE_STATIC_ASSERT_MSG( P > 0UL, "Invalid norm parameter detected" );
+
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( P == 1UL ) return l1Norm( dm );
+   else if constexpr( P == 2UL ) return l2Norm( dm );
+   else return cudaNorm( dm, CUDALpNorm< ElementType_t<MT> >{ ElementType_t<MT>( P ) } );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the Lp norm of a CUDA-assignable floating point dense matrix into a device
+// scalar.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the norm computation.
+// \param result The device (or managed) scalar receiving the Lp norm.
+// \return void
+*/
+template< size_t P       // Compile time norm parameter
+        , typename MT >  // Type of the dense matrix
+inline auto lpNorm( const MT& dm, ElementType_t<MT>* result )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> > >
+{
+   BLAZE_STATIC_ASSERT_MSG( P > 0UL, "Invalid norm parameter detected" );
+
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( P == 1UL ) l1Norm( dm, result );
+   else if constexpr( P == 2UL ) l2Norm( dm, result );
+   else cudaNorm( dm, CUDALpNorm< ElementType_t<MT> >{ ElementType_t<MT>( P ) }, result );
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
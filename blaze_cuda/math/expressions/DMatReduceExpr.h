@@ -0,0 +1,257 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/expressions/DMatReduceExpr.h
+//  \brief Header file for the dense matrix reduction expression
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_EXPRESSIONS_DMATREDUCEEXPR_H_
+#define _BLAZE_CUDA_MATH_EXPRESSIONS_DMATREDUCEEXPR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <limits>
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/math/expressions/DMatReduceExpr.h>
+#include <blaze/math/functors/Add.h>
+#include <blaze/math/functors/Max.h>
+#include <blaze/math/functors/Min.h>
+#include <blaze/math/functors/Mult.h>
+#include <blaze/math/ReductionFlag.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/math/typetraits/HasConstDataAccess.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/math/typetraits/IsDenseMatrix.h>
+#include <blaze/math/typetraits/IsRowMajorMatrix.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/FunctionTrace.h>
+
+#include <blaze_cuda/util/algorithms/CUDASegmentedReduce.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  PARTIAL REDUCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief CUDA-based partial reduction of a dense matrix into a dense vector.
+// \ingroup dense_matrix
+//
+// \param lhs The target left-hand side dense vector.
+// \param dm The dense matrix to be reduced.
+// \param op The reduction operation.
+// \return void
+//
+// Reductions along the storage order of \a dm reduce contiguous segments with one warp (or one
+// block, for long segments) per segment, the other orientation is reduced with coalesced
+// accesses, one thread per result. Operands without data access are evaluated beforehand.
+*/
+template< ReductionFlag RF  // Reduction flag
+        , typename VT       // Type of the target dense vector
+        , bool TF           // Transpose flag of the target dense vector
+        , typename MT       // Type of the dense matrix
+        , bool SO           // Storage order of the dense matrix
+        , typename OP >     // Type of the reduction operation
+inline void cudaReduceAssign( DenseVector<VT,TF>& lhs, const DenseMatrix<MT,SO>& dm, OP op )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<MT> ) {
+      const ResultType_t<MT> tmp( ~dm );
+      cudaReduceAssign<RF>( ~lhs, tmp, op );
+   }
+   else {
+      const size_t lines ( SO == rowMajor ? (~dm).rows()    : (~dm).columns() );
+      const size_t length( SO == rowMajor ? (~dm).columns() : (~dm).rows()    );
+
+      BLAZE_INTERNAL_ASSERT( (~lhs).size() == ( RF == rowwise ? (~dm).rows() : (~dm).columns() )
+                           , "Invalid vector size" );
+
+      if( (~lhs).size() == 0UL )
+         return;
+
+      // Reductions of empty rows/columns yield default values, as in Blaze
+      if( lines == 0UL || length == 0UL ) {
+         reset( ~lhs );
+         return;
+      }
+
+      if( ( RF == rowwise ) == ( SO == rowMajor ) ) {
+         cuda_reduce_segments( lines, length, (~dm).data(), (~dm).spacing(), (~lhs).begin(), op );
+      }
+      else {
+         cuda_reduce_strided( lines, length, (~dm).data(), (~dm).spacing(), (~lhs).begin(), op );
+      }
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Assignment of a dense matrix partial reduction to a dense vector.
+// \ingroup dense_matrix
+//
+// \param lhs The target left-hand side dense vector.
+// \param rhs The right-hand side reduction expression to be assigned.
+// \return void
+*/
+template< typename VT         // Type of the target dense vector
+        , bool TF             // Transpose flag of the target dense vector
+        , typename MT         // Type of the dense matrix
+        , typename OP         // Type of the reduction operation
+        , ReductionFlag RF >  // Reduction flag
+inline void cudaAssign( DenseVector<VT,TF>& lhs, const DMatReduceExpr<MT,OP,RF>& rhs )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   BLAZE_INTERNAL_ASSERT( (~lhs).size() == rhs.size(), "Invalid vector sizes" );
+
+   cudaReduceAssign<RF>( ~lhs, rhs.operand(), rhs.operation() );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief SMP assignment of a dense matrix partial reduction to a CUDA-assignable dense vector.
+// \ingroup dense_matrix
+//
+// \param lhs The target left-hand side dense vector.
+// \param rhs The right-hand side reduction expression to be assigned.
+// \return void
+//
+// The rows (resp. columns) of the matrix are reduced on the device, by a segmented reduction
+// along the contiguous lines or by a strided one across them, directly into the target vector.
+*/
+template< typename VT         // Type of the target dense vector
+        , bool TF             // Transpose flag of the target dense vector
+        , typename MT         // Type of the dense matrix
+        , typename OP         // Type of the reduction operation
+        , ReductionFlag RF >  // Reduction flag
+inline auto smpAssign( DenseVector<VT,TF>& lhs, const DMatReduceExpr<MT,OP,RF>& rhs )
+   -> EnableIf_t< IsCUDAAssignable_v<VT> && IsCUDAAssignable_v<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   cudaAssign( ~lhs, rhs );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  TOTAL REDUCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Identity elements of the reduction operations supported by the CUDA total reduction.
+// \ingroup dense_matrix
+//
+// The single launch kernel of cuda_reduce() seeds every thread with an identity of the
+// operation. Total reductions with other operations are left to Blaze.
+*/
+template< typename T >
+constexpr T cudaReductionIdentity( Add ) { return T(0); }
+
+template< typename T >
+constexpr T cudaReductionIdentity( Mult ) { return T(1); }
+
+template< typename T >
+constexpr T cudaReductionIdentity( Min ) { return std::numeric_limits<T>::max(); }
+
+template< typename T >
+constexpr T cudaReductionIdentity( Max ) { return std::numeric_limits<T>::lowest(); }
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief CUDA-based total reduction of a CUDA-assignable dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The dense matrix to be reduced.
+// \param op The reduction operation.
+// \return The result of the reduction.
+//
+// The whole matrix, padding excluded, is reduced by a single kernel launch. This serves sum(),
+// prod(), min() and max() of any CUDA-assignable matrix or view.
+*/
+template< typename MT    // Type of the dense matrix
+        , typename OP >  // Type of the reduction operation
+inline auto dmatreduce( const MT& dm, OP op )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT>
+                , decltype( cudaReductionIdentity< ElementType_t<MT> >( op ) ) >
+{
+   using ET = ElementType_t<MT>;
+
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<MT> ) {
+      const ResultType_t<MT> tmp( dm );
+      return dmatreduce( tmp, op );
+   }
+   else {
+      const size_t lines ( IsRowMajorMatrix_v<MT> ? dm.rows()    : dm.columns() );
+      const size_t length( IsRowMajorMatrix_v<MT> ? dm.columns() : dm.rows()    );
+
+      if( lines == 0UL || length == 0UL )
+         return ET{};
+
+      return cuda_reduce_2d( lines, length, dm.data(), dm.spacing()
+                           , cudaReductionIdentity<ET>( op ), op );
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
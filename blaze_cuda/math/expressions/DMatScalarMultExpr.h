@@ -0,0 +1,180 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/expressions/DMatScalarMultExpr.h
+//  \brief Header file for the dense matrix/scalar multiplication expression
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_EXPRESSIONS_DMATSCALARMULTEXPR_H_
+#define _BLAZE_CUDA_MATH_EXPRESSIONS_DMATSCALARMULTEXPR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/expressions/DMatScalarMultExpr.h>
+#include <blaze/util/EnableIf.h>
+
+#include <blaze_cuda/math/cublas/gemm.h>
+#include <blaze_cuda/math/cuda/ExpressionFusion.h>
+#include <blaze_cuda/math/typetraits/RequiresCUDAEvaluation.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+namespace blaze {
+
+//**Assignment to dense matrices****************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Assignment of a dense matrix-scalar multiplication to a dense matrix.
+// \ingroup dense_matrix
+//
+// \param lhs The target left-hand side dense matrix.
+// \param rhs The right-hand side scaling expression to be assigned.
+// \return auto
+//
+// This function implements the performance optimized assignment of a dense matrix-scalar
+// multiplication expression to a dense matrix. Due to the explicit application of the SFINAE
+// principle, this function can only be selected by the compiler in case the operand requires
+// an intermediate evaluation. A scaled matrix product is computed by a single GEMM, the scalar
+// being its alpha factor.
+*/
+template< typename MT  // Type of the target dense matrix
+        , bool SO2     // Storage order of the target dense matrix
+        , typename MT1
+        , typename ST
+        , bool SO >
+inline auto cudaAssign( DenseMatrix<MT,SO2>& lhs, const DMatScalarMultExpr<MT1,ST,SO>& rhs )
+   -> EnableIf_t< RequiresCUDAEvaluation_v<MT1> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
+
+   cudaFusedAssign( ~lhs, rhs );
+}
+/*! \endcond */
+//**********************************************************************************************
+
+
+//**Addition assignment to dense matrices*******************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Addition assignment of a scaled dense matrix multiplication to a dense matrix
+//        (\f$ C+=s*(A*B) \f$).
+// \ingroup dense_matrix
+//
+// \param lhs The target left-hand side dense matrix.
+// \param rhs The right-hand side scaled multiplication expression to be added.
+// \return auto
+//
+// The product is accumulated into the target by a single GEMM with \f$ \alpha=s \f$ and
+// \f$ \beta=1 \f$.
+*/
+template< typename MT   // Type of the target dense matrix
+        , bool SO       // Storage order of the target dense matrix
+        , typename MT1  // Type of the dense matrix product
+        , typename ST   // Type of the scalar
+        , bool SO1 >    // Storage order of the dense matrix product
+inline auto cudaAddAssign( DenseMatrix<MT,SO>& lhs, const DMatScalarMultExpr<MT1,ST,SO1>& rhs )
+   -> EnableIf_t< IsCUDAGemmProduct_v<MT1> >
+{
+   BLAZE_FUNCTION_TRACE;
+   BLAZE_CUDA_FUNCTION_RANGE;
+
+   BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
+
+   const auto& product( rhs.leftOperand() );
+
+   if( (~lhs).rows() == 0UL || (~lhs).columns() == 0UL || product.leftOperand().columns() == 0UL ) {
+      return;
+   }
+
+   using ET = typename MT::ElementType;
+   using LT = typename MT1::LT;
+   using RT = typename MT1::RT;
+
+   LT A( product.leftOperand()  );  // Evaluation of the left-hand side dense matrix operand
+   RT B( product.rightOperand() );  // Evaluation of the right-hand side dense matrix operand
+
+   cugemm( ~lhs, A, B, ET( rhs.rightOperand() ), ET(1) );
+}
+/*! \endcond */
+//**********************************************************************************************
+
+
+//**Subtraction assignment to dense matrices****************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Subtraction assignment of a scaled dense matrix multiplication to a dense matrix
+//        (\f$ C-=s*(A*B) \f$).
+// \ingroup dense_matrix
+//
+// \param lhs The target left-hand side dense matrix.
+// \param rhs The right-hand side scaled multiplication expression to be subtracted.
+// \return auto
+//
+// The product is accumulated into the target by a single GEMM with \f$ \alpha=-s \f$ and
+// \f$ \beta=1 \f$.
+*/
+template< typename MT   // Type of the target dense matrix
+        , bool SO       // Storage order of the target dense matrix
+        , typename MT1  // Type of the dense matrix product
+        , typename ST   // Type of the scalar
+        , bool SO1 >    // Storage order of the dense matrix product
+inline auto cudaSubAssign( DenseMatrix<MT,SO>& lhs, const DMatScalarMultExpr<MT1,ST,SO1>& rhs )
+   -> EnableIf_t< IsCUDAGemmProduct_v<MT1> >
+{
+   BLAZE_FUNCTION_TRACE;
+   BLAZE_CUDA_FUNCTION_RANGE;
+
+   BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
+   BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
+
+   const auto& product( rhs.leftOperand() );
+
+   if( (~lhs).rows() == 0UL || (~lhs).columns() == 0UL || product.leftOperand().columns() == 0UL ) {
+      return;
+   }
+
+   using ET = typename MT::ElementType;
+   using LT = typename MT1::LT;
+   using RT = typename MT1::RT;
+
+   LT A( product.leftOperand()  );  // Evaluation of the left-hand side dense matrix operand
+   RT B( product.rightOperand() );  // Evaluation of the right-hand side dense matrix operand
+
+   cugemm( ~lhs, A, B, -ET( rhs.rightOperand() ), ET(1) );
+}
+/*! \endcond */
+//**********************************************************************************************
+
+} // namespace blaze
+
+#endif
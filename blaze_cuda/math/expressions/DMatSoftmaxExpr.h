@@ -0,0 +1,218 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/expressions/DMatSoftmaxExpr.h
+//  \brief Header file for the dense matrix softmax function
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_EXPRESSIONS_DMATSOFTMAXEXPR_H_
+#define _BLAZE_CUDA_MATH_EXPRESSIONS_DMATSOFTMAXEXPR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/expressions/DMatSoftmaxExpr.h>
+#include <blaze/math/ReductionFlag.h>
+#include <blaze/math/StorageOrder.h>
+#include <blaze/math/typetraits/HasConstDataAccess.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/math/typetraits/IsDenseMatrix.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/typetraits/IsFloatingPoint.h>
+
+#include <blaze_cuda/util/algorithms/CUDASoftmax.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  SOFTMAX ASSIGNMENT
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Softmax of all the elements of a CUDA-assignable dense matrix.
+// \ingroup dense_matrix
+//
+// \param lhs The target left-hand side dense matrix.
+// \param dm The dense matrix for the softmax computation.
+// \return void
+//
+// Operands without data access are evaluated beforehand. The padding of both matrices is
+// skipped.
+*/
+template< typename MT1    // Type of the target dense matrix
+        , bool SO         // Storage order of both matrices
+        , typename MT2 >  // Type of the dense matrix
+inline void cudaSoftmaxAssign( DenseMatrix<MT1,SO>& lhs, const DenseMatrix<MT2,SO>& dm )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<MT2> ) {
+      const ResultType_t<MT2> tmp( ~dm );
+      cudaSoftmaxAssign( ~lhs, tmp );
+   }
+   else {
+      const size_t lines ( SO == rowMajor ? (~dm).rows()    : (~dm).columns() );
+      const size_t length( SO == rowMajor ? (~dm).columns() : (~dm).rows()    );
+
+      cuda_softmax_2d< ElementType_t<MT2> >( lines, length, (~dm).data(), (~dm).spacing()
+                                           , (~lhs).data(), (~lhs).spacing() );
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Rowwise or columnwise softmax of a CUDA-assignable dense matrix.
+// \ingroup dense_matrix
+//
+// \param lhs The target left-hand side dense matrix.
+// \param dm The dense matrix for the softmax computation.
+// \return void
+//
+// Along the storage order of \a dm, every row (resp. column) is handled by a team of threads
+// that reduces it and writes it in the same kernel. The other orientation is reduced with
+// coalesced accesses into a vector of states, which a 2D transform then applies.
+*/
+template< ReductionFlag RF  // Reduction flag
+        , typename MT1      // Type of the target dense matrix
+        , bool SO           // Storage order of both matrices
+        , typename MT2 >    // Type of the dense matrix
+inline void cudaSoftmaxAssign( DenseMatrix<MT1,SO>& lhs, const DenseMatrix<MT2,SO>& dm )
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( !HasConstDataAccess_v<MT2> ) {
+      const ResultType_t<MT2> tmp( ~dm );
+      cudaSoftmaxAssign<RF>( ~lhs, tmp );
+   }
+   else {
+      using ET = ElementType_t<MT2>;
+
+      const size_t lines ( SO == rowMajor ? (~dm).rows()    : (~dm).columns() );
+      const size_t length( SO == rowMajor ? (~dm).columns() : (~dm).rows()    );
+
+      if( ( RF == rowwise ) == ( SO == rowMajor ) ) {
+         cuda_softmax_segments<ET>( lines, length, (~dm).data(), (~dm).spacing()
+                                  , (~lhs).data(), (~lhs).spacing() );
+      }
+      else {
+         cuda_softmax_strided<ET>( lines, length, (~dm).data(), (~dm).spacing()
+                                 , (~lhs).data(), (~lhs).spacing() );
+      }
+   }
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  GLOBAL FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Computes the softmax function for the given CUDA-assignable dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the softmax computation.
+// \return The resulting dense matrix.
+//
+// The elements of the whole matrix are normalized together, by a single online reduction of
+// their maximum and exponential sum followed by a normalization kernel, or by a single kernel
+// for matrices of up to 8192 elements without padding.
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto softmax( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ResultType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   ResultType_t<MT> res( dm.rows(), dm.columns() );
+   cudaSoftmaxAssign( res, dm );
+
+   return res;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the row-/columnwise softmax function for the given CUDA-assignable dense
+//        matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the softmax computation.
+// \return The resulting dense matrix.
+//
+// \c softmax<rowwise>() normalizes every row of the matrix on its own, \c softmax<columnwise>()
+// every column:
+
+   \code
+   blaze::CUDADynamicMatrix<double> A{ { 1.0, 2.0 }, { 3.0, 4.0 } };
+   blaze::CUDADynamicMatrix<double> B;
+
+   B = softmax<rowwise>( A );  // Results in ( ( 0.268941 0.731059 ) ( 0.268941 0.731059 ) )
+   \endcode
+
+// For a row-major matrix, \c softmax<rowwise>() runs a single kernel in which a warp, or a
+// whole block for rows longer than 1024 elements, reduces a row and writes it back.
+*/
+template< ReductionFlag RF  // Reduction flag
+        , typename MT >     // Type of the dense matrix
+inline auto softmax( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ResultType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   ResultType_t<MT> res( dm.rows(), dm.columns() );
+   cudaSoftmaxAssign<RF>( res, dm );
+
+   return res;
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -0,0 +1,131 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/expressions/DMatStdDevExpr.h
+//  \brief Header file for the dense matrix standard deviation expression
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_EXPRESSIONS_DMATSTDDEVEXPR_H_
+#define _BLAZE_CUDA_MATH_EXPRESSIONS_DMATSTDDEVEXPR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseMatrix.h>
+#include <blaze/math/expressions/DMatStdDevExpr.h>
+#include <blaze/math/ReductionFlag.h>
+#include <blaze/math/TransposeFlag.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/math/typetraits/IsDenseMatrix.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/Exception.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/typetraits/IsFloatingPoint.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/math/expressions/DMatVarExpr.h>
+#include <blaze_cuda/util/algorithms/CUDAWelford.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  GLOBAL FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Computes the standard deviation of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the standard deviation computation.
+// \return The standard deviation of the given matrix.
+// \exception std::invalid_argument Invalid input matrix.
+//
+// As for var(), the matrix is reduced by a single Welford reduction on the device. In case the
+// size of the given matrix is smaller than 2, a \a std::invalid_argument is thrown.
+*/
+template< typename MT >  // Type of the dense matrix
+inline auto stddev( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >, ElementType_t<MT> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if( dm.rows() * dm.columns() < 2UL ) {
+      BLAZE_THROW_INVALID_ARGUMENT( "Invalid input matrix" );
+   }
+
+   return WelfordStdDev()( cudaWelford( dm ) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the row-/columnwise standard deviation of a CUDA-assignable floating point dense matrix.
+// \ingroup dense_matrix
+//
+// \param dm The given dense matrix for the standard deviation computation.
+// \return The row-/columnwise standard deviation of the given matrix.
+// \exception std::invalid_argument Invalid input matrix.
+//
+// \c stddev<rowwise>() returns a column vector with the standard deviation of each row,
+// \c stddev<columnwise>() a row vector with the standard deviation of each column. In case the
+// rows (resp. columns) of the given matrix have less than 2 elements, a \a std::invalid_argument
+// is thrown.
+*/
+template< ReductionFlag RF  // Reduction flag
+        , typename MT >     // Type of the dense matrix
+inline auto stddev( const MT& dm )
+   -> EnableIf_t< IsDenseMatrix_v<MT> && IsCUDAAssignable_v<MT> &&
+                  IsFloatingPoint_v< ElementType_t<MT> >
+                , CUDADynamicVector< ElementType_t<MT>, RF == rowwise ? columnVector : rowVector > >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if( ( RF == rowwise ? dm.columns() : dm.rows() ) < 2UL ) {
+      BLAZE_THROW_INVALID_ARGUMENT( "Invalid input matrix" );
+   }
+
+   CUDADynamicVector< ElementType_t<MT>, RF == rowwise ? columnVector : rowVector >
+      res( RF == rowwise ? dm.rows() : dm.columns() );
+   cudaWelfordAssign<RF>( res, dm, WelfordStdDev() );
+
+   return res;
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
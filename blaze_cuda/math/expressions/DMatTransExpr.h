@@ -40,154 +40,177 @@
 // Includes
 //*************************************************************************************************
 
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseMatrix.h>
 #include <blaze/math/expressions/DMatTransExpr.h>
+#include <blaze/math/StorageOrder.h>
 #include <blaze/math/traits/DeclSymTrait.h>
 #include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/FunctionTrace.h>
 
-#include <blaze_cuda/math/cublas/geam.h>
+#include <blaze_cuda/math/cuda/DenseMatrix.h>
 #include <blaze_cuda/math/typetraits/RequiresCUDAEvaluation.h>
+#include <blaze_cuda/util/algorithms/CUDATranspose.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 
 
 namespace blaze {
 
-//**Assignment to dense matrices****************************************************************
+//**Backend of the (compound) assignments*******************************************************
 /*! \cond BLAZE_INTERNAL */
-/*!\brief Assignment of a dense matrix-dense matrix addition to a dense matrix.
+/*!\brief Backend of the CUDA-based (compound) assignment of a transpose expression.
 // \ingroup dense_matrix
 //
 // \param lhs The target left-hand side dense matrix.
-// \param rhs The right-hand side addition expression to be assigned.
-// \return auto
+// \param rhs The right-hand side transpose expression to be assigned.
+// \param op The (compound) assignment operation.
+// \return void
 //
-// This function implements the performance optimized assignment of a dense matrix-dense
-// matrix addition expression to a dense matrix. Due to the explicit application of the
-// SFINAE principle, this function can only be selected by the compiler in case either
-// of the two operands requires an intermediate evaluation.
+// The operand of a transpose expression has the opposite storage order of the expression. If
+// the target has the storage order of the expression, the elements are laid out in the same
+// way in both and the assignment is a plain 2D transform. Otherwise the memory layout has to
+// be transposed, which is done by the tiled cuda_transpose() kernel. The operand is traversed
+// through its iterators, so only operands that require an evaluation are evaluated. Operands
+// whose own operands have different spacings are transposed one row (resp. column) at a time.
 */
-template< typename MT  // Type of the target dense matrix
-        , bool SO2
-        , typename MT1
-        , bool SO >   // Storage order of the target dense matrix
-inline auto cudaAssign( DenseMatrix<MT,SO2>& lhs, const DMatTransExpr<MT1,SO>& rhs )
+template< typename MT   // Type of the target dense matrix
+        , bool SO2      // Storage order of the target dense matrix
+        , typename MT1  // Type of the transposed dense matrix
+        , bool SO       // Storage order of the transpose expression
+        , typename OP > // Type of the assignment operation
+inline void cudaTransposeAssign( DenseMatrix<MT,SO2>& lhs, const DMatTransExpr<MT1,SO>& rhs, OP op )
 {
    BLAZE_FUNCTION_TRACE;
 
-   using ExpressionType = DMatTransExpr<MT1,SO>;
-   using ResultType = typename ExpressionType::OppositeType;
-   using ET = typename MT::ElementType;
-
-   ResultType tmp( serial( rhs.operand() ) );
-
    BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
    BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
 
-   cugeam( ~lhs, ~tmp, ET(1), CUBLAS_OP_T );
+   if constexpr( RequiresCUDAEvaluation_v<MT1> ) {
+      const ResultType_t<MT1> tmp( serial( rhs.operand() ) );
+      cudaTransposeAssign( ~lhs, trans( tmp ), op );
+   }
+   else if constexpr( SO2 == SO ) {
+      cudaAssign( ~lhs, ~rhs, op );
+   }
+   else {
+      BLAZE_CUDA_FUNCTION_RANGE;
+
+      const auto& dm( rhs.operand() );
+
+      const size_t lines ( SO2 == rowMajor ? dm.rows()    : dm.columns() );
+      const size_t length( SO2 == rowMajor ? dm.columns() : dm.rows()    );
+
+      if( lines == 0UL || length == 0UL )
+         return;
+
+      if( cudaIsUniformlySpaced( dm ) ) {
+         cuda_transpose( lines, length, dm.begin(0UL), cudaSpacing( dm )
+                       , (~lhs).begin(0UL), cudaSpacing( ~lhs ), op );
+      }
+      else {
+         for( size_t i = 0UL; i < lines; ++i )
+            cuda_transpose( 1UL, length, dm.begin(i), 0UL
+                          , (~lhs).begin(0UL) + i, cudaSpacing( ~lhs ), op );
+      }
+   }
 }
 /*! \endcond */
 //**********************************************************************************************
 
-//**Addition assignment to dense matrices*******************************************************
+//**Assignment to dense matrices****************************************************************
 /*! \cond BLAZE_INTERNAL */
-/*!\brief Addition assignment of a dense matrix-dense matrix addition to a dense matrix.
+/*!\brief Assignment of a transpose expression to a dense matrix.
 // \ingroup dense_matrix
 //
 // \param lhs The target left-hand side dense matrix.
-// \param rhs The right-hand side addition expression to be added.
-// \return auto
+// \param rhs The right-hand side transpose expression to be assigned.
+// \return void
 //
-// This function implements the performance optimized addition assignment of a dense matrix-
-// dense matrix addition expression to a dense matrix. Due to the explicit application of
-// the SFINAE principle, this function can only be selected by the compiler in case either
-// of the operands requires an intermediate evaluation.
+// This function implements the performance optimized assignment of a transpose expression to a
+// dense matrix, by a single transposing kernel instead of an evaluation followed by \c geam.
 */
-template< typename MT  // Type of the target dense matrix
-        , bool SO2     // Storage order of the target dense matrix
-        , typename MT1
-        , bool SO >
-inline auto cudaAddAssign( DenseMatrix<MT,SO2>& lhs, const DMatTransExpr<MT1,SO>& rhs )
+template< typename MT   // Type of the target dense matrix
+        , bool SO2      // Storage order of the target dense matrix
+        , typename MT1  // Type of the transposed dense matrix
+        , bool SO >     // Storage order of the transpose expression
+inline void cudaAssign( DenseMatrix<MT,SO2>& lhs, const DMatTransExpr<MT1,SO>& rhs )
 {
    BLAZE_FUNCTION_TRACE;
 
-   using ExpressionType = DMatTransExpr<MT1,SO>;
-   using ResultType = typename ExpressionType::OppositeType;
-   using ET = typename MT::ElementType;
-
-   ResultType tmp( serial( rhs.operand() ) );
+   cudaTransposeAssign( ~lhs, rhs, CUDAAssign() );
+}
+/*! \endcond */
+//**********************************************************************************************
 
-   BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
+//**Addition assignment to dense matrices*******************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Addition assignment of a transpose expression to a dense matrix.
+// \ingroup dense_matrix
+//
+// \param lhs The target left-hand side dense matrix.
+// \param rhs The right-hand side transpose expression to be added.
+// \return void
+*/
+template< typename MT   // Type of the target dense matrix
+        , bool SO2      // Storage order of the target dense matrix
+        , typename MT1  // Type of the transposed dense matrix
+        , bool SO >     // Storage order of the transpose expression
+inline void cudaAddAssign( DenseMatrix<MT,SO2>& lhs, const DMatTransExpr<MT1,SO>& rhs )
+{
+   BLAZE_FUNCTION_TRACE;
 
-   cugeam( ~lhs, ~lhs, ~rhs,
-         ET(1), CUBLAS_OP_N ,
-         ET(1), CUBLAS_OP_T );
+   cudaTransposeAssign( ~lhs, rhs, [] BLAZE_DEVICE_CALLABLE ( auto const& l, auto const& r ) {
+      return l + r;
+   } );
 }
 /*! \endcond */
 //**********************************************************************************************
 
 //**Subtraction assignment to dense matrices****************************************************
 /*! \cond BLAZE_INTERNAL */
-/*!\brief Subtraction assignment of a dense matrix-dense matrix addition to a dense matrix.
+/*!\brief Subtraction assignment of a transpose expression to a dense matrix.
 // \ingroup dense_matrix
 //
 // \param lhs The target left-hand side dense matrix.
-// \param rhs The right-hand side addition expression to be subtracted.
+// \param rhs The right-hand side transpose expression to be subtracted.
 // \return void
-//
-// This function implements the performance optimized subtraction assignment of a dense matrix-
-// dense matrix addition expression to a dense matrix. Due to the explicit application of
-// the SFINAE principle, this function can only be selected by the compiler in case either
-// of the operands requires an intermediate evaluation.
 */
-template< typename MT  // Type of the target dense matrix
-        , bool SO2     // Storage order of the target dense matrix
-        , typename MT1
-        , bool SO >
-inline auto cudaSubAssign( DenseMatrix<MT,SO2>& lhs, const DMatTransExpr<MT1,SO>& rhs )
+template< typename MT   // Type of the target dense matrix
+        , bool SO2      // Storage order of the target dense matrix
+        , typename MT1  // Type of the transposed dense matrix
+        , bool SO >     // Storage order of the transpose expression
+inline void cudaSubAssign( DenseMatrix<MT,SO2>& lhs, const DMatTransExpr<MT1,SO>& rhs )
 {
    BLAZE_FUNCTION_TRACE;
 
-   using ExpressionType = DMatTransExpr<MT1,SO>;
-   using ResultType = typename ExpressionType::OppositeType;
-   using ET = typename MT::ElementType;
-
-   ResultType tmp( serial( rhs.operand() ) );
-
-   BLAZE_INTERNAL_ASSERT( (~lhs).rows()    == rhs.rows()   , "Invalid number of rows"    );
-   BLAZE_INTERNAL_ASSERT( (~lhs).columns() == rhs.columns(), "Invalid number of columns" );
-
-   cugeam( ~lhs, ~lhs, ~rhs,
-         ET( 1), CUBLAS_OP_N ,
-         ET(-1), CUBLAS_OP_T );
+   cudaTransposeAssign( ~lhs, rhs, [] BLAZE_DEVICE_CALLABLE ( auto const& l, auto const& r ) {
+      return l - r;
+   } );
 }
 /*! \endcond */
 //**********************************************************************************************
 
 //**Schur product assignment to dense matrices**************************************************
 /*! \cond BLAZE_INTERNAL */
-/*!\brief Schur product assignment of a dense matrix-dense matrix addition to a dense matrix.
+/*!\brief Schur product assignment of a transpose expression to a dense matrix.
 // \ingroup dense_matrix
 //
 // \param lhs The target left-hand side dense matrix.
-// \param rhs The right-hand side addition expression for the Schur product.
+// \param rhs The right-hand side transpose expression for the Schur product.
 // \return void
-//
-// This function implements the performance optimized Schur product assignment of a dense
-// matrix-dense matrix addition expression to a dense matrix. Due to the explicit application
-// of the SFINAE principle, this function can only be selected by the compiler in case either
-// of the operands requires an intermediate evaluation.
 */
-template< typename MT  // Type of the target dense matrix
-        , bool SO2     // Storage order of the target dense matrix
-        , typename MT1
-        , bool SO >
-inline auto cudaSchurAssign( DenseMatrix<MT,SO2>& lhs, const DMatTransExpr<MT1,SO>& rhs )
+template< typename MT   // Type of the target dense matrix
+        , bool SO2      // Storage order of the target dense matrix
+        , typename MT1  // Type of the transposed dense matrix
+        , bool SO >     // Storage order of the transpose expression
+inline void cudaSchurAssign( DenseMatrix<MT,SO2>& lhs, const DMatTransExpr<MT1,SO>& rhs )
 {
    BLAZE_FUNCTION_TRACE;
 
-   using ExpressionType = DMatTransExpr<MT1,SO>;
-   using ResultType = typename ExpressionType::OppositeType;
-
-   ResultType tmp( serial( rhs.operand() ) );
+   cudaTransposeAssign( ~lhs, rhs, [] BLAZE_DEVICE_CALLABLE ( auto const& l, auto const& r ) {
+      return l * r;
+   } );
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -42,34 +42,54 @@
 
 #include <utility>
 
-#include <thrust/reduce.h>
-#include <thrust/execution_policy.h>
-
+#include <blaze/math/Aliases.h>
 #include <blaze/math/expressions/DVecDVecInnerExpr.h>
 #include <blaze/math/traits/DeclSymTrait.h>
+#include <blaze/math/traits/MultTrait.h>
 #include <blaze/math/functors/Add.h>
 #include <blaze/math/functors/Mult.h>
+#include <blaze/math/typetraits/IsColumnVector.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/math/typetraits/IsDenseVector.h>
+#include <blaze/math/typetraits/IsRowVector.h>
 #include <blaze/system/HostDevice.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/EnableIf.h>
 
 #include <blaze_cuda/math/dense/CUDADynamicVector.h>
-#include <blaze_cuda/util/algorithms/CUDAReduce.h>
-#include <blaze_cuda/util/BinopIterator.h>
+#include <blaze_cuda/util/algorithms/CUDATransformReduce.h>
 
 
 namespace blaze {
 
-template< typename ET1    // Type of the left-hand side dense vector
-        , typename ET2 >  // Type of the right-hand side dense vector
-inline auto dvecdvecinner( const CUDADynamicVector<ET1,true>& lhs
-   , const CUDADynamicVector<ET2,false>& rhs )
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief CUDA-based inner product of two CUDA-assignable dense vectors (\f$ s=\vec{a}^T*\vec{b} \f$).
+// \ingroup dense_vector
+//
+// \param lhs The left-hand side dense row vector.
+// \param rhs The right-hand side dense column vector.
+// \return The scalar product.
+//
+// The products are computed while loading and reduced in a single kernel launch, for any
+// CUDA-assignable vector or view.
+*/
+template< typename VT1    // Type of the left-hand side dense vector
+        , typename VT2 >  // Type of the right-hand side dense vector
+inline auto dvecdvecinner( const VT1& lhs, const VT2& rhs )
+   -> EnableIf_t< IsDenseVector_v<VT1> && IsRowVector_v<VT1> && IsCUDAAssignable_v<VT1> &&
+                  IsDenseVector_v<VT2> && IsColumnVector_v<VT2> && IsCUDAAssignable_v<VT2>
+                , MultTrait_t< ElementType_t<VT1>, ElementType_t<VT2> > >
 {
-   using blaze::BinopIterator;
+   using ET = MultTrait_t< ElementType_t<VT1>, ElementType_t<VT2> >;
+
+   BLAZE_INTERNAL_ASSERT( lhs.size() == rhs.size(), "Invalid vector sizes" );
 
-   return thrust::reduce( thrust::device,
-      BinopIterator( lhs.begin(), rhs.begin(), blaze::Mult() ),
-      BinopIterator( lhs.end()  , rhs.end()  , blaze::Mult() ),
-      ET1(0), blaze::Add() );
+   return cuda_transform_reduce( lhs.begin(), lhs.end(), rhs.begin()
+                               , ET(0), blaze::Add(), blaze::Mult() );
 }
+/*! \endcond */
+//*************************************************************************************************
 
 } // namespace blaze
 
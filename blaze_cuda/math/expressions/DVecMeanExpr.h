@@ -0,0 +1,114 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/expressions/DVecMeanExpr.h
+//  \brief Header file for the dense vector mean expression
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_EXPRESSIONS_DVECMEANEXPR_H_
+#define _BLAZE_CUDA_MATH_EXPRESSIONS_DVECMEANEXPR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/math/expressions/DVecMeanExpr.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/math/typetraits/IsDenseVector.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/Exception.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/typetraits/IsFloatingPoint.h>
+
+#include <blaze_cuda/util/algorithms/CUDAWelford.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  GLOBAL FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Single pass Welford reduction of a CUDA-assignable dense vector.
+// \ingroup dense_vector
+//
+// \param dv The dense vector to be reduced.
+// \return The Welford state (size, mean, sum of squared deviations) of \a dv.
+//
+// The elements are read once through the iterators of \a dv, so expressions are reduced
+// without being evaluated.
+*/
+template< typename VT  // Type of the dense vector
+        , bool TF >    // Transpose flag of the dense vector
+inline WelfordState< ElementType_t<VT> > cudaWelford( const DenseVector<VT,TF>& dv )
+{
+   BLAZE_FUNCTION_TRACE;
+   return cuda_welford< ElementType_t<VT> >( (~dv).begin(), (~dv).end() );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the mean of a CUDA-assignable floating point dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the mean computation.
+// \return The mean of the given vector.
+// \exception std::invalid_argument Invalid input vector.
+//
+// The mean is computed by a single Welford reduction on the device.
+// In case the size of the given vector is 0, a \a std::invalid_argument is thrown.
+*/
+template< typename VT >  // Type of the dense vector
+inline auto mean( const VT& dv )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> >, ElementType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   if( dv.size() == 0UL ) {
+      BLAZE_THROW_INVALID_ARGUMENT( "Invalid input vector" );
+   }
+
+   return cudaWelford( dv ).mean;
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
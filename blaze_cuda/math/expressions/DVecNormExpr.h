@@ -0,0 +1,487 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/expressions/DVecNormExpr.h
+//  \brief Header file for the dense vector norm expression
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_EXPRESSIONS_DVECNORMEXPR_H_
+#define _BLAZE_CUDA_MATH_EXPRESSIONS_DVECNORMEXPR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/math/expressions/DVecNormExpr.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/math/typetraits/IsDenseVector.h>
+#include <blaze/util/Assert.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/StaticAssert.h>
+#include <blaze/util/typetraits/IsFloatingPoint.h>
+#include <blaze/util/typetraits/IsNumeric.h>
+
+#include <blaze_cuda/util/algorithms/CUDANorm.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  GLOBAL FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Computes a norm of a CUDA-assignable dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param norm The norm policy.
+// \return The norm of the given vector.
+//
+// The elements are read once through the iterators of \a dv, so expressions are reduced
+// without being evaluated.
+*/
+template< typename VT      // Type of the dense vector
+        , bool TF          // Transpose flag of the dense vector
+        , typename Norm >  // Type of the norm policy
+inline auto cudaNorm( const DenseVector<VT,TF>& dv, Norm norm )
+{
+   BLAZE_FUNCTION_TRACE;
+   return cuda_norm( (~dv).begin(), (~dv).end(), norm );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Computes a norm of a CUDA-assignable dense vector into a device scalar.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param norm The norm policy.
+// \param result The device scalar receiving the norm.
+// \return void
+*/
+template< typename VT      // Type of the dense vector
+        , bool TF          // Transpose flag of the dense vector
+        , typename Norm >  // Type of the norm policy
+inline void cudaNorm( const DenseVector<VT,TF>& dv, Norm norm, ElementType_t<VT>* result )
+{
+   BLAZE_FUNCTION_TRACE;
+   cuda_norm_into( (~dv).begin(), (~dv).end(), norm, result );
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L2 norm of a CUDA-assignable floating point dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \return The L2 norm of the given dense vector.
+//
+// The norm is computed by a single fused reduction on the device.
+//
+// The squares are scaled by the largest absolute value, as in the reference BLAS nrm2, so the
+// result neither overflows nor underflows unless the norm itself does.
+*/
+template< typename VT >  // Type of the dense vector
+inline auto norm( const VT& dv )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> >, ElementType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dv, CUDAL2Norm< ElementType_t<VT> >() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L2 norm of a CUDA-assignable floating point dense vector into a device
+// scalar.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param result The device (or managed) scalar receiving the L2 norm.
+// \return void
+//
+// The norm is stored by the reduction kernel and the function returns without synchronizing,
+// e.g. to check the convergence of an iterative solver every few iterations only. \a result
+// must not be read on the host before the work submitted to the stream of the current
+// execution context is done.
+*/
+template< typename VT >  // Type of the dense vector
+inline auto norm( const VT& dv, ElementType_t<VT>* result )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dv, CUDAL2Norm< ElementType_t<VT> >(), result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the squared L2 norm of a CUDA-assignable floating point dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \return The squared L2 norm of the given dense vector.
+*/
+template< typename VT >  // Type of the dense vector
+inline auto sqrNorm( const VT& dv )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> >, ElementType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dv, CUDASqrNorm< ElementType_t<VT> >() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the squared L2 norm of a CUDA-assignable floating point dense vector
+// into a device scalar.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param result The device (or managed) scalar receiving the squared L2 norm.
+// \return void
+*/
+template< typename VT >  // Type of the dense vector
+inline auto sqrNorm( const VT& dv, ElementType_t<VT>* result )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dv, CUDASqrNorm< ElementType_t<VT> >(), result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L1 norm of a CUDA-assignable floating point dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \return The L1 norm of the given dense vector.
+*/
+template< typename VT >  // Type of the dense vector
+inline auto l1Norm( const VT& dv )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> >, ElementType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dv, CUDAL1Norm< ElementType_t<VT> >() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L1 norm of a CUDA-assignable floating point dense vector into a device
+// scalar.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param result The device (or managed) scalar receiving the L1 norm.
+// \return void
+*/
+template< typename VT >  // Type of the dense vector
+inline auto l1Norm( const VT& dv, ElementType_t<VT>* result )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dv, CUDAL1Norm< ElementType_t<VT> >(), result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L2 norm of a CUDA-assignable floating point dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \return The L2 norm of the given dense vector.
+//
+// This function is equivalent to norm().
+*/
+template< typename VT >  // Type of the dense vector
+inline auto l2Norm( const VT& dv )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> >, ElementType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dv, CUDAL2Norm< ElementType_t<VT> >() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L2 norm of a CUDA-assignable floating point dense vector into a device
+// scalar.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param result The device (or managed) scalar receiving the L2 norm.
+// \return void
+*/
+template< typename VT >  // Type of the dense vector
+inline auto l2Norm( const VT& dv, ElementType_t<VT>* result )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dv, CUDAL2Norm< ElementType_t<VT> >(), result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L3 norm of a CUDA-assignable floating point dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \return The L3 norm of the given dense vector.
+*/
+template< typename VT >  // Type of the dense vector
+inline auto l3Norm( const VT& dv )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> >, ElementType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dv, CUDALpNorm< ElementType_t<VT> >{ ElementType_t<VT>( 3 ) } );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L3 norm of a CUDA-assignable floating point dense vector into a device
+// scalar.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param result The device (or managed) scalar receiving the L3 norm.
+// \return void
+*/
+template< typename VT >  // Type of the dense vector
+inline auto l3Norm( const VT& dv, ElementType_t<VT>* result )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dv, CUDALpNorm< ElementType_t<VT> >{ ElementType_t<VT>( 3 ) }, result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L4 norm of a CUDA-assignable floating point dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \return The L4 norm of the given dense vector.
+*/
+template< typename VT >  // Type of the dense vector
+inline auto l4Norm( const VT& dv )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> >, ElementType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dv, CUDALpNorm< ElementType_t<VT> >{ ElementType_t<VT>( 4 ) } );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the L4 norm of a CUDA-assignable floating point dense vector into a device
+// scalar.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param result The device (or managed) scalar receiving the L4 norm.
+// \return void
+*/
+template< typename VT >  // Type of the dense vector
+inline auto l4Norm( const VT& dv, ElementType_t<VT>* result )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dv, CUDALpNorm< ElementType_t<VT> >{ ElementType_t<VT>( 4 ) }, result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the maximum norm of a CUDA-assignable floating point dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \return The maximum norm of the given dense vector.
+*/
+template< typename VT >  // Type of the dense vector
+inline auto maxNorm( const VT& dv )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> >, ElementType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   return cudaNorm( dv, CUDAMaxNorm< ElementType_t<VT> >() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the maximum norm of a CUDA-assignable floating point dense vector into a device
+// scalar.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param result The device (or managed) scalar receiving the maximum norm.
+// \return void
+*/
+template< typename VT >  // Type of the dense vector
+inline auto maxNorm( const VT& dv, ElementType_t<VT>* result )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> > >
+{
+   BLAZE_FUNCTION_TRACE;
+   cudaNorm( dv, CUDAMaxNorm< ElementType_t<VT> >(), result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the Lp norm of a CUDA-assignable floating point dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param p The norm parameter (p > 0).
+// \return The Lp norm of the given dense vector.
+*/
+template< typename VT    // Type of the dense vector
+        , typename ST >  // Type of the norm parameter
+inline auto lpNorm( const VT& dv, ST p )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> > && IsNumeric_v<ST>, ElementType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+   BLAZE_USER_ASSERT( p > ST( 0 ), "Invalid p for Lp norm detected" );
+   return cudaNorm( dv, CUDALpNorm< ElementType_t<VT> >{ ElementType_t<VT>( p ) } );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the Lp norm of a CUDA-assignable floating point dense vector into a device
+// scalar.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param p The norm parameter (p > 0).
+// \param result The device (or managed) scalar receiving the Lp norm.
+// \return void
+*/
+template< typename VT    // Type of the dense vector
+        , typename ST >  // Type of the norm parameter
+inline auto lpNorm( const VT& dv, ST p, ElementType_t<VT>* result )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> > && IsNumeric_v<ST> >
+{
+   BLAZE_FUNCTION_TRACE;
+   BLAZE_USER_ASSERT( p > ST( 0 ), "Invalid p for Lp norm detected" );
+   cudaNorm( dv, CUDALpNorm< ElementType_t<VT> >{ ElementType_t<VT>( p ) }, result );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the Lp norm of a CUDA-assignable floating point dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \return The Lp norm of the given dense vector.
+//
+// The L1 and L2 norms use the dedicated reductions of l1Norm() and l2Norm().
+*/
+template< size_t P       // Compile time norm parameter
+        , typename VT >  // Type of the dense vector
+inline auto lpNorm( const VT& dv )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> >, ElementType_t<VT> >
+{
+   BLAZE_STATIC_ASSERT_MSG( P > 0UL, "Invalid norm parameter detected" );
+
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( P == 1UL ) return l1Norm( dv );
+   else if constexpr( P == 2UL ) return l2Norm( dv );
+   else return cudaNorm( dv, CUDALpNorm< ElementType_t<VT> >{ ElementType_t<VT>( P ) } );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Computes the Lp norm of a CUDA-assignable floating point dense vector into a device
+// scalar.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the norm computation.
+// \param result The device (or managed) scalar receiving the Lp norm.
+// \return void
+*/
+template< size_t P       // Compile time norm parameter
+        , typename VT >  // Type of the dense vector
+inline auto lpNorm( const VT& dv, ElementType_t<VT>* result )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> > >
+{
+   BLAZE_STATIC_ASSERT_MSG( P > 0UL, "Invalid norm parameter detected" );
+
+   BLAZE_FUNCTION_TRACE;
+
+   if constexpr( P == 1UL ) l1Norm( dv, result );
+   else if constexpr( P == 2UL ) l2Norm( dv, result );
+   else cudaNorm( dv, CUDALpNorm< ElementType_t<VT> >{ ElementType_t<VT>( P ) }, result );
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -0,0 +1,99 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/expressions/DVecSoftmaxExpr.h
+//  \brief Header file for the dense vector softmax function
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_MATH_EXPRESSIONS_DVECSOFTMAXEXPR_H_
+#define _BLAZE_CUDA_MATH_EXPRESSIONS_DVECSOFTMAXEXPR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/Aliases.h>
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/math/expressions/DVecSoftmaxExpr.h>
+#include <blaze/math/typetraits/IsCUDAAssignable.h>
+#include <blaze/math/typetraits/IsDenseVector.h>
+#include <blaze/util/EnableIf.h>
+#include <blaze/util/FunctionTrace.h>
+#include <blaze/util/typetraits/IsFloatingPoint.h>
+
+#include <blaze_cuda/util/algorithms/CUDASoftmax.h>
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  GLOBAL FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Computes the softmax function for the given CUDA-assignable dense vector.
+// \ingroup dense_vector
+//
+// \param dv The given dense vector for the softmax computation.
+// \return The resulting dense vector.
+//
+// The maximum and the sum of the exponentials are accumulated by a single online reduction,
+// and the result is shifted by the maximum so that large elements do not overflow:
+
+   \code
+   blaze::CUDADynamicVector<double> a{ 1.0, 2.0, 3.0, 4.0 };
+   blaze::CUDADynamicVector<double> b;
+
+   b = softmax( a );  // Results in ( 0.0320586 0.0871443 0.236883 0.643914 )
+   \endcode
+
+// Vectors of up to 8192 elements are handled by a single kernel launch, larger ones by a
+// reduction and a normalization kernel. Neither synchronizes the host.
+*/
+template< typename VT >  // Type of the dense vector
+inline auto softmax( const VT& dv )
+   -> EnableIf_t< IsDenseVector_v<VT> && IsCUDAAssignable_v<VT> &&
+                  IsFloatingPoint_v< ElementType_t<VT> >, ResultType_t<VT> >
+{
+   BLAZE_FUNCTION_TRACE;
+
+   ResultType_t<VT> res( dv.size() );
+   cuda_softmax< ElementType_t<VT> >( dv.begin(), dv.end(), res.data() );
+
+   return res;
+}
+//*************************************************************************************************
+
+} // namespace blaze
+
+#endif
@@ -0,0 +1,178 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/math/expressions/TDMatDVecMultExpr.h
+//  \brief Header file for the transpose dense matrix/dense vector multiplication expression
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+#ifndef _BLAZE_CUDA_MATH_EXPRESSIONS_TDMATDVECMULTEXPR_H_
+#define _BLAZE_CUDA_MATH_EXPRESSIONS_TDMATDVECMULTEXPR_H_
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <blaze/math/expressions/TDMatDVecMultExpr.h>
+
+#include <blaze_cuda/math/cublas/gemv.h>
+#include <blaze_cuda/math/typetraits/RequiresCUDAEvaluation.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+
+namespace blaze {
+
+//**Assignment to dense vectors*****************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Assignment of a transpose dense matrix-dense vector
+//        multiplication to a dense vector (\f$ \vec{y}=A*\vec{x} \f$).
+// \ingroup dense_vector
+//
+// \param lhs The target left-hand side dense vector.
+// \param rhs The right-hand side multiplication expression to be assigned.
+// \return void
+//
+// The column-major matrix is the native layout of cuBLAS, so the product is a single cugemv()
+// call without transposition.
+*/
+template< typename VT1   // Type of the target dense vector
+        , typename MT    // Type of the left-hand side dense matrix
+        , typename VT2 > // Type of the right-hand side dense vector
+inline auto cudaAssign( DenseVector<VT1,false>& lhs, const TDMatDVecMultExpr<MT,VT2>& rhs )
+{
+   BLAZE_FUNCTION_TRACE;
+   BLAZE_CUDA_FUNCTION_RANGE;
+
+   BLAZE_INTERNAL_ASSERT( (~lhs).size() == rhs.size(), "Invalid vector sizes" );
+
+   if( (~lhs).size() == 0UL ) {
+      return;
+   }
+   else if( rhs.leftOperand().columns() == 0UL ) {
+      reset( ~lhs );
+      return;
+   }
+
+   using ET = typename VT1::ElementType;
+   using LT = typename TDMatDVecMultExpr<MT,VT2>::LT;
+   using RT = typename TDMatDVecMultExpr<MT,VT2>::RT;
+
+   LT A( rhs.leftOperand()  );  // Evaluation of the left-hand side operand
+   RT x( rhs.rightOperand() );  // Evaluation of the right-hand side operand
+
+   cugemv( ~lhs, A, x, ET(1), ET(0) );
+}
+/*! \endcond */
+//**********************************************************************************************
+
+
+//**Addition assignment to dense vectors********************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Addition assignment of a transpose dense matrix-dense vector
+//        multiplication to a dense vector (\f$ \vec{y}+=A*\vec{x} \f$).
+// \ingroup dense_vector
+//
+// \param lhs The target left-hand side dense vector.
+// \param rhs The right-hand side multiplication expression to be added.
+// \return void
+*/
+template< typename VT1   // Type of the target dense vector
+        , typename MT    // Type of the left-hand side dense matrix
+        , typename VT2 > // Type of the right-hand side dense vector
+inline auto cudaAddAssign( DenseVector<VT1,false>& lhs, const TDMatDVecMultExpr<MT,VT2>& rhs )
+{
+   BLAZE_FUNCTION_TRACE;
+   BLAZE_CUDA_FUNCTION_RANGE;
+
+   BLAZE_INTERNAL_ASSERT( (~lhs).size() == rhs.size(), "Invalid vector sizes" );
+
+   if( (~lhs).size() == 0UL || rhs.leftOperand().columns() == 0UL ) {
+      return;
+   }
+
+   using ET = typename VT1::ElementType;
+   using LT = typename TDMatDVecMultExpr<MT,VT2>::LT;
+   using RT = typename TDMatDVecMultExpr<MT,VT2>::RT;
+
+   LT A( rhs.leftOperand()  );  // Evaluation of the left-hand side operand
+   RT x( rhs.rightOperand() );  // Evaluation of the right-hand side operand
+
+   cugemv( ~lhs, A, x, ET(1), ET(1) );
+}
+/*! \endcond */
+//**********************************************************************************************
+
+
+//**Subtraction assignment to dense vectors*****************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Subtraction assignment of a transpose dense matrix-dense vector
+//        multiplication to a dense vector (\f$ \vec{y}-=A*\vec{x} \f$).
+// \ingroup dense_vector
+//
+// \param lhs The target left-hand side dense vector.
+// \param rhs The right-hand side multiplication expression to be subtracted.
+// \return void
+*/
+template< typename VT1   // Type of the target dense vector
+        , typename MT    // Type of the left-hand side dense matrix
+        , typename VT2 > // Type of the right-hand side dense vector
+inline auto cudaSubAssign( DenseVector<VT1,false>& lhs, const TDMatDVecMultExpr<MT,VT2>& rhs )
+{
+   BLAZE_FUNCTION_TRACE;
+   BLAZE_CUDA_FUNCTION_RANGE;
+
+   BLAZE_INTERNAL_ASSERT( (~lhs).size() == rhs.size(), "Invalid vector sizes" );
+
+   if( (~lhs).size() == 0UL || rhs.leftOperand().columns() == 0UL ) {
+      return;
+   }
+
+   using ET = typename VT1::ElementType;
+   using LT = typename TDMatDVecMultExpr<MT,VT2>::LT;
+   using RT = typename TDMatDVecMultExpr<MT,VT2>::RT;
+
+   LT A( rhs.leftOperand()  );  // Evaluation of the left-hand side operand
+   RT x( rhs.rightOperand() );  // Evaluation of the right-hand side operand
+
+   cugemv( ~lhs, A, x, ET(-1), ET(1) );
+}
+/*! \endcond */
+//**********************************************************************************************
+
+template< typename MT, typename VT2 >
+struct RequiresCUDAEvaluation< TDMatDVecMultExpr<MT,VT2>
+   , EnableIf_t< IsCUDAAssignable_v< TDMatDVecMultExpr<MT,VT2> > > >
+{
+public:
+   static constexpr bool value = true;
+};
+
+} // namespace blaze
+
+#endif
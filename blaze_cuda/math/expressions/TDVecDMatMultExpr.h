@@ -44,6 +44,7 @@
 #include <blaze/math/traits/DeclSymTrait.h>
 
 #include <blaze_cuda/math/typetraits/RequiresCUDAEvaluation.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
 #include <blaze_cuda/math/cublas/gemv.h>
 
 
@@ -69,6 +70,7 @@ template< typename VT1
 inline auto cudaAssign( DenseVector<VT1,true>& lhs, const TDVecDMatMultExpr<VT2,MT>& rhs )
 {
    BLAZE_FUNCTION_TRACE;
+   BLAZE_CUDA_FUNCTION_RANGE;
 
    using ET = typename VT1::ElementType;
    using LT = typename TDVecDMatMultExpr<VT2,MT>::LT;
@@ -99,6 +101,7 @@ template< typename VT1
 inline auto cudaAddAssign( DenseVector<VT1,true>& lhs, const TDVecDMatMultExpr<VT2,MT>& rhs )
 {
    BLAZE_FUNCTION_TRACE;
+   BLAZE_CUDA_FUNCTION_RANGE;
 
    using ET = typename VT1::ElementType;
    using LT = typename TDVecDMatMultExpr<VT2,MT>::LT;
@@ -130,6 +133,7 @@ template< typename VT1
 inline auto cudaSubAssign( DenseVector<VT1,SO>& lhs, const TDVecDMatMultExpr<VT2,MT>& rhs )
 {
    BLAZE_FUNCTION_TRACE;
+   BLAZE_CUDA_FUNCTION_RANGE;
 
    using ET = typename VT1::ElementType;
    using LT = typename TDVecDMatMultExpr<VT2,MT>::LT;
@@ -160,6 +164,7 @@ template< typename VT1
 inline auto cudaSchurAssign( DenseVector<VT1,true>& lhs, const TDVecDMatMultExpr<VT2,MT>& rhs )
 {
    BLAZE_FUNCTION_TRACE;
+   BLAZE_CUDA_FUNCTION_RANGE;
 }
 /*! \endcond */
 //**********************************************************************************************
@@ -183,6 +188,7 @@ template< typename VT1
 inline auto cudaMultAssign( DenseVector<VT1,true>& lhs, const TDVecDMatMultExpr<VT2,MT>& rhs )
 {
    BLAZE_FUNCTION_TRACE;
+   BLAZE_CUDA_FUNCTION_RANGE;
 
    using ET = TDVecDMatMultExpr<VT2,MT>;
    using ResultType = typename ET::ResultType;
@@ -41,9 +41,23 @@
 // Includes
 //*************************************************************************************************
 
+#include <blaze_cuda/util/algorithms/CUDABatchedGemm.h>
+#include <blaze_cuda/util/algorithms/CUDACompact.h>
 #include <blaze_cuda/util/algorithms/CUDACopy.h>
+#include <blaze_cuda/util/algorithms/CUDAGemm.h>
+#include <blaze_cuda/util/algorithms/CUDANorm.h>
+#include <blaze_cuda/util/algorithms/CUDAPackedTransform.h>
 #include <blaze_cuda/util/algorithms/CUDAReduce.h>
+#include <blaze_cuda/util/algorithms/CUDAScan.h>
+#include <blaze_cuda/util/algorithms/CUDASegmentedReduce.h>
+#include <blaze_cuda/util/algorithms/CUDASoftmax.h>
+#include <blaze_cuda/util/algorithms/CUDASort.h>
 #include <blaze_cuda/util/algorithms/CUDATransform.h>
+#include <blaze_cuda/util/algorithms/CUDATransform2D.h>
+#include <blaze_cuda/util/algorithms/CUDATransformReduce.h>
+#include <blaze_cuda/util/algorithms/CUDATranspose.h>
+#include <blaze_cuda/util/algorithms/CUDAWelford.h>
+#include <blaze_cuda/util/algorithms/HostParallel.h>
 #include <blaze_cuda/util/algorithms/Unroll.h>
 
 #endif
@@ -105,6 +105,19 @@ public:
       return BinopIterator( _lit + inc, _rit + inc, _op );
    }
 
+   inline BLAZE_DEVICE_CALLABLE BinopIterator operator-  (std::size_t dec) {
+      return BinopIterator( _lit - dec, _rit - dec, _op );
+   }
+
+   inline BLAZE_DEVICE_CALLABLE BinopIterator& operator+= (std::size_t inc) {
+      _lit += inc; _rit += inc;
+      return *this;
+   }
+
+   inline BLAZE_DEVICE_CALLABLE difference_type operator- ( BinopIterator const& other ) const {
+      return _lit - other._lit;
+   }
+
    inline BLAZE_DEVICE_CALLABLE value_type operator[] (std::size_t inc) {
       return *BinopIterator( _lit + inc, _rit + inc, _op );
    }
@@ -38,11 +38,15 @@
 #include <sstream>
 #include <stdexcept>
 
-#include <cublas_v2.h>
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/HostCUBLAS.h>
+#else
+#  include <cublas_v2.h>
+#endif
 
 namespace blaze {
 
-std::string cublasStatusToString( cublasStatus_t const& status ) {
+inline std::string cublasStatusToString( cublasStatus_t const& status ) {
    if ( status == CUBLAS_STATUS_SUCCESS )           return "CUBLAS_STATUS_SUCCESS";
    if ( status == CUBLAS_STATUS_NOT_INITIALIZED )   return "CUBLAS_STATUS_NOT_INITIALIZED";
    if ( status == CUBLAS_STATUS_ALLOC_FAILED )      return "CUBLAS_STATUS_ALLOC_FAILED";
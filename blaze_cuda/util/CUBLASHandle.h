@@ -0,0 +1,228 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/CUBLASHandle.h
+//  \brief Header file for the thread-local cuBLAS handle registry
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_CUBLASHANDLE_H_
+#define _BLAZE_CUDA_UTIL_CUBLASHANDLE_H_
+
+#include <map>
+#include <memory>
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/HostCUBLAS.h>
+#else
+#  include <cuda_runtime.h>
+#  include <cublas_v2.h>
+#endif
+
+#include <blaze_cuda/util/CUBLASErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CONFIGURATION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Configuration applied to the cuBLAS handles of a thread.
+// \ingroup cublas
+//
+// The configuration is thread-local: it applies to every handle returned by cublas_handle() on
+// the calling thread, whatever the current device. The stream is the one of the current
+// execution context (see CUDAExecutionContext). The pointer mode is not configurable: the BLAS
+// wrappers pass their scalar factors from the host, so the handles stay in the default
+// \c CUBLAS_POINTER_MODE_HOST.
+*/
+struct CUBLASConfig
+{
+   cublasMath_t mathMode = CUBLAS_DEFAULT_MATH;  //!< Tensor core usage.
+
+   inline bool operator==( const CUBLASConfig& rhs ) const noexcept {
+      return mathMode == rhs.mathMode;
+   }
+
+   inline bool operator!=( const CUBLASConfig& rhs ) const noexcept {
+      return !( *this == rhs );
+   }
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the cuBLAS configuration of the calling thread.
+// \ingroup cublas
+//
+// \return Reference to the thread-local configuration.
+//
+// Changes to the returned configuration are applied lazily to the handles of the thread, the
+// next time they are retrieved via cublas_handle().
+*/
+inline CUBLASConfig& cublas_config()
+{
+   thread_local CUBLASConfig config;
+   return config;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  HANDLE REGISTRY
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Owner of a single cuBLAS handle and of the configuration last applied to it.
+// \ingroup cublas
+*/
+class CUBLASHandle
+{
+ public:
+   inline CUBLASHandle()
+   {
+      CUBLAS_ERROR_CHECK( cublasCreate_v2( &handle_ ) );
+      BLAZE_CUDA_COUNT( cublasHandles, 1UL );
+   }
+
+   CUBLASHandle( const CUBLASHandle& ) = delete;
+   CUBLASHandle& operator=( const CUBLASHandle& ) = delete;
+
+   inline ~CUBLASHandle()
+   {
+      // The status is ignored: the CUDA context may already be gone at thread/program exit
+      cublasDestroy_v2( handle_ );
+   }
+
+   inline cublasHandle_t get( const CUBLASConfig& config, cudaStream_t stream )
+   {
+      if( stream != stream_ ) {
+         CUBLAS_ERROR_CHECK( cublasSetStream_v2( handle_, stream ) );
+         stream_ = stream;
+      }
+      if( config.mathMode != applied_.mathMode ) {
+         CUBLAS_ERROR_CHECK( cublasSetMathMode( handle_, config.mathMode ) );
+      }
+
+      applied_ = config;
+      return handle_;
+   }
+
+ private:
+   cublasHandle_t handle_;            //!< The cuBLAS handle.
+   CUBLASConfig   applied_;           //!< The configuration currently set on the handle.
+   cudaStream_t   stream_ = nullptr;  //!< The stream currently set on the handle.
+};
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the cuBLAS handle of the calling thread for the current device.
+// \ingroup cublas
+//
+// \return The configured cuBLAS handle.
+// \exception std::runtime_error Handle creation or configuration failed.
+//
+// Handles are created on first use, once per thread and per device, and are destroyed when
+// the thread exits. Reusing them avoids the cost of cublasCreate() on every BLAS call, which is
+// far higher than the one of a small gemm. The thread-local configuration (see cublas_config())
+// and the stream of the current execution context are applied to the handle before it is
+// returned.
+*/
+inline cublasHandle_t cublas_handle()
+{
+   thread_local std::map< int, std::unique_ptr<CUBLASHandle> > registry;
+
+   int device( 0 );
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+   cudaGetDevice( &device );
+#endif
+
+   auto& handle( registry[device] );
+
+   if( !handle ) {
+      handle = std::make_unique<CUBLASHandle>();
+   }
+
+   return handle->get( cublas_config(), cuda_stream() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Scoped change of the cuBLAS configuration of the calling thread.
+// \ingroup cublas
+//
+// The previous configuration is restored when the guard goes out of scope:
+
+   \code
+   {
+      blaze::CUBLASConfig config;
+      config.mathMode = CUBLAS_TF32_TENSOR_OP_MATH;
+      blaze::CUBLASConfigGuard guard( config );
+      C = A * B;  // The gemm may use TF32 tensor cores
+   }
+   \endcode
+*/
+class CUBLASConfigGuard
+{
+ public:
+   explicit inline CUBLASConfigGuard( const CUBLASConfig& config )
+      : previous_( cublas_config() )
+   {
+      cublas_config() = config;
+   }
+
+   CUBLASConfigGuard( const CUBLASConfigGuard& ) = delete;
+   CUBLASConfigGuard& operator=( const CUBLASConfigGuard& ) = delete;
+
+   inline ~CUBLASConfigGuard()
+   {
+      cublas_config() = previous_;
+   }
+
+ private:
+   CUBLASConfig previous_;  //!< The configuration to be restored.
+};
+//*************************************************************************************************
+
+}  // namespace blaze
+
+#endif
@@ -44,7 +44,9 @@
 #include <blaze/util/Memory.h>
 #include <blaze/util/typetraits/AlignmentOf.h>
 
-#include <cuda_runtime.h>
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <cuda_runtime.h>
+#endif
 
 namespace blaze_cuda {
 
@@ -38,6 +38,13 @@
 #include <sstream>
 #include <stdexcept>
 
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+// Nothing to check: the host backend reports errors through exceptions
+#define BLAZE_CUDA_ERROR_CHECK
+
+#else
+
 #include <cuda_runtime.h>
 
 #define BLAZE_CUDA_ERROR_CHECK                                                      \
@@ -49,4 +56,7 @@ if( auto err = cudaGetLastError(); err != cudaSuccess )                    \
       << cudaGetErrorString( err );                                        \
    throw std::runtime_error( ss.str() );                                   \
 }
+
+#endif
+
 #endif
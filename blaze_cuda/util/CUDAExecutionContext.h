@@ -0,0 +1,251 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/CUDAExecutionContext.h
+//  \brief Header file for the CUDA execution context
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_CUDAEXECUTIONCONTEXT_H_
+#define _BLAZE_CUDA_UTIL_CUDAEXECUTIONCONTEXT_H_
+
+#include <memory>
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+struct CUstream_st;
+typedef CUstream_st* cudaStream_t;
+#else
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Execution context of the CUDA algorithms.
+// \ingroup util
+//
+// An execution context designates the stream on which the work of the calling thread is
+// issued: the kernels of cuda_transform(), cuda_transform_2d() and cuda_reduce(), the copies of
+// cuda_copy() and CUDAMirroredArray, the cuBLAS calls (see cublas_handle()) and the stream
+// callbacks of the futures. The scratch resources follow the stream: reduction workspaces are
+// kept per stream, and the memory pools record an event on the stream a block is freed on, so
+// that its reuse on any stream is ordered after the kernels still accessing it.
+//
+// The default context uses the legacy default stream. Independent pipelines run concurrently
+// when they are issued from contexts with different streams:
+
+   \code
+   blaze::CUDAExecutionContext ctx( blaze::CUDAExecutionContext::create() );
+   {
+      blaze::CUDAExecutionContextGuard guard( ctx );
+      C = A * B + D;  // Issued on the stream of 'ctx'
+   }
+   ctx.synchronize();
+   \endcode
+
+// Contexts are cheap to copy; copies share the stream, which is destroyed with the last copy of
+// a context created by create().
+*/
+class CUDAExecutionContext
+{
+ public:
+   //**Constructors********************************************************************************
+   inline CUDAExecutionContext() noexcept = default;
+   explicit inline CUDAExecutionContext( cudaStream_t stream );
+
+   static inline CUDAExecutionContext create();
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   inline cudaStream_t stream() const noexcept { return stream_.get(); }
+   inline void synchronize() const;
+   //**********************************************************************************************
+
+ private:
+   //**Member variables****************************************************************************
+   std::shared_ptr<CUstream_st> stream_;  //!< The stream, owned or borrowed.
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Constructor of a context issuing work on the given stream.
+//
+// \param stream The stream, which must outlive the context.
+*/
+inline CUDAExecutionContext::CUDAExecutionContext( cudaStream_t stream )
+   : stream_( stream, []( CUstream_st* ) {} )
+{}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Creates a context owning a new non-blocking stream.
+//
+// \return The new context.
+// \exception std::runtime_error Stream creation failed.
+*/
+inline CUDAExecutionContext CUDAExecutionContext::create()
+{
+   CUDAExecutionContext ctx;
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   // Work is synchronous on the host: a unique address is enough to tell the contexts apart
+   ctx.stream_.reset( reinterpret_cast<CUstream_st*>( new char ),
+                      []( CUstream_st* s ) { delete reinterpret_cast<char*>( s ); } );
+#else
+   cudaStream_t stream( nullptr );
+   cudaStreamCreateWithFlags( &stream, cudaStreamNonBlocking );
+   BLAZE_CUDA_ERROR_CHECK;
+
+   // The status is ignored: the CUDA context may already be gone at program exit
+   ctx.stream_.reset( stream, []( CUstream_st* s ) { cudaStreamDestroy( s ); } );
+#endif
+
+   return ctx;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Blocks until the work issued on the stream of the context has completed.
+//
+// \return void
+*/
+inline void CUDAExecutionContext::synchronize() const
+{
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+   cudaStreamSynchronize( stream() );
+   BLAZE_CUDA_COUNT( synchronizations, 1UL );
+   BLAZE_CUDA_ERROR_CHECK;
+#endif
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CURRENT CONTEXT
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+inline CUDAExecutionContext& cuda_execution_context_slot()
+{
+   thread_local CUDAExecutionContext ctx;
+   return ctx;
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the execution context of the calling thread.
+// \ingroup util
+//
+// \return The current context.
+*/
+inline const CUDAExecutionContext& cuda_execution_context()
+{
+   return cuda_execution_context_slot();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Sets the execution context of the calling thread.
+// \ingroup util
+//
+// \param ctx The new context.
+// \return void
+*/
+inline void set_cuda_execution_context( const CUDAExecutionContext& ctx )
+{
+   cuda_execution_context_slot() = ctx;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the stream of the execution context of the calling thread.
+// \ingroup util
+//
+// \return The current stream.
+*/
+inline cudaStream_t cuda_stream()
+{
+   return cuda_execution_context_slot().stream();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Scoped change of the execution context of the calling thread.
+// \ingroup util
+//
+// The previous context is restored when the guard goes out of scope.
+*/
+class CUDAExecutionContextGuard
+{
+ public:
+   explicit inline CUDAExecutionContextGuard( const CUDAExecutionContext& ctx )
+      : previous_( cuda_execution_context() )
+   {
+      set_cuda_execution_context( ctx );
+   }
+
+   CUDAExecutionContextGuard( const CUDAExecutionContextGuard& ) = delete;
+   CUDAExecutionContextGuard& operator=( const CUDAExecutionContextGuard& ) = delete;
+
+   inline ~CUDAExecutionContextGuard()
+   {
+      set_cuda_execution_context( previous_ );
+   }
+
+ private:
+   CUDAExecutionContext previous_;  //!< The context to be restored.
+};
+//*************************************************************************************************
+
+}  // namespace blaze
+
+#endif
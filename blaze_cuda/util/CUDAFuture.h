@@ -0,0 +1,240 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/CUDAFuture.h
+//  \brief Header file for the futures completed by CUDA stream callbacks
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_CUDAFUTURE_H_
+#define _BLAZE_CUDA_UTIL_CUDAFUTURE_H_
+
+#include <future>
+#include <mutex>
+#include <vector>
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <cuda_runtime.h>
+#endif
+
+#if defined(BLAZE_USE_HPX_THREADS)
+#  include <hpx/include/lcos.hpp>
+#endif
+
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAMemoryPool.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  PROMISE TYPES
+//
+//=================================================================================================
+
+#if defined(BLAZE_USE_HPX_THREADS)
+//*************************************************************************************************
+/*!\brief Promise type producing \c hpx::future results, e.g. \c async_assign<CUDAHPXPromise>().
+// \ingroup util
+*/
+template< typename T >
+using CUDAHPXPromise = hpx::lcos::local::promise<T>;
+//*************************************************************************************************
+#endif
+
+
+
+
+//=================================================================================================
+//
+//  RESULT SLOTS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+/*!\brief Recycled managed memory slots receiving the results of asynchronous reductions.
+// \ingroup util
+//
+// Stream callbacks must not call the CUDA API, so the slots are never freed: a callback hands
+// its slot back with release() and the next asynchronous operation reuses it.
+*/
+template< typename T >
+class CUDAResultSlots
+{
+ public:
+   inline T* acquire()
+   {
+      {
+         std::lock_guard<std::mutex> lock( mutex_ );
+         if( !free_.empty() ) {
+            T* const slot( free_.back() );
+            free_.pop_back();
+            return slot;
+         }
+      }
+
+      return static_cast<T*>( cuda_memory_pool().allocate( sizeof(T), cuda_stream() ) );
+   }
+
+   inline void release( T* slot ) noexcept
+   {
+      std::lock_guard<std::mutex> lock( mutex_ );
+      try {
+         free_.push_back( slot );
+      }
+      catch( ... ) {}  // The slot is leaked
+   }
+
+ private:
+   std::mutex mutex_;
+   std::vector<T*> free_;
+};
+
+template< typename T >
+inline CUDAResultSlots<T>& cuda_result_slots()
+{
+   static CUDAResultSlots<T>* slots = new CUDAResultSlots<T>();
+   return *slots;
+}
+/*! \endcond */
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  FUTURES
+//
+//=================================================================================================
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+//*************************************************************************************************
+/*! \cond BLAZE_INTERNAL */
+namespace cuda_future_detail {
+
+template< template< typename > class Promise >
+void CUDART_CB fulfill( void* data )
+{
+   Promise<void>* const promise( static_cast<Promise<void>*>( data ) );
+   promise->set_value();
+   delete promise;
+}
+
+template< template< typename > class Promise, typename T >
+struct ValueState
+{
+   Promise<T> promise;
+   T* slot;
+};
+
+template< template< typename > class Promise, typename T >
+void CUDART_CB fulfill_value( void* data )
+{
+   ValueState<Promise,T>* const state( static_cast<ValueState<Promise,T>*>( data ) );
+   state->promise.set_value( *state->slot );
+   cuda_result_slots<T>().release( state->slot );
+   delete state;
+}
+
+}  // namespace cuda_future_detail
+/*! \endcond */
+//*************************************************************************************************
+#endif
+
+
+//*************************************************************************************************
+/*!\brief Returns a future that becomes ready once the work submitted so far is done.
+// \ingroup util
+//
+// \return Future of type \c Promise<void>::get_future().
+//
+// The promise is fulfilled from a host function enqueued on the stream of the current execution
+// context, so no host thread blocks on the device. \a Promise can be \c std::promise or, with
+// HPX, CUDAHPXPromise.
+*/
+template< template< typename > class Promise = std::promise >
+inline auto cuda_completion_future()
+{
+   Promise<void>* const promise( new Promise<void>() );
+   auto future( promise->get_future() );
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   promise->set_value();
+   delete promise;
+#else
+   if( cudaLaunchHostFunc( cuda_stream(), &cuda_future_detail::fulfill<Promise>, promise ) != cudaSuccess ) {
+      delete promise;
+      BLAZE_CUDA_ERROR_CHECK;
+   }
+#endif
+
+   return future;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a future for the value written to \a slot by the work submitted so far.
+// \ingroup util
+//
+// \param slot Slot obtained from cuda_result_slots<T>().acquire(), released once read.
+// \return Future of type \c Promise<T>::get_future().
+*/
+template< template< typename > class Promise = std::promise, typename T >
+inline auto cuda_value_future( T* slot )
+{
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   Promise<T> promise;
+   auto future( promise.get_future() );
+   promise.set_value( *slot );
+   cuda_result_slots<T>().release( slot );
+   return future;
+#else
+   using State = cuda_future_detail::ValueState<Promise,T>;
+
+   State* const state( new State{ Promise<T>(), slot } );
+   auto future( state->promise.get_future() );
+
+   if( cudaLaunchHostFunc( cuda_stream(), &cuda_future_detail::fulfill_value<Promise,T>, state ) != cudaSuccess ) {
+      cuda_result_slots<T>().release( slot );
+      delete state;
+      BLAZE_CUDA_ERROR_CHECK;
+   }
+
+   return future;
+#endif
+}
+//*************************************************************************************************
+
+}  // namespace blaze
+
+#endif
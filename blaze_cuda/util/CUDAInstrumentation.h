@@ -0,0 +1,800 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/CUDAInstrumentation.h
+//  \brief Header file for the kernel launch and data movement instrumentation
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_CUDAINSTRUMENTATION_H_
+#define _BLAZE_CUDA_UTIL_CUDAINSTRUMENTATION_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/system/Signature.h>
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <cuda_runtime.h>
+#  if defined(__has_include)
+#    if __has_include(<nvtx3/nvToolsExt.h>)
+#      include <nvtx3/nvToolsExt.h>
+#      define BLAZE_CUDA_NVTX 1
+#    endif
+#  endif
+#endif
+
+
+//=================================================================================================
+//
+//  INSTRUMENTATION MACROS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Instrumentation hooks of the library.
+// \ingroup util
+//
+// The hooks are compiled in only if \c BLAZE_CUDA_INSTRUMENTATION is defined before the first
+// blaze_cuda header is included, and expand to nothing otherwise:
+//
+//  - BLAZE_CUDA_RANGE( name ) opens a CUDAScopedRange named \a name until the end of the scope.
+//  - BLAZE_CUDA_FUNCTION_RANGE opens a range named after the signature of the enclosing
+//    function, template arguments included, which gives one range per expression type.
+//  - BLAZE_CUDA_COUNT( counter, n ) adds \a n to the CUDACounters member \a counter.
+*/
+#if defined(BLAZE_CUDA_INSTRUMENTATION)
+#  define BLAZE_CUDA_RANGE( NAME ) \
+      ::blaze::CUDAScopedRange BLAZE_CUDA_RANGE_OBJECT( NAME )
+#  define BLAZE_CUDA_FUNCTION_RANGE \
+      BLAZE_CUDA_RANGE( BLAZE_SIGNATURE )
+#  define BLAZE_CUDA_COUNT( COUNTER, N ) \
+      ::blaze::cuda_instrumentation().count( &::blaze::CUDACounters::COUNTER, N )
+#else
+#  define BLAZE_CUDA_RANGE( NAME )
+#  define BLAZE_CUDA_FUNCTION_RANGE
+#  define BLAZE_CUDA_COUNT( COUNTER, N )
+#endif
+//*************************************************************************************************
+
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  COUNTERS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Counters of the work issued by the library.
+// \ingroup util
+//
+// With the host execution backend (\c BLAZE_CUDA_HOST_BACKEND) the host parallel loops standing
+// in for kernels are counted as launches.
+*/
+struct CUDACounters
+{
+   std::size_t launches         = 0UL;  //!< Number of kernel launches.
+   std::size_t bytes            = 0UL;  //!< Bytes read and written by the algorithms.
+   std::size_t transfers        = 0UL;  //!< Bytes copied between the device and the host.
+   std::size_t synchronizations = 0UL;  //!< Number of stream and device synchronizations.
+   std::size_t cublasCalls      = 0UL;  //!< Number of cuBLAS calls.
+   std::size_t cublasHandles    = 0UL;  //!< Number of cuBLAS handle creations.
+   std::size_t allocations      = 0UL;  //!< Number of CUDA managed allocations.
+   std::size_t allocatedBytes   = 0UL;  //!< Bytes of the CUDA managed allocations.
+
+   inline CUDACounters& operator+=( const CUDACounters& rhs ) noexcept;
+   inline CUDACounters& operator-=( const CUDACounters& rhs ) noexcept;
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Addition assignment of counters.
+//
+// \param rhs The counters to be added.
+// \return Reference to the counters.
+*/
+inline CUDACounters& CUDACounters::operator+=( const CUDACounters& rhs ) noexcept
+{
+   launches         += rhs.launches;
+   bytes            += rhs.bytes;
+   transfers        += rhs.transfers;
+   synchronizations += rhs.synchronizations;
+   cublasCalls      += rhs.cublasCalls;
+   cublasHandles    += rhs.cublasHandles;
+   allocations      += rhs.allocations;
+   allocatedBytes   += rhs.allocatedBytes;
+   return *this;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Subtraction assignment of counters.
+//
+// \param rhs The counters to be subtracted.
+// \return Reference to the counters.
+*/
+inline CUDACounters& CUDACounters::operator-=( const CUDACounters& rhs ) noexcept
+{
+   launches         -= rhs.launches;
+   bytes            -= rhs.bytes;
+   transfers        -= rhs.transfers;
+   synchronizations -= rhs.synchronizations;
+   cublasCalls      -= rhs.cublasCalls;
+   cublasHandles    -= rhs.cublasHandles;
+   allocations      -= rhs.allocations;
+   allocatedBytes   -= rhs.allocatedBytes;
+   return *this;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Summary of the executions of a range.
+// \ingroup util
+//
+// The counters and the time of a range include the ones of the ranges nested in it.
+*/
+struct CUDARangeStats
+{
+   std::size_t  calls    = 0UL;  //!< Number of executions of the range.
+   double       seconds  = 0.0;  //!< Total host time spent in the range.
+   CUDACounters counters;        //!< Work issued during the executions.
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  SINKS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Base class of the receivers of the instrumentation ranges.
+// \ingroup util
+//
+// Sinks are attached to cuda_instrumentation() and notified from the threads running the
+// ranges, which may be several at once: implementations must be thread-safe.
+*/
+class CUDAInstrumentationSink
+{
+ public:
+   virtual ~CUDAInstrumentationSink() = default;
+
+   /*!\brief Called when a range is opened.
+   //
+   // \param name The name of the range.
+   */
+   virtual void begin( const char* name ) { (void)name; }
+
+   /*!\brief Called when a range is closed.
+   //
+   // \param name The name of the range.
+   // \param start The opening time, in seconds since the creation of cuda_instrumentation().
+   // \param duration The time spent in the range, in seconds.
+   // \param counters The work issued by the calling thread during the range.
+   */
+   virtual void end( const char* name, double start, double duration, const CUDACounters& counters ) = 0;
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief In-memory summary of the instrumentation ranges, per range name.
+// \ingroup util
+//
+// Ranges opened by BLAZE_CUDA_FUNCTION_RANGE are named after the expression type they evaluate,
+// so the summary tells which expressions launch the most kernels:
+
+   \code
+   auto stats( std::make_shared<blaze::CUDAStatsSink>() );
+   blaze::cuda_instrumentation().attach( stats );
+   // ...
+   stats->print( std::cout );
+   \endcode
+*/
+class CUDAStatsSink : public CUDAInstrumentationSink
+{
+ public:
+   inline void end( const char* name, double start, double duration, const CUDACounters& counters ) override;
+
+   inline std::map< std::string, CUDARangeStats > summary() const;
+   inline CUDARangeStats stats( const std::string& name ) const;
+   inline void clear();
+   inline void print( std::ostream& os ) const;
+
+ private:
+   mutable std::mutex mutex_;                         //!< Protects the summary.
+   std::map< std::string, CUDARangeStats > ranges_;  //!< Summary per range name.
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Adds an execution of a range to the summary.
+*/
+inline void CUDAStatsSink::end( const char* name, double, double duration, const CUDACounters& counters )
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+
+   auto& range( ranges_[name] );
+   ++range.calls;
+   range.seconds  += duration;
+   range.counters += counters;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a copy of the summary.
+//
+// \return The statistics of every range name.
+*/
+inline std::map< std::string, CUDARangeStats > CUDAStatsSink::summary() const
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+   return ranges_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the statistics of a range name.
+//
+// \param name The range name.
+// \return The statistics, zero if the range was not executed.
+*/
+inline CUDARangeStats CUDAStatsSink::stats( const std::string& name ) const
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+
+   const auto range( ranges_.find( name ) );
+   return range != ranges_.end() ? range->second : CUDARangeStats();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Resets the summary.
+*/
+inline void CUDAStatsSink::clear()
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+   ranges_.clear();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Prints the summary, ranges with the most launches first.
+//
+// \param os The output stream.
+*/
+inline void CUDAStatsSink::print( std::ostream& os ) const
+{
+   const auto ranges( summary() );
+
+   std::vector< std::pair< std::string, CUDARangeStats > > sorted( ranges.begin(), ranges.end() );
+   std::stable_sort( sorted.begin(), sorted.end(), []( const auto& a, const auto& b ) {
+      return a.second.counters.launches > b.second.counters.launches;
+   } );
+
+   for( const auto& range : sorted ) {
+      const CUDACounters& c( range.second.counters );
+      os << range.first << '\n'
+         << "   calls " << range.second.calls << ", " << range.second.seconds * 1e3 << " ms"
+         << ", launches " << c.launches << ", bytes " << c.bytes << ", transfers " << c.transfers
+         << ", synchronizations " << c.synchronizations << ", cuBLAS calls " << c.cublasCalls
+         << ", cuBLAS handles " << c.cublasHandles << ", allocations " << c.allocations
+         << " (" << c.allocatedBytes << " bytes)\n";
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Writer of the instrumentation ranges in the Chrome trace event format.
+// \ingroup util
+//
+// Every range is recorded as a complete event with its counters as arguments. The trace is
+// written when the sink is destroyed, or by write(), and can be opened in \c chrome://tracing
+// or Perfetto.
+*/
+class CUDATraceSink : public CUDAInstrumentationSink
+{
+ public:
+   explicit inline CUDATraceSink( std::string path );
+   CUDATraceSink( const CUDATraceSink& ) = delete;
+   CUDATraceSink& operator=( const CUDATraceSink& ) = delete;
+   inline ~CUDATraceSink() override;
+
+   inline void end( const char* name, double start, double duration, const CUDACounters& counters ) override;
+
+   inline bool write() const;
+   inline const std::string& path() const noexcept { return path_; }
+
+ private:
+   static inline std::size_t thread_index();
+   static inline std::string escape( const char* name );
+
+   mutable std::mutex       mutex_;   //!< Protects the events.
+   std::string              path_;    //!< File the trace is written to.
+   std::vector<std::string> events_;  //!< The JSON records of the events.
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Constructor of a trace sink.
+//
+// \param path The file the trace is written to.
+*/
+inline CUDATraceSink::CUDATraceSink( std::string path )
+   : path_( std::move( path ) )
+{}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief The destructor, writes the trace.
+*/
+inline CUDATraceSink::~CUDATraceSink()
+{
+   write();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Records a range as a complete event.
+*/
+inline void CUDATraceSink::end( const char* name, double start, double duration, const CUDACounters& counters )
+{
+   std::ostringstream event;
+   event.precision( 3 );
+
+   event << std::fixed
+         << "{\"name\":\"" << escape( name ) << "\",\"cat\":\"blaze_cuda\",\"ph\":\"X\""
+         << ",\"ts\":" << start * 1e6 << ",\"dur\":" << duration * 1e6
+         << ",\"pid\":0,\"tid\":" << thread_index()
+         << ",\"args\":{\"launches\":" << counters.launches
+         << ",\"bytes\":" << counters.bytes
+         << ",\"transfers\":" << counters.transfers
+         << ",\"synchronizations\":" << counters.synchronizations
+         << ",\"cublasCalls\":" << counters.cublasCalls
+         << ",\"cublasHandles\":" << counters.cublasHandles
+         << ",\"allocations\":" << counters.allocations
+         << ",\"allocatedBytes\":" << counters.allocatedBytes << "}}";
+
+   std::lock_guard<std::mutex> lock( mutex_ );
+   events_.push_back( event.str() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Writes the events recorded so far to the file of the sink.
+//
+// \return \a false if the file could not be written.
+*/
+inline bool CUDATraceSink::write() const
+{
+   std::ofstream out( path_ );
+
+   if( !out )
+      return false;
+
+   std::lock_guard<std::mutex> lock( mutex_ );
+
+   out << "{\"traceEvents\":[\n";
+
+   for( std::size_t i = 0UL; i < events_.size(); ++i ) {
+      out << events_[i] << ( i + 1UL < events_.size() ? ",\n" : "\n" );
+   }
+
+   out << "],\"displayTimeUnit\":\"ms\"}\n";
+
+   return bool( out );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a small identifier of the calling thread, assigned on first use.
+*/
+inline std::size_t CUDATraceSink::thread_index()
+{
+   static std::atomic<std::size_t> count( 0UL );
+   thread_local const std::size_t index( count++ );
+   return index;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Escapes a range name for a JSON string.
+*/
+inline std::string CUDATraceSink::escape( const char* name )
+{
+   std::string res;
+
+   for( ; *name != '\0'; ++name ) {
+      const unsigned char c( *name );
+      if( c == '"' || c == '\\' ) {
+         res += '\\';
+         res += char( c );
+      }
+      else if( c < 0x20 ) {
+         char code[8];
+         std::snprintf( code, sizeof(code), "\\u%04x", unsigned( c ) );
+         res += code;
+      }
+      else {
+         res += char( c );
+      }
+   }
+
+   return res;
+}
+//*************************************************************************************************
+
+
+#if defined(BLAZE_CUDA_NVTX)
+//*************************************************************************************************
+/*!\brief Forwarder of the instrumentation ranges to NVTX, for Nsight Systems.
+// \ingroup util
+//
+// Only available when the NVTX v3 headers are found (\c BLAZE_CUDA_NVTX is then defined).
+*/
+class CUDANVTXSink : public CUDAInstrumentationSink
+{
+ public:
+   inline void begin( const char* name ) override { nvtxRangePushA( name ); }
+
+   inline void end( const char*, double, double, const CUDACounters& ) override { nvtxRangePop(); }
+};
+//*************************************************************************************************
+#endif
+
+
+
+
+//=================================================================================================
+//
+//  GLOBAL INSTRUMENTATION STATE
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Global state of the instrumentation: the totals of the counters and the attached sinks.
+// \ingroup util
+//
+// Counters are only updated by the hooks compiled in with \c BLAZE_CUDA_INSTRUMENTATION, ranges
+// are only timed when at least one sink is attached.
+*/
+class CUDAInstrumentation
+{
+ public:
+   //**Type definitions****************************************************************************
+   using Sinks = std::vector< std::shared_ptr<CUDAInstrumentationSink> >;  //!< Attached sinks.
+   //**********************************************************************************************
+
+   //**Constructor*********************************************************************************
+   inline CUDAInstrumentation();
+   CUDAInstrumentation( const CUDAInstrumentation& ) = delete;
+   CUDAInstrumentation& operator=( const CUDAInstrumentation& ) = delete;
+   //**********************************************************************************************
+
+   //**Sink functions******************************************************************************
+   inline void attach( std::shared_ptr<CUDAInstrumentationSink> sink );
+   inline void detach( const std::shared_ptr<CUDAInstrumentationSink>& sink );
+   inline std::shared_ptr<const Sinks> sinks() const;
+   inline bool active() const noexcept { return active_.load( std::memory_order_relaxed ); }
+   //**********************************************************************************************
+
+   //**Counter functions***************************************************************************
+   inline void count( std::size_t CUDACounters::* counter, std::size_t n ) noexcept;
+   inline CUDACounters totals() const;
+   inline void reset();
+   static inline CUDACounters& thread_counters() noexcept;
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   inline double now() const noexcept;
+   inline bool synchronizing() const noexcept { return synchronizing_.load( std::memory_order_relaxed ); }
+   inline void setSynchronizing( bool synchronizing ) noexcept { synchronizing_ = synchronizing; }
+   //**********************************************************************************************
+
+ private:
+   //**Member variables****************************************************************************
+   mutable std::mutex mutex_;             //!< Protects the totals and the sinks.
+   CUDACounters totals_;                  //!< Totals of the counters over all threads.
+   std::shared_ptr<const Sinks> sinks_;   //!< The attached sinks, replaced on change.
+   std::atomic<bool> active_;             //!< Whether at least one sink is attached.
+   std::atomic<bool> synchronizing_;      //!< Whether ranges wait for the device work they issued.
+   const std::chrono::steady_clock::time_point epoch_;  //!< Origin of the range times.
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Default constructor of the instrumentation state.
+*/
+inline CUDAInstrumentation::CUDAInstrumentation()
+   : sinks_        ( std::make_shared<const Sinks>() )
+   , active_       ( false )
+   , synchronizing_( false )
+   , epoch_        ( std::chrono::steady_clock::now() )
+{}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Attaches a sink, which receives the ranges closed from now on.
+//
+// \param sink The sink.
+*/
+inline void CUDAInstrumentation::attach( std::shared_ptr<CUDAInstrumentationSink> sink )
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+
+   auto sinks( std::make_shared<Sinks>( *sinks_ ) );
+   sinks->push_back( std::move( sink ) );
+   sinks_ = std::move( sinks );
+   active_ = true;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Detaches a sink.
+//
+// \param sink The sink.
+//
+// Ranges already opened may still notify the sink when they are closed.
+*/
+inline void CUDAInstrumentation::detach( const std::shared_ptr<CUDAInstrumentationSink>& sink )
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+
+   auto sinks( std::make_shared<Sinks>( *sinks_ ) );
+   sinks->erase( std::remove( sinks->begin(), sinks->end(), sink ), sinks->end() );
+   active_ = !sinks->empty();
+   sinks_ = std::move( sinks );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the attached sinks.
+//
+// \return Shared, immutable list of the sinks.
+*/
+inline std::shared_ptr<const CUDAInstrumentation::Sinks> CUDAInstrumentation::sinks() const
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+   return sinks_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Adds \a n to a counter of the calling thread and to its total.
+//
+// \param counter The counter, a member of CUDACounters.
+// \param n The value to be added.
+*/
+inline void CUDAInstrumentation::count( std::size_t CUDACounters::* counter, std::size_t n ) noexcept
+{
+   thread_counters().*counter += n;
+
+   std::lock_guard<std::mutex> lock( mutex_ );
+   totals_.*counter += n;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the totals of the counters over all threads.
+*/
+inline CUDACounters CUDAInstrumentation::totals() const
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+   return totals_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Resets the totals of the counters.
+*/
+inline void CUDAInstrumentation::reset()
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+   totals_ = CUDACounters();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the counters of the calling thread, which are never reset.
+*/
+inline CUDACounters& CUDAInstrumentation::thread_counters() noexcept
+{
+   thread_local CUDACounters counters;
+   return counters;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the time elapsed since the creation of the instrumentation state.
+//
+// \return The time in seconds.
+*/
+inline double CUDAInstrumentation::now() const noexcept
+{
+   return std::chrono::duration<double>( std::chrono::steady_clock::now() - epoch_ ).count();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the instrumentation state of the library.
+// \ingroup util
+//
+// \return Reference to the global instrumentation state.
+//
+// A CUDATraceSink writing to the file named by the BLAZE_CUDA_TRACE environment variable is
+// attached if the variable is set, the trace being written at program exit.
+*/
+inline CUDAInstrumentation& cuda_instrumentation()
+{
+   static CUDAInstrumentation instrumentation;
+   static const bool traced( [] {
+      const char* path( std::getenv( "BLAZE_CUDA_TRACE" ) );
+      if( path != nullptr && path[0] != '\0' )
+         instrumentation.attach( std::make_shared<CUDATraceSink>( path ) );
+      return true;
+   }() );
+
+   (void)traced;
+   return instrumentation;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  SCOPED RANGES
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Named instrumentation range, from its construction to its destruction.
+// \ingroup util
+//
+// The range is reported to the sinks attached to cuda_instrumentation() with the host time it
+// lasted and the counters of the work the calling thread issued meanwhile. Kernels run
+// asynchronously, so the time only includes their execution if the range waits for the device
+// before closing, see CUDAInstrumentation::setSynchronizing(). Nothing is measured if no sink
+// is attached.
+*/
+class CUDAScopedRange
+{
+ public:
+   explicit inline CUDAScopedRange( const char* name );
+   CUDAScopedRange( const CUDAScopedRange& ) = delete;
+   CUDAScopedRange& operator=( const CUDAScopedRange& ) = delete;
+   inline ~CUDAScopedRange();
+
+ private:
+   const char*                                        name_;      //!< The name of the range.
+   std::shared_ptr<const CUDAInstrumentation::Sinks>  sinks_;     //!< The sinks notified, if any.
+   double                                             start_;     //!< The opening time.
+   CUDACounters                                       counters_;  //!< The thread counters at opening.
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Opens a range.
+//
+// \param name The name of the range, which must outlive it.
+*/
+inline CUDAScopedRange::CUDAScopedRange( const char* name )
+   : name_ ( name )
+   , start_( 0.0 )
+{
+   CUDAInstrumentation& instrumentation( cuda_instrumentation() );
+
+   if( !instrumentation.active() )
+      return;
+
+   sinks_    = instrumentation.sinks();
+   counters_ = CUDAInstrumentation::thread_counters();
+
+   for( const auto& sink : *sinks_ )
+      sink->begin( name_ );
+
+   start_ = instrumentation.now();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Closes the range and reports it to the sinks.
+*/
+inline CUDAScopedRange::~CUDAScopedRange()
+{
+   if( !sinks_ )
+      return;
+
+   CUDAInstrumentation& instrumentation( cuda_instrumentation() );
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+   if( instrumentation.synchronizing() )
+      cudaDeviceSynchronize();
+#endif
+
+   const double duration( instrumentation.now() - start_ );
+
+   CUDACounters counters( CUDAInstrumentation::thread_counters() );
+   counters -= counters_;
+
+   for( auto sink = sinks_->rbegin(); sink != sinks_->rend(); ++sink )
+      (*sink)->end( name_, start_, duration, counters );
+}
+//*************************************************************************************************
+
+}  // namespace blaze
+
+#endif
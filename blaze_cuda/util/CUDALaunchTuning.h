@@ -0,0 +1,504 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/CUDALaunchTuning.h
+//  \brief Header file for the tuned launch configurations of the CUDA kernels
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_CUDALAUNCHTUNING_H_
+#define _BLAZE_CUDA_UTIL_CUDALAUNCHTUNING_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <cuda_runtime.h>
+#  include <blaze_cuda/util/CUDAErrorManagement.h>
+#  include <blaze_cuda/util/CUDAExecutionContext.h>
+#endif
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  LAUNCH CONFIGURATIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Template argument value selecting the tuned launch configuration of a kernel.
+// \ingroup util
+//
+// The Unroll and BlockSizeExponent template parameters of cuda_transform() and cuda_reduce()
+// default to cuda_tuned: the launch configuration is then looked up in cuda_launch_table().
+// Setting them explicitly bypasses the table.
+*/
+constexpr std::size_t cuda_tuned = 0UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Launch configuration of a grid-stride kernel.
+// \ingroup util
+*/
+struct CUDALaunchConfig
+{
+   std::size_t blockSize;  //!< Number of threads per block.
+   std::size_t unroll;     //!< Number of elements per thread and grid stride.
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the name of an element type in the launch table.
+// \ingroup util
+//
+// \return "f", "i" or "u" followed by the number of bits for arithmetic types, "b" followed by
+//         the number of bytes otherwise.
+*/
+template< typename T >
+inline const std::string& cuda_launch_type_name()
+{
+   static const std::string name(
+      std::is_floating_point<T>::value ? "f" + std::to_string( sizeof(T) * 8UL ) :
+      std::is_integral<T>::value       ? ( std::is_signed<T>::value ? "i" : "u" ) + std::to_string( sizeof(T) * 8UL ) :
+                                         "b" + std::to_string( sizeof(T) ) );
+   return name;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Table of the tuned launch configurations.
+// \ingroup util
+//
+// Configurations are indexed by kernel class ("reduce", "unary_transform", ...), element type
+// (see cuda_launch_type_name()) and size bucket, the bucket of a size being its base 2
+// logarithm. A single configuration is far from optimal for both small and large sizes: small
+// ranges want few elements per thread to occupy the device, large ones want more work per
+// thread to amortize the block scheduling.
+//
+// The table is stored as a text file with one configuration per line:
+
+   \code
+   # kernel type bucket blockSize unroll
+   reduce f32 20 256 16
+   \endcode
+
+// Missing configurations are either tuned on first use, when the kernel class allows it and
+// tuning is enabled, or replaced by the default configuration of the kernel class.
+*/
+class CUDALaunchTable
+{
+ public:
+   //**Constants***********************************************************************************
+   static constexpr std::size_t buckets = 64UL;  //!< Number of size buckets.
+   //**********************************************************************************************
+
+   //**Constructor*********************************************************************************
+   explicit inline CUDALaunchTable( std::string path = std::string(), bool tuning = false );
+   CUDALaunchTable( const CUDALaunchTable& ) = delete;
+   CUDALaunchTable& operator=( const CUDALaunchTable& ) = delete;
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   static inline std::size_t bucket( std::size_t size ) noexcept;
+
+   inline bool find( const std::string& kernel, const std::string& type, std::size_t size
+                   , CUDALaunchConfig& config ) const;
+   inline void insert( const std::string& kernel, const std::string& type, std::size_t size
+                     , const CUDALaunchConfig& config );
+
+   template< typename Tune >
+   inline CUDALaunchConfig lookup( const std::string& kernel, const std::string& type
+                                 , std::size_t size, const CUDALaunchConfig& fallback, Tune tune );
+
+   inline bool load( const std::string& path );
+   inline bool save( const std::string& path ) const;
+   inline bool save() const;
+
+   inline const std::string& path() const noexcept { return path_; }
+   inline bool tuning() const noexcept { return tuning_; }
+   inline void setTuning( bool tuning ) noexcept { tuning_ = tuning; }
+   //**********************************************************************************************
+
+ private:
+   //**Type definitions****************************************************************************
+   //! Configurations of a kernel class and element type, unset ones have a zero block size.
+   using Row = std::array< CUDALaunchConfig, buckets >;
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   mutable std::mutex mutex_;  //!< Protects the configurations.
+
+   std::map< std::pair< std::string, std::string >, Row > rows_;  //!< Configurations.
+
+   std::string path_;    //!< File the table is loaded from and saved to.
+   bool        tuning_;  //!< Whether missing configurations are tuned on first use.
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CONSTRUCTOR
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Constructor of a launch table.
+//
+// \param path The file the table is loaded from and saved to, none if empty.
+// \param tuning Whether missing configurations are tuned on first use.
+*/
+inline CUDALaunchTable::CUDALaunchTable( std::string path, bool tuning )
+   : path_  ( std::move( path ) )
+   , tuning_( tuning )
+{
+   if( !path_.empty() )
+      load( path_ );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the size bucket of a range of \a size elements.
+//
+// \param size The number of elements.
+// \return The base 2 logarithm of \a size, 0 for empty ranges.
+*/
+inline std::size_t CUDALaunchTable::bucket( std::size_t size ) noexcept
+{
+   std::size_t res( 0UL );
+   while( size > 1UL ) {
+      size >>= 1;
+      ++res;
+   }
+   return res;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Looks for the configuration of a kernel class, element type and size.
+//
+// \param kernel The kernel class.
+// \param type The element type name.
+// \param size The number of elements.
+// \param config The configuration, set if found.
+// \return \a true if a configuration was found.
+*/
+inline bool CUDALaunchTable::find( const std::string& kernel, const std::string& type
+                                 , std::size_t size, CUDALaunchConfig& config ) const
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+
+   const auto row( rows_.find( std::make_pair( kernel, type ) ) );
+
+   if( row == rows_.end() || row->second[ bucket( size ) ].blockSize == 0UL )
+      return false;
+
+   config = row->second[ bucket( size ) ];
+   return true;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Sets the configuration of a kernel class, element type and size bucket.
+//
+// \param kernel The kernel class.
+// \param type The element type name.
+// \param size A number of elements of the bucket.
+// \param config The configuration.
+*/
+inline void CUDALaunchTable::insert( const std::string& kernel, const std::string& type
+                                   , std::size_t size, const CUDALaunchConfig& config )
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+
+   auto& row( rows_[ std::make_pair( kernel, type ) ] );
+   row[ bucket( size ) ] = config;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the configuration of a kernel class, element type and size.
+//
+// \param kernel The kernel class.
+// \param type The element type name.
+// \param size The number of elements.
+// \param fallback The configuration used when none is found and tuning is disabled.
+// \param tune Callable returning the best configuration for \a size, called if tuning is enabled.
+// \return The configuration.
+//
+// A tuned configuration is inserted and the table saved to its file.
+*/
+template< typename Tune >
+inline CUDALaunchConfig
+   CUDALaunchTable::lookup( const std::string& kernel, const std::string& type
+                          , std::size_t size, const CUDALaunchConfig& fallback, Tune tune )
+{
+   CUDALaunchConfig config( fallback );
+
+   if( find( kernel, type, size, config ) || !tuning_ )
+      return config;
+
+   config = tune();
+   insert( kernel, type, size, config );
+   save();
+
+   return config;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Loads configurations from a file.
+//
+// \param path The file.
+// \return \a false if the file could not be read.
+//
+// Configurations are added to the ones in the table, lines that cannot be parsed are ignored.
+*/
+inline bool CUDALaunchTable::load( const std::string& path )
+{
+   std::ifstream in( path );
+
+   if( !in )
+      return false;
+
+   std::string line;
+
+   while( std::getline( in, line ) )
+   {
+      if( line.empty() || line[0] == '#' )
+         continue;
+
+      std::istringstream fields( line );
+      std::string kernel, type;
+      std::size_t bucket( 0UL );
+      CUDALaunchConfig config{ 0UL, 0UL };
+
+      if( !( fields >> kernel >> type >> bucket >> config.blockSize >> config.unroll ) ||
+          bucket >= buckets || config.blockSize == 0UL || config.unroll == 0UL )
+         continue;
+
+      std::lock_guard<std::mutex> lock( mutex_ );
+      rows_[ std::make_pair( kernel, type ) ][ bucket ] = config;
+   }
+
+   return true;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Saves the configurations to a file.
+//
+// \param path The file.
+// \return \a false if the file could not be written.
+*/
+inline bool CUDALaunchTable::save( const std::string& path ) const
+{
+   std::ofstream out( path );
+
+   if( !out )
+      return false;
+
+   std::lock_guard<std::mutex> lock( mutex_ );
+
+   out << "# kernel type bucket blockSize unroll\n";
+
+   for( const auto& row : rows_ ) {
+      for( std::size_t i = 0UL; i < buckets; ++i ) {
+         if( row.second[i].blockSize != 0UL ) {
+            out << row.first.first << ' ' << row.first.second << ' ' << i << ' '
+                << row.second[i].blockSize << ' ' << row.second[i].unroll << '\n';
+         }
+      }
+   }
+
+   return bool( out );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Saves the configurations to the file of the table, if any.
+//
+// \return \a false if the table has a file that could not be written.
+*/
+inline bool CUDALaunchTable::save() const
+{
+   return path_.empty() || save( path_ );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  GLOBAL LAUNCH TABLE
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the launch table used by the kernels of the library.
+// \ingroup util
+//
+// \return Reference to the global launch table.
+//
+// The table is loaded from the file named by the BLAZE_CUDA_LAUNCH_TABLE environment variable,
+// if set, and first use tuning is enabled by setting BLAZE_CUDA_AUTOTUNE to a non-zero value.
+// Tuned configurations are then saved back to the file.
+*/
+inline CUDALaunchTable& cuda_launch_table()
+{
+   static CUDALaunchTable table( [] {
+      const char* path( std::getenv( "BLAZE_CUDA_LAUNCH_TABLE" ) );
+      return std::string( path != nullptr ? path : "" );
+   }(), [] {
+      const char* tuning( std::getenv( "BLAZE_CUDA_AUTOTUNE" ) );
+      return tuning != nullptr && tuning[0] != '\0' && std::string( tuning ) != "0";
+   }() );
+
+   return table;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  TUNING
+//
+//=================================================================================================
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+
+//*************************************************************************************************
+/*!\brief Returns the average duration in milliseconds of the work submitted by \a f.
+// \ingroup util
+//
+// \param f Callable submitting work to the stream of the current execution context.
+// \param repetitions The number of timed calls, after one warm-up call.
+// \return The average duration of a call.
+*/
+template< typename F >
+inline float cuda_time_launch( F&& f, std::size_t repetitions = 3UL )
+{
+   cudaEvent_t start, stop;
+   cudaEventCreate( &start );
+   cudaEventCreate( &stop );
+
+   f();
+
+   cudaEventRecord( start, cuda_stream() );
+   for( std::size_t i = 0UL; i < repetitions; ++i )
+      f();
+   cudaEventRecord( stop, cuda_stream() );
+   cudaEventSynchronize( stop );
+
+   float ms( 0.0F );
+   cudaEventElapsedTime( &ms, start, stop );
+
+   cudaEventDestroy( start );
+   cudaEventDestroy( stop );
+   BLAZE_CUDA_ERROR_CHECK;
+
+   return ms / float( repetitions );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the fastest of the given configurations.
+// \ingroup util
+//
+// \param candidates The candidate configurations.
+// \param launch Callable submitting the work of a configuration.
+// \return The configuration with the smallest average duration.
+*/
+template< std::size_t N, typename Launch >
+inline CUDALaunchConfig cuda_fastest_config( const std::array< CUDALaunchConfig, N >& candidates
+                                           , Launch launch )
+{
+   CUDALaunchConfig best( candidates[0] );
+   float best_ms( std::numeric_limits<float>::max() );
+
+   for( const auto& config : candidates ) {
+      const float ms( cuda_time_launch( [&] { launch( config ); } ) );
+      if( ms < best_ms ) {
+         best_ms = ms;
+         best = config;
+      }
+   }
+
+   return best;
+}
+//*************************************************************************************************
+
+#endif // BLAZE_CUDA_HOST_BACKEND
+
+}  // namespace blaze
+
+#endif
@@ -45,7 +45,9 @@
 #include <blaze/util/Memory.h>
 #include <blaze/util/typetraits/AlignmentOf.h>
 
-#include <cuda_runtime.h>
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <cuda_runtime.h>
+#endif
 
 namespace blaze_cuda {
 
@@ -278,7 +280,11 @@ inline void CUDAManagedAllocator<Type>::deallocate( Pointer ptr, size_t numObjec
    if( ptr == nullptr )
       return;
 
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   blaze::deallocate_backend( ptr );
+#else
    cudaFree( ptr );
+#endif
 }
 //*************************************************************************************************
 
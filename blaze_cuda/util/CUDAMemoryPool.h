@@ -0,0 +1,704 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/CUDAMemoryPool.h
+//  \brief Header file for the caching CUDA memory pool
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_CUDAMEMORYPOOL_H_
+#define _BLAZE_CUDA_UTIL_CUDAMEMORYPOOL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <blaze/util/Memory.h>
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <cuda_runtime.h>
+#endif
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  MEMORY BACKENDS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Completion events of the blocks cached by the CUDA memory backends.
+// \ingroup util
+//
+// A freed block is cached together with an event recorded on the stream it was last used on,
+// which completes once the kernels reading or writing the block are done. record() creates the
+// event on first use and returns \c false on failure, ready() tells whether the event has
+// completed. With the host execution backend (\c BLAZE_CUDA_HOST_BACKEND) the kernels run
+// synchronously and the events are always complete.
+*/
+struct CUDAStreamEvents
+{
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   using Event = const void*;
+
+   static inline bool record( Event&, const void* ) noexcept { return true; }
+   static inline bool ready( Event ) noexcept { return true; }
+   static inline void destroy( Event ) noexcept {}
+#else
+   using Event = cudaEvent_t;
+
+   static inline bool record( Event& event, const void* stream ) noexcept
+   {
+      if( event == nullptr && cudaEventCreateWithFlags( &event, cudaEventDisableTiming ) != cudaSuccess ) {
+         cudaGetLastError();  // Resets the error state
+         event = nullptr;
+         return false;
+      }
+
+      if( cudaEventRecord( event, toStream( stream ) ) != cudaSuccess ) {
+         cudaGetLastError();  // Resets the error state
+         return false;
+      }
+
+      return true;
+   }
+
+   static inline bool ready( Event event ) noexcept
+   {
+      const cudaError_t status( cudaEventQuery( event ) );
+      if( status != cudaSuccess && status != cudaErrorNotReady )
+         cudaGetLastError();  // Resets the error state
+      return status == cudaSuccess;
+   }
+
+   static inline void destroy( Event event ) noexcept
+   {
+      if( event != nullptr )
+         cudaEventDestroy( event );
+   }
+
+ protected:
+   static inline cudaStream_t toStream( const void* stream ) noexcept
+   {
+      return static_cast<cudaStream_t>( const_cast<void*>( stream ) );
+   }
+#endif
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief CUDA managed memory backend of the memory pool.
+// \ingroup util
+//
+// A memory backend provides the static allocate() and deallocate() functions used by the pool
+// to obtain and release blocks. allocate() returns \c nullptr on failure. It also provides the
+// completion events of the cached blocks (see CUDAStreamEvents) and wait(), which orders the
+// reuse of a block after its pending kernels. Managed memory is written by the host as soon as
+// it is handed out, so wait() blocks the calling thread until the event completes.
+*/
+struct CUDAManagedMemoryBackend : public CUDAStreamEvents
+{
+   static inline void* allocate( std::size_t size ) noexcept
+   {
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+      try {
+         return allocate_backend( size, 64UL );
+      }
+      catch( ... ) {
+         return nullptr;
+      }
+#else
+      void* raw( nullptr );
+      if( cudaMallocManaged( &raw, size ) != cudaSuccess ) {
+         cudaGetLastError();  // Resets the error state
+         return nullptr;
+      }
+      return raw;
+#endif
+   }
+
+   static inline void deallocate( void* address ) noexcept
+   {
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+      deallocate_backend( address );
+#else
+      cudaFree( address );
+#endif
+   }
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   static inline void wait( Event, const void* ) noexcept {}
+#else
+   static inline void wait( Event event, const void* /*stream*/ ) noexcept
+   {
+      cudaEventSynchronize( event );
+   }
+#endif
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief CUDA device memory backend of the memory pool.
+// \ingroup util
+//
+// Plain device memory (cudaMalloc()) is not accessible from the host. With the host execution
+// backend (\c BLAZE_CUDA_HOST_BACKEND) it is cache line aligned host memory. As the memory is
+// only accessed by kernels, wait() orders the reuse of a block on the device: the stream of the
+// new allocation waits for the event, the calling thread does not.
+*/
+struct CUDADeviceMemoryBackend : public CUDAStreamEvents
+{
+   static inline void* allocate( std::size_t size ) noexcept
+   {
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+      return CUDAManagedMemoryBackend::allocate( size );
+#else
+      void* raw( nullptr );
+      if( cudaMalloc( &raw, size ) != cudaSuccess ) {
+         cudaGetLastError();  // Resets the error state
+         return nullptr;
+      }
+      return raw;
+#endif
+   }
+
+   static inline void deallocate( void* address ) noexcept
+   {
+      CUDAManagedMemoryBackend::deallocate( address );
+   }
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   static inline void wait( Event, const void* ) noexcept {}
+#else
+   static inline void wait( Event event, const void* stream ) noexcept
+   {
+      cudaStreamWaitEvent( toStream( stream ), event, 0U );
+   }
+#endif
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Host \c malloc() backend of the memory pool, used to test the pool logic.
+// \ingroup util
+//
+// The stream tags are not interpreted and the cached blocks are always ready for reuse.
+*/
+struct HostMallocMemoryBackend
+{
+   using Event = const void*;
+
+   static inline void* allocate( std::size_t size ) noexcept { return std::malloc( size ); }
+   static inline void deallocate( void* address ) noexcept { std::free( address ); }
+
+   static inline bool record( Event&, const void* ) noexcept { return true; }
+   static inline bool ready( Event ) noexcept { return true; }
+   static inline void wait( Event, const void* ) noexcept {}
+   static inline void destroy( Event ) noexcept {}
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Statistics of a memory pool.
+// \ingroup util
+*/
+struct CUDAMemoryPoolStatistics
+{
+   std::size_t allocations         = 0UL;  //!< Number of allocations served.
+   std::size_t hits                = 0UL;  //!< Number of allocations served from the cache.
+   std::size_t waits               = 0UL;  //!< Number of hits waiting for pending kernels.
+   std::size_t backendAllocations  = 0UL;  //!< Number of blocks obtained from the backend.
+   std::size_t backendDeallocations= 0UL;  //!< Number of blocks released to the backend.
+   std::size_t bytesInUse          = 0UL;  //!< Bytes currently handed out (rounded to classes).
+   std::size_t bytesCached         = 0UL;  //!< Bytes held in the free lists.
+   std::size_t peakBytesInUse      = 0UL;  //!< High-water mark of bytesInUse.
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Caching memory pool with size classes.
+// \ingroup util
+//
+// Requests are rounded up to a size class and served from the free list of that class when
+// possible. Freed blocks go back to their free list instead of being released to the backend,
+// which avoids both the cost of cudaMallocManaged() and the device synchronization implied by
+// cudaFree(). The size classes are the multiples of a quarter of a power of two (e.g. 1024,
+// 1280, 1536, 1792, 2048, 2560, ...), which bounds the internal fragmentation to 25%.
+//
+// The number of cached bytes can be bounded via setCacheLimit(): blocks freed while the cache is
+// full are released to the backend. trim() releases all cached blocks. When the backend fails to
+// allocate, the cache is trimmed and the allocation retried once.
+//
+// Allocations are tagged with the stream they are issued on (see CUDAExecutionContext). When a
+// block is freed, an event is recorded on the stream it was last used on, and the block may then
+// serve an allocation on any stream. Blocks whose event has completed are reused first; otherwise
+// the reuse waits for the event via the wait() function of the backend, so that neither a kernel
+// on another stream nor the host writes to a block still accessed by pending kernels.
+*/
+template< typename Backend >  // Type of the memory backend
+class BasicCUDAMemoryPool
+{
+ public:
+   //**Constants***********************************************************************************
+   static constexpr std::size_t minBlockSize = 512UL;  //!< Size of the smallest size class.
+   //**********************************************************************************************
+
+   //**Constructor and destructor******************************************************************
+   BasicCUDAMemoryPool() = default;
+   BasicCUDAMemoryPool( const BasicCUDAMemoryPool& ) = delete;
+   BasicCUDAMemoryPool& operator=( const BasicCUDAMemoryPool& ) = delete;
+
+   inline ~BasicCUDAMemoryPool();
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   static inline std::size_t sizeClass( std::size_t size ) noexcept;
+
+   inline void* allocate( std::size_t size, const void* stream = nullptr );
+   inline void  deallocate( const void* address ) noexcept;
+   inline void  deallocate( const void* address, const void* stream ) noexcept;
+   inline void  trim() noexcept;
+
+   inline void        setCacheLimit( std::size_t bytes ) noexcept;
+   inline std::size_t cacheLimit() const noexcept;
+
+   inline CUDAMemoryPoolStatistics statistics() const;
+   //**********************************************************************************************
+
+ private:
+   //**Type definitions****************************************************************************
+   using Event = typename Backend::Event;  //!< Completion event of a cached block.
+
+   //! Cached block.
+   struct Block {
+      void* address;  //!< Address of the block.
+      Event event;    //!< Event recorded on the stream the block was last used on.
+   };
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   inline void release( const void* address, const void* stream, bool tagged ) noexcept;
+   inline void trimTo( std::size_t bytes ) noexcept;
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   mutable std::mutex mutex_;  //!< Protects all other members.
+
+   //! Free lists, indexed by size class.
+   std::map< std::size_t, std::vector<Block> > free_;
+
+   //! Size classes and streams of the live blocks.
+   std::unordered_map< const void*, std::pair< std::size_t, const void* > > live_;
+
+   std::vector<Event> events_;  //!< Events of the reused blocks, recycled by later frees.
+
+   std::size_t cacheLimit_ = std::numeric_limits<std::size_t>::max();  //!< Bound on bytesCached.
+   CUDAMemoryPoolStatistics stats_;  //!< Pool statistics.
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Destructor of the memory pool, releasing all cached blocks and events.
+*/
+template< typename Backend >
+inline BasicCUDAMemoryPool<Backend>::~BasicCUDAMemoryPool()
+{
+   trim();
+
+   for( Event event : events_ )
+      Backend::destroy( event );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the size class of a request of \a size bytes.
+//
+// \param size The requested number of bytes.
+// \return The number of bytes of the block serving the request.
+*/
+template< typename Backend >
+inline std::size_t BasicCUDAMemoryPool<Backend>::sizeClass( std::size_t size ) noexcept
+{
+   if( size <= minBlockSize )
+      return minBlockSize;
+
+   std::size_t base( minBlockSize );
+   while( base <= size / 2UL )
+      base *= 2UL;
+
+   // base <= size < 2*base: rounding up to a multiple of base/4
+   const std::size_t step( base / 4UL );
+   return ( ( size + step - 1UL ) / step ) * step;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Allocates a block of at least \a size bytes.
+//
+// \param size The number of bytes to be allocated.
+// \param stream The stream the block is used on.
+// \return Pointer to the allocated block.
+// \exception std::bad_alloc Allocation failed.
+//
+// A cached block whose kernels are done is preferred. Otherwise the most recently freed block
+// of the size class is reused after waiting for its event.
+*/
+template< typename Backend >
+inline void* BasicCUDAMemoryPool<Backend>::allocate( std::size_t size, const void* stream )
+{
+   const std::size_t bytes( sizeClass( size ) );
+
+   std::unique_lock<std::mutex> lock( mutex_ );
+
+   void* address( nullptr );
+
+   auto list( free_.find( bytes ) );
+   if( list != free_.end() && !list->second.empty() )
+   {
+      std::vector<Block>& blocks( list->second );
+
+      auto ready( std::find_if( blocks.rbegin(), blocks.rend(), []( const Block& b ) {
+         return Backend::ready( b.event );
+      } ) );
+
+      const bool pending( ready == blocks.rend() );
+      const Block block( pending ? blocks.back() : *ready );
+
+      blocks.erase( pending ? std::prev( blocks.end() ) : std::next( ready ).base() );
+      stats_.bytesCached -= bytes;
+      ++stats_.hits;
+
+      // The block is no longer listed, waiting does not hold up the other threads
+      if( pending ) {
+         ++stats_.waits;
+         lock.unlock();
+         Backend::wait( block.event, stream );
+         lock.lock();
+      }
+
+      address = block.address;
+
+      try {
+         events_.push_back( block.event );
+      }
+      catch( ... ) {
+         Backend::destroy( block.event );
+      }
+   }
+   else {
+      address = Backend::allocate( bytes );
+
+      if( address == nullptr ) {
+         trimTo( 0UL );
+         address = Backend::allocate( bytes );
+      }
+
+      if( address == nullptr )
+         throw std::bad_alloc();
+
+      ++stats_.backendAllocations;
+   }
+
+   live_.emplace( address, std::make_pair( bytes, stream ) );
+
+   ++stats_.allocations;
+   stats_.bytesInUse += bytes;
+   if( stats_.bytesInUse > stats_.peakBytesInUse )
+      stats_.peakBytesInUse = stats_.bytesInUse;
+
+   return address;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a block to the pool.
+//
+// \param address The address of a block previously returned by allocate().
+// \return void
+//
+// The block is reused once the kernels issued on the stream it was allocated on are done.
+// Addresses unknown to the pool are handed to the backend directly.
+*/
+template< typename Backend >
+inline void BasicCUDAMemoryPool<Backend>::deallocate( const void* address ) noexcept
+{
+   release( address, nullptr, false );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a block last used on the given stream to the pool.
+//
+// \param address The address of a block previously returned by allocate().
+// \param stream The stream the block was last used on.
+// \return void
+//
+// The block is reused once the kernels issued on \a stream are done. Addresses unknown to the
+// pool are handed to the backend directly.
+*/
+template< typename Backend >
+inline void BasicCUDAMemoryPool<Backend>::deallocate( const void* address, const void* stream ) noexcept
+{
+   release( address, stream, true );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Releases all cached blocks to the backend.
+//
+// \return void
+*/
+template< typename Backend >
+inline void BasicCUDAMemoryPool<Backend>::trim() noexcept
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+   trimTo( 0UL );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Sets the maximum number of bytes kept in the free lists.
+//
+// \param bytes The new cache limit.
+// \return void
+//
+// Cached blocks beyond the new limit are released immediately, largest first.
+*/
+template< typename Backend >
+inline void BasicCUDAMemoryPool<Backend>::setCacheLimit( std::size_t bytes ) noexcept
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+   cacheLimit_ = bytes;
+   trimTo( bytes );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the maximum number of bytes kept in the free lists.
+//
+// \return The cache limit.
+*/
+template< typename Backend >
+inline std::size_t BasicCUDAMemoryPool<Backend>::cacheLimit() const noexcept
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+   return cacheLimit_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns a snapshot of the pool statistics.
+//
+// \return The statistics of the pool.
+*/
+template< typename Backend >
+inline CUDAMemoryPoolStatistics BasicCUDAMemoryPool<Backend>::statistics() const
+{
+   std::lock_guard<std::mutex> lock( mutex_ );
+   return stats_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Caches a freed block together with an event recorded on its stream.
+//
+// \param address The address of the block.
+// \param stream The stream the block was last used on.
+// \param tagged \a true if \a stream is given, \a false to use the stream of the allocation.
+// \return void
+//
+// Blocks exceeding the cache limit, and blocks whose event cannot be recorded, are released to
+// the backend.
+*/
+template< typename Backend >
+inline void BasicCUDAMemoryPool<Backend>::release( const void* address, const void* stream
+                                                 , bool tagged ) noexcept
+{
+   if( address == nullptr )
+      return;
+
+   std::lock_guard<std::mutex> lock( mutex_ );
+
+   auto live( live_.find( address ) );
+   if( live == live_.end() ) {
+      Backend::deallocate( const_cast<void*>( address ) );
+      return;
+   }
+
+   const std::size_t bytes( live->second.first );
+   if( !tagged )
+      stream = live->second.second;
+   live_.erase( live );
+   stats_.bytesInUse -= bytes;
+
+   if( stats_.bytesCached + bytes > cacheLimit_ ) {
+      Backend::deallocate( const_cast<void*>( address ) );
+      ++stats_.backendDeallocations;
+      return;
+   }
+
+   Event event{};
+   if( !events_.empty() ) {
+      event = events_.back();
+      events_.pop_back();
+   }
+
+   try {
+      if( !Backend::record( event, stream ) )
+         throw std::bad_alloc();
+      free_[bytes].push_back( Block{ const_cast<void*>( address ), event } );
+      stats_.bytesCached += bytes;
+   }
+   catch( ... ) {
+      Backend::destroy( event );
+      Backend::deallocate( const_cast<void*>( address ) );
+      ++stats_.backendDeallocations;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Releases cached blocks, largest first, until at most \a bytes bytes are cached.
+//
+// \param bytes The number of cached bytes to keep.
+// \return void
+//
+// The caller must hold the mutex.
+*/
+template< typename Backend >
+inline void BasicCUDAMemoryPool<Backend>::trimTo( std::size_t bytes ) noexcept
+{
+   for( auto list = free_.rbegin(); list != free_.rend() && stats_.bytesCached > bytes; ++list )
+   {
+      while( !list->second.empty() && stats_.bytesCached > bytes ) {
+         Backend::deallocate( list->second.back().address );
+         Backend::destroy( list->second.back().event );
+         list->second.pop_back();
+         stats_.bytesCached -= list->first;
+         ++stats_.backendDeallocations;
+      }
+   }
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  GLOBAL POOL
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief The memory pool type serving the CUDA containers.
+// \ingroup util
+*/
+using CUDAMemoryPool = BasicCUDAMemoryPool<CUDAManagedMemoryBackend>;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the memory pool serving cuda_managed_allocate().
+// \ingroup util
+//
+// \return Reference to the global memory pool.
+//
+// The pool is intentionally never destroyed: containers with static storage duration may
+// release their memory after any static pool would have been destroyed. Call trim() to return
+// the cached memory to the device.
+*/
+inline CUDAMemoryPool& cuda_memory_pool()
+{
+   static CUDAMemoryPool* pool = new CUDAMemoryPool();
+   return *pool;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief The memory pool type serving plain device memory.
+// \ingroup util
+*/
+using CUDADeviceMemoryPool = BasicCUDAMemoryPool<CUDADeviceMemoryBackend>;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the memory pool serving plain device memory.
+// \ingroup util
+//
+// \return Reference to the global device memory pool.
+//
+// Like cuda_memory_pool(), the pool is intentionally never destroyed.
+*/
+inline CUDADeviceMemoryPool& cuda_device_memory_pool()
+{
+   static CUDADeviceMemoryPool* pool = new CUDADeviceMemoryPool();
+   return *pool;
+}
+//*************************************************************************************************
+
+}  // namespace blaze
+
+#endif
@@ -0,0 +1,550 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/CUDAMirroredArray.h
+//  \brief Header file for the device array with a lazily synchronized host mirror
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_CUDAMIRROREDARRAY_H_
+#define _BLAZE_CUDA_UTIL_CUDAMIRROREDARRAY_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <blaze/util/Memory.h>
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+#include <blaze_cuda/util/CUDAMemoryPool.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Array in plain device memory with a lazily synchronized host mirror.
+// \ingroup util
+//
+// Unlike the unified memory used by the CUDA containers, the elements of a CUDAMirroredArray
+// live in plain device memory (served by cuda_device_memory_pool()). Host access goes through a
+// pinned host mirror that is only allocated on first use. The array tracks which side holds the
+// most recent values and synchronizes the other side with a single bulk copy when it is accessed:
+//
+// - device() marks the device side as modified, host() marks the host side as modified;
+// - the const overloads and the \c c prefixed functions only synchronize.
+//
+// This replaces the element-by-element page faults of unified memory with predictable bulk
+// transfers. Pointers returned by host() or device() stay valid until the next access to the
+// other side, resize() or destruction. \a Type must be trivially copyable. CUDAMirroredVector
+// and CUDAMirroredMatrix are the dense containers built on this array.
+*/
+template< typename Type >  // Data type of the elements
+class CUDAMirroredArray
+{
+   static_assert( std::is_trivially_copyable<Type>::value, "Type must be trivially copyable" );
+
+ public:
+   //**Type definitions****************************************************************************
+   using ValueType = Type;  //!< Type of the elements.
+   //**********************************************************************************************
+
+   //**Constructors and destructor*****************************************************************
+   explicit inline CUDAMirroredArray( std::size_t n = 0UL );
+   inline CUDAMirroredArray( const CUDAMirroredArray& a );
+   inline CUDAMirroredArray( CUDAMirroredArray&& a ) noexcept;
+   inline ~CUDAMirroredArray();
+   //**********************************************************************************************
+
+   //**Assignment operators************************************************************************
+   inline CUDAMirroredArray& operator=( const CUDAMirroredArray& a );
+   inline CUDAMirroredArray& operator=( CUDAMirroredArray&& a ) noexcept;
+   //**********************************************************************************************
+
+   //**Data access functions***********************************************************************
+   inline Type*       device();
+   inline const Type* device() const;
+   inline const Type* cdevice() const;
+
+   inline Type*       host();
+   inline const Type* host() const;
+   inline const Type* chost() const;
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   inline std::size_t size() const noexcept { return size_; }
+   inline bool hasHostMirror() const noexcept { return host_ != nullptr; }
+   inline bool isHostModified() const noexcept { return state_ == hostModified; }
+   inline bool isDeviceModified() const noexcept { return state_ == deviceModified; }
+
+   inline void resize( std::size_t n, bool preserve = true );
+   inline void releaseHostMirror();
+   inline void swap( CUDAMirroredArray& a ) noexcept;
+   //**********************************************************************************************
+
+ private:
+   //**Type definitions****************************************************************************
+   //! Side holding the most recent values.
+   enum State { synchronized, hostModified, deviceModified };
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   inline void syncDevice() const;
+   inline void syncHost() const;
+
+   static inline Type* allocateHost( std::size_t n );
+   static inline void  deallocateHost( Type* ptr ) noexcept;
+   static inline void  copy( Type* dst, const Type* src, std::size_t n );
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   std::size_t   size_;    //!< Number of elements.
+   Type*         device_;  //!< Device side of the array.
+   mutable Type* host_;    //!< Host mirror, allocated on first host access.
+   mutable State state_;   //!< Side holding the most recent values.
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  CONSTRUCTORS AND DESTRUCTOR
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Constructor for an array of size \a n.
+//
+// \param n The number of elements.
+// \exception std::bad_alloc Allocation failed.
+//
+// The elements are left uninitialized.
+*/
+template< typename Type >
+inline CUDAMirroredArray<Type>::CUDAMirroredArray( std::size_t n )
+   : size_  ( n )
+   , device_( n != 0UL ? static_cast<Type*>( cuda_device_memory_pool().allocate( n*sizeof(Type), cuda_stream() ) )
+                       : nullptr )
+   , host_  ( nullptr )
+   , state_ ( synchronized )
+{}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief The copy constructor.
+//
+// \param a The array to be copied.
+//
+// The copy is performed on the device; the new array has no host mirror.
+*/
+template< typename Type >
+inline CUDAMirroredArray<Type>::CUDAMirroredArray( const CUDAMirroredArray& a )
+   : CUDAMirroredArray( a.size_ )
+{
+   if( size_ != 0UL )
+      copy( device_, a.cdevice(), size_ );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief The move constructor.
+//
+// \param a The array to be moved into this instance.
+*/
+template< typename Type >
+inline CUDAMirroredArray<Type>::CUDAMirroredArray( CUDAMirroredArray&& a ) noexcept
+   : size_  ( a.size_ )
+   , device_( a.device_ )
+   , host_  ( a.host_ )
+   , state_ ( a.state_ )
+{
+   a.size_   = 0UL;
+   a.device_ = nullptr;
+   a.host_   = nullptr;
+   a.state_  = synchronized;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief The destructor.
+*/
+template< typename Type >
+inline CUDAMirroredArray<Type>::~CUDAMirroredArray()
+{
+   cuda_device_memory_pool().deallocate( device_, cuda_stream() );
+   deallocateHost( host_ );
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  ASSIGNMENT OPERATORS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Copy assignment operator.
+//
+// \param a The array to be copied.
+// \return Reference to the assigned array.
+*/
+template< typename Type >
+inline CUDAMirroredArray<Type>& CUDAMirroredArray<Type>::operator=( const CUDAMirroredArray& a )
+{
+   if( &a != this ) {
+      CUDAMirroredArray tmp( a );
+      swap( tmp );
+   }
+   return *this;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Move assignment operator.
+//
+// \param a The array to be moved into this instance.
+// \return Reference to the assigned array.
+*/
+template< typename Type >
+inline CUDAMirroredArray<Type>& CUDAMirroredArray<Type>::operator=( CUDAMirroredArray&& a ) noexcept
+{
+   CUDAMirroredArray tmp( std::move( a ) );
+   swap( tmp );
+   return *this;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  DATA ACCESS FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Returns the device side of the array for modification.
+//
+// \return Pointer to the first element in device memory.
+//
+// The host mirror, if any, is synchronized first and considered outdated afterwards.
+*/
+template< typename Type >
+inline Type* CUDAMirroredArray<Type>::device()
+{
+   syncDevice();
+   if( host_ != nullptr )
+      state_ = deviceModified;
+   return device_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the device side of the array for reading.
+//
+// \return Pointer to the first element in device memory.
+*/
+template< typename Type >
+inline const Type* CUDAMirroredArray<Type>::device() const
+{
+   return cdevice();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the device side of the array for reading.
+//
+// \return Pointer to the first element in device memory.
+*/
+template< typename Type >
+inline const Type* CUDAMirroredArray<Type>::cdevice() const
+{
+   syncDevice();
+   return device_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the host mirror of the array for modification.
+//
+// \return Pointer to the first element of the host mirror.
+// \exception std::bad_alloc Allocation of the host mirror failed.
+//
+// The mirror is allocated and synchronized if necessary. The device side is considered outdated
+// afterwards.
+*/
+template< typename Type >
+inline Type* CUDAMirroredArray<Type>::host()
+{
+   syncHost();
+   state_ = hostModified;
+   return host_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the host mirror of the array for reading.
+//
+// \return Pointer to the first element of the host mirror.
+// \exception std::bad_alloc Allocation of the host mirror failed.
+*/
+template< typename Type >
+inline const Type* CUDAMirroredArray<Type>::host() const
+{
+   return chost();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the host mirror of the array for reading.
+//
+// \return Pointer to the first element of the host mirror.
+// \exception std::bad_alloc Allocation of the host mirror failed.
+*/
+template< typename Type >
+inline const Type* CUDAMirroredArray<Type>::chost() const
+{
+   syncHost();
+   return host_;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  UTILITY FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Changes the size of the array.
+//
+// \param n The new number of elements.
+// \param preserve \a true if the old values should be preserved, \a false if not.
+// \return void
+//
+// The values are preserved on the device; the host mirror is released.
+*/
+template< typename Type >
+inline void CUDAMirroredArray<Type>::resize( std::size_t n, bool preserve )
+{
+   if( n == size_ )
+      return;
+
+   CUDAMirroredArray tmp( n );
+
+   if( preserve && std::min( n, size_ ) != 0UL )
+      copy( tmp.device_, cdevice(), std::min( n, size_ ) );
+
+   swap( tmp );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Releases the host mirror after synchronizing the device side.
+//
+// \return void
+*/
+template< typename Type >
+inline void CUDAMirroredArray<Type>::releaseHostMirror()
+{
+   syncDevice();
+   deallocateHost( host_ );
+   host_ = nullptr;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Swapping the contents of two arrays.
+//
+// \param a The array to be swapped.
+// \return void
+*/
+template< typename Type >
+inline void CUDAMirroredArray<Type>::swap( CUDAMirroredArray& a ) noexcept
+{
+   using std::swap;
+
+   swap( size_  , a.size_   );
+   swap( device_, a.device_ );
+   swap( host_  , a.host_   );
+   swap( state_ , a.state_  );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Copies the host mirror to the device if it holds the most recent values.
+//
+// \return void
+*/
+template< typename Type >
+inline void CUDAMirroredArray<Type>::syncDevice() const
+{
+   if( state_ == hostModified ) {
+      copy( device_, host_, size_ );
+      state_ = synchronized;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Allocates the host mirror and copies the device side to it if necessary.
+//
+// \return void
+// \exception std::bad_alloc Allocation of the host mirror failed.
+*/
+template< typename Type >
+inline void CUDAMirroredArray<Type>::syncHost() const
+{
+   if( host_ == nullptr ) {
+      host_ = allocateHost( size_ );
+      state_ = deviceModified;
+   }
+
+   if( state_ == deviceModified ) {
+      copy( host_, device_, size_ );
+      state_ = synchronized;
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Allocates pinned host memory for \a n elements.
+//
+// \param n The number of elements.
+// \return Pointer to the allocated memory.
+// \exception std::bad_alloc Allocation failed.
+*/
+template< typename Type >
+inline Type* CUDAMirroredArray<Type>::allocateHost( std::size_t n )
+{
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   return reinterpret_cast<Type*>( allocate_backend( std::max( n, std::size_t( 1UL ) )*sizeof(Type), 64UL ) );
+#else
+   void* raw( nullptr );
+   if( cudaMallocHost( &raw, std::max( n, std::size_t( 1UL ) )*sizeof(Type) ) != cudaSuccess ) {
+      cudaGetLastError();  // Resets the error state
+      throw std::bad_alloc();
+   }
+   return static_cast<Type*>( raw );
+#endif
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Deallocates a host mirror.
+//
+// \param ptr The host mirror to be deallocated.
+// \return void
+*/
+template< typename Type >
+inline void CUDAMirroredArray<Type>::deallocateHost( Type* ptr ) noexcept
+{
+   if( ptr == nullptr )
+      return;
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   deallocate_backend( ptr );
+#else
+   cudaFreeHost( ptr );
+#endif
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Bulk copy of \a n elements.
+//
+// \param dst The destination.
+// \param src The source.
+// \param n The number of elements.
+// \return void
+//
+// The direction is deduced from the addresses (unified virtual addressing). The copy is issued
+// on the stream of the current execution context, and completed before returning.
+*/
+template< typename Type >
+inline void CUDAMirroredArray<Type>::copy( Type* dst, const Type* src, std::size_t n )
+{
+   if( n == 0UL )
+      return;
+
+   BLAZE_CUDA_COUNT( transfers, n*sizeof(Type) );
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   std::memcpy( dst, src, n*sizeof(Type) );
+#else
+   cudaMemcpyAsync( dst, src, n*sizeof(Type), cudaMemcpyDefault, cuda_stream() );
+   cudaStreamSynchronize( cuda_stream() );
+   BLAZE_CUDA_COUNT( synchronizations, 1UL );
+   BLAZE_CUDA_ERROR_CHECK;
+#endif
+}
+//*************************************************************************************************
+
+}  // namespace blaze
+
+#endif
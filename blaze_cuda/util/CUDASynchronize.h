@@ -0,0 +1,69 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/CUDASynchronize.h
+//  \brief Header file for the device synchronization function
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_CUDASYNCHRONIZE_H_
+#define _BLAZE_CUDA_UTIL_CUDASYNCHRONIZE_H_
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+namespace blaze {
+
+//*************************************************************************************************
+/*!\brief Blocks until the device work issued on the current stream has completed.
+// \ingroup util
+//
+// \return void
+//
+// Only the stream of the current execution context (see CUDAExecutionContext) is waited for,
+// so the work of other host threads keeps running. With the host execution backend (\c BLAZE_CUDA_HOST_BACKEND) every algorithm completes before
+// returning, so this function does nothing.
+*/
+inline void cuda_synchronize()
+{
+   BLAZE_CUDA_COUNT( synchronizations, 1UL );
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+   cudaStreamSynchronize( cuda_stream() );
+#endif
+}
+//*************************************************************************************************
+
+}  // namespace blaze
+
+#endif
@@ -37,7 +37,9 @@
 
 #include <utility>
 
-#include <cuda_runtime.h>
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <cuda_runtime.h>
+#endif
 
 #include <blaze/system/HostDevice.h>
 
@@ -51,8 +53,12 @@ class CUDAManagedValue
 public:
    inline BLAZE_DEVICE_CALLABLE CUDAManagedValue()
    {
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+      _ptr = new T();
+#else
       cudaMallocManaged( ( void** )&_ptr, sizeof( T ) );
       *_ptr = T();
+#endif
    }
 
    inline BLAZE_DEVICE_CALLABLE CUDAManagedValue( CUDAManagedValue && o )      : _ptr( o._ptr )
@@ -70,7 +76,11 @@ public:
    inline BLAZE_DEVICE_CALLABLE T& operator*() { return *_ptr; }
    inline BLAZE_DEVICE_CALLABLE T* ptr()       { return  _ptr; }
 
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   inline ~CUDAManagedValue() { delete _ptr; }
+#else
    inline BLAZE_DEVICE_CALLABLE ~CUDAManagedValue() { if( _ptr != nullptr ) cudaFree( _ptr ); }
+#endif
 };
 
 }  // namespace blaze
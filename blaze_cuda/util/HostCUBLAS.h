@@ -0,0 +1,510 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/HostCUBLAS.h
+//  \brief Host stand-in for the subset of cuBLAS used by Blaze CUDA
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_HOSTCUBLAS_H_
+#define _BLAZE_CUDA_UTIL_HOSTCUBLAS_H_
+
+#include <complex>
+#include <cstddef>
+
+#include <blaze_cuda/util/algorithms/HostParallel.h>
+
+
+//=================================================================================================
+//
+//  TYPES
+//
+//  With the host execution backend (BLAZE_CUDA_HOST_BACKEND) the cuBLAS headers are replaced by
+//  this file. It declares the cuBLAS types and implements the cuBLAS routines called by the
+//  Blaze CUDA wrappers with straightforward, column-major host loops, so the dispatch layer
+//  (handles, operation flags, leading dimensions) can be exercised without a GPU.
+//
+//=================================================================================================
+
+struct CUstream_st;
+typedef CUstream_st* cudaStream_t;
+
+struct cuFloatComplex  { float  x, y; };
+struct cuDoubleComplex { double x, y; };
+typedef cuFloatComplex cuComplex;
+
+typedef enum {
+   CUBLAS_STATUS_SUCCESS          = 0,
+   CUBLAS_STATUS_NOT_INITIALIZED  = 1,
+   CUBLAS_STATUS_ALLOC_FAILED     = 3,
+   CUBLAS_STATUS_INVALID_VALUE    = 7,
+   CUBLAS_STATUS_ARCH_MISMATCH    = 8,
+   CUBLAS_STATUS_MAPPING_ERROR    = 11,
+   CUBLAS_STATUS_EXECUTION_FAILED = 13,
+   CUBLAS_STATUS_INTERNAL_ERROR   = 14,
+   CUBLAS_STATUS_NOT_SUPPORTED    = 15
+} cublasStatus_t;
+
+typedef enum {
+   CUBLAS_OP_N = 0,
+   CUBLAS_OP_T = 1,
+   CUBLAS_OP_C = 2
+} cublasOperation_t;
+
+typedef enum {
+   CUBLAS_FILL_MODE_LOWER = 0,
+   CUBLAS_FILL_MODE_UPPER = 1,
+   CUBLAS_FILL_MODE_FULL  = 2
+} cublasFillMode_t;
+
+typedef enum {
+   CUBLAS_POINTER_MODE_HOST   = 0,
+   CUBLAS_POINTER_MODE_DEVICE = 1
+} cublasPointerMode_t;
+
+typedef enum {
+   CUBLAS_DEFAULT_MATH        = 0,
+   CUBLAS_TENSOR_OP_MATH      = 1,
+   CUBLAS_PEDANTIC_MATH       = 2,
+   CUBLAS_TF32_TENSOR_OP_MATH = 3
+} cublasMath_t;
+
+struct cublasContext
+{
+   cudaStream_t        stream;
+   cublasPointerMode_t pointerMode;
+   cublasMath_t        mathMode;
+};
+typedef cublasContext* cublasHandle_t;
+
+
+namespace blaze {
+
+namespace host_cublas_detail {
+
+//=================================================================================================
+//
+//  REFERENCE IMPLEMENTATIONS
+//
+//=================================================================================================
+
+template< typename T >
+inline T conj_if( T const& v, bool ) { return v; }
+
+template< typename T >
+inline std::complex<T> conj_if( std::complex<T> const& v, bool c ) { return c ? std::conj( v ) : v; }
+
+template< typename T >
+inline T real_if( T const& v, bool ) { return v; }
+
+template< typename T >
+inline std::complex<T> real_if( std::complex<T> const& v, bool r ) { return r ? std::complex<T>( v.real() ) : v; }
+
+// Element (i,j) of op(A), A being stored column-major with leading dimension lda
+template< typename T >
+inline T op_at( cublasOperation_t op, const T* A, int lda, int i, int j )
+{
+   return ( op == CUBLAS_OP_N )
+        ? A[ i + std::ptrdiff_t( j ) * lda ]
+        : conj_if( A[ j + std::ptrdiff_t( i ) * lda ], op == CUBLAS_OP_C );
+}
+
+// Columns [jbegin..jend) of a single gemm, run sequentially
+template< typename T >
+inline void gemm_columns( cublasOperation_t transA, cublasOperation_t transB
+                        , int m, int k, T alpha
+                        , const T* A, int lda, const T* B, int ldb
+                        , T beta, T* C, int ldc, int jbegin, int jend )
+{
+   for( int j = jbegin; j < jend; ++j ) {
+      for( int i = 0; i < m; ++i ) {
+         T acc = T();
+         for( int l = 0; l < k; ++l ) {
+            acc += op_at( transA, A, lda, i, l ) * op_at( transB, B, ldb, l, j );
+         }
+         T& c = C[ i + std::ptrdiff_t( j ) * ldc ];
+         c = ( beta == T() ) ? alpha * acc : alpha * acc + beta * c;
+      }
+   }
+}
+
+template< typename T >
+inline cublasStatus_t gemm( cublasOperation_t transA, cublasOperation_t transB
+                          , int m, int n, int k, T alpha
+                          , const T* A, int lda, const T* B, int ldb
+                          , T beta, T* C, int ldc )
+{
+   if( m < 0 || n < 0 || k < 0 ) return CUBLAS_STATUS_INVALID_VALUE;
+
+   host_parallel_for( std::size_t( n ), std::size_t( m ) * std::size_t( k + 1 )
+      , [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      gemm_columns( transA, transB, m, k, alpha, A, lda, B, ldb, beta, C, ldc, int( begin ), int( end ) );
+   } );
+
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+// The batched variants parallelize over the batch, each product being computed by one thread
+template< typename T >
+inline cublasStatus_t gemm_strided_batched( cublasOperation_t transA, cublasOperation_t transB
+                                          , int m, int n, int k, T alpha
+                                          , const T* A, int lda, long long strideA
+                                          , const T* B, int ldb, long long strideB
+                                          , T beta, T* C, int ldc, long long strideC, int count )
+{
+   if( m < 0 || n < 0 || k < 0 || count < 0 ) return CUBLAS_STATUS_INVALID_VALUE;
+
+   host_parallel_for( std::size_t( count ), std::size_t( m ) * std::size_t( n ) * std::size_t( k + 1 )
+      , [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( std::size_t b = begin; b < end; ++b ) {
+         gemm_columns( transA, transB, m, k, alpha, A + b * strideA, lda, B + b * strideB, ldb
+                     , beta, C + b * strideC, ldc, 0, n );
+      }
+   } );
+
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+template< typename T >
+inline cublasStatus_t gemm_batched( cublasOperation_t transA, cublasOperation_t transB
+                                  , int m, int n, int k, T alpha
+                                  , const T* const* A, int lda, const T* const* B, int ldb
+                                  , T beta, T* const* C, int ldc, int count )
+{
+   if( m < 0 || n < 0 || k < 0 || count < 0 ) return CUBLAS_STATUS_INVALID_VALUE;
+
+   host_parallel_for( std::size_t( count ), std::size_t( m ) * std::size_t( n ) * std::size_t( k + 1 )
+      , [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( std::size_t b = begin; b < end; ++b ) {
+         gemm_columns( transA, transB, m, k, alpha, A[b], lda, B[b], ldb, beta, C[b], ldc, 0, n );
+      }
+   } );
+
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+template< typename T >
+inline cublasStatus_t gemv( cublasOperation_t trans, int m, int n, T alpha
+                          , const T* A, int lda, const T* x, int incx
+                          , T beta, T* y, int incy )
+{
+   if( m < 0 || n < 0 || incx == 0 || incy == 0 ) return CUBLAS_STATUS_INVALID_VALUE;
+
+   // Dimensions of op(A)
+   const int rows( trans == CUBLAS_OP_N ? m : n );
+   const int cols( trans == CUBLAS_OP_N ? n : m );
+
+   const std::ptrdiff_t xoff( incx < 0 ? std::ptrdiff_t( 1 - cols ) * incx : 0 );
+   const std::ptrdiff_t yoff( incy < 0 ? std::ptrdiff_t( 1 - rows ) * incy : 0 );
+
+   host_parallel_for( std::size_t( rows ), std::size_t( cols )
+      , [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( int i = int( begin ); i < int( end ); ++i ) {
+         T acc = T();
+         for( int j = 0; j < cols; ++j ) {
+            acc += op_at( trans, A, lda, i, j ) * x[ xoff + std::ptrdiff_t( j ) * incx ];
+         }
+         T& yi = y[ yoff + std::ptrdiff_t( i ) * incy ];
+         yi = ( beta == T() ) ? alpha * acc : alpha * acc + beta * yi;
+      }
+   } );
+
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+// Rank-k update of the 'uplo' triangle of C, C = alpha*op(A)*op(A)^T + beta*C, or with 'herm'
+// C = alpha*op(A)*op(A)^H + beta*C with the imaginary parts of the diagonal set to zero
+template< typename T, typename ST >
+inline cublasStatus_t syrk( cublasFillMode_t uplo, cublasOperation_t trans, int n, int k
+                          , ST alpha, const T* A, int lda, ST beta, T* C, int ldc, bool herm )
+{
+   if( n < 0 || k < 0 ) return CUBLAS_STATUS_INVALID_VALUE;
+
+   host_parallel_for( std::size_t( n ), std::size_t( n ) * std::size_t( k + 1 ) / 2UL
+      , [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( int j = int( begin ); j < int( end ); ++j ) {
+         const int ibegin( uplo == CUBLAS_FILL_MODE_LOWER ? j : 0     );
+         const int iend  ( uplo == CUBLAS_FILL_MODE_LOWER ? n : j + 1 );
+         for( int i = ibegin; i < iend; ++i ) {
+            T acc = T();
+            for( int l = 0; l < k; ++l ) {
+               acc += op_at( trans, A, lda, i, l ) * conj_if( op_at( trans, A, lda, j, l ), herm );
+            }
+            T& c = C[ i + std::ptrdiff_t( j ) * ldc ];
+            c = ( beta == ST() ) ? T( alpha ) * acc : T( alpha ) * acc + T( beta ) * c;
+            c = real_if( c, herm && i == j );
+         }
+      }
+   } );
+
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+template< typename T >
+inline cublasStatus_t geam( cublasOperation_t transA, cublasOperation_t transB, int m, int n
+                          , T alpha, const T* A, int lda
+                          , T beta , const T* B, int ldb
+                          , T* C, int ldc )
+{
+   if( m < 0 || n < 0 ) return CUBLAS_STATUS_INVALID_VALUE;
+
+   host_parallel_for( std::size_t( n ), std::size_t( m )
+      , [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( int j = int( begin ); j < int( end ); ++j ) {
+         for( int i = 0; i < m; ++i ) {
+            T c = T();
+            if( alpha != T() ) c += alpha * op_at( transA, A, lda, i, j );
+            if( beta  != T() ) c += beta  * op_at( transB, B, ldb, i, j );
+            C[ i + std::ptrdiff_t( j ) * ldc ] = c;
+         }
+      }
+   } );
+
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+template< typename T > struct HostType                  { using Type = T; };
+template<> struct HostType<cuFloatComplex>              { using Type = std::complex<float>;  };
+template<> struct HostType<cuDoubleComplex>             { using Type = std::complex<double>; };
+
+template< typename T >
+inline auto host( T* p ) { return reinterpret_cast<typename HostType<T>::Type*>( p ); }
+
+template< typename T >
+inline auto host( const T* p ) { return reinterpret_cast<const typename HostType<T>::Type*>( p ); }
+
+template< typename T >
+inline auto host( const T* const* p ) { return reinterpret_cast<const typename HostType<T>::Type* const*>( p ); }
+
+template< typename T >
+inline auto host( T* const* p ) { return reinterpret_cast<typename HostType<T>::Type* const*>( p ); }
+
+} // namespace host_cublas_detail
+
+} // namespace blaze
+
+
+
+
+//=================================================================================================
+//
+//  HANDLE MANAGEMENT
+//
+//=================================================================================================
+
+inline cublasStatus_t cublasCreate_v2( cublasHandle_t* handle )
+{
+   *handle = new cublasContext{ nullptr, CUBLAS_POINTER_MODE_HOST, CUBLAS_DEFAULT_MATH };
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+inline cublasStatus_t cublasDestroy_v2( cublasHandle_t handle )
+{
+   delete handle;
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+inline cublasStatus_t cublasSetStream_v2( cublasHandle_t handle, cudaStream_t stream )
+{
+   handle->stream = stream;
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+inline cublasStatus_t cublasGetStream_v2( cublasHandle_t handle, cudaStream_t* stream )
+{
+   *stream = handle->stream;
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+inline cublasStatus_t cublasSetPointerMode_v2( cublasHandle_t handle, cublasPointerMode_t mode )
+{
+   handle->pointerMode = mode;
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+inline cublasStatus_t cublasSetMathMode( cublasHandle_t handle, cublasMath_t mode )
+{
+   handle->mathMode = mode;
+   return CUBLAS_STATUS_SUCCESS;
+}
+
+#define cublasCreate         cublasCreate_v2
+#define cublasDestroy        cublasDestroy_v2
+#define cublasSetStream      cublasSetStream_v2
+#define cublasGetStream      cublasGetStream_v2
+#define cublasSetPointerMode cublasSetPointerMode_v2
+
+
+
+
+//=================================================================================================
+//
+//  BLAS ROUTINES
+//
+//  Scalars are read through their pointers in both pointer modes, since all memory is host
+//  memory with this backend.
+//
+//=================================================================================================
+
+#define BLAZE_CUDA_HOST_CUBLAS_GEMM( NAME, T )                                                   \
+inline cublasStatus_t NAME( cublasHandle_t, cublasOperation_t transA, cublasOperation_t transB,  \
+                            int m, int n, int k, const T* alpha, const T* A, int lda,            \
+                            const T* B, int ldb, const T* beta, T* C, int ldc )                  \
+{                                                                                                \
+   using namespace blaze::host_cublas_detail;                                                    \
+   return gemm( transA, transB, m, n, k, *host( alpha ), host( A ), lda, host( B ), ldb,         \
+                *host( beta ), host( C ), ldc );                                                 \
+}
+
+#define BLAZE_CUDA_HOST_CUBLAS_GEMM_STRIDED_BATCHED( NAME, T )                                   \
+inline cublasStatus_t NAME( cublasHandle_t, cublasOperation_t transA, cublasOperation_t transB,  \
+                            int m, int n, int k, const T* alpha,                                 \
+                            const T* A, int lda, long long strideA,                              \
+                            const T* B, int ldb, long long strideB, const T* beta,               \
+                            T* C, int ldc, long long strideC, int batchCount )                   \
+{                                                                                                \
+   using namespace blaze::host_cublas_detail;                                                    \
+   return gemm_strided_batched( transA, transB, m, n, k, *host( alpha ),                         \
+                                host( A ), lda, strideA, host( B ), ldb, strideB,                \
+                                *host( beta ), host( C ), ldc, strideC, batchCount );            \
+}
+
+#define BLAZE_CUDA_HOST_CUBLAS_GEMM_BATCHED( NAME, T )                                           \
+inline cublasStatus_t NAME( cublasHandle_t, cublasOperation_t transA, cublasOperation_t transB,  \
+                            int m, int n, int k, const T* alpha,                                 \
+                            const T* const A[], int lda, const T* const B[], int ldb,            \
+                            const T* beta, T* const C[], int ldc, int batchCount )               \
+{                                                                                                \
+   using namespace blaze::host_cublas_detail;                                                    \
+   return gemm_batched( transA, transB, m, n, k, *host( alpha ), host( A ), lda,                 \
+                        host( B ), ldb, *host( beta ), host( C ), ldc, batchCount );             \
+}
+
+#define BLAZE_CUDA_HOST_CUBLAS_GEMV( NAME, T )                                                   \
+inline cublasStatus_t NAME( cublasHandle_t, cublasOperation_t trans, int m, int n,               \
+                            const T* alpha, const T* A, int lda, const T* x, int incx,           \
+                            const T* beta, T* y, int incy )                                      \
+{                                                                                                \
+   using namespace blaze::host_cublas_detail;                                                    \
+   return gemv( trans, m, n, *host( alpha ), host( A ), lda, host( x ), incx,                    \
+                *host( beta ), host( y ), incy );                                                \
+}
+
+#define BLAZE_CUDA_HOST_CUBLAS_GEAM( NAME, T )                                                   \
+inline cublasStatus_t NAME( cublasHandle_t, cublasOperation_t transA, cublasOperation_t transB,  \
+                            int m, int n, const T* alpha, const T* A, int lda,                   \
+                            const T* beta, const T* B, int ldb, T* C, int ldc )                  \
+{                                                                                                \
+   using namespace blaze::host_cublas_detail;                                                    \
+   return geam( transA, transB, m, n, *host( alpha ), host( A ), lda,                            \
+                *host( beta ), host( B ), ldb, host( C ), ldc );                                 \
+}
+
+#define BLAZE_CUDA_HOST_CUBLAS_SYRK( NAME, T )                                                   \
+inline cublasStatus_t NAME( cublasHandle_t, cublasFillMode_t uplo, cublasOperation_t trans,      \
+                            int n, int k, const T* alpha, const T* A, int lda,                   \
+                            const T* beta, T* C, int ldc )                                       \
+{                                                                                                \
+   using namespace blaze::host_cublas_detail;                                                    \
+   return syrk( uplo, trans, n, k, *host( alpha ), host( A ), lda, *host( beta ), host( C ), ldc \
+              , false );                                                                         \
+}
+
+#define BLAZE_CUDA_HOST_CUBLAS_HERK( NAME, RT, T )                                               \
+inline cublasStatus_t NAME( cublasHandle_t, cublasFillMode_t uplo, cublasOperation_t trans,      \
+                            int n, int k, const RT* alpha, const T* A, int lda,                  \
+                            const RT* beta, T* C, int ldc )                                      \
+{                                                                                                \
+   using namespace blaze::host_cublas_detail;                                                    \
+   return syrk( uplo, trans, n, k, *alpha, host( A ), lda, *beta, host( C ), ldc, true );        \
+}
+
+BLAZE_CUDA_HOST_CUBLAS_GEMM( cublasSgemm_v2, float           )
+BLAZE_CUDA_HOST_CUBLAS_GEMM( cublasDgemm_v2, double          )
+BLAZE_CUDA_HOST_CUBLAS_GEMM( cublasCgemm_v2, cuFloatComplex  )
+BLAZE_CUDA_HOST_CUBLAS_GEMM( cublasZgemm_v2, cuDoubleComplex )
+
+BLAZE_CUDA_HOST_CUBLAS_GEMM_STRIDED_BATCHED( cublasSgemmStridedBatched, float           )
+BLAZE_CUDA_HOST_CUBLAS_GEMM_STRIDED_BATCHED( cublasDgemmStridedBatched, double          )
+BLAZE_CUDA_HOST_CUBLAS_GEMM_STRIDED_BATCHED( cublasCgemmStridedBatched, cuFloatComplex  )
+BLAZE_CUDA_HOST_CUBLAS_GEMM_STRIDED_BATCHED( cublasZgemmStridedBatched, cuDoubleComplex )
+
+BLAZE_CUDA_HOST_CUBLAS_GEMM_BATCHED( cublasSgemmBatched, float           )
+BLAZE_CUDA_HOST_CUBLAS_GEMM_BATCHED( cublasDgemmBatched, double          )
+BLAZE_CUDA_HOST_CUBLAS_GEMM_BATCHED( cublasCgemmBatched, cuFloatComplex  )
+BLAZE_CUDA_HOST_CUBLAS_GEMM_BATCHED( cublasZgemmBatched, cuDoubleComplex )
+
+BLAZE_CUDA_HOST_CUBLAS_GEMV( cublasSgemv_v2, float           )
+BLAZE_CUDA_HOST_CUBLAS_GEMV( cublasDgemv_v2, double          )
+BLAZE_CUDA_HOST_CUBLAS_GEMV( cublasCgemv_v2, cuFloatComplex  )
+BLAZE_CUDA_HOST_CUBLAS_GEMV( cublasZgemv_v2, cuDoubleComplex )
+
+BLAZE_CUDA_HOST_CUBLAS_GEAM( cublasSgeam, float           )
+BLAZE_CUDA_HOST_CUBLAS_GEAM( cublasDgeam, double          )
+BLAZE_CUDA_HOST_CUBLAS_GEAM( cublasCgeam, cuFloatComplex  )
+BLAZE_CUDA_HOST_CUBLAS_GEAM( cublasZgeam, cuDoubleComplex )
+
+BLAZE_CUDA_HOST_CUBLAS_SYRK( cublasSsyrk_v2, float           )
+BLAZE_CUDA_HOST_CUBLAS_SYRK( cublasDsyrk_v2, double          )
+BLAZE_CUDA_HOST_CUBLAS_SYRK( cublasCsyrk_v2, cuFloatComplex  )
+BLAZE_CUDA_HOST_CUBLAS_SYRK( cublasZsyrk_v2, cuDoubleComplex )
+
+BLAZE_CUDA_HOST_CUBLAS_HERK( cublasCherk_v2, float , cuFloatComplex  )
+BLAZE_CUDA_HOST_CUBLAS_HERK( cublasZherk_v2, double, cuDoubleComplex )
+
+#undef BLAZE_CUDA_HOST_CUBLAS_GEMM
+#undef BLAZE_CUDA_HOST_CUBLAS_GEMM_STRIDED_BATCHED
+#undef BLAZE_CUDA_HOST_CUBLAS_GEMM_BATCHED
+#undef BLAZE_CUDA_HOST_CUBLAS_GEMV
+#undef BLAZE_CUDA_HOST_CUBLAS_GEAM
+#undef BLAZE_CUDA_HOST_CUBLAS_SYRK
+#undef BLAZE_CUDA_HOST_CUBLAS_HERK
+
+#define cublasSgemm cublasSgemm_v2
+#define cublasDgemm cublasDgemm_v2
+#define cublasCgemm cublasCgemm_v2
+#define cublasZgemm cublasZgemm_v2
+#define cublasSgemv cublasSgemv_v2
+#define cublasDgemv cublasDgemv_v2
+#define cublasCgemv cublasCgemv_v2
+#define cublasZgemv cublasZgemv_v2
+#define cublasSsyrk cublasSsyrk_v2
+#define cublasDsyrk cublasDsyrk_v2
+#define cublasCsyrk cublasCsyrk_v2
+#define cublasZsyrk cublasZsyrk_v2
+#define cublasCherk cublasCherk_v2
+#define cublasZherk cublasZherk_v2
+
+#endif
@@ -35,17 +35,23 @@
 #ifndef _BLAZE_CUDA_UTIL_MEMORY_H_
 #define _BLAZE_CUDA_UTIL_MEMORY_H_
 
-#include <cuda_runtime.h>
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <cuda_runtime.h>
+#endif
 
 #include <new>
 #include <blaze/util/Assert.h>
 #include <blaze/util/DisableIf.h>
 #include <blaze/util/EnableIf.h>
 #include <blaze/util/Exception.h>
+#include <blaze/util/Memory.h>
 #include <blaze/util/Types.h>
 #include <blaze/util/typetraits/IsBuiltin.h>
 
 #include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+#include <blaze_cuda/util/CUDAMemoryPool.h>
 
 namespace blaze {
 
@@ -64,10 +70,22 @@ namespace blaze {
 // \return Byte pointer to the first element of the array.
 // \exception std::bad_alloc Allocation failed.
 //
-// This function provides the functionality to allocate CUDA managed memory.
+// This function provides the functionality to allocate CUDA managed memory. With the host
+// execution backend (\c BLAZE_CUDA_HOST_BACKEND) the memory is plain, cache line aligned host
+// memory instead. Unless \c BLAZE_CUDA_NO_MEMORY_POOL is defined, the memory is served by the
+// caching cuda_memory_pool().
 */
 inline byte_t* cuda_managed_allocate_backend( size_t size )
 {
+   BLAZE_CUDA_RANGE( "cuda_managed_allocate" );
+   BLAZE_CUDA_COUNT( allocations, 1UL );
+   BLAZE_CUDA_COUNT( allocatedBytes, size );
+
+#if !defined(BLAZE_CUDA_NO_MEMORY_POOL)
+   return reinterpret_cast<byte_t*>( cuda_memory_pool().allocate( size, cuda_stream() ) );
+#elif defined(BLAZE_CUDA_HOST_BACKEND)
+   return allocate_backend( size, 64UL );
+#else
    void* raw( nullptr );
 
    cudaMallocManaged( &raw, size );
@@ -76,6 +94,7 @@ inline byte_t* cuda_managed_allocate_backend( size_t size )
       BLAZE_THROW_BAD_ALLOC;
 
    return reinterpret_cast<byte_t*>( raw );
+#endif
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -90,11 +109,18 @@ inline byte_t* cuda_managed_allocate_backend( size_t size )
 // \return void
 //
 // This function deallocates the given memory that was previously allocated via the
-// cuda_managed_allocate() function.
+// cuda_managed_allocate() function. With the memory pool the block is cached for reuse once the
+// kernels of the current stream are done, which avoids the device synchronization of cudaFree().
 */
 inline void cuda_deallocate_backend( const void* address ) noexcept
 {
+#if !defined(BLAZE_CUDA_NO_MEMORY_POOL)
+   cuda_memory_pool().deallocate( address, cuda_stream() );
+#elif defined(BLAZE_CUDA_HOST_BACKEND)
+   deallocate_backend( address );
+#else
    cudaFree( const_cast<void*>( address ) );
+#endif
 }
 /*! \endcond */
 //*************************************************************************************************
@@ -210,7 +236,7 @@ DisableIf_t< IsBuiltin_v<T> > cuda_managed_deallocate( T* address )
    for( size_t i=0UL; i<size; ++i )
       address[i].~T();
 
-   cudaFree( reinterpret_cast<void*>( address ) );
+   cuda_deallocate_backend( address );
 }
 //*************************************************************************************************
 
@@ -0,0 +1,281 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDABatchedGemm.h
+//  \brief Header file for the batched multiplication of small matrices
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDABATCHEDGEMM_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDABATCHEDGEMM_H_
+
+#include <algorithm>
+#include <cstddef>
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/algorithms/HostParallel.h>
+#else
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  BATCHED GEMM OF SMALL MATRICES
+//
+//  cuda_gemm_batched_small() computes 'C_b = alpha*A_b*B_b + beta*C_b' for 'count' products of
+//  an m x k and a k x n matrix, all dimensions being at most cuda_small_gemm_max. Element (i,j)
+//  of a matrix is located at 'p + i*rs + j*cs', where 'p' is returned by the batch accessor for
+//  this product, so any storage order and transposition is expressed by the strides. If beta
+//  is zero, C is not read.
+//
+//  At these sizes a vendor GEMM launches far more threads than there is work, so the device
+//  kernel packs as many products per block as fit in shared memory. Each thread accumulates a
+//  2x2 block of C in registers, reading both operands from shared memory.
+//
+//  The host execution backend distributes the products over the threads.
+//
+//=================================================================================================
+
+//! Largest dimension handled by cuda_gemm_batched_small().
+constexpr std::size_t cuda_small_gemm_max = 32;
+
+/*!\brief Batch accessor for matrices stored at a constant distance from each other.
+*/
+template< typename T >
+struct CUDAStridedBatch
+{
+   T* data;
+   std::size_t stride;
+
+   inline BLAZE_DEVICE_CALLABLE T* operator()( std::size_t b ) const
+   {
+      return data + b * stride;
+   }
+};
+
+/*!\brief Batch accessor for matrices given by an array of pointers.
+*/
+template< typename T >
+struct CUDAPointerBatch
+{
+   T* const* data;
+
+   inline BLAZE_DEVICE_CALLABLE T* operator()( std::size_t b ) const
+   {
+      return data[b];
+   }
+};
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+template < typename T, typename ABatch, typename BBatch, typename CBatch >
+inline void cuda_gemm_batched_small( std::size_t count, std::size_t m, std::size_t n, std::size_t k
+                                   , T alpha
+                                   , ABatch a, std::size_t a_rs, std::size_t a_cs
+                                   , BBatch b, std::size_t b_rs, std::size_t b_cs
+                                   , T beta
+                                   , CBatch c, std::size_t c_rs, std::size_t c_cs )
+{
+   BLAZE_CUDA_RANGE( "cuda_gemm_batched_small" );
+
+   if( count == 0UL || m == 0UL || n == 0UL ) return;
+
+   host_parallel_for( count, m * n * k, [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( std::size_t p = begin; p < end; ++p )
+      {
+         const auto A( a( p ) );
+         const auto B( b( p ) );
+         const auto C( c( p ) );
+
+         for( std::size_t i = 0UL; i < m; ++i ) {
+            for( std::size_t j = 0UL; j < n; ++j )
+            {
+               T acc{};
+               for( std::size_t l = 0UL; l < k; ++l )
+                  acc += A[i*a_rs+l*a_cs] * B[l*b_rs+j*b_cs];
+
+               T& out( C[i*c_rs+j*c_cs] );
+               out = ( beta == T(0) ) ? alpha * acc : alpha * acc + beta * out;
+            }
+         }
+      }
+   } );
+}
+
+#else // BLAZE_CUDA_HOST_BACKEND
+
+namespace cuda_gemm_batched_detail {
+
+constexpr std::size_t block_size = 256;   // Threads per block
+constexpr std::size_t capacity   = 2048;  // Elements of the operands staged per block
+
+/*!\brief Raw shared memory for the operands, as elements may not be trivially constructible.
+*/
+template< typename T >
+struct OperandStorage
+{
+   alignas( T ) unsigned char data[ capacity * sizeof( T ) ];
+
+   inline __device__ T* get() { return reinterpret_cast<T*>( data ); }
+};
+
+inline BLAZE_DEVICE_CALLABLE std::size_t half( std::size_t n )
+{
+   return ( n + 1UL ) / 2UL;
+}
+
+//! Number of products computed at once by one block.
+inline std::size_t group_size( std::size_t m, std::size_t n, std::size_t k )
+{
+   const std::size_t tiles  ( half( m ) * half( n ) );
+   const std::size_t staged ( m * k + k * n );
+
+   return std::max( std::min( block_size / tiles, staged ? capacity / staged : block_size ), 1UL );
+}
+
+template < typename T, typename ABatch, typename BBatch, typename CBatch >
+void __global__ gemm_batched_small_kernel( std::size_t count, std::size_t group
+                                         , std::size_t m, std::size_t n, std::size_t k
+                                         , T alpha
+                                         , ABatch a, std::size_t a_rs, std::size_t a_cs
+                                         , BBatch b, std::size_t b_rs, std::size_t b_cs
+                                         , T beta
+                                         , CBatch c, std::size_t c_rs, std::size_t c_cs )
+{
+   using std::size_t;
+
+   __shared__ OperandStorage<T> sdata;
+
+   T* const smem = sdata.get();
+
+   size_t const mk     = m * k;
+   size_t const staged = mk + k * n;
+   size_t const tn     = half( n );
+   size_t const tiles  = half( m ) * tn;
+
+   // The thread's 2x2 block of C, clamped so that edge threads load in bounds
+   size_t const g   = threadIdx.x / tiles;
+   size_t const i0  = 2UL * ( ( threadIdx.x % tiles ) / tn );
+   size_t const j0  = 2UL * ( ( threadIdx.x % tiles ) % tn );
+   size_t const i1  = ( i0 + 1UL < m ) ? i0 + 1UL : i0;
+   size_t const j1  = ( j0 + 1UL < n ) ? j0 + 1UL : j0;
+
+   for( size_t first = blockIdx.x * group; first < count; first += gridDim.x * group )
+   {
+      size_t const active = ( count - first < group ) ? count - first : group;
+
+      // Stage A_b (m x k, row-major) and B_b (k x n, row-major) for all products of the group
+      for( size_t idx = threadIdx.x; idx < active * staged; idx += blockDim.x )
+      {
+         size_t const p = idx / staged;
+         size_t const r = idx % staged;
+
+         if( r < mk )
+            smem[idx] = a( first + p )[ ( r / k ) * a_rs + ( r % k ) * a_cs ];
+         else
+            smem[idx] = b( first + p )[ ( ( r - mk ) / n ) * b_rs + ( ( r - mk ) % n ) * b_cs ];
+      }
+      __syncthreads();
+
+      if( g < active )
+      {
+         T const* const As = smem + g * staged;
+         T const* const Bs = As + mk;
+
+         T acc00{}, acc01{}, acc10{}, acc11{};
+
+         for( size_t l = 0UL; l < k; ++l ) {
+            T const a0 = As[i0*k+l];
+            T const a1 = As[i1*k+l];
+            T const b0 = Bs[l*n+j0];
+            T const b1 = Bs[l*n+j1];
+            acc00 += a0 * b0;
+            acc01 += a0 * b1;
+            acc10 += a1 * b0;
+            acc11 += a1 * b1;
+         }
+
+         T* const C = c( first + g );
+
+         auto store = [&]( size_t i, size_t j, T const& acc ) {
+            T& out = C[i*c_rs+j*c_cs];
+            out = ( beta == T(0) ) ? alpha * acc : alpha * acc + beta * out;
+         };
+
+         store( i0, j0, acc00 );
+         if( j0 + 1UL < n ) store( i0, j1, acc01 );
+         if( i0 + 1UL < m ) store( i1, j0, acc10 );
+         if( i0 + 1UL < m && j0 + 1UL < n ) store( i1, j1, acc11 );
+      }
+      __syncthreads();
+   }
+}
+
+}  // namespace cuda_gemm_batched_detail
+
+template < typename T, typename ABatch, typename BBatch, typename CBatch >
+inline void cuda_gemm_batched_small( std::size_t count, std::size_t m, std::size_t n, std::size_t k
+                                   , T alpha
+                                   , ABatch a, std::size_t a_rs, std::size_t a_cs
+                                   , BBatch b, std::size_t b_rs, std::size_t b_cs
+                                   , T beta
+                                   , CBatch c, std::size_t c_rs, std::size_t c_cs )
+{
+   using namespace cuda_gemm_batched_detail;
+
+   constexpr std::size_t max_grid = 65535;
+
+   BLAZE_CUDA_RANGE( "cuda_gemm_batched_small" );
+
+   if( count == 0UL || m == 0UL || n == 0UL ) return;
+
+   const std::size_t group( group_size( m, n, k ) );
+   const std::size_t grid ( std::min( ( count + group - 1UL ) / group, max_grid ) );
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   gemm_batched_small_kernel <<< grid, block_size, 0, cuda_stream() >>>
+      ( count, group, m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs, c_cs );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+#endif // BLAZE_CUDA_HOST_BACKEND
+
+}  // namespace blaze
+
+#endif
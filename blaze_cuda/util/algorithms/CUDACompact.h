@@ -0,0 +1,514 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDACompact.h
+//  \brief Header file for the CUDA counting and stream compaction algorithms
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDACOMPACT_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDACOMPACT_H_
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/algorithms/HostParallel.h>
+#else
+#  include <array>
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze/system/HostDevice.h>
+#include <blaze/util/Limits.h>
+
+#include <blaze_cuda/util/algorithms/CUDAReduce.h>
+#include <blaze_cuda/util/algorithms/CUDAScan.h>
+#include <blaze_cuda/util/algorithms/CUDASegmentedReduce.h>
+#include <blaze_cuda/util/algorithms/CUDATransformReduce.h>
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+#include <blaze_cuda/util/CUDAMemoryPool.h>
+
+namespace blaze {
+
+namespace cuda_compact_detail {
+
+/*!\brief Sum of two counts.
+*/
+struct Plus
+{
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& a, T const& b ) const { return a + b; }
+};
+
+/*!\brief Maps a value to 1 if it satisfies the predicate, 0 otherwise.
+*/
+template< typename Pred >
+struct Indicator
+{
+   Pred pred;
+
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE std::size_t operator()( T const& x ) const { return pred( x ) ? 1 : 0; }
+};
+
+/*!\brief Loads the indicator of the i-th element of a padded block.
+*/
+template< typename Input, typename Pred >
+struct PaddedIndicatorLoad
+{
+   cuda_reduce_detail::PaddedLoad<Input> load;
+   Pred pred;
+
+   inline BLAZE_DEVICE_CALLABLE std::size_t operator()( std::size_t i ) { return pred( load( i ) ) ? 1 : 0; }
+};
+
+/*!\brief Emits the selected element itself.
+*/
+struct EmitValue
+{
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE T operator()( std::size_t, T const& x ) const { return x; }
+};
+
+/*!\brief Emits the index of the selected element.
+*/
+struct EmitIndex
+{
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE std::size_t operator()( std::size_t i, T const& ) const { return i; }
+};
+
+}  // namespace cuda_compact_detail
+
+
+//*************************************************************************************************
+/*!\brief Predicate selecting the elements different from their default value.
+// \ingroup util
+//
+// Used by the nonZeros() functions of the CUDA containers. As the relaxed isDefault() on the
+// host, floating point values (and the parts of complex values) within the accuracy of their
+// type around zero are treated as default values.
+*/
+struct CUDAIsNonDefault
+{
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE bool operator()( T const& x ) const { return !( x == T() ); }
+
+   inline BLAZE_DEVICE_CALLABLE bool operator()( float x ) const { return !isZero( x ); }
+   inline BLAZE_DEVICE_CALLABLE bool operator()( double x ) const { return !isZero( x ); }
+
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE bool operator()( std::complex<T> const& x ) const {
+      return !( isZero( x.real() ) && isZero( x.imag() ) );
+   }
+
+ private:
+   template< typename T >
+   static inline BLAZE_DEVICE_CALLABLE bool isZero( T x ) {
+      constexpr T acc( Limits<T>::accuracy() );
+      return -acc <= x && x <= acc;
+   }
+};
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  COUNTING
+//
+//=================================================================================================
+
+/*!\brief Returns the number of elements of [in_begin, in_end) satisfying \a pred.
+//
+// The count is computed by a single launch of the transform-reduce kernel.
+*/
+template < typename InputIt, typename Pred >
+inline std::size_t cuda_count_if( InputIt in_begin, InputIt in_end, Pred pred )
+{
+   return cuda_transform_reduce( in_begin, in_end, std::size_t( 0 )
+                               , cuda_compact_detail::Plus()
+                               , cuda_compact_detail::Indicator<Pred>{ pred } );
+}
+
+/*!\brief Returns the number of elements of the m x n block at \a in_begin satisfying \a pred.
+//
+// The padding of the block is skipped, and the whole block is counted by a single launch.
+*/
+template < typename InputIt, typename Pred >
+inline std::size_t cuda_count_if_2d( std::size_t m, std::size_t n
+                                   , InputIt in_begin, std::size_t in_spacing, Pred pred )
+{
+   using Load = cuda_compact_detail::PaddedIndicatorLoad< InputIt, Pred >;
+
+   if( m == 0UL || n == 0UL ) return 0UL;
+
+   CUDAReduceWorkspace<std::size_t>& workspace( cuda_reduce_workspace<std::size_t>() );
+
+   cuda_reduce_detail::reduce_into< cuda_tuned, cuda_tuned >( m * n
+      , Load{ { in_begin, n, in_spacing }, pred }, std::size_t( 0 )
+      , cuda_compact_detail::Plus(), workspace.result(), workspace );
+
+   return workspace.value();
+}
+
+
+
+
+//=================================================================================================
+//
+//  STREAM COMPACTION
+//
+//=================================================================================================
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+
+namespace cuda_compact_detail {
+
+using cuda_scan_detail::block_size;
+
+/*!\brief Counts the selected elements of each chunk into counts[blockIdx.x].
+*/
+template < typename InputIt, typename Pred >
+void __global__ chunk_count_kernel( std::size_t size, std::size_t chunk
+                                  , InputIt in_begin, Pred pred, std::size_t* counts )
+{
+   using std::size_t;
+
+   __shared__ std::array< size_t, block_size > sdata;
+
+   size_t const begin = blockIdx.x * chunk;
+   size_t const end   = begin + chunk < size ? begin + chunk : size;
+
+   size_t acc = 0;
+
+   for( size_t i = begin + threadIdx.x; i < end; i += block_size )
+      acc += pred( *( in_begin + i ) ) ? 1 : 0;
+
+   cuda_reduce_detail::block_reduce< cuda_scan_detail::block_size_exponent >( sdata, acc, Plus() );
+
+   if( threadIdx.x == 0 )
+      counts[ blockIdx.x ] = sdata[ 0 ];
+}
+
+/*!\brief Writes the selected elements of each chunk, in order, after those of the chunks before.
+*/
+template < typename InputIt, typename OutputIt, typename Pred, typename Emit >
+void __global__ chunk_write_kernel( std::size_t size, std::size_t chunk
+                                  , InputIt in_begin, Pred pred, std::size_t const* offsets
+                                  , OutputIt out_begin, Emit emit )
+{
+   using std::size_t;
+
+   __shared__ std::array< size_t, block_size > sdata;
+
+   size_t const begin = blockIdx.x * chunk;
+   size_t const end   = begin + chunk < size ? begin + chunk : size;
+
+   size_t offset = blockIdx.x > 0 ? offsets[ blockIdx.x - 1 ] : 0;
+
+   for( size_t base = begin; base < end; base += block_size )
+   {
+      size_t const i = base + threadIdx.x;
+      bool const selected = i < end && pred( *( in_begin + i ) );
+
+      sdata[ threadIdx.x ] = selected ? 1 : 0;
+      __syncthreads();
+
+      // Positions of the selected elements within the tile
+      cuda_scan_detail::block_scan( sdata, Plus() );
+
+      if( selected )
+         *( out_begin + offset + sdata[ threadIdx.x ] - 1 ) = emit( i, *( in_begin + i ) );
+
+      offset += sdata[ block_size - 1 ];
+      __syncthreads();
+   }
+}
+
+}  // namespace cuda_compact_detail
+
+#endif // BLAZE_CUDA_HOST_BACKEND
+
+
+//*************************************************************************************************
+/*!\brief Stream compaction of a range, in two steps.
+// \ingroup util
+//
+// count() counts the elements satisfying the predicate chunk by chunk and scans the per-chunk
+// counts on the device; only the total is transferred to the host. copy() and copyIndices()
+// then write the selected elements (resp. their indices) in order, each chunk starting at the
+// offset computed by count(), so the output can be allocated with its exact size in between.
+// The range, the predicate and the execution context must be the same for both steps.
+*/
+class CUDACompaction
+{
+ public:
+   //**Constructor and destructor******************************************************************
+   CUDACompaction() = default;
+   CUDACompaction( const CUDACompaction& ) = delete;
+   CUDACompaction& operator=( const CUDACompaction& ) = delete;
+   inline ~CUDACompaction();
+   //**********************************************************************************************
+
+   //**Compaction functions************************************************************************
+   template< typename InputIt, typename Pred >
+   inline std::size_t count( InputIt in_begin, InputIt in_end, Pred pred );
+
+   template< typename InputIt, typename OutputIt, typename Pred >
+   inline void copy( InputIt in_begin, OutputIt out_begin, Pred pred ) const;
+
+   template< typename InputIt, typename OutputIt, typename Pred >
+   inline void copyIndices( InputIt in_begin, OutputIt out_begin, Pred pred ) const;
+   //**********************************************************************************************
+
+ private:
+   //**Utility functions***************************************************************************
+   template< typename InputIt, typename OutputIt, typename Pred, typename Emit >
+   inline void write( InputIt in_begin, OutputIt out_begin, Pred pred, Emit emit ) const;
+
+   inline void release();
+   //**********************************************************************************************
+
+   //**Member variables****************************************************************************
+   std::size_t size_  = 0UL;  //!< Size of the counted range.
+   std::size_t total_ = 0UL;  //!< Number of selected elements.
+   std::size_t chunk_ = 0UL;  //!< Number of elements per chunk.
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   std::vector<std::size_t> offsets_;  //!< Number of selected elements before each chunk.
+#else
+   std::size_t  chunks_  = 0UL;      //!< Number of chunks.
+   std::size_t* offsets_ = nullptr;  //!< Device scan of the per-chunk counts.
+#endif
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief The destructor.
+*/
+inline CUDACompaction::~CUDACompaction()
+{
+   release();
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Releases the per-chunk offsets.
+*/
+inline void CUDACompaction::release()
+{
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+   if( offsets_ != nullptr ) {
+      cuda_device_memory_pool().deallocate( offsets_ );
+      offsets_ = nullptr;
+   }
+#endif
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Counts the elements of [in_begin, in_end) satisfying \a pred.
+//
+// \param in_begin The beginning of the range.
+// \param in_end The end of the range.
+// \param pred The selection predicate.
+// \return The number of selected elements.
+*/
+template< typename InputIt, typename Pred >
+inline std::size_t CUDACompaction::count( InputIt in_begin, InputIt in_end, Pred pred )
+{
+   using std::size_t;
+
+   if( in_end - in_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   release();
+
+   size_  = in_end - in_begin;
+   total_ = 0UL;
+
+   if( size_ == 0UL ) return 0UL;
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   offsets_.assign( host_chunk_count( size_ ), 0UL );
+
+   host_parallel_for( size_, [&]( size_t chunk, size_t begin, size_t end )
+   {
+      size_t acc = 0UL;
+
+      for( size_t i = begin; i < end; ++i )
+         acc += pred( *( in_begin + i ) ) ? 1UL : 0UL;
+
+      offsets_[chunk] = acc;
+   } );
+
+   for( auto& offset : offsets_ ) {
+      const size_t cnt( offset );
+      offset = total_;
+      total_ += cnt;
+   }
+#else
+   using cuda_scan_detail::block_size;
+
+   chunks_ = std::min( ( size_ + cuda_scan_detail::min_chunk_size - 1 ) / cuda_scan_detail::min_chunk_size
+                     , cuda_scan_detail::max_chunks );
+   chunk_  = ( size_ + chunks_ - 1 ) / chunks_;
+
+   offsets_ = static_cast<size_t*>(
+      cuda_device_memory_pool().allocate( chunks_ * sizeof(size_t), cuda_stream() ) );
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   cuda_compact_detail::chunk_count_kernel <<< chunks_, block_size, 0, cuda_stream() >>>
+      ( size_, chunk_, in_begin, pred, offsets_ );
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   cuda_scan_detail::chunk_scan_kernel< false > <<< 1, block_size, 0, cuda_stream() >>>
+      ( chunks_, chunks_, offsets_, offsets_, static_cast<size_t const*>( nullptr )
+      , size_t( 0 ), false, cuda_compact_detail::Plus() );
+
+   cudaMemcpyAsync( &total_, offsets_ + chunks_ - 1, sizeof(size_t), cudaMemcpyDeviceToHost, cuda_stream() );
+   cudaStreamSynchronize( cuda_stream() );
+   BLAZE_CUDA_COUNT( transfers, sizeof(size_t) );
+   BLAZE_CUDA_COUNT( synchronizations, 1UL );
+   BLAZE_CUDA_ERROR_CHECK;
+#endif
+
+   return total_;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Writes the elements selected by the last count() to \a out_begin.
+//
+// \param in_begin The beginning of the counted range.
+// \param out_begin The beginning of the output range, of at least count() elements.
+// \param pred The selection predicate given to count().
+// \return void
+*/
+template< typename InputIt, typename OutputIt, typename Pred >
+inline void CUDACompaction::copy( InputIt in_begin, OutputIt out_begin, Pred pred ) const
+{
+   write( in_begin, out_begin, pred, cuda_compact_detail::EmitValue() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Writes the indices of the elements selected by the last count() to \a out_begin.
+//
+// \param in_begin The beginning of the counted range.
+// \param out_begin The beginning of the output range, of at least count() elements.
+// \param pred The selection predicate given to count().
+// \return void
+*/
+template< typename InputIt, typename OutputIt, typename Pred >
+inline void CUDACompaction::copyIndices( InputIt in_begin, OutputIt out_begin, Pred pred ) const
+{
+   write( in_begin, out_begin, pred, cuda_compact_detail::EmitIndex() );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Backend of copy() and copyIndices().
+*/
+template< typename InputIt, typename OutputIt, typename Pred, typename Emit >
+inline void CUDACompaction::write( InputIt in_begin, OutputIt out_begin, Pred pred, Emit emit ) const
+{
+   using std::size_t;
+
+   if( total_ == 0UL ) return;
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   host_parallel_for( size_, [&]( size_t chunk, size_t begin, size_t end )
+   {
+      auto out = out_begin + offsets_[chunk];
+
+      for( size_t i = begin; i < end; ++i ) {
+         const auto x( *( in_begin + i ) );
+         if( pred( x ) ) {
+            *out = emit( i, x );
+            ++out;
+         }
+      }
+   } );
+#else
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   cuda_compact_detail::chunk_write_kernel
+      <<< chunks_, cuda_scan_detail::block_size, 0, cuda_stream() >>>
+      ( size_, chunk_, in_begin, pred, static_cast<size_t const*>( offsets_ ), out_begin, emit );
+
+   BLAZE_CUDA_ERROR_CHECK;
+#endif
+}
+//*************************************************************************************************
+
+
+/*!\brief Copies the elements of [in_begin, in_end) satisfying \a pred to \a out_begin, in order.
+//
+// \return The number of copied elements.
+*/
+template < typename InputIt, typename OutputIt, typename Pred >
+inline std::size_t cuda_copy_if( InputIt in_begin, InputIt in_end, OutputIt out_begin, Pred pred )
+{
+   CUDACompaction compaction;
+   const std::size_t n( compaction.count( in_begin, in_end, pred ) );
+   compaction.copy( in_begin, out_begin, pred );
+   return n;
+}
+
+/*!\brief Writes the indices of the elements of [in_begin, in_end) satisfying \a pred to
+// \a out_begin, in increasing order.
+//
+// \return The number of written indices.
+*/
+template < typename InputIt, typename OutputIt, typename Pred >
+inline std::size_t cuda_copy_index_if( InputIt in_begin, InputIt in_end, OutputIt out_begin, Pred pred )
+{
+   CUDACompaction compaction;
+   const std::size_t n( compaction.count( in_begin, in_end, pred ) );
+   compaction.copyIndices( in_begin, out_begin, pred );
+   return n;
+}
+
+}  // namespace blaze
+
+#endif
@@ -0,0 +1,254 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDAGemm.h
+//  \brief Header file for the matrix multiplication with a fused epilogue
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDAGEMM_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDAGEMM_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/algorithms/HostParallel.h>
+#else
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  GEMM WITH EPILOGUE
+//
+//  cuda_gemm() computes the product of an m x k matrix A and a k x n matrix B and stores
+//  'epilogue( i, j, acc )' into element (i,j) of the output, 'acc' being the dot product of
+//  row i of A and column j of B. Element (i,j) of an operand is located at 'p + i*rs + j*cs',
+//  so any storage order is expressed by the strides. The epilogue may read other operands at
+//  (i,j) (e.g. a bias or the previous value of the output), which makes scaling, bias
+//  additions and activations part of the single write of the result.
+//
+//  Each block computes a 64x64 tile of the output with 16x16 threads, each accumulating a
+//  4x4 block in registers. Slices of 16 columns of A and 16 rows of B are staged in shared
+//  memory. The rows and columns of a thread are interleaved with a stride of 16, so that the
+//  threads of a warp read consecutive shared memory words and store consecutive outputs.
+//
+//  The host execution backend distributes the rows of the output over the threads.
+//
+//=================================================================================================
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+template < typename AIt, typename BIt, typename OutputIt, typename E >
+inline void cuda_gemm( std::size_t m, std::size_t n, std::size_t k
+                     , AIt a, std::size_t a_rs, std::size_t a_cs
+                     , BIt b, std::size_t b_rs, std::size_t b_cs
+                     , OutputIt out, std::size_t out_rs, std::size_t out_cs
+                     , E epilogue )
+{
+   using T = std::decay_t< decltype( *a * *b ) >;
+
+   BLAZE_CUDA_RANGE( "cuda_gemm" );
+
+   if( m == 0UL || n == 0UL ) return;
+
+   host_parallel_for( m, n * ( k + 1UL ), [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      std::vector<T> acc( n );
+
+      for( std::size_t i = begin; i < end; ++i )
+      {
+         std::fill( acc.begin(), acc.end(), T() );
+
+         for( std::size_t l = 0UL; l < k; ++l ) {
+            const T ail( *( a + i * a_rs + l * a_cs ) );
+            const auto bl( b + l * b_rs );
+            for( std::size_t j = 0UL; j < n; ++j )
+               acc[j] += ail * *( bl + j * b_cs );
+         }
+
+         for( std::size_t j = 0UL; j < n; ++j )
+            *( out + i * out_rs + j * out_cs ) = epilogue( i, j, acc[j] );
+      }
+   } );
+}
+
+#else // BLAZE_CUDA_HOST_BACKEND
+
+namespace cuda_gemm_detail {
+
+constexpr std::size_t tile    = 64;            // Edge of the tile of the output of a block
+constexpr std::size_t depth   = 16;            // Length of the slices of the inner dimension
+constexpr std::size_t micro   = 4;             // Edge of the block accumulated by a thread
+constexpr std::size_t threads = tile / micro;  // Threads along each dimension of a block
+
+/*!\brief Raw shared memory for a padded slice, as elements may not be trivially constructible.
+*/
+template< typename T >
+struct SliceStorage
+{
+   alignas( T ) unsigned char data[ depth * ( tile + 1 ) * sizeof( T ) ];
+
+   inline __device__ T& operator()( std::size_t l, std::size_t i )
+   {
+      return reinterpret_cast<T*>( data )[ l * ( tile + 1 ) + i ];
+   }
+};
+
+inline BLAZE_DEVICE_CALLABLE std::size_t tiles( std::size_t n )
+{
+   return ( n + tile - 1 ) / tile;
+}
+
+template < typename T, typename AIt, typename BIt, typename OutputIt, typename E >
+void __global__ gemm_kernel( std::size_t m, std::size_t n, std::size_t k
+                           , AIt a, std::size_t a_rs, std::size_t a_cs
+                           , BIt b, std::size_t b_rs, std::size_t b_cs
+                           , OutputIt out, std::size_t out_rs, std::size_t out_cs
+                           , E epilogue )
+{
+   using std::size_t;
+
+   __shared__ SliceStorage<T> as;  // as( l, i ) = A( i0+i, l0+l )
+   __shared__ SliceStorage<T> bs;  // bs( l, j ) = B( l0+l, j0+j )
+
+   size_t const tid = threadIdx.y * threads + threadIdx.x;
+
+   // Load along the contiguous dimension of each operand
+   bool const a_rows = ( a_cs == 1UL );
+   bool const b_rows = ( b_cs == 1UL );
+
+   for( size_t ti = blockIdx.y; ti < tiles( m ); ti += gridDim.y )
+   {
+      for( size_t tj = blockIdx.x; tj < tiles( n ); tj += gridDim.x )
+      {
+         size_t const i0 = ti * tile;
+         size_t const j0 = tj * tile;
+
+         T acc[micro][micro];
+
+         #pragma unroll
+         for( size_t r = 0UL; r < micro; ++r )
+            #pragma unroll
+            for( size_t c = 0UL; c < micro; ++c )
+               acc[r][c] = T();
+
+         for( size_t l0 = 0UL; l0 < k; l0 += depth )
+         {
+            for( size_t e = tid; e < tile * depth; e += threads * threads )
+            {
+               size_t const i = a_rows ? e / depth : e % tile;
+               size_t const l = a_rows ? e % depth : e / tile;
+               as( l, i ) = ( i0 + i < m && l0 + l < k )
+                          ? T( *( a + ( i0 + i ) * a_rs + ( l0 + l ) * a_cs ) ) : T();
+
+               size_t const j  = b_rows ? e % tile : e / depth;
+               size_t const lb = b_rows ? e / tile : e % depth;
+               bs( lb, j ) = ( l0 + lb < k && j0 + j < n )
+                           ? T( *( b + ( l0 + lb ) * b_rs + ( j0 + j ) * b_cs ) ) : T();
+            }
+            __syncthreads();
+
+            #pragma unroll
+            for( size_t l = 0UL; l < depth; ++l )
+            {
+               T ra[micro], rb[micro];
+
+               #pragma unroll
+               for( size_t r = 0UL; r < micro; ++r ) {
+                  ra[r] = as( l, threadIdx.y + r * threads );
+                  rb[r] = bs( l, threadIdx.x + r * threads );
+               }
+
+               #pragma unroll
+               for( size_t r = 0UL; r < micro; ++r )
+                  #pragma unroll
+                  for( size_t c = 0UL; c < micro; ++c )
+                     acc[r][c] += ra[r] * rb[c];
+            }
+            __syncthreads();
+         }
+
+         #pragma unroll
+         for( size_t r = 0UL; r < micro; ++r ) {
+            size_t const i = i0 + threadIdx.y + r * threads;
+            #pragma unroll
+            for( size_t c = 0UL; c < micro; ++c ) {
+               size_t const j = j0 + threadIdx.x + c * threads;
+               if( i < m && j < n )
+                  *( out + i * out_rs + j * out_cs ) = epilogue( i, j, acc[r][c] );
+            }
+         }
+      }
+   }
+}
+
+}  // namespace cuda_gemm_detail
+
+template < typename AIt, typename BIt, typename OutputIt, typename E >
+inline void cuda_gemm( std::size_t m, std::size_t n, std::size_t k
+                     , AIt a, std::size_t a_rs, std::size_t a_cs
+                     , BIt b, std::size_t b_rs, std::size_t b_cs
+                     , OutputIt out, std::size_t out_rs, std::size_t out_cs
+                     , E epilogue )
+{
+   using namespace cuda_gemm_detail;
+   using T = std::decay_t< decltype( *a * *b ) >;
+
+   constexpr std::size_t max_grid = 65535;
+
+   BLAZE_CUDA_RANGE( "cuda_gemm" );
+
+   if( m == 0UL || n == 0UL ) return;
+
+   dim3 const grid( std::min( tiles( n ), max_grid ), std::min( tiles( m ), max_grid ) );
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   gemm_kernel<T> <<< grid, dim3( threads, threads ), 0, cuda_stream() >>>
+      ( m, n, k, a, a_rs, a_cs, b, b_rs, b_cs, out, out_rs, out_cs, epilogue );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+#endif // BLAZE_CUDA_HOST_BACKEND
+
+}  // namespace blaze
+
+#endif
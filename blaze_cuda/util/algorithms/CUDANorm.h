@@ -0,0 +1,307 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDANorm.h
+//  \brief Fused norm reductions
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDANORM_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDANORM_H_
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/util/algorithms/CUDAReduce.h>
+#include <blaze_cuda/util/algorithms/CUDASegmentedReduce.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  NORM REDUCTIONS
+//
+//  A norm is computed by a single launch of the kernel of cuda_reduce(): every element is
+//  loaded as a partial state, the states are merged, and the norm is computed from the final
+//  state by the last block. A norm policy provides, as device callable members,
+//
+//     identity()   the state of an empty range,
+//     load(x)      the state of a single element,
+//     operator()   the merge of two states,
+//     finalize(s)  the norm of a state.
+//
+//  The _into variants store the norm into a device scalar without synchronizing, so iterative
+//  solvers can check convergence every few iterations only.
+//
+//=================================================================================================
+
+/*!\brief Partial state of an overflow-safe Euclidean norm: the norm is scale * sqrt(ssq).
+*/
+template< typename T >  // Type of the accumulated values
+struct CUDAScaledSquares
+{
+   T scale;  //!< Largest absolute value of the reduced elements.
+   T ssq;    //!< Sum of the squares of the reduced elements, divided by scale^2.
+};
+
+/*!\brief Euclidean norm policy, scaled as the reference BLAS nrm2.
+//
+// The squares are accumulated relative to the largest absolute value reduced so far, so the
+// norm neither overflows nor underflows unless the result does.
+*/
+template< typename T >  // Type of the accumulated values
+struct CUDAL2Norm
+{
+   using State = CUDAScaledSquares<T>;
+
+   inline BLAZE_DEVICE_CALLABLE State identity() const { return State{ T( 0 ), T( 0 ) }; }
+
+   template< typename U >
+   inline BLAZE_DEVICE_CALLABLE State load( U const& x ) const
+   {
+      using std::abs;
+      T const a = abs( T( x ) );
+      return a == T( 0 ) ? identity() : State{ a, T( 1 ) };
+   }
+
+   inline BLAZE_DEVICE_CALLABLE State operator()( State const& a, State const& b ) const
+   {
+      State const& big   = a.scale < b.scale ? b : a;
+      State const& small = a.scale < b.scale ? a : b;
+
+      // Equal scales include two empty states and two infinite ones
+      if( small.scale == big.scale ) return State{ big.scale, big.ssq + small.ssq };
+      if( small.scale == T( 0 ) ) return big;
+
+      T const ratio = small.scale / big.scale;
+      return State{ big.scale, big.ssq + small.ssq * ratio * ratio };
+   }
+
+   inline BLAZE_DEVICE_CALLABLE T finalize( State const& s ) const
+   {
+      using std::sqrt;
+      return s.scale * sqrt( s.ssq );
+   }
+};
+
+/*!\brief Squared Euclidean norm policy.
+*/
+template< typename T >  // Type of the accumulated values
+struct CUDASqrNorm
+{
+   using State = T;
+
+   inline BLAZE_DEVICE_CALLABLE T identity() const { return T( 0 ); }
+
+   template< typename U >
+   inline BLAZE_DEVICE_CALLABLE T load( U const& x ) const { return T( x ) * T( x ); }
+
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& a, T const& b ) const { return a + b; }
+
+   inline BLAZE_DEVICE_CALLABLE T finalize( T const& s ) const { return s; }
+};
+
+/*!\brief L1 norm policy.
+*/
+template< typename T >  // Type of the accumulated values
+struct CUDAL1Norm
+{
+   using State = T;
+
+   inline BLAZE_DEVICE_CALLABLE T identity() const { return T( 0 ); }
+
+   template< typename U >
+   inline BLAZE_DEVICE_CALLABLE T load( U const& x ) const { using std::abs; return abs( T( x ) ); }
+
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& a, T const& b ) const { return a + b; }
+
+   inline BLAZE_DEVICE_CALLABLE T finalize( T const& s ) const { return s; }
+};
+
+/*!\brief Maximum norm policy.
+*/
+template< typename T >  // Type of the accumulated values
+struct CUDAMaxNorm
+{
+   using State = T;
+
+   inline BLAZE_DEVICE_CALLABLE T identity() const { return T( 0 ); }
+
+   template< typename U >
+   inline BLAZE_DEVICE_CALLABLE T load( U const& x ) const { using std::abs; return abs( T( x ) ); }
+
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& a, T const& b ) const { return a < b ? b : a; }
+
+   inline BLAZE_DEVICE_CALLABLE T finalize( T const& s ) const { return s; }
+};
+
+/*!\brief Lp norm policy.
+*/
+template< typename T >  // Type of the accumulated values
+struct CUDALpNorm
+{
+   using State = T;
+
+   T p;  //!< The norm parameter.
+
+   inline BLAZE_DEVICE_CALLABLE T identity() const { return T( 0 ); }
+
+   template< typename U >
+   inline BLAZE_DEVICE_CALLABLE T load( U const& x ) const
+   {
+      using std::abs; using std::pow;
+      return pow( abs( T( x ) ), p );
+   }
+
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& a, T const& b ) const { return a + b; }
+
+   inline BLAZE_DEVICE_CALLABLE T finalize( T const& s ) const
+   {
+      using std::pow;
+      return pow( s, T( 1 ) / p );
+   }
+};
+
+namespace cuda_norm_detail {
+
+/*!\brief Loads the i-th element of a range as a state of \a Norm.
+*/
+template< typename Load, typename Norm >
+struct NormLoad
+{
+   Load base;
+   Norm norm;
+
+   inline BLAZE_DEVICE_CALLABLE auto operator()( std::size_t i ) { return norm.load( base( i ) ); }
+};
+
+/*!\brief Computes the norm of the final state.
+*/
+template< typename Norm >
+struct NormFinal
+{
+   Norm norm;
+
+   template< typename S >
+   inline BLAZE_DEVICE_CALLABLE auto operator()( S const& s ) const { return norm.finalize( s ); }
+};
+
+template< typename Load, typename Norm, typename R >
+inline void reduce_norm_into( std::size_t size, Load load, Norm norm, R* result )
+{
+   using State = typename Norm::State;
+
+   BLAZE_CUDA_RANGE( "cuda_norm" );
+
+   cuda_reduce_detail::reduce_into< cuda_tuned, cuda_tuned >( size
+      , NormLoad<Load,Norm>{ load, norm }, norm.identity(), norm, NormFinal<Norm>{ norm }
+      , result, cuda_reduce_workspace<State>() );
+}
+
+template< typename Load, typename Norm >
+inline auto reduce_norm( std::size_t size, Load load, Norm norm )
+{
+   using State = typename Norm::State;
+
+   BLAZE_CUDA_RANGE( "cuda_norm" );
+
+   CUDAReduceWorkspace<State>& workspace( cuda_reduce_workspace<State>() );
+
+   // The state is finalized on the host, which leaves the workspace result slot to the state
+   cuda_reduce_detail::reduce_into< cuda_tuned, cuda_tuned >( size
+      , NormLoad<Load,Norm>{ load, norm }, norm.identity(), norm, workspace.result(), workspace );
+
+   return norm.finalize( workspace.value() );
+}
+
+}  // namespace cuda_norm_detail
+
+/*!\brief Stores the norm of [\a in_begin, \a in_end) into the device scalar \a result.
+*/
+template < typename InputIt, typename Norm, typename R >
+inline void cuda_norm_into( InputIt in_begin, InputIt in_end, Norm norm, R* result )
+{
+   if( in_end - in_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   cuda_norm_detail::reduce_norm_into( in_end - in_begin
+      , cuda_reduce_detail::IteratorLoad<InputIt>{ in_begin }, norm, result );
+}
+
+/*!\brief Returns the norm of [\a in_begin, \a in_end).
+*/
+template < typename InputIt, typename Norm >
+inline auto cuda_norm( InputIt in_begin, InputIt in_end, Norm norm )
+{
+   if( in_end - in_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   return cuda_norm_detail::reduce_norm( in_end - in_begin
+      , cuda_reduce_detail::IteratorLoad<InputIt>{ in_begin }, norm );
+}
+
+/*!\brief Stores the norm of the m x n block at \a in_begin, given as for cuda_reduce_2d(), into
+// the device scalar \a result.
+*/
+template < typename InputIt, typename Norm, typename R >
+inline void cuda_norm_2d_into( std::size_t m, std::size_t n
+                             , InputIt in_begin, std::size_t in_spacing
+                             , Norm norm, R* result )
+{
+   if( in_spacing == n || m < 2UL ) {
+      cuda_norm_detail::reduce_norm_into( m * n
+         , cuda_reduce_detail::IteratorLoad<InputIt>{ in_begin }, norm, result );
+   }
+   else {
+      cuda_norm_detail::reduce_norm_into( m * n
+         , cuda_reduce_detail::PaddedLoad<InputIt>{ in_begin, n, in_spacing }, norm, result );
+   }
+}
+
+/*!\brief Returns the norm of the m x n block at \a in_begin, given as for cuda_reduce_2d().
+*/
+template < typename InputIt, typename Norm >
+inline auto cuda_norm_2d( std::size_t m, std::size_t n
+                        , InputIt in_begin, std::size_t in_spacing, Norm norm )
+{
+   if( in_spacing == n || m < 2UL ) {
+      return cuda_norm_detail::reduce_norm( m * n
+         , cuda_reduce_detail::IteratorLoad<InputIt>{ in_begin }, norm );
+   }
+   else {
+      return cuda_norm_detail::reduce_norm( m * n
+         , cuda_reduce_detail::PaddedLoad<InputIt>{ in_begin, n, in_spacing }, norm );
+   }
+}
+
+}  // namespace blaze
+
+#endif
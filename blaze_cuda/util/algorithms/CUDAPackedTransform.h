@@ -0,0 +1,221 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDAPackedTransform.h
+//  \brief Header file for the CUDA element-wise transform of contiguous ranges with 128-bit accesses
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDAPACKEDTRANSFORM_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDAPACKEDTRANSFORM_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/algorithms/HostParallel.h>
+#else
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/util/algorithms/Unroll.h>
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  PACKED TRANSFORM
+//
+//  cuda_packed_transform() computes out[i] = f( in[i]... ) over contiguous ranges. When all the
+//  element types have the same size, dividing 16 bytes, and all the pointers have the same
+//  offset from a 16 byte boundary, each thread loads and stores whole 16 byte packs (the
+//  float4/double2 accesses of the CUDA samples): only the elements before the first and after
+//  the last aligned pack are accessed one by one. Otherwise all the elements are.
+//
+//  The host backend runs a vectorizable loop over the raw pointers.
+//
+//=================================================================================================
+
+namespace cuda_packed_detail {
+
+constexpr std::size_t pack_bytes = 16;
+
+/*!\brief Whether ranges of the given element types can be accessed by 16 byte packs.
+*/
+template< typename Out, typename... In >
+struct IsPackable
+{
+   static constexpr bool value =
+      sizeof(Out) <= pack_bytes && pack_bytes % sizeof(Out) == 0 &&
+      std::is_trivially_copyable<Out>::value &&
+      ( ( sizeof(In) == sizeof(Out) && std::is_trivially_copyable<In>::value ) && ... );
+};
+
+/*!\brief Offset of a pointer from the previous 16 byte boundary.
+*/
+template< typename T >
+inline std::size_t misalignment( T const* ptr ) noexcept
+{
+   return reinterpret_cast<std::uintptr_t>( ptr ) % pack_bytes;
+}
+
+}  // namespace cuda_packed_detail
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+template< typename F, typename Out, typename... In >
+inline void cuda_packed_transform( std::size_t size, Out* out, F f, In const*... in )
+{
+   BLAZE_CUDA_RANGE( "cuda_packed_transform" );
+   BLAZE_CUDA_COUNT( bytes, size * ( sizeof(Out) + ( sizeof(In) + ... + 0UL ) ) );
+
+   host_parallel_for( size, [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      BLAZE_CUDA_HOST_SIMD
+      for( std::ptrdiff_t i = std::ptrdiff_t( begin ); i < std::ptrdiff_t( end ); ++i ) {
+         out[i] = f( in[i]... );
+      }
+   } );
+}
+
+#else // BLAZE_CUDA_HOST_BACKEND
+
+namespace cuda_packed_detail {
+
+constexpr std::size_t block_size = 256;
+constexpr std::size_t max_blocks = 4096;
+
+/*!\brief 16 byte pack of elements.
+*/
+template< typename T >
+struct alignas( pack_bytes ) Pack
+{
+   T v[ pack_bytes / sizeof(T) ];
+};
+
+/*!\brief Computes one pack of results from one pack of each input.
+*/
+template< typename F, typename Out, typename... In >
+__device__ inline void apply( Pack<Out>& res, F const& f, Pack<In> const&... in )
+{
+   unroll< pack_bytes / sizeof(Out) >( [&] ( auto const& I ) {
+      res.v[ I() ] = f( in.v[ I() ]... );
+   } );
+}
+
+/*!\brief Transforms the packs [0, packs), each thread accessing whole packs.
+*/
+template< typename F, typename Out, typename... In >
+void __global__ pack_kernel( std::size_t packs, F f, Pack<Out>* out, Pack<In> const*... in )
+{
+   for( std::size_t p = blockIdx.x * blockDim.x + threadIdx.x; p < packs; p += gridDim.x * blockDim.x )
+   {
+      Pack<Out> res;
+      apply( res, f, in[p]... );
+      out[p] = res;
+   }
+}
+
+/*!\brief Transforms the elements [0, head) and [tail, size) one by one.
+*/
+template< typename F, typename Out, typename... In >
+void __global__ element_kernel( std::size_t size, std::size_t head, std::size_t tail
+                              , F f, Out* out, In const*... in )
+{
+   std::size_t const count = head + ( size - tail );
+
+   for( std::size_t k = blockIdx.x * blockDim.x + threadIdx.x; k < count; k += gridDim.x * blockDim.x )
+   {
+      std::size_t const i = k < head ? k : tail + ( k - head );
+      out[i] = f( in[i]... );
+   }
+}
+
+inline std::size_t grid_size( std::size_t count )
+{
+   return std::min( ( count + block_size - 1 ) / block_size, max_blocks );
+}
+
+}  // namespace cuda_packed_detail
+
+template< typename F, typename Out, typename... In >
+inline void cuda_packed_transform( std::size_t size, Out* out, F f, In const*... in )
+{
+   using namespace cuda_packed_detail;
+
+   if( size == 0UL ) return;
+
+   BLAZE_CUDA_RANGE( "cuda_packed_transform" );
+   BLAZE_CUDA_COUNT( bytes, size * ( sizeof(Out) + ( sizeof(In) + ... + 0UL ) ) );
+
+   std::size_t head( size ), tail( size );
+
+   if constexpr( IsPackable<Out,In...>::value )
+   {
+      constexpr std::size_t width = pack_bytes / sizeof(Out);
+
+      std::size_t const offset( misalignment( out ) );
+
+      if( offset % sizeof(Out) == 0UL && ( ( misalignment( in ) == offset ) && ... ) )
+      {
+         head = std::min( ( ( pack_bytes - offset ) % pack_bytes ) / sizeof(Out), size );
+
+         std::size_t const packs( ( size - head ) / width );
+         tail = head + packs * width;
+
+         if( packs > 0UL ) {
+            BLAZE_CUDA_COUNT( launches, 1UL );
+            pack_kernel <<< grid_size( packs ), block_size, 0, cuda_stream() >>>
+               ( packs, f, reinterpret_cast< Pack<Out>* >( out + head )
+               , reinterpret_cast< Pack<In> const* >( in + head )... );
+         }
+      }
+   }
+
+   if( head + ( size - tail ) > 0UL ) {
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      element_kernel <<< grid_size( head + ( size - tail ) ), block_size, 0, cuda_stream() >>>
+         ( size, head, tail, f, out, in... );
+   }
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+#endif // BLAZE_CUDA_HOST_BACKEND
+
+}  // namespace blaze
+
+#endif
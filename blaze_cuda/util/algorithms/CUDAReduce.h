@@ -35,152 +35,610 @@
 #ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDAREDUCE_H_
 #define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDAREDUCE_H_
 
+#include <algorithm>
 #include <array>
+#include <map>
+#include <memory>
 #include <cstddef>
+#include <stdexcept>
+#include <vector>
 
-#include <cuda_runtime.h>
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/algorithms/HostParallel.h>
+#else
+#  include <cuda_runtime.h>
+#endif
 
 // In Blaze we Thrust
-#ifndef BLAZE_CUDA_NO_THRUST
+#if !defined(BLAZE_CUDA_HOST_BACKEND) && !defined(BLAZE_CUDA_NO_THRUST)
 #  include <thrust/reduce.h>
 #  include <thrust/execution_policy.h>
+#  include <thrust/system/cuda/execution_policy.h>
 #endif
 
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/system/HostDevice.h>
 #include <blaze/system/Inline.h>
 
-#include <blaze_cuda/math/dense/CUDADynamicVector.h>
-#include <blaze_cuda/util/algorithms/CUDATransform.h>
 #include <blaze_cuda/util/algorithms/Unroll.h>
 #include <blaze_cuda/util/CUDAErrorManagement.h>
-#include <blaze_cuda/util/CUDAValue.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+#include <blaze_cuda/util/CUDALaunchTuning.h>
+#include <blaze_cuda/util/CUDAMemoryPool.h>
 
 namespace blaze {
 
-#ifndef BLAZE_CUDA_NO_THRUST
+namespace cuda_reduce_detail {
 
-template < typename Input
+/*!\brief Loads the i-th element of a range given by its first iterator.
+//
+// The reduction kernels read their input through a load functor, which lets cuda_transform_reduce()
+// apply its transform on the fly.
+*/
+template< typename Input >
+struct IteratorLoad
+{
+   Input it;
+
+   inline BLAZE_DEVICE_CALLABLE decltype(auto) operator()( std::size_t i ) { return *( it + i ); }
+};
+
+/*!\brief Stores the reduced value as is.
+//
+// The _into reductions apply a final functor to the reduced value when storing it, which lets
+// reductions over an intermediate state (e.g. a scaled sum of squares) store their actual result
+// without a second launch.
+*/
+struct NoFinal
+{
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& value ) const { return value; }
+};
+
+}  // namespace cuda_reduce_detail
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+namespace cuda_reduce_detail {
+
+template < typename Load
          , typename T
          , typename BinOp >
-inline auto cuda_reduce( Input begin, Input end, T init, BinOp op )
+inline T host_reduce( std::size_t size, Load load, T init, BinOp binop )
 {
-   return thrust::reduce( thrust::device, begin, end, init, op );
+   using std::size_t;
+
+   BLAZE_CUDA_RANGE( "cuda_reduce" );
+   BLAZE_CUDA_COUNT( bytes, size * sizeof(T) );
+
+   // Length of the sequential accumulations, as for the threads of the device kernel
+   constexpr size_t block_size = 4096UL;
+
+   // One partial result per chunk, each one seeded with the first element of its chunk
+   std::vector<T> partials( host_chunk_count( size ), init );
+
+   host_parallel_for( size, [&]( size_t chunk, size_t begin, size_t end )
+   {
+      Load chunk_load( load );
+
+      auto reduce_block = [&]( size_t block_begin ) {
+         const size_t block_end( std::min( block_begin + block_size, end ) );
+         T acc = chunk_load( block_begin );
+
+         for( size_t i = block_begin + 1UL; i < block_end; ++i ) {
+            acc = binop( acc, chunk_load( i ) );
+         }
+
+         return acc;
+      };
+
+      // Long chunks are reduced block by block, which bounds the rounding errors of floating
+      // point reductions as the tree reductions of the device do
+      T acc = reduce_block( begin );
+
+      for( size_t b = begin + block_size; b < end; b += block_size ) {
+         acc = binop( acc, reduce_block( b ) );
+      }
+
+      partials[chunk] = acc;
+   } );
+
+   T res = init;
+
+   if( size > 0UL ) {
+      for( auto const& p : partials ) res = binop( res, p );
+   }
+
+   return res;
 }
 
-#else // !BLAZE_CUDA_USE_THRUST
+}  // namespace cuda_reduce_detail
 
-namespace cuda_reduce_detail {
+template < std::size_t Unroll = cuda_tuned, std::size_t BlockSizeExponent = cuda_tuned
+         , typename Input
+         , typename T
+         , typename BinOp >
+inline auto cuda_reduce
+   ( Input inout_beg
+   , Input inout_end
+   , T init, BinOp binop )
+{
+   if( inout_end - inout_beg < 0 ) throw std::runtime_error("Invalid iterator order");
 
-template < std::size_t Unroll, std::size_t BlockSizeExponent
-         , typename InputIt , typename OutputIt
+   return cuda_reduce_detail::host_reduce( inout_end - inout_beg
+      , cuda_reduce_detail::IteratorLoad<Input>{ inout_beg }, init, binop );
+}
+
+#elif !defined(BLAZE_CUDA_NO_THRUST)
+
+template < typename Input
          , typename T
          , typename BinOp >
-void __global__ reduce_kernel ( InputIt in_beg, OutputIt inout_beg, T init, BinOp binop )
+inline auto cuda_reduce( Input begin, Input end, T init, BinOp op )
 {
-   // See: https://developer.download.nvidia.com/assets/cuda/files/reduction.pdf
+   BLAZE_CUDA_RANGE( "cuda_reduce" );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( end - begin ) * sizeof(T) );
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   BLAZE_CUDA_COUNT( transfers, sizeof(T) );
+   BLAZE_CUDA_COUNT( synchronizations, 1UL );
 
-   constexpr size_t block_size = 1 << BlockSizeExponent;
+   return thrust::reduce( thrust::cuda::par.on( cuda_stream() ), begin, end, init, op );
+}
 
-   // Thread indexing
-   auto const thread_count = blockDim.x * gridDim.x;
-   auto const global_id    = blockDim.x * blockIdx.x + threadIdx.x;
+#endif
 
-   // Array indexing
-   auto begin = in_beg + global_id;
 
-   // Shared memory pool & init
-   __shared__ std::array< T, block_size * 2 > sdata;
-   sdata[ threadIdx.x + block_size ] = init;
+//=================================================================================================
+//
+//  REDUCTION WORKSPACE
+//
+//=================================================================================================
 
-   // Accumulator init
-   T acc = *begin;
+//*************************************************************************************************
+/*!\brief Reusable device workspace of the single pass cuda_reduce() kernel.
+// \ingroup util
+//
+// The workspace holds one partial result per block, the block completion counter and a result
+// slot, all in device memory served by cuda_device_memory_pool(). Reusing a workspace makes a
+// reduction free of any allocation. A workspace must not be used by two reductions running
+// concurrently on different streams; cuda_reduce_workspace() provides one per stream.
+*/
+template< typename T >  // Type of the reduced values
+class CUDAReduceWorkspace
+{
+ public:
+   //**Constructor and destructor******************************************************************
+   explicit inline CUDAReduceWorkspace( std::size_t maxBlocks = 1024UL );
+   CUDAReduceWorkspace( const CUDAReduceWorkspace& ) = delete;
+   CUDAReduceWorkspace& operator=( const CUDAReduceWorkspace& ) = delete;
+   inline ~CUDAReduceWorkspace();
+   //**********************************************************************************************
+
+   //**Utility functions***************************************************************************
+   inline std::size_t   maxBlocks() const noexcept { return maxBlocks_; }
+   inline T*            partials()        noexcept { return partials_; }
+   inline unsigned int* counter()         noexcept { return counter_; }
+   inline T*            result()          noexcept { return partials_ + maxBlocks_; }
+
+   inline T value() const;
+   //**********************************************************************************************
+
+ private:
+   //**Member variables****************************************************************************
+   std::size_t   maxBlocks_;  //!< Maximum number of blocks of a reduction.
+   T*            partials_;   //!< Partial results, followed by the result slot.
+   unsigned int* counter_;    //!< Number of blocks done, reset by the last block.
+   //**********************************************************************************************
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Constructor of a workspace for reductions of up to \a maxBlocks blocks.
+//
+// \param maxBlocks The maximum number of blocks, larger ranges are handled by fewer threads.
+// \exception std::bad_alloc Allocation failed.
+*/
+template< typename T >
+inline CUDAReduceWorkspace<T>::CUDAReduceWorkspace( std::size_t maxBlocks )
+   : maxBlocks_( std::max( maxBlocks, std::size_t( 1UL ) ) )
+   , partials_ ( static_cast<T*>( cuda_device_memory_pool().allocate( ( maxBlocks_ + 1UL )*sizeof(T)
+                                                                    , cuda_stream() ) ) )
+   , counter_  ( nullptr )
+{
+   try {
+      counter_ = static_cast<unsigned int*>( cuda_device_memory_pool().allocate( sizeof(unsigned int)
+                                                                               , cuda_stream() ) );
+   }
+   catch( ... ) {
+      cuda_device_memory_pool().deallocate( partials_ );
+      throw;
+   }
 
-   // Computation, unrolled N times
-   unroll< Unroll - 1 >( [&]( auto const& I ) {
-      acc = binop( acc, *( begin + ( (I() + 1) * thread_count ) ) );
-   } );
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   *counter_ = 0U;
+#else
+   // Completed before any stream uses the workspace
+   cudaMemset( counter_, 0, sizeof(unsigned int) );
+   cudaDeviceSynchronize();
+   BLAZE_CUDA_COUNT( synchronizations, 1UL );
+   BLAZE_CUDA_ERROR_CHECK;
+#endif
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief The destructor.
+*/
+template< typename T >
+inline CUDAReduceWorkspace<T>::~CUDAReduceWorkspace()
+{
+   cuda_device_memory_pool().deallocate( counter_  );
+   cuda_device_memory_pool().deallocate( partials_ );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the content of the result slot.
+//
+// \return The last result written to result().
+//
+// The copy waits for the work previously submitted to the stream of the current execution
+// context, but does not synchronize the whole device.
+*/
+template< typename T >
+inline T CUDAReduceWorkspace<T>::value() const
+{
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+   return partials_[maxBlocks_];
+#else
+   T res;
+   cudaMemcpyAsync( &res, partials_ + maxBlocks_, sizeof(T), cudaMemcpyDeviceToHost, cuda_stream() );
+   cudaStreamSynchronize( cuda_stream() );
+   BLAZE_CUDA_COUNT( transfers, sizeof(T) );
+   BLAZE_CUDA_COUNT( synchronizations, 1UL );
+   BLAZE_CUDA_ERROR_CHECK;
+   return res;
+#endif
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the reduction workspace of the calling thread for the current stream.
+// \ingroup util
+//
+// \return Reference to the thread local workspace for values of type \a T.
+*/
+template< typename T >
+inline CUDAReduceWorkspace<T>& cuda_reduce_workspace()
+{
+   thread_local std::map< cudaStream_t, std::unique_ptr< CUDAReduceWorkspace<T> > > registry;
+
+   auto& workspace( registry[ cuda_stream() ] );
+
+   if( !workspace ) {
+      workspace = std::make_unique< CUDAReduceWorkspace<T> >();
+   }
+
+   return *workspace;
+}
+//*************************************************************************************************
+
+
+
+
+//=================================================================================================
+//
+//  WORKSPACE BASED REDUCTIONS
+//
+//=================================================================================================
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+namespace cuda_reduce_detail {
+
+template < std::size_t Unroll, std::size_t BlockSizeExponent
+         , typename Load
+         , typename T
+         , typename BinOp
+         , typename Final
+         , typename R >
+inline void reduce_into
+   ( std::size_t size, Load load, T init, BinOp binop, Final final
+   , R* result, CUDAReduceWorkspace<T>& workspace )
+{
+   (void)workspace;
+   *result = final( host_reduce( size, load, init, binop ) );
+}
 
-   // Storing result
+}  // namespace cuda_reduce_detail
+
+#else
+
+namespace cuda_reduce_detail {
+
+/*!\brief Reduces one value per thread into sdata[0], for all the threads of the block.
+*/
+template < std::size_t BlockSizeExponent, typename T, typename BinOp >
+__device__ inline void block_reduce( std::array< T, 1 << BlockSizeExponent >& sdata
+                                   , T const& acc, BinOp binop )
+{
    sdata[ threadIdx.x ] = acc;
    __syncthreads();
 
-   // Block reduction
    unroll< BlockSizeExponent >( [&] ( auto I ) {
       auto constexpr Delta = 1 << ( BlockSizeExponent - I() - 1 );
-      auto v = binop( sdata[ threadIdx.x ], sdata[ threadIdx.x + Delta ] );
-      __syncthreads();
-      sdata[ threadIdx.x ] = v;
+      if( threadIdx.x < Delta )
+         sdata[ threadIdx.x ] = binop( sdata[ threadIdx.x ], sdata[ threadIdx.x + Delta ] );
       __syncthreads();
    } );
+}
+
+/*!\brief Single pass reduction: every block reduces a grid-stride slice of the range, and the
+// last block to finish reduces the partial results into *result.
+*/
+template < std::size_t BlockSizeExponent
+         , typename Load
+         , typename T
+         , typename BinOp
+         , typename Final
+         , typename R >
+void __global__ fused_reduce_kernel
+   ( Load load, std::size_t size, T init, BinOp binop, Final final
+   , T* partials, unsigned int* counter, R* result )
+{
+   // See the threadFenceReduction CUDA sample
+
+   constexpr std::size_t block_size = 1 << BlockSizeExponent;
+
+   __shared__ std::array< T, block_size > sdata;
+   __shared__ bool is_last;
+
+   // Accumulating a grid-stride slice, out-of-range threads keep init
+   T acc = init;
+
+   for( std::size_t i = blockIdx.x * block_size + threadIdx.x; i < size
+      ; i += block_size * gridDim.x )
+      acc = binop( acc, load( i ) );
+
+   block_reduce< BlockSizeExponent >( sdata, acc, binop );
+
+   if( threadIdx.x == 0 ) {
+      partials[ blockIdx.x ] = sdata[ 0 ];
+      __threadfence();
+
+      // Wraps back to 0 for the last block, which leaves the counter ready for the next call
+      is_last = ( atomicInc( counter, gridDim.x - 1 ) == gridDim.x - 1 );
+   }
+   __syncthreads();
+
+   if( !is_last )
+      return;
+
+   // Reducing the partial results
+   acc = init;
+
+   for( std::size_t i = threadIdx.x; i < gridDim.x; i += block_size )
+      acc = binop( acc, partials[ i ] );
+
+   block_reduce< BlockSizeExponent >( sdata, acc, binop );
 
-   // Storing result
    if( threadIdx.x == 0 )
-      *( inout_beg + blockIdx.x ) = binop( *( inout_beg + blockIdx.x ), sdata[ 0 ] );
+      *result = final( sdata[ 0 ] );
+}
+
+/*!\brief Launches the single pass reduction with blocks of 2^BlockSizeExponent threads, each
+// thread reducing about \a unroll elements.
+*/
+template < std::size_t BlockSizeExponent
+         , typename Load
+         , typename T
+         , typename BinOp
+         , typename Final
+         , typename R >
+inline void launch_reduce
+   ( std::size_t size, std::size_t unroll, Load load, T init, BinOp binop, Final final
+   , R* result, CUDAReduceWorkspace<T>& workspace )
+{
+   using std::size_t;
+
+   size_t constexpr block_size = 1 << BlockSizeExponent;
+   size_t const elmts_per_block = block_size * unroll;
+
+   size_t const block_cnt = std::max( std::min( ( size + elmts_per_block - 1 ) / elmts_per_block
+                                              , workspace.maxBlocks() )
+                                    , size_t( 1 ) );
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   fused_reduce_kernel
+      < BlockSizeExponent >
+      <<< block_cnt, block_size, 0, cuda_stream() >>>
+      ( load, size, init, binop, final, workspace.partials(), workspace.counter(), result );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+/*!\brief Launches the single pass reduction with the given configuration.
+*/
+template < typename Load
+         , typename T
+         , typename BinOp
+         , typename Final
+         , typename R >
+inline void launch_reduce
+   ( CUDALaunchConfig const& config, std::size_t size, Load load, T init, BinOp binop, Final final
+   , R* result, CUDAReduceWorkspace<T>& workspace )
+{
+   switch( config.blockSize ) {
+      case  128: launch_reduce<  7 >( size, config.unroll, load, init, binop, final, result, workspace ); break;
+      case  512: launch_reduce<  9 >( size, config.unroll, load, init, binop, final, result, workspace ); break;
+      case 1024: launch_reduce< 10 >( size, config.unroll, load, init, binop, final, result, workspace ); break;
+      default:   launch_reduce<  8 >( size, config.unroll, load, init, binop, final, result, workspace ); break;
    }
+}
+
+/*!\brief Configurations tried when tuning the reduction, and the default one.
+*/
+constexpr std::array< CUDALaunchConfig, 12 > reduce_candidates
+   {{ {  128, 1 }, {  128, 4 }, {  128, 16 }
+    , {  256, 1 }, {  256, 4 }, {  256, 16 }
+    , {  512, 1 }, {  512, 4 }, {  512, 16 }
+    , { 1024, 1 }, { 1024, 4 }, { 1024, 16 } }};
+
+constexpr CUDALaunchConfig reduce_default{ 256, 16 };
+
+/*!\brief Reduces into *result, with the tuned configuration unless both parameters are given.
+//
+// An unspecified parameter takes its default value (Unroll = 16, BlockSizeExponent = 8) when the
+// other one is given. Since a reduction only reads its input, a missing configuration can be
+// tuned on the actual range, the candidates writing to the result slot of the workspace.
+*/
+template < std::size_t Unroll, std::size_t BlockSizeExponent
+         , typename Load
+         , typename T
+         , typename BinOp
+         , typename Final
+         , typename R >
+inline void reduce_into
+   ( std::size_t size, Load load, T init, BinOp binop, Final final
+   , R* result, CUDAReduceWorkspace<T>& workspace )
+{
+   BLAZE_CUDA_RANGE( "cuda_reduce" );
+   BLAZE_CUDA_COUNT( bytes, size * sizeof(T) );
+
+   if constexpr( Unroll == cuda_tuned && BlockSizeExponent == cuda_tuned )
+   {
+      CUDALaunchConfig const config( cuda_launch_table().lookup(
+         "reduce", cuda_launch_type_name<T>(), size, reduce_default, [&] {
+            return cuda_fastest_config( reduce_candidates, [&]( CUDALaunchConfig const& c ) {
+               launch_reduce( c, size, load, init, binop, NoFinal(), workspace.result(), workspace );
+            } );
+         } ) );
+
+      launch_reduce( config, size, load, init, binop, final, result, workspace );
+   }
+   else
+   {
+      launch_reduce< BlockSizeExponent == cuda_tuned ? 8 : BlockSizeExponent >
+         ( size, Unroll == cuda_tuned ? 16 : Unroll, load, init, binop, final, result, workspace );
+   }
+}
 
 }  // namespace cuda_reduce_detail
 
-template < std::size_t Unroll = 16, std::size_t BlockSizeExponent = 8
-         , typename Input
+#endif
+
+namespace cuda_reduce_detail {
+
+/*!\brief Reduces into *result, storing the reduced value as is.
+*/
+template < std::size_t Unroll, std::size_t BlockSizeExponent
+         , typename Load
          , typename T
          , typename BinOp >
-inline auto cuda_reduce
-   ( Input inout_beg
-   , Input inout_end
-   , T init, BinOp binop )
+inline void reduce_into
+   ( std::size_t size, Load load, T init, BinOp binop
+   , T* result, CUDAReduceWorkspace<T>& workspace )
 {
-   using cuda_reduce_detail::reduce_kernel;
+   reduce_into< Unroll, BlockSizeExponent >( size, load, init, binop, NoFinal(), result, workspace );
+}
 
-   using std::size_t;
+}  // namespace cuda_reduce_detail
 
+/*!\brief Reduces [inout_beg, inout_end) into the device scalar \a result.
+//
+// The reduction runs as a single kernel without any allocation or synchronization: \a result
+// holds the value once the work submitted to the stream of the current execution context is
+// done. \a init must be an identity of \a binop.
+*/
+template < std::size_t Unroll = cuda_tuned, std::size_t BlockSizeExponent = cuda_tuned
+         , typename Input
+         , typename T
+         , typename BinOp >
+inline void cuda_reduce_into
+   ( Input inout_beg, Input inout_end, T init, BinOp binop
+   , T* result, CUDAReduceWorkspace<T>& workspace )
+{
    if( inout_end - inout_beg < 0 ) throw std::runtime_error("Invalid iterator order");
 
-   size_t constexpr block_size = 1 << BlockSizeExponent;
-   size_t constexpr elmts_per_block = block_size * Unroll;
+   cuda_reduce_detail::reduce_into< Unroll, BlockSizeExponent >( inout_end - inout_beg
+      , cuda_reduce_detail::IteratorLoad<Input>{ inout_beg }, init, binop, result, workspace );
+}
+
+/*!\brief Reduces [inout_beg, inout_end) using the given workspace.
+//
+// Only the transfer of the result to the host waits for the device.
+*/
+template < std::size_t Unroll = cuda_tuned, std::size_t BlockSizeExponent = cuda_tuned
+         , typename Input
+         , typename T
+         , typename BinOp >
+inline T cuda_reduce
+   ( Input inout_beg, Input inout_end, T init, BinOp binop, CUDAReduceWorkspace<T>& workspace )
+{
+   cuda_reduce_into< Unroll, BlockSizeExponent >
+      ( inout_beg, inout_end, init, binop, workspace.result(), workspace );
 
-   size_t const unpadded_size = ( inout_end - inout_beg ) % elmts_per_block;
+   return workspace.value();
+}
 
-   using store_t = CUDADynamicVector<T>;
-   store_t store_vec( elmts_per_block, init );
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
 
-   if( unpadded_size > 0 ) {
-      cuda_transform( inout_end - unpadded_size, inout_end
-         , store_vec.begin()
-         , store_vec.begin(), binop );
+namespace cuda_reduce_detail {
 
-      //cudaDeviceSynchronize();
-      //CUDA_ERROR_CHECK;
-   }
+struct TuningSum
+{
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& a, T const& b ) const { return a + b; }
+};
 
-   // Computing
+}  // namespace cuda_reduce_detail
 
-   while( inout_end - inout_beg >= ptrdiff_t( elmts_per_block ) )
-   {
-      size_t const size      = inout_end - inout_beg;
-      size_t const block_cnt = std::min( size / elmts_per_block, elmts_per_block );
+/*!\brief Tunes the reduction of \a size elements of type \a T.
+//
+// The candidates sum a zeroed scratch range, the fastest configuration is inserted into
+// cuda_launch_table(). It applies to all the reductions of values of type \a T.
+*/
+template < typename T >
+inline void cuda_tune_reduce( std::size_t size )
+{
+   using Load = cuda_reduce_detail::IteratorLoad<T const*>;
 
-      reduce_kernel
-         < Unroll, BlockSizeExponent >
-         <<< block_cnt, block_size >>>
-         ( inout_beg, store_vec.begin(), init, binop );
+   if( size == 0UL ) return;
 
-      inout_beg += block_cnt * elmts_per_block;
-      //cudaDeviceSynchronize();
-   }
+   T* const in = static_cast<T*>( cuda_device_memory_pool().allocate( size * sizeof(T), cuda_stream() ) );
+   cudaMemsetAsync( in, 0, size * sizeof(T), cuda_stream() );
 
-   // Initializing final reduce value
-   CUDAManagedValue<T> res_wrapper( init );
-   auto& res = *res_wrapper;
+   CUDAReduceWorkspace<T>& workspace( cuda_reduce_workspace<T>() );
 
-   // Reducing the storage vector inside *res_wrapper
-   reduce_kernel
-      < Unroll, BlockSizeExponent >
-      <<< 1, block_size >>>
-      ( store_vec.begin(), &res, init, binop );
+   cuda_launch_table().insert( "reduce", cuda_launch_type_name<T>(), size
+      , cuda_fastest_config( cuda_reduce_detail::reduce_candidates, [&]( CUDALaunchConfig const& c ) {
+           cuda_reduce_detail::launch_reduce( c, size, Load{ in }, T( 0 ), cuda_reduce_detail::TuningSum()
+                                            , cuda_reduce_detail::NoFinal(), workspace.result(), workspace );
+        } ) );
 
-   cudaDeviceSynchronize();
-   BLAZE_CUDA_ERROR_CHECK;
+   cuda_device_memory_pool().deallocate( in );
+}
 
-   return res;
+#endif
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND) && defined(BLAZE_CUDA_NO_THRUST)
+
+template < std::size_t Unroll = cuda_tuned, std::size_t BlockSizeExponent = cuda_tuned
+         , typename Input
+         , typename T
+         , typename BinOp >
+inline auto cuda_reduce
+   ( Input inout_beg
+   , Input inout_end
+   , T init, BinOp binop )
+{
+   return cuda_reduce< Unroll, BlockSizeExponent >
+      ( inout_beg, inout_end, init, binop, cuda_reduce_workspace<T>() );
 }
 
 #endif
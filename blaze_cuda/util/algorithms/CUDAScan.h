@@ -0,0 +1,453 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDAScan.h
+//  \brief Header file for the CUDA inclusive and exclusive scan algorithms
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDASCAN_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDASCAN_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/algorithms/HostParallel.h>
+#else
+#  include <array>
+#  include <cuda_runtime.h>
+#  include <blaze_cuda/util/algorithms/Unroll.h>
+#endif
+
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+#include <blaze_cuda/util/CUDAMemoryPool.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  SCANS
+//
+//  cuda_inclusive_scan() and cuda_exclusive_scan() follow std::inclusive_scan() and
+//  std::exclusive_scan(): 'out[i]' is the combination of 'in[0..i]' (resp. of 'init' and
+//  'in[0..i)'). The operation must be associative, the operands are combined in order. Scans may
+//  be performed in place.
+//
+//  Ranges are scanned in three passes: the range is split into at most 1024 chunks, whose sums
+//  are computed, then scanned by a single block, and finally each chunk is scanned by a block
+//  starting from the sum of the previous chunks. Small ranges are scanned by a single launch.
+//
+//  cuda_inclusive_scan_segments() scans each of the m contiguous segments of an m x n block
+//  given as for cuda_transform_2d(), cuda_inclusive_scan_strided() scans each of its n columns.
+//
+//=================================================================================================
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+namespace cuda_scan_detail {
+
+template < bool Exclusive, typename InputIt, typename OutputIt, typename T, typename BinOp >
+inline void scan( std::size_t size, InputIt in_begin, OutputIt out_begin
+                , T init, bool has_init, BinOp binop )
+{
+   using std::size_t;
+
+   if( size == 0UL ) return;
+
+   const size_t chunks( host_chunk_count( size ) );
+
+   // Sum of each chunk, then carry into each chunk
+   std::vector<T> carries( chunks );
+
+   host_parallel_for( size, [&]( size_t chunk, size_t begin, size_t end )
+   {
+      T acc = *( in_begin + begin );
+
+      for( size_t i = begin + 1UL; i < end; ++i )
+         acc = binop( acc, *( in_begin + i ) );
+
+      carries[chunk] = acc;
+   } );
+
+   T carry = init;
+
+   for( size_t c = 0UL; c < chunks; ++c ) {
+      const T sum( carries[c] );
+      carries[c] = carry;
+      carry = ( c > 0UL || has_init ) ? binop( carry, sum ) : sum;
+   }
+
+   host_parallel_for( size, [&]( size_t chunk, size_t begin, size_t end )
+   {
+      bool has_carry( chunk > 0UL || has_init );
+      T acc( carries[chunk] );
+
+      for( size_t i = begin; i < end; ++i )
+      {
+         const T x( *( in_begin + i ) );
+
+         if( Exclusive ) {
+            *( out_begin + i ) = acc;
+            acc = binop( acc, x );
+         }
+         else {
+            acc = has_carry ? binop( acc, x ) : x;
+            has_carry = true;
+            *( out_begin + i ) = acc;
+         }
+      }
+   } );
+}
+
+}  // namespace cuda_scan_detail
+
+template < typename InputIt, typename OutputIt, typename BinOp >
+inline void cuda_inclusive_scan_segments( std::size_t m, std::size_t n
+                                        , InputIt in_begin, std::size_t in_spacing
+                                        , OutputIt out_begin, std::size_t out_spacing
+                                        , BinOp binop )
+{
+   if( n == 0UL ) return;
+
+   host_parallel_for( m, n, [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( std::size_t i = begin; i < end; ++i )
+      {
+         const auto in  = in_begin  + i * in_spacing;
+         const auto out = out_begin + i * out_spacing;
+
+         auto acc = *in;
+         *out = acc;
+
+         for( std::size_t j = 1UL; j < n; ++j ) {
+            acc = binop( acc, *( in + j ) );
+            *( out + j ) = acc;
+         }
+      }
+   } );
+}
+
+template < typename InputIt, typename OutputIt, typename BinOp >
+inline void cuda_inclusive_scan_strided( std::size_t m, std::size_t n
+                                       , InputIt in_begin, std::size_t in_spacing
+                                       , OutputIt out_begin, std::size_t out_spacing
+                                       , BinOp binop )
+{
+   using T = std::decay_t< decltype( *in_begin ) >;
+
+   if( m == 0UL ) return;
+
+   host_parallel_for( n, m, [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      std::vector<T> acc( in_begin + begin, in_begin + end );
+      std::copy( acc.begin(), acc.end(), out_begin + begin );
+
+      for( std::size_t i = 1UL; i < m; ++i )
+      {
+         const auto in  = in_begin  + i * in_spacing;
+         const auto out = out_begin + i * out_spacing;
+
+         for( std::size_t j = begin; j < end; ++j ) {
+            acc[j-begin] = binop( acc[j-begin], *( in + j ) );
+            *( out + j ) = acc[j-begin];
+         }
+      }
+   } );
+}
+
+#else // BLAZE_CUDA_HOST_BACKEND
+
+namespace cuda_scan_detail {
+
+constexpr std::size_t block_size_exponent = 8;
+constexpr std::size_t block_size          = 1 << block_size_exponent;
+constexpr std::size_t max_chunks          = 1024;
+constexpr std::size_t min_chunk_size      = 2048;
+
+/*!\brief Inclusive Hillis-Steele scan of sdata, each slot only depends on the slots before it.
+*/
+template < typename T, typename BinOp >
+__device__ inline void block_scan( std::array< T, block_size >& sdata, BinOp binop )
+{
+   unroll< block_size_exponent >( [&] ( auto I ) {
+      auto constexpr Delta = 1 << I();
+      T v;
+      bool const active = threadIdx.x >= Delta;
+      if( active )
+         v = binop( sdata[ threadIdx.x - Delta ], sdata[ threadIdx.x ] );
+      __syncthreads();
+      if( active )
+         sdata[ threadIdx.x ] = v;
+      __syncthreads();
+   } );
+}
+
+/*!\brief Scans [0, size) tile by tile with the whole block, starting from 'carry' if any.
+//
+// Returns the combination of the carry and of the whole range. Tiles are loaded before anything
+// is written, which makes in-place scans safe.
+*/
+template < bool Exclusive, typename InputIt, typename OutputIt, typename T, typename BinOp >
+__device__ inline T block_scan_range( std::array< T, block_size >& sdata, std::size_t size
+                                    , InputIt in, OutputIt out
+                                    , T carry, bool has_carry, BinOp binop )
+{
+   using std::size_t;
+
+   for( size_t base = 0; base < size; base += block_size )
+   {
+      size_t const count = size - base < block_size ? size - base : block_size;
+
+      if( threadIdx.x < count )
+         sdata[ threadIdx.x ] = *( in + base + threadIdx.x );
+      __syncthreads();
+
+      block_scan( sdata, binop );
+
+      if( threadIdx.x < count ) {
+         if( Exclusive )
+            *( out + base + threadIdx.x ) =
+               threadIdx.x == 0 ? carry : binop( carry, sdata[ threadIdx.x - 1 ] );
+         else
+            *( out + base + threadIdx.x ) =
+               has_carry ? binop( carry, sdata[ threadIdx.x ] ) : sdata[ threadIdx.x ];
+      }
+
+      carry = has_carry ? binop( carry, sdata[ count - 1 ] ) : sdata[ count - 1 ];
+      has_carry = true;
+      __syncthreads();
+   }
+
+   return carry;
+}
+
+/*!\brief First pass: sum of each chunk, written to partials[blockIdx.x].
+*/
+template < typename InputIt, typename T, typename BinOp >
+void __global__ chunk_reduce_kernel( std::size_t size, std::size_t chunk
+                                   , InputIt in_begin, T* partials, BinOp binop )
+{
+   using std::size_t;
+
+   __shared__ std::array< T, block_size > sdata;
+
+   size_t const begin = blockIdx.x * chunk;
+   size_t const end   = begin + chunk < size ? begin + chunk : size;
+
+   // Scanning the chunk into shared memory only, the last slot of each tile holds its sum
+   T carry;
+   bool has_carry = false;
+
+   for( size_t base = begin; base < end; base += block_size )
+   {
+      size_t const count = end - base < block_size ? end - base : block_size;
+
+      if( threadIdx.x < count )
+         sdata[ threadIdx.x ] = *( in_begin + base + threadIdx.x );
+      __syncthreads();
+
+      block_scan( sdata, binop );
+
+      carry = has_carry ? binop( carry, sdata[ count - 1 ] ) : sdata[ count - 1 ];
+      has_carry = true;
+      __syncthreads();
+   }
+
+   if( threadIdx.x == 0 )
+      partials[ blockIdx.x ] = carry;
+}
+
+/*!\brief Scans each chunk, starting from the scanned partials of the chunks before it.
+*/
+template < bool Exclusive, typename InputIt, typename OutputIt, typename T, typename BinOp >
+void __global__ chunk_scan_kernel( std::size_t size, std::size_t chunk
+                                 , InputIt in_begin, OutputIt out_begin, T const* offsets
+                                 , T init, bool has_init, BinOp binop )
+{
+   using std::size_t;
+
+   __shared__ std::array< T, block_size > sdata;
+
+   size_t const begin = blockIdx.x * chunk;
+   size_t const end   = begin + chunk < size ? begin + chunk : size;
+
+   T carry = init;
+
+   if( blockIdx.x > 0 )
+      carry = has_init ? binop( init, offsets[ blockIdx.x - 1 ] ) : offsets[ blockIdx.x - 1 ];
+
+   block_scan_range< Exclusive >( sdata, end - begin, in_begin + begin, out_begin + begin
+                                , carry, has_init || blockIdx.x > 0, binop );
+}
+
+/*!\brief Scans each segment with a whole block.
+*/
+template < typename InputIt, typename OutputIt, typename BinOp >
+void __global__ segmented_scan_kernel( std::size_t m, std::size_t n
+                                     , InputIt in_begin, std::size_t in_spacing
+                                     , OutputIt out_begin, std::size_t out_spacing
+                                     , BinOp binop )
+{
+   using T = std::decay_t< decltype( *in_begin ) >;
+
+   __shared__ std::array< T, block_size > sdata;
+
+   for( std::size_t i = blockIdx.x; i < m; i += gridDim.x ) {
+      block_scan_range< false >( sdata, n, in_begin + i * in_spacing, out_begin + i * out_spacing
+                               , T(), false, binop );
+   }
+}
+
+/*!\brief Scans each column with one thread, consecutive threads read consecutive elements.
+*/
+template < typename InputIt, typename OutputIt, typename BinOp >
+void __global__ strided_scan_kernel( std::size_t m, std::size_t n
+                                   , InputIt in_begin, std::size_t in_spacing
+                                   , OutputIt out_begin, std::size_t out_spacing
+                                   , BinOp binop )
+{
+   for( std::size_t j = blockIdx.x * blockDim.x + threadIdx.x; j < n; j += gridDim.x * blockDim.x )
+   {
+      auto acc = *( in_begin + j );
+      *( out_begin + j ) = acc;
+
+      for( std::size_t i = 1; i < m; ++i ) {
+         acc = binop( acc, *( in_begin + i * in_spacing + j ) );
+         *( out_begin + i * out_spacing + j ) = acc;
+      }
+   }
+}
+
+template < bool Exclusive, typename InputIt, typename OutputIt, typename T, typename BinOp >
+inline void scan( std::size_t size, InputIt in_begin, OutputIt out_begin
+                , T init, bool has_init, BinOp binop )
+{
+   using std::size_t;
+
+   if( size == 0UL ) return;
+
+   size_t const chunks = std::min( ( size + min_chunk_size - 1 ) / min_chunk_size, max_chunks );
+   size_t const chunk  = ( size + chunks - 1 ) / chunks;
+
+   if( chunks == 1UL ) {
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      chunk_scan_kernel< Exclusive > <<< 1, block_size, 0, cuda_stream() >>>
+         ( size, size, in_begin, out_begin, static_cast<T const*>( nullptr ), init, has_init, binop );
+   }
+   else {
+      T* partials = static_cast<T*>(
+         cuda_device_memory_pool().allocate( chunks * sizeof(T), cuda_stream() ) );
+
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      chunk_reduce_kernel <<< chunks, block_size, 0, cuda_stream() >>>
+         ( size, chunk, in_begin, partials, binop );
+
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      chunk_scan_kernel< false > <<< 1, block_size, 0, cuda_stream() >>>
+         ( chunks, chunks, partials, partials, static_cast<T const*>( nullptr ), T(), false, binop );
+
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      chunk_scan_kernel< Exclusive > <<< chunks, block_size, 0, cuda_stream() >>>
+         ( size, chunk, in_begin, out_begin, static_cast<T const*>( partials ), init, has_init, binop );
+
+      // Reused by the pool once the chunk scan is done
+      cuda_device_memory_pool().deallocate( partials );
+   }
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+}  // namespace cuda_scan_detail
+
+template < typename InputIt, typename OutputIt, typename BinOp >
+inline void cuda_inclusive_scan_segments( std::size_t m, std::size_t n
+                                        , InputIt in_begin, std::size_t in_spacing
+                                        , OutputIt out_begin, std::size_t out_spacing
+                                        , BinOp binop )
+{
+   if( m == 0UL || n == 0UL ) return;
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   cuda_scan_detail::segmented_scan_kernel
+      <<< std::min( m, std::size_t( 65535 ) ), cuda_scan_detail::block_size, 0, cuda_stream() >>>
+      ( m, n, in_begin, in_spacing, out_begin, out_spacing, binop );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+template < typename InputIt, typename OutputIt, typename BinOp >
+inline void cuda_inclusive_scan_strided( std::size_t m, std::size_t n
+                                       , InputIt in_begin, std::size_t in_spacing
+                                       , OutputIt out_begin, std::size_t out_spacing
+                                       , BinOp binop )
+{
+   constexpr std::size_t block_size = 256;
+
+   if( m == 0UL || n == 0UL ) return;
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   cuda_scan_detail::strided_scan_kernel
+      <<< std::min( ( n + block_size - 1 ) / block_size, std::size_t( 65535 ) ), block_size, 0, cuda_stream() >>>
+      ( m, n, in_begin, in_spacing, out_begin, out_spacing, binop );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+#endif // BLAZE_CUDA_HOST_BACKEND
+
+template < typename InputIt, typename OutputIt, typename BinOp >
+inline void cuda_inclusive_scan( InputIt in_begin, InputIt in_end, OutputIt out_begin, BinOp binop )
+{
+   using T = std::decay_t< decltype( *in_begin ) >;
+
+   if( in_end - in_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   cuda_scan_detail::scan< false >( in_end - in_begin, in_begin, out_begin, T(), false, binop );
+}
+
+template < typename InputIt, typename OutputIt, typename T, typename BinOp >
+inline void cuda_exclusive_scan( InputIt in_begin, InputIt in_end, OutputIt out_begin
+                               , T init, BinOp binop )
+{
+   if( in_end - in_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   cuda_scan_detail::scan< true >( in_end - in_begin, in_begin, out_begin, init, true, binop );
+}
+
+}  // namespace blaze
+
+#endif
@@ -0,0 +1,426 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDASegmentedReduce.h
+//  \brief Header file for the CUDA segmented and 2D reduction algorithms
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDASEGMENTEDREDUCE_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDASEGMENTEDREDUCE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/algorithms/HostParallel.h>
+#else
+#  include <array>
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/util/algorithms/CUDAReduce.h>
+#include <blaze_cuda/util/algorithms/Unroll.h>
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+#include <blaze_cuda/util/CUDAMemoryPool.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  SEGMENTED REDUCTIONS
+//
+//  The segmented reductions reduce an m x n block of elements given, as for cuda_transform_2d(),
+//  by an iterator to its first element and a spacing: element (i,j) is located at
+//  'in + i*spacing + j'. cuda_reduce_segments() reduces each of the m contiguous segments into
+//  'out[i]', cuda_reduce_strided() reduces each of the n strided columns into 'out[j]'. Every
+//  segment is seeded with its own first element, so the operation needs no identity, but it
+//  must be associative and commutative. Empty segments (n == 0, resp. m == 0) are not written.
+//
+//  cuda_reduce_2d() reduces the whole block to a single value with one launch of the kernel of
+//  cuda_reduce(); as for cuda_reduce(), \a init must be an identity of \a binop.
+//
+//=================================================================================================
+
+namespace cuda_reduce_detail {
+
+/*!\brief Loads the i-th element of an m x n block in row order, skipping the padding.
+*/
+template< typename Input >
+struct PaddedLoad
+{
+   Input it;
+   std::size_t n;
+   std::size_t spacing;
+
+   inline BLAZE_DEVICE_CALLABLE decltype(auto) operator()( std::size_t i )
+   {
+      return *( it + ( i / n ) * spacing + i % n );
+   }
+};
+
+/*!\brief Input iterator loading the elements of a range through \a F.
+//
+// This adaptor lets the segmented reductions, which reduce the values of their input iterator,
+// reduce a transform of the elements (e.g. the states of a Welford reduction) without
+// materializing it.
+*/
+template< typename InputIt, typename F >
+class TransformIterator
+{
+ public:
+   using iterator_category = std::input_iterator_tag;
+   using value_type        = std::decay_t< decltype( std::declval<F const&>()( *std::declval<InputIt>() ) ) >;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = void;
+   using reference         = value_type;
+
+   inline BLAZE_DEVICE_CALLABLE TransformIterator( InputIt it, F f ) : it_( it ), f_( f ) {}
+
+   inline BLAZE_DEVICE_CALLABLE value_type operator*() const { return f_( *it_ ); }
+
+   inline BLAZE_DEVICE_CALLABLE TransformIterator operator+( std::size_t inc ) const {
+      return TransformIterator( it_ + inc, f_ );
+   }
+
+   inline BLAZE_DEVICE_CALLABLE TransformIterator& operator++() { ++it_; return *this; }
+
+   inline BLAZE_DEVICE_CALLABLE difference_type operator-( TransformIterator const& other ) const {
+      return it_ - other.it_;
+   }
+
+   inline BLAZE_DEVICE_CALLABLE bool operator==( TransformIterator const& other ) const { return it_ == other.it_; }
+   inline BLAZE_DEVICE_CALLABLE bool operator!=( TransformIterator const& other ) const { return it_ != other.it_; }
+
+ private:
+   InputIt it_;
+   F f_;
+};
+
+}  // namespace cuda_reduce_detail
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+template < typename InputIt, typename OutputIt, typename BinOp >
+inline void cuda_reduce_segments( std::size_t m, std::size_t n
+                                , InputIt in_begin, std::size_t in_spacing
+                                , OutputIt out_begin, BinOp binop )
+{
+   if( n == 0UL ) return;
+
+   host_parallel_for( m, n, [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( std::size_t i = begin; i < end; ++i )
+      {
+         const auto in = in_begin + i * in_spacing;
+
+         auto acc = *in;
+
+         for( std::size_t j = 1UL; j < n; ++j ) {
+            acc = binop( acc, *( in + j ) );
+         }
+
+         *( out_begin + i ) = acc;
+      }
+   } );
+}
+
+template < typename InputIt, typename OutputIt, typename BinOp >
+inline void cuda_reduce_strided( std::size_t m, std::size_t n
+                               , InputIt in_begin, std::size_t in_spacing
+                               , OutputIt out_begin, BinOp binop )
+{
+   using T = std::decay_t< decltype( *in_begin ) >;
+
+   if( m == 0UL ) return;
+
+   // Column chunks, traversed row after row to keep the accesses contiguous
+   host_parallel_for( n, m, [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      std::vector<T> acc( in_begin + begin, in_begin + end );
+
+      for( std::size_t i = 1UL; i < m; ++i )
+      {
+         const auto in = in_begin + i * in_spacing;
+
+         for( std::size_t j = begin; j < end; ++j ) {
+            acc[j-begin] = binop( acc[j-begin], *( in + j ) );
+         }
+      }
+
+      std::copy( acc.begin(), acc.end(), out_begin + begin );
+   } );
+}
+
+#else // BLAZE_CUDA_HOST_BACKEND
+
+namespace cuda_reduce_detail {
+
+/*!\brief Reduces each segment with a team of 1 << TeamSizeExponent threads of a 256 threads block.
+//
+// Teams stride over the segments block by block, which keeps the loop uniform within a block
+// and makes the barriers of the tree reduction safe.
+*/
+template < std::size_t TeamSizeExponent
+         , typename InputIt, typename OutputIt, typename BinOp >
+void __global__ segmented_reduce_kernel( std::size_t m, std::size_t n
+                                       , InputIt in_begin, std::size_t in_spacing
+                                       , OutputIt out_begin, BinOp binop )
+{
+   using std::size_t;
+   using T = std::decay_t< decltype( *in_begin ) >;
+
+   constexpr size_t block_size = 256;
+   constexpr size_t team_size  = 1 << TeamSizeExponent;
+   constexpr size_t teams      = block_size / team_size;
+
+   __shared__ std::array< T, block_size > sdata;
+
+   size_t const team  = threadIdx.x / team_size;
+   size_t const lane  = threadIdx.x % team_size;
+   size_t const count = n < team_size ? n : team_size;
+
+   for( size_t base = blockIdx.x * teams; base < m; base += gridDim.x * teams )
+   {
+      size_t const i = base + team;
+
+      if( i < m && lane < count ) {
+         const auto in = in_begin + i * in_spacing;
+
+         T acc = *( in + lane );
+
+         for( size_t j = lane + team_size; j < n; j += team_size )
+            acc = binop( acc, *( in + j ) );
+
+         sdata[ threadIdx.x ] = acc;
+      }
+      __syncthreads();
+
+      // Tree reduction over the 'count' valid lanes of each team
+      unroll< TeamSizeExponent >( [&] ( auto I ) {
+         auto constexpr Delta = team_size >> ( I() + 1 );
+         if( i < m && lane < Delta && lane + Delta < count )
+            sdata[ threadIdx.x ] = binop( sdata[ threadIdx.x ], sdata[ threadIdx.x + Delta ] );
+         __syncthreads();
+      } );
+
+      if( i < m && lane == 0 )
+         *( out_begin + i ) = sdata[ threadIdx.x ];
+      __syncthreads();
+   }
+}
+
+/*!\brief Reduces the columns of a block with 32 x 8 threads blocks: each warp reads 32
+// consecutive elements of a row, and the 8 rows of threads are combined through shared memory.
+//
+// The rows are split into gridDim.y parts, the result of part p of column j is written to
+// 'out + p*out_spacing + j'.
+*/
+template < typename InputIt, typename OutputIt, typename BinOp >
+void __global__ strided_reduce_kernel( std::size_t m, std::size_t n
+                                     , InputIt in_begin, std::size_t in_spacing
+                                     , OutputIt out_begin, std::size_t out_spacing
+                                     , BinOp binop )
+{
+   using std::size_t;
+   using T = std::decay_t< decltype( *in_begin ) >;
+
+   constexpr size_t warp_size = 32;
+   constexpr size_t rows      = 8;
+
+   __shared__ std::array< T, warp_size * rows > sdata;
+
+   size_t const row_begin = ( blockIdx.y * m ) / gridDim.y;
+   size_t const row_end   = ( ( blockIdx.y + 1 ) * m ) / gridDim.y;
+   size_t const count     = row_end - row_begin < rows ? row_end - row_begin : rows;
+   size_t const tid       = threadIdx.y * warp_size + threadIdx.x;
+
+   for( size_t base = blockIdx.x * warp_size; base < n; base += gridDim.x * warp_size )
+   {
+      size_t const j = base + threadIdx.x;
+
+      if( j < n && threadIdx.y < count ) {
+         T acc = *( in_begin + ( row_begin + threadIdx.y ) * in_spacing + j );
+
+         for( size_t i = row_begin + threadIdx.y + rows; i < row_end; i += rows )
+            acc = binop( acc, *( in_begin + i * in_spacing + j ) );
+
+         sdata[ tid ] = acc;
+      }
+      __syncthreads();
+
+      unroll< 3 >( [&] ( auto I ) {
+         auto constexpr Delta = rows >> ( I() + 1 );
+         if( j < n && threadIdx.y < Delta && threadIdx.y + Delta < count )
+            sdata[ tid ] = binop( sdata[ tid ], sdata[ tid + Delta * warp_size ] );
+         __syncthreads();
+      } );
+
+      if( j < n && threadIdx.y == 0 )
+         *( out_begin + blockIdx.y * out_spacing + j ) = sdata[ tid ];
+      __syncthreads();
+   }
+}
+
+}  // namespace cuda_reduce_detail
+
+template < typename InputIt, typename OutputIt, typename BinOp >
+inline void cuda_reduce_segments( std::size_t m, std::size_t n
+                                , InputIt in_begin, std::size_t in_spacing
+                                , OutputIt out_begin, BinOp binop )
+{
+   using std::size_t;
+
+   constexpr size_t max_grid = 65535;
+
+   if( m == 0UL || n == 0UL ) return;
+
+   // One warp per segment, or a whole block for long segments
+   if( n > 1024UL ) {
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      cuda_reduce_detail::segmented_reduce_kernel< 8 >
+         <<< std::min( m, max_grid ), 256, 0, cuda_stream() >>>
+         ( m, n, in_begin, in_spacing, out_begin, binop );
+   }
+   else {
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      cuda_reduce_detail::segmented_reduce_kernel< 5 >
+         <<< std::min( ( m + 7 ) / 8, max_grid ), 256, 0, cuda_stream() >>>
+         ( m, n, in_begin, in_spacing, out_begin, binop );
+   }
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+template < typename InputIt, typename OutputIt, typename BinOp >
+inline void cuda_reduce_strided( std::size_t m, std::size_t n
+                               , InputIt in_begin, std::size_t in_spacing
+                               , OutputIt out_begin, BinOp binop )
+{
+   using std::size_t;
+   using T = std::decay_t< decltype( *in_begin ) >;
+
+   constexpr size_t max_grid   = 65535;
+   constexpr size_t min_blocks = 512;
+   constexpr size_t min_rows   = 256;
+
+   if( m == 0UL || n == 0UL ) return;
+
+   dim3 const block( 32, 8 );
+   size_t const col_blocks = std::min( ( n + 31 ) / 32, max_grid );
+
+   // Narrow and tall blocks are split into parts of at least min_rows rows, reduced in a
+   // second pass
+   size_t const parts = std::min( { std::max( min_blocks / col_blocks, size_t( 1 ) )
+                                  , std::max( m / min_rows, size_t( 1 ) )
+                                  , max_grid } );
+
+   if( parts == 1UL ) {
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      cuda_reduce_detail::strided_reduce_kernel
+         <<< dim3( col_blocks, 1 ), block, 0, cuda_stream() >>>
+         ( m, n, in_begin, in_spacing, out_begin, 0UL, binop );
+   }
+   else {
+      T* partials = static_cast<T*>(
+         cuda_device_memory_pool().allocate( parts * n * sizeof(T), cuda_stream() ) );
+
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      cuda_reduce_detail::strided_reduce_kernel
+         <<< dim3( col_blocks, parts ), block, 0, cuda_stream() >>>
+         ( m, n, in_begin, in_spacing, partials, n, binop );
+
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      cuda_reduce_detail::strided_reduce_kernel
+         <<< dim3( col_blocks, 1 ), block, 0, cuda_stream() >>>
+         ( parts, n, static_cast<const T*>( partials ), n, out_begin, 0UL, binop );
+
+      // Reused by the pool once the second pass is done
+      cuda_device_memory_pool().deallocate( partials );
+   }
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+#endif // BLAZE_CUDA_HOST_BACKEND
+
+/*!\brief Reduces the m x n block at \a in_begin into the device scalar \a result.
+//
+// The whole block is reduced by a single kernel launch, padded blocks included.
+*/
+template < std::size_t Unroll = cuda_tuned, std::size_t BlockSizeExponent = cuda_tuned
+         , typename InputIt
+         , typename T
+         , typename BinOp >
+inline void cuda_reduce_2d_into( std::size_t m, std::size_t n
+                               , InputIt in_begin, std::size_t in_spacing
+                               , T init, BinOp binop
+                               , T* result, CUDAReduceWorkspace<T>& workspace )
+{
+   if( in_spacing == n || m < 2UL ) {
+      cuda_reduce_detail::reduce_into< Unroll, BlockSizeExponent >( m * n
+         , cuda_reduce_detail::IteratorLoad<InputIt>{ in_begin }, init, binop, result, workspace );
+   }
+   else {
+      cuda_reduce_detail::reduce_into< Unroll, BlockSizeExponent >( m * n
+         , cuda_reduce_detail::PaddedLoad<InputIt>{ in_begin, n, in_spacing }
+         , init, binop, result, workspace );
+   }
+}
+
+/*!\brief Reduces the m x n block at \a in_begin.
+*/
+template < std::size_t Unroll = cuda_tuned, std::size_t BlockSizeExponent = cuda_tuned
+         , typename InputIt
+         , typename T
+         , typename BinOp >
+inline T cuda_reduce_2d( std::size_t m, std::size_t n
+                       , InputIt in_begin, std::size_t in_spacing
+                       , T init, BinOp binop )
+{
+   CUDAReduceWorkspace<T>& workspace( cuda_reduce_workspace<T>() );
+
+   cuda_reduce_2d_into< Unroll, BlockSizeExponent >
+      ( m, n, in_begin, in_spacing, init, binop, workspace.result(), workspace );
+
+   return workspace.value();
+}
+
+}  // namespace blaze
+
+#endif
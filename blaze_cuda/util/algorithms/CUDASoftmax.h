@@ -0,0 +1,370 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDASoftmax.h
+//  \brief Header file for the online softmax algorithms
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDASOFTMAX_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDASOFTMAX_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/algorithms/HostParallel.h>
+#else
+#  include <array>
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/util/algorithms/CUDAReduce.h>
+#include <blaze_cuda/util/algorithms/CUDASegmentedReduce.h>
+#include <blaze_cuda/util/algorithms/CUDATransform.h>
+#include <blaze_cuda/util/algorithms/CUDATransform2D.h>
+#include <blaze_cuda/util/algorithms/CUDATransformReduce.h>
+#include <blaze_cuda/util/algorithms/Unroll.h>
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+#include <blaze_cuda/util/CUDAMemoryPool.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  ONLINE SOFTMAX
+//
+//  The softmax y_i = exp(x_i - max) / sum_j exp(x_j - max) is computed from the state (max, sum)
+//  of the online softmax: every element is loaded as (x, 1), and two states are merged by
+//  rescaling the sum of the smaller maximum,
+//
+//     max = max(max_a, max_b),  sum = sum_a * exp(max_a - max) + sum_b * exp(max_b - max),
+//
+//  so the maximum and the sum are accumulated in a single pass over the data, and the
+//  exponentials never overflow. The outputs are written by a second pass, in the same kernel
+//  when a team of threads owns a whole segment.
+//
+//  As for the segmented reductions, the blocks are given by an iterator to their first element
+//  and a spacing. The output may alias the input.
+//
+//=================================================================================================
+
+/*!\brief State of an online softmax: the maximum and the sum of exp(x - max).
+*/
+template< typename T >  // Type of the accumulated values
+struct CUDASoftmaxState
+{
+   T max;  //!< Maximum of the reduced elements.
+   T sum;  //!< Sum of the exponentials of the reduced elements, relative to the maximum.
+};
+
+/*!\brief Loads an element as the state of a single element softmax.
+*/
+template< typename T >  // Type of the accumulated values
+struct SoftmaxLoad
+{
+   template< typename U >
+   inline BLAZE_DEVICE_CALLABLE CUDASoftmaxState<T> operator()( U const& x ) const
+   {
+      return CUDASoftmaxState<T>{ T( x ), T( 1 ) };
+   }
+};
+
+/*!\brief Merges two online softmax states.
+*/
+struct SoftmaxMerge
+{
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE CUDASoftmaxState<T>
+      operator()( CUDASoftmaxState<T> const& a, CUDASoftmaxState<T> const& b ) const
+   {
+      using std::exp;
+
+      if( a.max < b.max ) return CUDASoftmaxState<T>{ b.max, b.sum + a.sum * exp( a.max - b.max ) };
+      if( b.max < a.max ) return CUDASoftmaxState<T>{ a.max, a.sum + b.sum * exp( b.max - a.max ) };
+      if( a.max == b.max ) return CUDASoftmaxState<T>{ a.max, a.sum + b.sum };
+
+      // Unordered maxima: the NaN is propagated
+      return CUDASoftmaxState<T>{ a.max + b.max, a.sum + b.sum };
+   }
+};
+
+namespace cuda_softmax_detail {
+
+/*!\brief Normalizes an element with the softmax state it belongs to.
+*/
+struct Normalize
+{
+   template< typename U, typename T >
+   inline BLAZE_DEVICE_CALLABLE T operator()( U const& x, CUDASoftmaxState<T> const& s ) const
+   {
+      using std::exp;
+      return exp( T( x ) - s.max ) / s.sum;
+   }
+};
+
+/*!\brief Normalizes an element with the softmax state stored at \a state.
+*/
+template< typename T >
+struct NormalizeBy
+{
+   CUDASoftmaxState<T> const* state;
+
+   template< typename U >
+   inline BLAZE_DEVICE_CALLABLE T operator()( U const& x ) const { return Normalize()( x, *state ); }
+};
+
+template< typename T >
+inline CUDASoftmaxState<T> identity()
+{
+   return CUDASoftmaxState<T>{ -std::numeric_limits<T>::infinity(), T( 0 ) };
+}
+
+}  // namespace cuda_softmax_detail
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+template < typename T, typename InputIt, typename OutputIt >
+inline void cuda_softmax_segments( std::size_t m, std::size_t n
+                                 , InputIt in_begin, std::size_t in_spacing
+                                 , OutputIt out_begin, std::size_t out_spacing )
+{
+   BLAZE_CUDA_RANGE( "cuda_softmax" );
+
+   if( n == 0UL ) return;
+
+   host_parallel_for( m, n, [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( std::size_t i = begin; i < end; ++i )
+      {
+         const auto in  = in_begin  + i * in_spacing;
+         const auto out = out_begin + i * out_spacing;
+
+         CUDASoftmaxState<T> s = SoftmaxLoad<T>()( *in );
+
+         for( std::size_t j = 1UL; j < n; ++j ) {
+            s = SoftmaxMerge()( s, SoftmaxLoad<T>()( *( in + j ) ) );
+         }
+
+         for( std::size_t j = 0UL; j < n; ++j ) {
+            *( out + j ) = cuda_softmax_detail::Normalize()( *( in + j ), s );
+         }
+      }
+   } );
+}
+
+#else // BLAZE_CUDA_HOST_BACKEND
+
+namespace cuda_softmax_detail {
+
+/*!\brief Softmax of each segment with a team of 1 << TeamSizeExponent threads of a 256 threads
+// block.
+//
+// The teams reduce their segment as segmented_reduce_kernel() does, then read the state of the
+// segment from shared memory and write the normalized elements, which were just loaded and are
+// likely still cached.
+*/
+template < std::size_t TeamSizeExponent
+         , typename T, typename InputIt, typename OutputIt >
+void __global__ softmax_segments_kernel( std::size_t m, std::size_t n
+                                       , InputIt in_begin, std::size_t in_spacing
+                                       , OutputIt out_begin, std::size_t out_spacing )
+{
+   using std::size_t;
+   using State = CUDASoftmaxState<T>;
+
+   constexpr size_t block_size = 256;
+   constexpr size_t team_size  = 1 << TeamSizeExponent;
+   constexpr size_t teams      = block_size / team_size;
+
+   __shared__ std::array< State, block_size > sdata;
+
+   size_t const team  = threadIdx.x / team_size;
+   size_t const lane  = threadIdx.x % team_size;
+   size_t const count = n < team_size ? n : team_size;
+
+   for( size_t base = blockIdx.x * teams; base < m; base += gridDim.x * teams )
+   {
+      size_t const i = base + team;
+
+      if( i < m && lane < count ) {
+         const auto in = in_begin + i * in_spacing;
+
+         State acc = SoftmaxLoad<T>()( *( in + lane ) );
+
+         for( size_t j = lane + team_size; j < n; j += team_size )
+            acc = SoftmaxMerge()( acc, SoftmaxLoad<T>()( *( in + j ) ) );
+
+         sdata[ threadIdx.x ] = acc;
+      }
+      __syncthreads();
+
+      unroll< TeamSizeExponent >( [&] ( auto I ) {
+         auto constexpr Delta = team_size >> ( I() + 1 );
+         if( i < m && lane < Delta && lane + Delta < count )
+            sdata[ threadIdx.x ] = SoftmaxMerge()( sdata[ threadIdx.x ], sdata[ threadIdx.x + Delta ] );
+         __syncthreads();
+      } );
+
+      if( i < m ) {
+         const auto in  = in_begin  + i * in_spacing;
+         const auto out = out_begin + i * out_spacing;
+         State const s  = sdata[ team * team_size ];
+
+         for( size_t j = lane; j < n; j += team_size )
+            *( out + j ) = Normalize()( *( in + j ), s );
+      }
+      __syncthreads();
+   }
+}
+
+}  // namespace cuda_softmax_detail
+
+template < typename T, typename InputIt, typename OutputIt >
+inline void cuda_softmax_segments( std::size_t m, std::size_t n
+                                 , InputIt in_begin, std::size_t in_spacing
+                                 , OutputIt out_begin, std::size_t out_spacing )
+{
+   using std::size_t;
+
+   constexpr size_t max_grid = 65535;
+
+   BLAZE_CUDA_RANGE( "cuda_softmax" );
+
+   if( m == 0UL || n == 0UL ) return;
+
+   // One warp per segment, or a whole block for long segments
+   if( n > 1024UL ) {
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      cuda_softmax_detail::softmax_segments_kernel< 8, T >
+         <<< std::min( m, max_grid ), 256, 0, cuda_stream() >>>
+         ( m, n, in_begin, in_spacing, out_begin, out_spacing );
+   }
+   else {
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      cuda_softmax_detail::softmax_segments_kernel< 5, T >
+         <<< std::min( ( m + 7 ) / 8, max_grid ), 256, 0, cuda_stream() >>>
+         ( m, n, in_begin, in_spacing, out_begin, out_spacing );
+   }
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+#endif // BLAZE_CUDA_HOST_BACKEND
+
+/*!\brief Softmax of each of the n strided columns of the m x n block at \a in_begin.
+//
+// The states of the columns are reduced with the kernels of cuda_reduce_strided(), then the
+// block is normalized by a 2D transform.
+*/
+template < typename T, typename InputIt, typename OutputIt >
+inline void cuda_softmax_strided( std::size_t m, std::size_t n
+                                , InputIt in_begin, std::size_t in_spacing
+                                , OutputIt out_begin, std::size_t out_spacing )
+{
+   using State = CUDASoftmaxState<T>;
+   using Load  = cuda_reduce_detail::TransformIterator< InputIt, SoftmaxLoad<T> >;
+
+   BLAZE_CUDA_RANGE( "cuda_softmax" );
+
+   if( m == 0UL || n == 0UL ) return;
+
+   State* states = static_cast<State*>(
+      cuda_device_memory_pool().allocate( n * sizeof(State), cuda_stream() ) );
+
+   cuda_reduce_strided( m, n, Load( in_begin, SoftmaxLoad<T>() ), in_spacing, states, SoftmaxMerge() );
+
+   // A zero spacing repeats the row of states for every row of the block
+   cuda_transform_2d( m, n, in_begin, in_spacing, static_cast<State const*>( states ), 0UL
+                    , out_begin, out_spacing, cuda_softmax_detail::Normalize() );
+
+   // Reused by the pool once the normalization is done
+   cuda_device_memory_pool().deallocate( states );
+}
+
+/*!\brief Softmax of the whole m x n block at \a in_begin.
+//
+// Blocks small enough for a single thread block are handled by one launch of the segment
+// kernel. Larger ones are reduced by the single pass kernel of cuda_reduce() into a device
+// state, which the normalizing transform reads on the device: two launches, no host
+// synchronization.
+*/
+template < typename T, typename InputIt, typename OutputIt >
+inline void cuda_softmax_2d( std::size_t m, std::size_t n
+                           , InputIt in_begin, std::size_t in_spacing
+                           , OutputIt out_begin, std::size_t out_spacing )
+{
+   using State = CUDASoftmaxState<T>;
+   using Load  = cuda_reduce_detail::TransformIterator< InputIt, SoftmaxLoad<T> >;
+
+   constexpr std::size_t single_block = 8192UL;
+
+   BLAZE_CUDA_RANGE( "cuda_softmax" );
+
+   if( m == 0UL || n == 0UL ) return;
+
+   const bool contiguous( m == 1UL || ( in_spacing == n && out_spacing == n ) );
+
+   if( contiguous && m * n <= single_block ) {
+      cuda_softmax_segments<T>( 1UL, m * n, in_begin, m * n, out_begin, m * n );
+      return;
+   }
+
+   CUDAReduceWorkspace<State>& workspace( cuda_reduce_workspace<State>() );
+
+   cuda_reduce_2d_into( m, n, Load( in_begin, SoftmaxLoad<T>() ), in_spacing
+                      , cuda_softmax_detail::identity<T>(), SoftmaxMerge()
+                      , workspace.result(), workspace );
+
+   cuda_transform_2d( m, n, in_begin, in_spacing, out_begin, out_spacing
+                    , cuda_softmax_detail::NormalizeBy<T>{ workspace.result() } );
+}
+
+/*!\brief Softmax of the range [\a in_begin, \a in_end) into \a out_begin.
+*/
+template < typename T, typename InputIt, typename OutputIt >
+inline void cuda_softmax( InputIt in_begin, InputIt in_end, OutputIt out_begin )
+{
+   if( in_end - in_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   const std::size_t n( in_end - in_begin );
+
+   cuda_softmax_2d<T>( 1UL, n, in_begin, n, out_begin, n );
+}
+
+}  // namespace blaze
+
+#endif
@@ -0,0 +1,730 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDASort.h
+//  \brief Header file for the CUDA radix sort, argsort and top-k algorithms
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDASORT_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDASORT_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if !defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze/math/expressions/DenseVector.h>
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/util/algorithms/CUDACompact.h>
+#include <blaze_cuda/util/algorithms/CUDAScan.h>
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+#include <blaze_cuda/util/CUDAMemoryPool.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  SORTING
+//
+//  cuda_sort(), cuda_sort_by_key() and cuda_argsort() are stable LSD radix sorts of arithmetic
+//  keys, 4 bits per pass: each pass computes a digit histogram per chunk, scans the histograms
+//  with cuda_exclusive_scan() and scatters the keys (and values) in order, the rank of each key
+//  within a tile being computed with warp ballots. Floating point keys are ordered by value,
+//  NaNs excepted. -0.0 and +0.0 compare equal and keep their input order, as on the host.
+//
+//  cuda_top_k() selects the k largest keys without sorting the range: the k-th largest key is
+//  found by a radix select, one histogram per digit, then the keys larger than it (and the first
+//  ones equal to it) are compacted and only these k keys are sorted. Ties are ordered by index.
+//
+//  The host backend uses std::stable_sort() and std::partial_sort() with the same ordering.
+//
+//=================================================================================================
+
+namespace cuda_sort_detail {
+
+/*!\brief Unsigned integer of the given size.
+*/
+template< std::size_t Size > struct UnsignedOfSize;
+template<> struct UnsignedOfSize<1> { using Type = std::uint8_t;  };
+template<> struct UnsignedOfSize<2> { using Type = std::uint16_t; };
+template<> struct UnsignedOfSize<4> { using Type = std::uint32_t; };
+template<> struct UnsignedOfSize<8> { using Type = std::uint64_t; };
+
+/*!\brief Order preserving mapping of an arithmetic key to an unsigned integer.
+//
+// Signed integers have their sign bit flipped; negative floating point numbers have all their
+// bits flipped and the others their sign bit, which orders them by value. -0.0 is mapped to the
+// key of +0.0 first, so that the two zeros are equal keys.
+*/
+template< typename K >
+struct RadixKey
+{
+   static_assert( std::is_arithmetic<K>::value, "Radix sorted keys must be arithmetic" );
+
+   using Bits = typename UnsignedOfSize< sizeof(K) >::Type;
+
+   static constexpr Bits sign = Bits( Bits(1) << ( sizeof(Bits) * 8 - 1 ) );
+
+   static inline BLAZE_DEVICE_CALLABLE Bits encode( K const& k, bool descending )
+   {
+      Bits b;
+      memcpy( &b, &k, sizeof(K) );
+
+      if( std::is_floating_point<K>::value ) {
+         if( b == sign ) b = Bits( 0 );
+         b ^= ( b & sign ) ? Bits( ~Bits(0) ) : sign;
+      }
+      else if( std::is_signed<K>::value ) {
+         b ^= sign;
+      }
+
+      return descending ? Bits( ~b ) : b;
+   }
+
+   static inline BLAZE_DEVICE_CALLABLE bool isNegativeZero( K const& k )
+   {
+      Bits b;
+      memcpy( &b, &k, sizeof(K) );
+      return std::is_floating_point<K>::value && b == sign;
+   }
+
+   static inline BLAZE_DEVICE_CALLABLE K decode( Bits b, bool descending )
+   {
+      if( descending )
+         b = Bits( ~b );
+
+      if( std::is_floating_point<K>::value )
+         b ^= ( b & sign ) ? sign : Bits( ~Bits(0) );
+      else if( std::is_signed<K>::value )
+         b ^= sign;
+
+      K k;
+      memcpy( &k, &b, sizeof(K) );
+      return k;
+   }
+};
+
+/*!\brief Strict ordering of two keys by value, ties ordered by index.
+*/
+template< typename K >
+struct TopKOrder
+{
+   const K* keys;
+
+   inline bool operator()( std::size_t a, std::size_t b ) const
+   {
+      return keys[a] > keys[b] || ( !( keys[b] > keys[a] ) && a < b );
+   }
+};
+
+}  // namespace cuda_sort_detail
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+template < typename KeyIt, typename ValueIt >
+inline void cuda_sort_by_key( KeyIt keys_begin, KeyIt keys_end, ValueIt values_begin
+                            , bool descending = false )
+{
+   using K = std::decay_t< decltype( *keys_begin ) >;
+   using V = std::decay_t< decltype( *values_begin ) >;
+
+   if( keys_end - keys_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   const std::size_t size( keys_end - keys_begin );
+
+   std::vector<K> keys( keys_begin, keys_end );
+   std::vector<V> values( values_begin, values_begin + size );
+   std::vector<std::size_t> perm( size );
+   std::iota( perm.begin(), perm.end(), std::size_t( 0 ) );
+
+   std::stable_sort( perm.begin(), perm.end(), [&]( std::size_t a, std::size_t b ) {
+      return descending ? keys[b] < keys[a] : keys[a] < keys[b];
+   } );
+
+   for( std::size_t i = 0UL; i < size; ++i ) {
+      *( keys_begin   + i ) = keys  [ perm[i] ];
+      *( values_begin + i ) = values[ perm[i] ];
+   }
+}
+
+template < typename KeyIt >
+inline void cuda_sort( KeyIt keys_begin, KeyIt keys_end, bool descending = false )
+{
+   using K = std::decay_t< decltype( *keys_begin ) >;
+
+   if( descending )
+      std::stable_sort( keys_begin, keys_end, []( K const& a, K const& b ) { return b < a; } );
+   else
+      std::stable_sort( keys_begin, keys_end );
+}
+
+template < typename KeyIt, typename IndexIt >
+inline void cuda_argsort( KeyIt keys_begin, KeyIt keys_end, IndexIt indices_begin
+                        , bool descending = false )
+{
+   using K = std::decay_t< decltype( *keys_begin ) >;
+
+   if( keys_end - keys_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   const std::size_t size( keys_end - keys_begin );
+
+   std::vector<K> keys( keys_begin, keys_end );
+   std::vector<std::size_t> perm( size );
+   std::iota( perm.begin(), perm.end(), std::size_t( 0 ) );
+
+   std::stable_sort( perm.begin(), perm.end(), [&]( std::size_t a, std::size_t b ) {
+      return descending ? keys[b] < keys[a] : keys[a] < keys[b];
+   } );
+
+   std::copy( perm.begin(), perm.end(), indices_begin );
+}
+
+template < typename KeyIt, typename OutputIt, typename IndexIt >
+inline std::size_t cuda_top_k( KeyIt keys_begin, KeyIt keys_end, std::size_t k
+                             , OutputIt values_begin, IndexIt indices_begin )
+{
+   using K = std::decay_t< decltype( *keys_begin ) >;
+
+   if( keys_end - keys_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   const std::size_t size( keys_end - keys_begin );
+   k = std::min( k, size );
+
+   std::vector<K> keys( keys_begin, keys_end );
+   std::vector<std::size_t> perm( size );
+   std::iota( perm.begin(), perm.end(), std::size_t( 0 ) );
+
+   std::partial_sort( perm.begin(), perm.begin() + k, perm.end()
+                    , cuda_sort_detail::TopKOrder<K>{ keys.data() } );
+
+   for( std::size_t i = 0UL; i < k; ++i ) {
+      *( values_begin  + i ) = keys[ perm[i] ];
+      *( indices_begin + i ) = perm[i];
+   }
+
+   return k;
+}
+
+#else // BLAZE_CUDA_HOST_BACKEND
+
+namespace cuda_sort_detail {
+
+constexpr std::size_t radix_bits = 4;
+constexpr std::size_t radix      = 1 << radix_bits;
+constexpr std::size_t block_size = 256;
+constexpr std::size_t warps      = block_size / 32;
+
+/*!\brief Calls f(i) for each i in [0, size).
+*/
+template< typename F >
+void __global__ for_each_index_kernel( std::size_t size, F f )
+{
+   for( std::size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < size; i += gridDim.x * blockDim.x )
+      f( i );
+}
+
+template< typename F >
+inline void for_each_index( std::size_t size, F f )
+{
+   if( size == 0UL ) return;
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   for_each_index_kernel <<< std::min( ( size + block_size - 1 ) / block_size, std::size_t( 65535 ) )
+                           , block_size, 0, cuda_stream() >>>( size, f );
+}
+
+template< typename K, typename KeyIt, typename Bits >
+struct Encode
+{
+   KeyIt in; Bits* out; bool descending;
+   inline BLAZE_DEVICE_CALLABLE void operator()( std::size_t i ) { out[i] = RadixKey<K>::encode( *( in + i ), descending ); }
+};
+
+template< typename K, typename KeyIt, typename Bits >
+struct Decode
+{
+   Bits const* in; KeyIt out; bool descending;
+   inline BLAZE_DEVICE_CALLABLE void operator()( std::size_t i ) { *( out + i ) = RadixKey<K>::decode( in[i], descending ); }
+};
+
+template< typename InputIt, typename OutputIt >
+struct Copy
+{
+   InputIt in; OutputIt out;
+   inline BLAZE_DEVICE_CALLABLE void operator()( std::size_t i ) { *( out + i ) = *( in + i ); }
+};
+
+template< typename InputIt, typename OutputIt >
+struct GatherKeys
+{
+   InputIt in; std::size_t const* indices; OutputIt out;
+   inline BLAZE_DEVICE_CALLABLE void operator()( std::size_t i ) { *( out + i ) = *( in + indices[i] ); }
+};
+
+struct Iota
+{
+   std::size_t* out;
+   inline BLAZE_DEVICE_CALLABLE void operator()( std::size_t i ) { out[i] = i; }
+};
+
+template< typename Bits >
+struct Gather
+{
+   Bits const* in; std::size_t const* indices; Bits* out;
+   inline BLAZE_DEVICE_CALLABLE void operator()( std::size_t i ) { out[i] = in[ indices[i] ]; }
+};
+
+/*!\brief Number of chunks of a radix sort pass, each chunk is processed by one block.
+*/
+inline std::size_t chunk_count( std::size_t size )
+{
+   return std::min( ( size + cuda_scan_detail::min_chunk_size - 1 ) / cuda_scan_detail::min_chunk_size
+                  , cuda_scan_detail::max_chunks );
+}
+
+/*!\brief Digit histogram of each chunk, stored digit-major: hist[digit*chunks + chunk].
+*/
+template< typename Bits >
+void __global__ histogram_kernel( std::size_t size, std::size_t chunk, Bits const* keys
+                                , unsigned int shift, std::size_t* hist )
+{
+   __shared__ unsigned int counts[ radix ];
+
+   if( threadIdx.x < radix )
+      counts[ threadIdx.x ] = 0;
+   __syncthreads();
+
+   std::size_t const begin = blockIdx.x * chunk;
+   std::size_t const end   = begin + chunk < size ? begin + chunk : size;
+
+   for( std::size_t i = begin + threadIdx.x; i < end; i += block_size )
+      atomicAdd( &counts[ ( keys[i] >> shift ) & ( radix - 1 ) ], 1U );
+   __syncthreads();
+
+   if( threadIdx.x < radix )
+      hist[ threadIdx.x * gridDim.x + blockIdx.x ] = counts[ threadIdx.x ];
+}
+
+/*!\brief Stable scatter of each chunk to the offsets of its digits.
+//
+// The rank of a key among the keys of its warp with the same digit is computed with one ballot
+// per digit; the per-warp counts are then scanned to order the warps of the tile.
+*/
+template< typename Bits, typename V >
+void __global__ scatter_kernel( std::size_t size, std::size_t chunk, unsigned int shift
+                              , Bits const* keys_in, V const* values_in
+                              , Bits* keys_out, V* values_out, std::size_t const* offsets )
+{
+   __shared__ std::size_t  bin_offset [ radix ];
+   __shared__ unsigned int tile_counts[ radix ];
+   __shared__ unsigned int warp_counts[ warps ][ radix ];
+
+   std::size_t const begin = blockIdx.x * chunk;
+   std::size_t const end   = begin + chunk < size ? begin + chunk : size;
+
+   unsigned int const lane = threadIdx.x % 32;
+   unsigned int const warp = threadIdx.x / 32;
+   unsigned int const lanemask_lt = ( 1U << lane ) - 1U;
+
+   if( threadIdx.x < radix )
+      bin_offset[ threadIdx.x ] = offsets[ threadIdx.x * gridDim.x + blockIdx.x ];
+   __syncthreads();
+
+   for( std::size_t base = begin; base < end; base += block_size )
+   {
+      std::size_t const i = base + threadIdx.x;
+      bool const valid = i < end;
+
+      Bits const key = valid ? keys_in[i] : Bits( 0 );
+      unsigned int const digit = valid ? unsigned( ( key >> shift ) & ( radix - 1 ) ) : unsigned( radix );
+      unsigned int rank = 0;
+
+      for( unsigned int b = 0; b < radix; ++b ) {
+         unsigned int const ballot = __ballot_sync( 0xFFFFFFFFU, digit == b );
+         if( digit == b )
+            rank = __popc( ballot & lanemask_lt );
+         if( lane == 0 )
+            warp_counts[ warp ][ b ] = __popc( ballot );
+      }
+      __syncthreads();
+
+      if( threadIdx.x < radix ) {
+         unsigned int run = 0;
+         for( std::size_t w = 0; w < warps; ++w ) {
+            unsigned int const c = warp_counts[ w ][ threadIdx.x ];
+            warp_counts[ w ][ threadIdx.x ] = run;
+            run += c;
+         }
+         tile_counts[ threadIdx.x ] = run;
+      }
+      __syncthreads();
+
+      if( valid ) {
+         std::size_t const pos = bin_offset[ digit ] + warp_counts[ warp ][ digit ] + rank;
+         keys_out[ pos ] = key;
+         if( values_out != nullptr )
+            values_out[ pos ] = values_in[ i ];
+      }
+      __syncthreads();
+
+      if( threadIdx.x < radix )
+         bin_offset[ threadIdx.x ] += tile_counts[ threadIdx.x ];
+      __syncthreads();
+   }
+}
+
+/*!\brief Digit histogram of the keys whose higher digits match \a prefix.
+*/
+template< typename Bits >
+void __global__ select_histogram_kernel( std::size_t size, Bits const* keys, Bits prefix, Bits mask
+                                       , unsigned int shift, unsigned long long* counts )
+{
+   __shared__ unsigned int block_counts[ radix ];
+
+   if( threadIdx.x < radix )
+      block_counts[ threadIdx.x ] = 0;
+   __syncthreads();
+
+   for( std::size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < size; i += gridDim.x * blockDim.x )
+      if( ( keys[i] & mask ) == prefix )
+         atomicAdd( &block_counts[ ( keys[i] >> shift ) & ( radix - 1 ) ], 1U );
+   __syncthreads();
+
+   if( threadIdx.x < radix && block_counts[ threadIdx.x ] > 0 )
+      atomicAdd( &counts[ threadIdx.x ], (unsigned long long)( block_counts[ threadIdx.x ] ) );
+}
+
+template< typename Bits >
+struct Less
+{
+   Bits threshold;
+   inline BLAZE_DEVICE_CALLABLE bool operator()( Bits b ) const { return b < threshold; }
+};
+
+template< typename Bits >
+struct Equal
+{
+   Bits threshold;
+   inline BLAZE_DEVICE_CALLABLE bool operator()( Bits b ) const { return b == threshold; }
+};
+
+/*!\brief Device buffer of \a size elements from cuda_device_memory_pool().
+*/
+template< typename T >
+class Buffer
+{
+ public:
+   explicit inline Buffer( std::size_t size )
+      : ptr_( static_cast<T*>( cuda_device_memory_pool().allocate( std::max( size, std::size_t( 1 ) ) * sizeof(T)
+                                                                 , cuda_stream() ) ) ) {}
+   Buffer( const Buffer& ) = delete;
+   Buffer& operator=( const Buffer& ) = delete;
+   // The pool orders the reuse of the block after the pending kernels
+   inline ~Buffer() { cuda_device_memory_pool().deallocate( ptr_ ); }
+   inline T* get() const noexcept { return ptr_; }
+
+ private:
+   T* ptr_;
+};
+
+template< typename K >
+struct IsZero
+{
+   inline BLAZE_DEVICE_CALLABLE bool operator()( K const& k ) const { return k == K( 0 ); }
+};
+
+template< typename K >
+struct IsNegativeZero
+{
+   inline BLAZE_DEVICE_CALLABLE bool operator()( K const& k ) const { return RadixKey<K>::isNegativeZero( k ); }
+};
+
+/*!\brief Restores the negative zeros of sorted floating point keys.
+//
+// Both zeros share a radix key, so the run of zeros of the sorted keys holds the zeros of the
+// input in input order, but decodes to +0.0. If the input has negative zeros, its zeros are
+// compacted before sorting and written over the run by restore(). Other inputs cost one count.
+*/
+template< typename K >
+class SignedZeros
+{
+ public:
+   template< typename KeyIt, typename Bits >
+   inline SignedZeros( KeyIt begin, std::size_t size, Bits const* encoded, bool descending )
+      : count_ ( hasNegativeZeros( begin, size ) ? zeros_.count( begin, begin + size, IsZero<K>{} ) : 0UL )
+      , offset_( count_ == 0UL ? 0UL : cuda_count_if( encoded, encoded + size
+                                                    , Less<Bits>{ RadixKey<K>::encode( K( 0 ), descending ) } ) )
+      , buffer_( count_ )
+   {
+      if( count_ != 0UL )
+         zeros_.copy( begin, buffer_.get(), IsZero<K>{} );
+   }
+
+   template< typename KeyIt >
+   inline void restore( KeyIt out ) const
+   {
+      if( count_ != 0UL )
+         for_each_index( count_, Copy<K const*,KeyIt>{ buffer_.get(), out + offset_ } );
+   }
+
+ private:
+   template< typename KeyIt >
+   static inline bool hasNegativeZeros( KeyIt begin, std::size_t size )
+   {
+      return std::is_floating_point<K>::value &&
+             cuda_count_if( begin, begin + size, IsNegativeZero<K>{} ) != 0UL;
+   }
+
+   CUDACompaction zeros_;   //!< Compaction of the zeros of the input.
+   std::size_t    count_;   //!< Number of zeros, 0 if none of them is negative.
+   std::size_t    offset_;  //!< Position of the run of zeros in the sorted keys.
+   Buffer<K>      buffer_;  //!< The zeros of the input, in input order.
+};
+
+/*!\brief Radix sorts size encoded keys, and values if any, the result is left in keys/values.
+//
+// The number of passes is even, so the buffers end up back in place after the last pass.
+*/
+template< typename Bits, typename V >
+inline void radix_sort( std::size_t size, Bits* keys, V* values, Bits* keys_alt, V* values_alt )
+{
+   if( size < 2UL ) return;
+
+   std::size_t const chunks = chunk_count( size );
+   std::size_t const chunk  = ( size + chunks - 1 ) / chunks;
+
+   Buffer<std::size_t> hist( radix * chunks );
+
+   for( unsigned int shift = 0; shift < sizeof(Bits) * 8; shift += radix_bits )
+   {
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      histogram_kernel <<< chunks, block_size, 0, cuda_stream() >>>
+         ( size, chunk, static_cast<Bits const*>( keys ), shift, hist.get() );
+
+      cuda_exclusive_scan( hist.get(), hist.get() + radix * chunks, hist.get()
+                         , std::size_t( 0 ), cuda_compact_detail::Plus() );
+
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      scatter_kernel <<< chunks, block_size, 0, cuda_stream() >>>
+         ( size, chunk, shift, static_cast<Bits const*>( keys ), static_cast<V const*>( values )
+         , keys_alt, values_alt, static_cast<std::size_t const*>( hist.get() ) );
+
+      std::swap( keys, keys_alt );
+      std::swap( values, values_alt );
+   }
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+}  // namespace cuda_sort_detail
+
+template < typename KeyIt, typename ValueIt >
+inline void cuda_sort_by_key( KeyIt keys_begin, KeyIt keys_end, ValueIt values_begin
+                            , bool descending = false )
+{
+   using namespace cuda_sort_detail;
+   using K    = std::decay_t< decltype( *keys_begin ) >;
+   using V    = std::decay_t< decltype( *values_begin ) >;
+   using Bits = typename RadixKey<K>::Bits;
+
+   if( keys_end - keys_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   std::size_t const size( keys_end - keys_begin );
+
+   if( size < 2UL ) return;
+
+   Buffer<Bits> keys( size ), keys_alt( size );
+   Buffer<V> values( size ), values_alt( size );
+
+   for_each_index( size, Encode<K,KeyIt,Bits>{ keys_begin, keys.get(), descending } );
+   for_each_index( size, Copy<ValueIt,V*>{ values_begin, values.get() } );
+   SignedZeros<K> const zeros( keys_begin, size, keys.get(), descending );
+
+   radix_sort( size, keys.get(), values.get(), keys_alt.get(), values_alt.get() );
+
+   for_each_index( size, Decode<K,KeyIt,Bits>{ keys.get(), keys_begin, descending } );
+   for_each_index( size, Copy<V const*,ValueIt>{ values.get(), values_begin } );
+   zeros.restore( keys_begin );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+template < typename KeyIt >
+inline void cuda_sort( KeyIt keys_begin, KeyIt keys_end, bool descending = false )
+{
+   using namespace cuda_sort_detail;
+   using K    = std::decay_t< decltype( *keys_begin ) >;
+   using Bits = typename RadixKey<K>::Bits;
+
+   if( keys_end - keys_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   std::size_t const size( keys_end - keys_begin );
+
+   if( size < 2UL ) return;
+
+   Buffer<Bits> keys( size ), keys_alt( size );
+
+   for_each_index( size, Encode<K,KeyIt,Bits>{ keys_begin, keys.get(), descending } );
+   SignedZeros<K> const zeros( keys_begin, size, keys.get(), descending );
+
+   radix_sort( size, keys.get(), static_cast<char*>( nullptr ), keys_alt.get(), static_cast<char*>( nullptr ) );
+
+   for_each_index( size, Decode<K,KeyIt,Bits>{ keys.get(), keys_begin, descending } );
+   zeros.restore( keys_begin );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+template < typename KeyIt, typename IndexIt >
+inline void cuda_argsort( KeyIt keys_begin, KeyIt keys_end, IndexIt indices_begin
+                        , bool descending = false )
+{
+   using namespace cuda_sort_detail;
+   using K    = std::decay_t< decltype( *keys_begin ) >;
+   using Bits = typename RadixKey<K>::Bits;
+
+   if( keys_end - keys_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   std::size_t const size( keys_end - keys_begin );
+
+   if( size == 0UL ) return;
+
+   Buffer<Bits> keys( size ), keys_alt( size );
+   Buffer<std::size_t> indices( size ), indices_alt( size );
+
+   for_each_index( size, Encode<K,KeyIt,Bits>{ keys_begin, keys.get(), descending } );
+   for_each_index( size, Iota{ indices.get() } );
+
+   radix_sort( size, keys.get(), indices.get(), keys_alt.get(), indices_alt.get() );
+
+   for_each_index( size, Copy<std::size_t const*,IndexIt>{ indices.get(), indices_begin } );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+template < typename KeyIt, typename OutputIt, typename IndexIt >
+inline std::size_t cuda_top_k( KeyIt keys_begin, KeyIt keys_end, std::size_t k
+                             , OutputIt values_begin, IndexIt indices_begin )
+{
+   using namespace cuda_sort_detail;
+   using K    = std::decay_t< decltype( *keys_begin ) >;
+   using Bits = typename RadixKey<K>::Bits;
+
+   if( keys_end - keys_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   std::size_t const size( keys_end - keys_begin );
+   k = std::min( k, size );
+
+   if( k == 0UL ) return 0UL;
+
+   // Largest keys first: the k smallest encoded keys are selected
+   Buffer<Bits> keys( size );
+   for_each_index( size, Encode<K,KeyIt,Bits>{ keys_begin, keys.get(), true } );
+
+   // Radix select of the k-th smallest encoded key, most significant digit first
+   Buffer<unsigned long long> counts( radix );
+   unsigned long long host_counts[ radix ];
+
+   Bits prefix( 0 ), mask( 0 );
+   std::size_t remaining( k );
+
+   for( int shift = int( sizeof(Bits) * 8 - radix_bits ); shift >= 0; shift -= int( radix_bits ) )
+   {
+      cudaMemsetAsync( counts.get(), 0, radix * sizeof(unsigned long long), cuda_stream() );
+
+      BLAZE_CUDA_COUNT( launches, 1UL );
+      select_histogram_kernel
+         <<< std::min( ( size + block_size - 1 ) / block_size, std::size_t( 1024 ) ), block_size, 0, cuda_stream() >>>
+         ( size, static_cast<Bits const*>( keys.get() ), prefix, mask, unsigned( shift ), counts.get() );
+
+      cudaMemcpyAsync( host_counts, counts.get(), sizeof(host_counts), cudaMemcpyDeviceToHost, cuda_stream() );
+      cudaStreamSynchronize( cuda_stream() );
+      BLAZE_CUDA_COUNT( transfers, sizeof(host_counts) );
+      BLAZE_CUDA_COUNT( synchronizations, 1UL );
+      BLAZE_CUDA_ERROR_CHECK;
+
+      std::size_t digit( 0 );
+      while( host_counts[digit] < remaining ) {
+         remaining -= host_counts[digit];
+         ++digit;
+      }
+
+      prefix |= Bits( Bits( digit ) << shift );
+      mask   |= Bits( Bits( radix - 1 ) << shift );
+   }
+
+   // Keys smaller than the threshold, then the first keys equal to it, in index order
+   CUDACompaction less, equal;
+   std::size_t const nless ( less .count( keys.get(), keys.get() + size, Less <Bits>{ prefix } ) );
+   std::size_t const nequal( equal.count( keys.get(), keys.get() + size, Equal<Bits>{ prefix } ) );
+
+   Buffer<std::size_t> indices( nless + nequal ), indices_alt( k );
+   less .copyIndices( keys.get(), indices.get(), Less <Bits>{ prefix } );
+   equal.copyIndices( keys.get(), indices.get() + nless, Equal<Bits>{ prefix } );
+
+   // Sorting the k selected keys only
+   Buffer<Bits> selected( k ), selected_alt( k );
+   for_each_index( k, Gather<Bits>{ keys.get(), indices.get(), selected.get() } );
+
+   radix_sort( k, selected.get(), indices.get(), selected_alt.get(), indices_alt.get() );
+
+   // The values are gathered from the input, which keeps the sign of zeros
+   for_each_index( k, GatherKeys<KeyIt,OutputIt>{ keys_begin, indices.get(), values_begin } );
+   for_each_index( k, Copy<std::size_t const*,IndexIt>{ indices.get(), indices_begin } );
+
+   BLAZE_CUDA_ERROR_CHECK;
+
+   return k;
+}
+
+#endif // BLAZE_CUDA_HOST_BACKEND
+
+/*!\brief Sorts a dense vector with data access in place.
+*/
+template< typename VT, bool TF >
+inline void cuda_sort( DenseVector<VT,TF>& vec, bool descending = false )
+{
+   blaze::cuda_sort( (~vec).data(), (~vec).data() + (~vec).size(), descending );
+}
+
+}  // namespace blaze
+
+#endif
@@ -35,18 +35,79 @@
 #ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDATRANSFORM_H_
 #define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDATRANSFORM_H_
 
+#include <array>
 #include <cstddef>
+#include <type_traits>
 
 #include <blaze_cuda/util/algorithms/Unroll.h>
 
-#ifndef BLAZE_CUDA_NO_THRUST
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/algorithms/HostParallel.h>
+#elif !defined(BLAZE_CUDA_NO_THRUST)
 #  include <thrust/transform.h>
 #  include <thrust/execution_policy.h>
+#  include <thrust/system/cuda/execution_policy.h>
 #endif
 
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+#include <blaze_cuda/util/CUDALaunchTuning.h>
+#include <blaze_cuda/util/CUDAMemoryPool.h>
+
 namespace blaze {
 
-#ifndef BLAZE_CUDA_NO_THRUST
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+template < std::size_t Unroll = cuda_tuned
+         , typename InputIt1, typename InputIt2, typename OutputIt
+         , typename F >
+inline void cuda_transform ( InputIt1 in1_begin , InputIt1 in1_end
+                           , InputIt2 in2_begin
+                           , OutputIt out_begin
+                           , F f )
+{
+   BLAZE_CUDA_RANGE( "cuda_transform" );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( in1_end - in1_begin )
+                          * ( sizeof( *in1_begin ) + sizeof( *in2_begin ) + sizeof( *out_begin ) ) );
+
+   host_parallel_for( in1_end - in1_begin
+      , [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      const auto in1 = in1_begin + begin;
+      const auto in2 = in2_begin + begin;
+      const auto out = out_begin + begin;
+
+      BLAZE_CUDA_HOST_SIMD
+      for( std::ptrdiff_t i = 0; i < std::ptrdiff_t( end - begin ); ++i ) {
+         *( out + i ) = f( *( in1 + i ), *( in2 + i ) );
+      }
+   } );
+}
+
+template < std::size_t Unroll = cuda_tuned
+         , typename InputIt1, typename OutputIt
+         , typename F >
+inline void cuda_transform ( InputIt1 in1_begin , InputIt1 in1_end
+                           , OutputIt out_begin
+                           , F f )
+{
+   BLAZE_CUDA_RANGE( "cuda_transform" );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( in1_end - in1_begin ) * ( sizeof( *in1_begin ) + sizeof( *out_begin ) ) );
+
+   host_parallel_for( in1_end - in1_begin
+      , [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      const auto in1 = in1_begin + begin;
+      const auto out = out_begin + begin;
+
+      BLAZE_CUDA_HOST_SIMD
+      for( std::ptrdiff_t i = 0; i < std::ptrdiff_t( end - begin ); ++i ) {
+         *( out + i ) = f( *( in1 + i ) );
+      }
+   } );
+}
+
+#elif !defined(BLAZE_CUDA_NO_THRUST)
 
 namespace detail {
 
@@ -142,7 +203,7 @@ public:
 
 }  // namespace detail
 
-template < std::size_t Unroll = 16
+template < std::size_t Unroll = cuda_tuned
          , typename InputIt1, typename InputIt2, typename OutputIt
          , typename F >
 inline void cuda_transform ( InputIt1 in1_begin , InputIt1 in1_end
@@ -150,31 +211,42 @@ inline void cuda_transform ( InputIt1 in1_begin , InputIt1 in1_end
                            , OutputIt out_begin
                            , F f )
 {
+   BLAZE_CUDA_RANGE( "cuda_transform" );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( in1_end - in1_begin )
+                          * ( sizeof( *in1_begin ) + sizeof( *in2_begin ) + sizeof( *out_begin ) ) );
+
    using namespace detail;
    using AI1 = ThrustInputIteratorAdapter<InputIt1>;
    using AI2 = ThrustInputIteratorAdapter<InputIt2>;
    using AO = ThrustOutputIteratorAdapter<OutputIt>;
 
-   thrust::transform( thrust::device,
+   BLAZE_CUDA_COUNT( launches, 1UL );
+
+   thrust::transform( thrust::cuda::par.on( cuda_stream() ),
       AI1( in1_begin ), AI1( in1_end ),   // Meant to be the left-hand side
       AI2( in2_begin ),                   // Adaptor for the right-hand side
       AO( out_begin ), f );
 }
 
-template < std::size_t Unroll = 16
+template < std::size_t Unroll = cuda_tuned
          , typename InputIt1, typename OutputIt
          , typename F >
 inline void cuda_transform ( InputIt1 in1_begin , InputIt1 in1_end
                            , OutputIt out_begin
                            , F f )
 {
+   BLAZE_CUDA_RANGE( "cuda_transform" );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( in1_end - in1_begin ) * ( sizeof( *in1_begin ) + sizeof( *out_begin ) ) );
+
    using namespace detail;
    using AI1 = ThrustInputIteratorAdapter<InputIt1>;
 
-   thrust::transform( thrust::device, AI1(in1_begin), AI1(in1_end), out_begin, f );
+   BLAZE_CUDA_COUNT( launches, 1UL );
+
+   thrust::transform( thrust::cuda::par.on( cuda_stream() ), AI1(in1_begin), AI1(in1_end), out_begin, f );
 }
 
-#else // ifndef BLAZE_CUDA_NO_THRUST
+#else // BLAZE_CUDA_NO_THRUST
 
 namespace detail {
 
@@ -222,16 +294,16 @@ namespace detail {
       } );
    }
 
-   template< std::size_t Unroll = 4, typename InputIt, typename OutputIt, typename F >
-   inline void cuda_transform ( InputIt in_begin, InputIt in_end
+   template< std::size_t Unroll, typename InputIt, typename OutputIt, typename F >
+   inline void cuda_transform ( std::size_t max_block_size
+                              , InputIt in_begin, InputIt in_end
                               , OutputIt out_begin
                               , F const& f )
    {
       using std::size_t;
 
-      constexpr size_t max_block_size   = 512;
       constexpr size_t max_block_cnt    = 8192;
-      constexpr size_t elmts_per_block  = max_block_size * Unroll;
+      size_t const     elmts_per_block  = max_block_size * Unroll;
 
       while( in_end - in_begin >= ptrdiff_t( elmts_per_block ) )
       {
@@ -239,9 +311,11 @@ namespace detail {
          size_t const block_cnt = elmt_cnt / elmts_per_block;
 
          auto const final_block_cnt = std::min( block_cnt, max_block_cnt );
+
+         BLAZE_CUDA_COUNT( launches, 1UL );
          detail::_cuda_transform_impl
             <Unroll>
-            <<< final_block_cnt, max_block_size >>>
+            <<< final_block_cnt, max_block_size, 0, cuda_stream() >>>
             ( in_begin, out_begin, f );
 
          auto const incr = final_block_cnt * elmts_per_block;
@@ -254,7 +328,8 @@ namespace detail {
       {
          auto const final_block_size = std::min( max_block_size, size_t( in_end - in_begin ) );
 
-         detail::_cuda_transform_impl<1> <<< 1, final_block_size >>>
+         BLAZE_CUDA_COUNT( launches, 1UL );
+         detail::_cuda_transform_impl<1> <<< 1, final_block_size, 0, cuda_stream() >>>
             ( in_begin, out_begin, f );
 
          auto const incr = final_block_size;
@@ -263,12 +338,13 @@ namespace detail {
       }
    }
 
-   template < std::size_t Unroll = 4
+   template < std::size_t Unroll
             , typename InputIt1
             , typename InputIt2
             , typename OutputIt
             , typename F >
-   inline void cuda_transform ( InputIt1 in1_begin
+   inline void cuda_transform ( std::size_t max_block_size
+                              , InputIt1 in1_begin
                               , InputIt1 in1_end
                               , InputIt2 in2_begin
                               , OutputIt out_begin
@@ -276,9 +352,8 @@ namespace detail {
    {
       using std::size_t;
 
-      constexpr size_t max_block_size  = 512;
       constexpr size_t max_block_cnt   = 8192;
-      constexpr size_t elmts_per_block = max_block_size * Unroll;
+      size_t const     elmts_per_block = max_block_size * Unroll;
 
       while( in1_end - in1_begin >= ptrdiff_t( elmts_per_block ) )
       {
@@ -287,9 +362,10 @@ namespace detail {
 
          auto const final_block_cnt = std::min( block_cnt, max_block_cnt );
 
+         BLAZE_CUDA_COUNT( launches, 1UL );
          detail::_cuda_transform_impl
             <Unroll>
-            <<< final_block_cnt, max_block_size >>>
+            <<< final_block_cnt, max_block_size, 0, cuda_stream() >>>
             ( in1_begin, in2_begin, out_begin, f );
 
          auto const incr = final_block_cnt * elmts_per_block;
@@ -303,9 +379,10 @@ namespace detail {
       {
          auto const final_block_size = std::min( max_block_size, size_t( in1_end - in1_begin ) );
 
+         BLAZE_CUDA_COUNT( launches, 1UL );
          detail::_cuda_transform_impl
             <1>
-            <<< 1, final_block_size >>>
+            <<< 1, final_block_size, 0, cuda_stream() >>>
             ( in1_begin, in2_begin, out_begin, f );
 
          auto const incr = final_block_size;
@@ -315,9 +392,52 @@ namespace detail {
          out_begin += incr;
       }
    }
+
+   // Configurations tried by cuda_tune_transform(), and the default one
+   constexpr std::array< CUDALaunchConfig, 9 > transform_candidates
+      {{ { 128, 1 }, { 128, 4 }, { 128, 16 }
+       , { 256, 1 }, { 256, 4 }, { 256, 16 }
+       , { 512, 1 }, { 512, 4 }, { 512, 16 } }};
+
+   constexpr CUDALaunchConfig transform_default{ 512, 4 };
+
+   // Transforms with the given configuration, the unroll factor being one of the candidates
+   template< typename... Args >
+   inline void cuda_transform ( CUDALaunchConfig const& config, Args const&... args )
+   {
+      switch( config.unroll ) {
+         case 1:  detail::cuda_transform< 1>( config.blockSize, args... ); break;
+         case 16: detail::cuda_transform<16>( config.blockSize, args... ); break;
+         default: detail::cuda_transform< 4>( config.blockSize, args... ); break;
+      }
+   }
+
+   // Configuration of a transform writing to elements of type T
+   template< typename T >
+   inline CUDALaunchConfig transform_config( const char* kernel, std::size_t size )
+   {
+      CUDALaunchConfig config( transform_default );
+      cuda_launch_table().find( kernel, cuda_launch_type_name<T>(), size, config );
+      return config;
+   }
+
+   template< typename T >
+   struct TuningCopy
+   {
+      inline BLAZE_DEVICE_CALLABLE T operator()( T const& a ) const { return a; }
+   };
+
+   template< typename T >
+   struct TuningSum
+   {
+      inline BLAZE_DEVICE_CALLABLE T operator()( T const& a, T const& b ) const { return a + b; }
+   };
 }  // namespace detail
 
-template < std::size_t Unroll = 16
+/*!\brief Transforms with the configuration of the launch table unless \a Unroll is given, in
+// which case blocks of 512 threads are used.
+*/
+template < std::size_t Unroll = cuda_tuned
          , typename InputIt1, typename InputIt2, typename OutputIt
          , typename F >
 inline void cuda_transform ( InputIt1 in1_begin , InputIt1 in1_end
@@ -325,20 +445,72 @@ inline void cuda_transform ( InputIt1 in1_begin , InputIt1 in1_end
                            , OutputIt out_begin
                            , F f )
 {
-   detail::cuda_transform( in1_begin, in1_end, in2_begin, out_begin, f );
+   BLAZE_CUDA_RANGE( "cuda_transform" );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( in1_end - in1_begin )
+                          * ( sizeof( *in1_begin ) + sizeof( *in2_begin ) + sizeof( *out_begin ) ) );
+
+   using T = std::decay_t< decltype( *out_begin ) >;
+
+   if constexpr( Unroll == cuda_tuned )
+      detail::cuda_transform( detail::transform_config<T>( "binary_transform", in1_end - in1_begin )
+                            , in1_begin, in1_end, in2_begin, out_begin, f );
+   else
+      detail::cuda_transform<Unroll>( 512, in1_begin, in1_end, in2_begin, out_begin, f );
 }
 
-template < std::size_t Unroll = 16
+template < std::size_t Unroll = cuda_tuned
          , typename InputIt1, typename OutputIt
          , typename F >
 inline void cuda_transform ( InputIt1 in1_begin , InputIt1 in1_end
                            , OutputIt out_begin
                            , F f )
 {
-   detail::cuda_transform( in1_begin, in1_end, out_begin, f );
+   BLAZE_CUDA_RANGE( "cuda_transform" );
+   BLAZE_CUDA_COUNT( bytes, std::size_t( in1_end - in1_begin ) * ( sizeof( *in1_begin ) + sizeof( *out_begin ) ) );
+
+   using T = std::decay_t< decltype( *out_begin ) >;
+
+   if constexpr( Unroll == cuda_tuned )
+      detail::cuda_transform( detail::transform_config<T>( "unary_transform", in1_end - in1_begin )
+                            , in1_begin, in1_end, out_begin, f );
+   else
+      detail::cuda_transform<Unroll>( 512, in1_begin, in1_end, out_begin, f );
+}
+
+/*!\brief Tunes the unary and binary transforms of \a size elements of type \a T.
+//
+// The candidates run on zeroed scratch ranges, the fastest configurations are inserted into
+// cuda_launch_table(). Transforms are not tuned on first use since they may write in place.
+*/
+template < typename T >
+inline void cuda_tune_transform( std::size_t size )
+{
+   if( size == 0UL ) return;
+
+   T* const buffer = static_cast<T*>(
+      cuda_device_memory_pool().allocate( 3UL * size * sizeof(T), cuda_stream() ) );
+   cudaMemsetAsync( buffer, 0, 3UL * size * sizeof(T), cuda_stream() );
+
+   T* const in1 = buffer;
+   T* const in2 = buffer + size;
+   T* const out = buffer + 2UL * size;
+
+   CUDALaunchTable& table( cuda_launch_table() );
+
+   table.insert( "unary_transform", cuda_launch_type_name<T>(), size
+               , cuda_fastest_config( detail::transform_candidates, [&]( CUDALaunchConfig const& c ) {
+                    detail::cuda_transform( c, in1, in1 + size, out, detail::TuningCopy<T>() );
+                 } ) );
+
+   table.insert( "binary_transform", cuda_launch_type_name<T>(), size
+               , cuda_fastest_config( detail::transform_candidates, [&]( CUDALaunchConfig const& c ) {
+                    detail::cuda_transform( c, in1, in1 + size, in2, out, detail::TuningSum<T>() );
+                 } ) );
+
+   cuda_device_memory_pool().deallocate( buffer );
 }
 
-#endif   // ifndef BLAZE_CUDA_NO_THRUST
+#endif   // BLAZE_CUDA_HOST_BACKEND
 
 }  // namespace blaze
 
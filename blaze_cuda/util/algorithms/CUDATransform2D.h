@@ -0,0 +1,272 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDATransform2D.h
+//  \brief Header file for the cuda_transform_2d algorithm
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDATRANSFORM2D_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDATRANSFORM2D_H_
+
+#include <algorithm>
+#include <cstddef>
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/algorithms/HostParallel.h>
+#else
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  2D TRANSFORM
+//
+//  The 2D transform applies an element-wise operation to an m x n block of elements. Each operand
+//  is given as an iterator to its first element and a spacing: element (i,j) of an operand is
+//  located at 'it + i*spacing + j'. Hence padded rows (or columns, for column-major matrices) can
+//  be traversed in a single kernel launch instead of one launch per row. cuda_generate_2d() is
+//  the index-based variant: element (i,j) of the output is set to 'g(i,j)'.
+//
+//=================================================================================================
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+template < typename InputIt1, typename InputIt2, typename OutputIt, typename F >
+inline void cuda_transform_2d( std::size_t m, std::size_t n
+                             , InputIt1 in1_begin, std::size_t in1_spacing
+                             , InputIt2 in2_begin, std::size_t in2_spacing
+                             , OutputIt out_begin, std::size_t out_spacing
+                             , F f )
+{
+   host_parallel_for( m, n, [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( std::size_t i = begin; i < end; ++i )
+      {
+         const auto in1 = in1_begin + i * in1_spacing;
+         const auto in2 = in2_begin + i * in2_spacing;
+         const auto out = out_begin + i * out_spacing;
+
+         BLAZE_CUDA_HOST_SIMD
+         for( std::ptrdiff_t j = 0; j < std::ptrdiff_t( n ); ++j ) {
+            *( out + j ) = f( *( in1 + j ), *( in2 + j ) );
+         }
+      }
+   } );
+}
+
+template < typename InputIt, typename OutputIt, typename F >
+inline void cuda_transform_2d( std::size_t m, std::size_t n
+                             , InputIt in_begin, std::size_t in_spacing
+                             , OutputIt out_begin, std::size_t out_spacing
+                             , F f )
+{
+   host_parallel_for( m, n, [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( std::size_t i = begin; i < end; ++i )
+      {
+         const auto in  = in_begin  + i * in_spacing;
+         const auto out = out_begin + i * out_spacing;
+
+         BLAZE_CUDA_HOST_SIMD
+         for( std::ptrdiff_t j = 0; j < std::ptrdiff_t( n ); ++j ) {
+            *( out + j ) = f( *( in + j ) );
+         }
+      }
+   } );
+}
+
+template < typename OutputIt, typename G >
+inline void cuda_generate_2d( std::size_t m, std::size_t n
+                            , OutputIt out_begin, std::size_t out_spacing
+                            , G g )
+{
+   host_parallel_for( m, n, [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( std::size_t i = begin; i < end; ++i )
+      {
+         const auto out = out_begin + i * out_spacing;
+
+         BLAZE_CUDA_HOST_SIMD
+         for( std::ptrdiff_t j = 0; j < std::ptrdiff_t( n ); ++j ) {
+            *( out + j ) = g( i, std::size_t( j ) );
+         }
+      }
+   } );
+}
+
+#else // BLAZE_CUDA_HOST_BACKEND
+
+namespace detail {
+
+   template < typename InputIt1, typename InputIt2, typename OutputIt, typename F >
+   void __global__ _cuda_transform_2d_impl( std::size_t m, std::size_t n
+                                          , InputIt1 in1_begin, std::size_t in1_spacing
+                                          , InputIt2 in2_begin, std::size_t in2_spacing
+                                          , OutputIt out_begin, std::size_t out_spacing
+                                          , F f )
+   {
+      using std::size_t;
+
+      size_t const row_stride = gridDim.y * blockDim.y;
+      size_t const col_stride = gridDim.x * blockDim.x;
+
+      for( size_t i = blockIdx.y * blockDim.y + threadIdx.y; i < m; i += row_stride )
+      {
+         const auto in1 = in1_begin + i * in1_spacing;
+         const auto in2 = in2_begin + i * in2_spacing;
+         const auto out = out_begin + i * out_spacing;
+
+         for( size_t j = blockIdx.x * blockDim.x + threadIdx.x; j < n; j += col_stride ) {
+            *( out + j ) = f( *( in1 + j ), *( in2 + j ) );
+         }
+      }
+   }
+
+   template < typename InputIt, typename OutputIt, typename F >
+   void __global__ _cuda_transform_2d_impl( std::size_t m, std::size_t n
+                                          , InputIt in_begin, std::size_t in_spacing
+                                          , OutputIt out_begin, std::size_t out_spacing
+                                          , F f )
+   {
+      using std::size_t;
+
+      size_t const row_stride = gridDim.y * blockDim.y;
+      size_t const col_stride = gridDim.x * blockDim.x;
+
+      for( size_t i = blockIdx.y * blockDim.y + threadIdx.y; i < m; i += row_stride )
+      {
+         const auto in  = in_begin  + i * in_spacing;
+         const auto out = out_begin + i * out_spacing;
+
+         for( size_t j = blockIdx.x * blockDim.x + threadIdx.x; j < n; j += col_stride ) {
+            *( out + j ) = f( *( in + j ) );
+         }
+      }
+   }
+
+   template < typename OutputIt, typename G >
+   void __global__ _cuda_generate_2d_impl( std::size_t m, std::size_t n
+                                         , OutputIt out_begin, std::size_t out_spacing
+                                         , G g )
+   {
+      using std::size_t;
+
+      size_t const row_stride = gridDim.y * blockDim.y;
+      size_t const col_stride = gridDim.x * blockDim.x;
+
+      for( size_t i = blockIdx.y * blockDim.y + threadIdx.y; i < m; i += row_stride )
+      {
+         const auto out = out_begin + i * out_spacing;
+
+         for( size_t j = blockIdx.x * blockDim.x + threadIdx.x; j < n; j += col_stride ) {
+            *( out + j ) = g( i, j );
+         }
+      }
+   }
+
+   // Block and grid dimensions for an m x n launch. Blocks are as wide as the rows (rounded up to
+   // a full warp, at most max_block_size threads) and the remaining threads of the block are spent
+   // on additional rows, which keeps all threads busy for tall and skinny matrices.
+   inline void cuda_transform_2d_dims( std::size_t m, std::size_t n, dim3& grid, dim3& block )
+   {
+      using std::size_t;
+
+      constexpr size_t warp_size      = 32;
+      constexpr size_t max_block_size = 256;
+      constexpr size_t max_grid_x     = 65535;
+      constexpr size_t max_grid_y     = 65535;
+
+      size_t const bx = std::min( ( ( n + warp_size - 1 ) / warp_size ) * warp_size, max_block_size );
+      size_t const by = max_block_size / bx;
+
+      block = dim3( bx, by );
+      grid  = dim3( std::min( ( n + bx - 1 ) / bx, max_grid_x )
+                  , std::min( ( m + by - 1 ) / by, max_grid_y ) );
+   }
+
+}  // namespace detail
+
+template < typename InputIt1, typename InputIt2, typename OutputIt, typename F >
+inline void cuda_transform_2d( std::size_t m, std::size_t n
+                             , InputIt1 in1_begin, std::size_t in1_spacing
+                             , InputIt2 in2_begin, std::size_t in2_spacing
+                             , OutputIt out_begin, std::size_t out_spacing
+                             , F f )
+{
+   if( m == 0UL || n == 0UL ) return;
+
+   dim3 grid, block;
+   detail::cuda_transform_2d_dims( m, n, grid, block );
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   detail::_cuda_transform_2d_impl <<< grid, block, 0, cuda_stream() >>>
+      ( m, n, in1_begin, in1_spacing, in2_begin, in2_spacing, out_begin, out_spacing, f );
+}
+
+template < typename InputIt, typename OutputIt, typename F >
+inline void cuda_transform_2d( std::size_t m, std::size_t n
+                             , InputIt in_begin, std::size_t in_spacing
+                             , OutputIt out_begin, std::size_t out_spacing
+                             , F f )
+{
+   if( m == 0UL || n == 0UL ) return;
+
+   dim3 grid, block;
+   detail::cuda_transform_2d_dims( m, n, grid, block );
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   detail::_cuda_transform_2d_impl <<< grid, block, 0, cuda_stream() >>>
+      ( m, n, in_begin, in_spacing, out_begin, out_spacing, f );
+}
+
+template < typename OutputIt, typename G >
+inline void cuda_generate_2d( std::size_t m, std::size_t n
+                            , OutputIt out_begin, std::size_t out_spacing
+                            , G g )
+{
+   if( m == 0UL || n == 0UL ) return;
+
+   dim3 grid, block;
+   detail::cuda_transform_2d_dims( m, n, grid, block );
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   detail::_cuda_generate_2d_impl <<< grid, block, 0, cuda_stream() >>> ( m, n, out_begin, out_spacing, g );
+}
+
+#endif // BLAZE_CUDA_HOST_BACKEND
+
+}  // namespace blaze
+
+#endif
@@ -0,0 +1,157 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDATransformReduce.h
+//  \brief Header file for the fused CUDA transform-reduce algorithm
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDATRANSFORMREDUCE_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDATRANSFORMREDUCE_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/util/algorithms/CUDAReduce.h>
+
+namespace blaze {
+
+namespace cuda_reduce_detail {
+
+/*!\brief Loads the transform of the i-th element of a range.
+*/
+template< typename Input, typename F >
+struct UnaryTransformLoad
+{
+   Input it;
+   F f;
+
+   inline BLAZE_DEVICE_CALLABLE decltype(auto) operator()( std::size_t i ) { return f( *( it + i ) ); }
+};
+
+/*!\brief Loads the transform of the i-th elements of two ranges.
+*/
+template< typename Input1, typename Input2, typename F >
+struct BinaryTransformLoad
+{
+   Input1 it1;
+   Input2 it2;
+   F f;
+
+   inline BLAZE_DEVICE_CALLABLE decltype(auto) operator()( std::size_t i )
+   {
+      return f( *( it1 + i ), *( it2 + i ) );
+   }
+};
+
+}  // namespace cuda_reduce_detail
+
+//=================================================================================================
+//
+//  TRANSFORM-REDUCE
+//
+//  cuda_transform_reduce() reduces the transformed elements of one or two ranges with the single
+//  pass kernel of cuda_reduce(): the transform is applied while loading, so no intermediate
+//  range is materialized and a single kernel is launched. As for cuda_reduce(), \a init must be
+//  an identity of \a reduce_op. The _into variants write the result to a device scalar without
+//  synchronizing.
+//
+//=================================================================================================
+
+template < std::size_t Unroll = cuda_tuned, std::size_t BlockSizeExponent = cuda_tuned
+         , typename InputIt1, typename InputIt2
+         , typename T
+         , typename ReduceOp, typename TransformOp >
+inline void cuda_transform_reduce_into
+   ( InputIt1 in1_begin, InputIt1 in1_end, InputIt2 in2_begin
+   , T init, ReduceOp reduce_op, TransformOp transform_op
+   , T* result, CUDAReduceWorkspace<T>& workspace )
+{
+   using Load = cuda_reduce_detail::BinaryTransformLoad< InputIt1, InputIt2, TransformOp >;
+
+   if( in1_end - in1_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   cuda_reduce_detail::reduce_into< Unroll, BlockSizeExponent >( in1_end - in1_begin
+      , Load{ in1_begin, in2_begin, transform_op }, init, reduce_op, result, workspace );
+}
+
+template < std::size_t Unroll = cuda_tuned, std::size_t BlockSizeExponent = cuda_tuned
+         , typename InputIt
+         , typename T
+         , typename ReduceOp, typename TransformOp >
+inline void cuda_transform_reduce_into
+   ( InputIt in_begin, InputIt in_end
+   , T init, ReduceOp reduce_op, TransformOp transform_op
+   , T* result, CUDAReduceWorkspace<T>& workspace )
+{
+   using Load = cuda_reduce_detail::UnaryTransformLoad< InputIt, TransformOp >;
+
+   if( in_end - in_begin < 0 ) throw std::runtime_error("Invalid iterator order");
+
+   cuda_reduce_detail::reduce_into< Unroll, BlockSizeExponent >( in_end - in_begin
+      , Load{ in_begin, transform_op }, init, reduce_op, result, workspace );
+}
+
+template < std::size_t Unroll = cuda_tuned, std::size_t BlockSizeExponent = cuda_tuned
+         , typename InputIt1, typename InputIt2
+         , typename T
+         , typename ReduceOp, typename TransformOp >
+inline T cuda_transform_reduce
+   ( InputIt1 in1_begin, InputIt1 in1_end, InputIt2 in2_begin
+   , T init, ReduceOp reduce_op, TransformOp transform_op )
+{
+   CUDAReduceWorkspace<T>& workspace( cuda_reduce_workspace<T>() );
+
+   cuda_transform_reduce_into< Unroll, BlockSizeExponent >( in1_begin, in1_end, in2_begin
+      , init, reduce_op, transform_op, workspace.result(), workspace );
+
+   return workspace.value();
+}
+
+template < std::size_t Unroll = cuda_tuned, std::size_t BlockSizeExponent = cuda_tuned
+         , typename InputIt
+         , typename T
+         , typename ReduceOp, typename TransformOp >
+inline T cuda_transform_reduce
+   ( InputIt in_begin, InputIt in_end
+   , T init, ReduceOp reduce_op, TransformOp transform_op )
+{
+   CUDAReduceWorkspace<T>& workspace( cuda_reduce_workspace<T>() );
+
+   cuda_transform_reduce_into< Unroll, BlockSizeExponent >( in_begin, in_end
+      , init, reduce_op, transform_op, workspace.result(), workspace );
+
+   return workspace.value();
+}
+
+}  // namespace blaze
+
+#endif
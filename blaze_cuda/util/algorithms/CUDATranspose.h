@@ -0,0 +1,398 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDATranspose.h
+//  \brief Header file for the cuda_transpose algorithms
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDATRANSPOSE_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDATRANSPOSE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+#  include <blaze_cuda/util/algorithms/HostParallel.h>
+#else
+#  include <cuda_runtime.h>
+#endif
+
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/util/CUDAErrorManagement.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  TRANSPOSE
+//
+//  cuda_transpose() transposes an m x n block of elements into an n x m block, with operands
+//  given as for cuda_transform_2d(): element (i,j) of the input is located at
+//  'in + i*in_spacing + j' and is combined into element (j,i) of the output, located at
+//  'out + j*out_spacing + i', as 'out(j,i) = f( out(j,i), in(i,j) )'. The block is processed
+//  in square tiles staged in shared memory, so both the loads and the stores are coalesced.
+//  The tiles are padded by one column to avoid shared memory bank conflicts.
+//
+//  cuda_transpose_inplace() transposes a square n x n block in place, applying 'f' to every
+//  element (e.g. a conjugation). Each block swaps a pair of mirrored tiles, and the diagonal
+//  tiles are transposed within themselves.
+//
+//  cuda_mirror_lower() completes a square n x n block of which only the lower triangle,
+//  'begin + i*spacing + j' with j < i, holds valid elements, as 'out(j,i) = f( in(i,j) )'.
+//  It is used to fill the second triangle of the result of a symmetric (f = identity) or
+//  Hermitian (f = conj) rank-k update. Only the tiles on and below the diagonal are read.
+//
+//  The host execution backend processes the same tiles, sized to stay in the L1 cache.
+//
+//=================================================================================================
+
+namespace cuda_transpose_detail {
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+constexpr std::size_t tile = 64;
+#else
+constexpr std::size_t tile = 32;  // Tile edge, one warp wide
+constexpr std::size_t rows = 8;   // Rows of threads of a block, which loop over the tile
+#endif
+
+inline BLAZE_DEVICE_CALLABLE std::size_t tiles( std::size_t n )
+{
+   return ( n + tile - 1 ) / tile;
+}
+
+}  // namespace cuda_transpose_detail
+
+#if defined(BLAZE_CUDA_HOST_BACKEND)
+
+template < typename InputIt, typename OutputIt, typename F >
+inline void cuda_transpose( std::size_t m, std::size_t n
+                          , InputIt in_begin, std::size_t in_spacing
+                          , OutputIt out_begin, std::size_t out_spacing
+                          , F f )
+{
+   using cuda_transpose_detail::tile;
+
+   BLAZE_CUDA_RANGE( "cuda_transpose" );
+
+   if( m == 0UL || n == 0UL ) return;
+
+   host_parallel_for( cuda_transpose_detail::tiles( m ), tile * n
+                    , [&]( std::size_t, std::size_t begin, std::size_t end )
+   {
+      for( std::size_t ti = begin; ti < end; ++ti )
+      {
+         const std::size_t iend( std::min( ( ti + 1UL ) * tile, m ) );
+
+         for( std::size_t jj = 0UL; jj < n; jj += tile )
+         {
+            const std::size_t jend( std::min( jj + tile, n ) );
+
+            for( std::size_t i = ti * tile; i < iend; ++i ) {
+               const auto in = in_begin + i * in_spacing;
+               for( std::size_t j = jj; j < jend; ++j ) {
+                  auto out = out_begin + j * out_spacing + i;
+                  *out = f( *out, *( in + j ) );
+               }
+            }
+         }
+      }
+   } );
+}
+
+template < typename InOutIt, typename F >
+inline void cuda_transpose_inplace( std::size_t n, InOutIt begin, std::size_t spacing, F f )
+{
+   using cuda_transpose_detail::tile;
+
+   BLAZE_CUDA_RANGE( "cuda_transpose" );
+
+   if( n == 0UL ) return;
+
+   // Tile row ti owns the pairs (ti,tj), tj <= ti, so chunks never touch the same elements
+   host_parallel_for( cuda_transpose_detail::tiles( n ), tile * n / 2UL
+                    , [&]( std::size_t, std::size_t tbegin, std::size_t tend )
+   {
+      for( std::size_t ti = tbegin; ti < tend; ++ti )
+      {
+         const std::size_t ii  ( ti * tile );
+         const std::size_t iend( std::min( ii + tile, n ) );
+
+         for( std::size_t jj = 0UL; jj <= ii; jj += tile )
+         {
+            const std::size_t jend( std::min( jj + tile, n ) );
+
+            for( std::size_t i = ii; i < iend; ++i ) {
+               for( std::size_t j = jj; j < jend && j < i; ++j ) {
+                  auto lower = begin + i * spacing + j;
+                  auto upper = begin + j * spacing + i;
+                  const auto tmp( f( *lower ) );
+                  *lower = f( *upper );
+                  *upper = tmp;
+               }
+            }
+         }
+
+         for( std::size_t i = ii; i < iend; ++i ) {
+            auto diag = begin + i * spacing + i;
+            *diag = f( *diag );
+         }
+      }
+   } );
+}
+
+template < typename InOutIt, typename F >
+inline void cuda_mirror_lower( std::size_t n, InOutIt begin, std::size_t spacing, F f )
+{
+   using cuda_transpose_detail::tile;
+
+   BLAZE_CUDA_RANGE( "cuda_mirror_lower" );
+
+   if( n < 2UL ) return;
+
+   host_parallel_for( cuda_transpose_detail::tiles( n ), tile * n / 2UL
+                    , [&]( std::size_t, std::size_t tbegin, std::size_t tend )
+   {
+      for( std::size_t ti = tbegin; ti < tend; ++ti )
+      {
+         const std::size_t ii  ( ti * tile );
+         const std::size_t iend( std::min( ii + tile, n ) );
+
+         for( std::size_t jj = 0UL; jj <= ii; jj += tile )
+         {
+            const std::size_t jend( std::min( jj + tile, n ) );
+
+            for( std::size_t i = ii; i < iend; ++i ) {
+               const auto in = begin + i * spacing;
+               for( std::size_t j = jj; j < jend && j < i; ++j ) {
+                  *( begin + j * spacing + i ) = f( *( in + j ) );
+               }
+            }
+         }
+      }
+   } );
+}
+
+#else // BLAZE_CUDA_HOST_BACKEND
+
+namespace cuda_transpose_detail {
+
+/*!\brief Raw shared memory for a padded tile, as elements may not be trivially constructible.
+*/
+template< typename T >
+struct TileStorage
+{
+   alignas( T ) unsigned char data[ tile * ( tile + 1 ) * sizeof( T ) ];
+
+   inline __device__ T& operator()( std::size_t i, std::size_t j )
+   {
+      return reinterpret_cast<T*>( data )[ i * ( tile + 1 ) + j ];
+   }
+};
+
+template < typename InputIt, typename OutputIt, typename F >
+void __global__ transpose_kernel( std::size_t m, std::size_t n
+                                , InputIt in_begin, std::size_t in_spacing
+                                , OutputIt out_begin, std::size_t out_spacing
+                                , F f )
+{
+   using std::size_t;
+   using T = std::decay_t< decltype( *in_begin ) >;
+
+   __shared__ TileStorage<T> sdata;
+
+   size_t const tiles_m = tiles( m );
+   size_t const tiles_n = tiles( n );
+
+   for( size_t ti = blockIdx.y; ti < tiles_m; ti += gridDim.y )
+   {
+      for( size_t tj = blockIdx.x; tj < tiles_n; tj += gridDim.x )
+      {
+         size_t const i0 = ti * tile;
+         size_t const j0 = tj * tile;
+
+         // Coalesced along the rows of the input...
+         for( size_t k = threadIdx.y; k < tile; k += rows ) {
+            if( i0 + k < m && j0 + threadIdx.x < n )
+               sdata( k, threadIdx.x ) = *( in_begin + ( i0 + k ) * in_spacing + j0 + threadIdx.x );
+         }
+         __syncthreads();
+
+         // ... and along the rows of the output
+         for( size_t k = threadIdx.y; k < tile; k += rows ) {
+            if( j0 + k < n && i0 + threadIdx.x < m ) {
+               auto out = out_begin + ( j0 + k ) * out_spacing + i0 + threadIdx.x;
+               *out = f( *out, sdata( threadIdx.x, k ) );
+            }
+         }
+         __syncthreads();
+      }
+   }
+}
+
+template < typename InOutIt, typename F >
+void __global__ transpose_inplace_kernel( std::size_t n, InOutIt begin, std::size_t spacing, F f )
+{
+   using std::size_t;
+   using T = std::decay_t< decltype( *begin ) >;
+
+   __shared__ TileStorage<T> lower;
+   __shared__ TileStorage<T> upper;
+
+   size_t const tiles_n = tiles( n );
+
+   for( size_t ti = blockIdx.y; ti < tiles_n; ti += gridDim.y )
+   {
+      // Only the blocks of the lower triangle of tiles work, each on a mirrored pair
+      for( size_t tj = blockIdx.x; tj <= ti; tj += gridDim.x )
+      {
+         size_t const i0 = ti * tile;
+         size_t const j0 = tj * tile;
+
+         for( size_t k = threadIdx.y; k < tile; k += rows ) {
+            if( i0 + k < n && j0 + threadIdx.x < n )
+               lower( k, threadIdx.x ) = *( begin + ( i0 + k ) * spacing + j0 + threadIdx.x );
+            if( ti != tj && j0 + k < n && i0 + threadIdx.x < n )
+               upper( k, threadIdx.x ) = *( begin + ( j0 + k ) * spacing + i0 + threadIdx.x );
+         }
+         __syncthreads();
+
+         for( size_t k = threadIdx.y; k < tile; k += rows ) {
+            if( j0 + k < n && i0 + threadIdx.x < n )
+               *( begin + ( j0 + k ) * spacing + i0 + threadIdx.x ) = f( lower( threadIdx.x, k ) );
+            if( ti != tj && i0 + k < n && j0 + threadIdx.x < n )
+               *( begin + ( i0 + k ) * spacing + j0 + threadIdx.x ) = f( upper( threadIdx.x, k ) );
+         }
+         __syncthreads();
+      }
+   }
+}
+
+template < typename InOutIt, typename F >
+void __global__ mirror_lower_kernel( std::size_t n, InOutIt begin, std::size_t spacing, F f )
+{
+   using std::size_t;
+   using T = std::decay_t< decltype( *begin ) >;
+
+   __shared__ TileStorage<T> lower;
+
+   size_t const tiles_n = tiles( n );
+
+   for( size_t ti = blockIdx.y; ti < tiles_n; ti += gridDim.y )
+   {
+      // Each block of the lower triangle of tiles writes the mirrored tile of the upper one
+      for( size_t tj = blockIdx.x; tj <= ti; tj += gridDim.x )
+      {
+         size_t const i0 = ti * tile;
+         size_t const j0 = tj * tile;
+
+         for( size_t k = threadIdx.y; k < tile; k += rows ) {
+            if( i0 + k < n && j0 + threadIdx.x < i0 + k )
+               lower( k, threadIdx.x ) = *( begin + ( i0 + k ) * spacing + j0 + threadIdx.x );
+         }
+         __syncthreads();
+
+         for( size_t k = threadIdx.y; k < tile; k += rows ) {
+            if( i0 + threadIdx.x < n && j0 + k < i0 + threadIdx.x )
+               *( begin + ( j0 + k ) * spacing + i0 + threadIdx.x ) = f( lower( threadIdx.x, k ) );
+         }
+         __syncthreads();
+      }
+   }
+}
+
+inline dim3 transpose_grid( std::size_t m, std::size_t n )
+{
+   constexpr std::size_t max_grid = 65535;
+
+   return dim3( std::min( tiles( n ), max_grid ), std::min( tiles( m ), max_grid ) );
+}
+
+}  // namespace cuda_transpose_detail
+
+template < typename InputIt, typename OutputIt, typename F >
+inline void cuda_transpose( std::size_t m, std::size_t n
+                          , InputIt in_begin, std::size_t in_spacing
+                          , OutputIt out_begin, std::size_t out_spacing
+                          , F f )
+{
+   using namespace cuda_transpose_detail;
+
+   BLAZE_CUDA_RANGE( "cuda_transpose" );
+
+   if( m == 0UL || n == 0UL ) return;
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   transpose_kernel <<< transpose_grid( m, n ), dim3( tile, rows ), 0, cuda_stream() >>>
+      ( m, n, in_begin, in_spacing, out_begin, out_spacing, f );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+template < typename InOutIt, typename F >
+inline void cuda_transpose_inplace( std::size_t n, InOutIt begin, std::size_t spacing, F f )
+{
+   using namespace cuda_transpose_detail;
+
+   BLAZE_CUDA_RANGE( "cuda_transpose" );
+
+   if( n == 0UL ) return;
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   transpose_inplace_kernel <<< transpose_grid( n, n ), dim3( tile, rows ), 0, cuda_stream() >>>
+      ( n, begin, spacing, f );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+template < typename InOutIt, typename F >
+inline void cuda_mirror_lower( std::size_t n, InOutIt begin, std::size_t spacing, F f )
+{
+   using namespace cuda_transpose_detail;
+
+   BLAZE_CUDA_RANGE( "cuda_mirror_lower" );
+
+   if( n < 2UL ) return;
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+   mirror_lower_kernel <<< transpose_grid( n, n ), dim3( tile, rows ), 0, cuda_stream() >>>
+      ( n, begin, spacing, f );
+
+   BLAZE_CUDA_ERROR_CHECK;
+}
+
+#endif // BLAZE_CUDA_HOST_BACKEND
+
+}  // namespace blaze
+
+#endif
@@ -0,0 +1,252 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/CUDAWelford.h
+//  \brief Single pass mean and variance reductions
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_CUDAWELFORD_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_CUDAWELFORD_H_
+
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/util/algorithms/CUDAReduce.h>
+#include <blaze_cuda/util/algorithms/CUDASegmentedReduce.h>
+#include <blaze_cuda/util/algorithms/CUDATransformReduce.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+namespace blaze {
+
+//=================================================================================================
+//
+//  WELFORD REDUCTIONS
+//
+//  The Welford reductions compute the mean and the sum of squared deviations M2 of a range in a
+//  single pass. Every element is loaded as the state (1, x, 0), and the states of two parts of
+//  the range are merged with the parallel update of Chan et al.:
+//
+//     n = na + nb,  d = mean_b - mean_a,
+//     mean = mean_a + d * nb/n,  M2 = M2_a + M2_b + d^2 * na*nb/n
+//
+//  The merge is associative and commutative (up to rounding), and the empty state (0, 0, 0) is
+//  its identity, so the states are reduced with the kernels of cuda_reduce() and of the
+//  segmented reductions. Unlike the textbook two pass formula, no cancellation occurs when the
+//  mean is large compared to the deviations.
+//
+//=================================================================================================
+
+/*!\brief Partial state of a Welford reduction.
+*/
+template< typename T >  // Type of the accumulated values
+struct WelfordState
+{
+   std::size_t count;  //!< Number of reduced elements.
+   T mean;             //!< Mean of the reduced elements.
+   T m2;               //!< Sum of the squared deviations from the mean.
+};
+
+/*!\brief Merges two Welford states.
+*/
+struct WelfordMerge
+{
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE WelfordState<T>
+      operator()( WelfordState<T> const& a, WelfordState<T> const& b ) const
+   {
+      std::size_t const count = a.count + b.count;
+
+      if( count == 0UL ) return a;
+
+      T const delta = b.mean - a.mean;
+      T const ratio = T( b.count ) / T( count );
+
+      return WelfordState<T>{ count, a.mean + delta * ratio
+                            , a.m2 + b.m2 + delta * delta * T( a.count ) * ratio };
+   }
+};
+
+/*!\brief Loads an element as the state of a single element Welford reduction.
+*/
+template< typename T >  // Type of the accumulated values
+struct WelfordLoad
+{
+   template< typename U >
+   inline BLAZE_DEVICE_CALLABLE WelfordState<T> operator()( U const& x ) const
+   {
+      return WelfordState<T>{ 1UL, T( x ), T( 0 ) };
+   }
+};
+
+/*!\brief Mean of a Welford state.
+*/
+struct WelfordMean
+{
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE T operator()( WelfordState<T> const& s ) const { return s.mean; }
+};
+
+/*!\brief Sample variance of a Welford state.
+*/
+struct WelfordVariance
+{
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE T operator()( WelfordState<T> const& s ) const
+   {
+      return s.m2 / T( s.count - 1UL );
+   }
+};
+
+/*!\brief Sample standard deviation of a Welford state.
+*/
+struct WelfordStdDev
+{
+   template< typename T >
+   inline BLAZE_DEVICE_CALLABLE T operator()( WelfordState<T> const& s ) const
+   {
+      using std::sqrt;
+      return sqrt( s.m2 / T( s.count - 1UL ) );
+   }
+};
+
+namespace cuda_welford_detail {
+
+/*!\brief Output iterator storing the result of \a F for the Welford states assigned to it.
+//
+// The segmented reductions write their final states through this adaptor, so the mean, the
+// variance or the standard deviation is stored without a temporary and a second launch.
+*/
+template< typename OutputIt, typename F >
+class FinalizeIterator
+{
+ public:
+   struct Proxy
+   {
+      OutputIt it;
+      F f;
+
+      template< typename T >
+      inline BLAZE_DEVICE_CALLABLE Proxy& operator=( WelfordState<T> const& s ) {
+         *it = f( s );
+         return *this;
+      }
+   };
+
+   using iterator_category = std::output_iterator_tag;
+   using value_type        = void;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = void;
+   using reference         = Proxy;
+
+   inline BLAZE_DEVICE_CALLABLE FinalizeIterator( OutputIt it, F f ) : it_( it ), f_( f ) {}
+
+   inline BLAZE_DEVICE_CALLABLE Proxy operator*() const { return Proxy{ it_, f_ }; }
+
+   inline BLAZE_DEVICE_CALLABLE FinalizeIterator operator+( std::size_t inc ) const {
+      return FinalizeIterator( it_ + inc, f_ );
+   }
+
+   inline BLAZE_DEVICE_CALLABLE FinalizeIterator& operator++() { ++it_; return *this; }
+
+ private:
+   OutputIt it_;
+   F f_;
+};
+
+}  // namespace cuda_welford_detail
+
+/*!\brief Reduces the range [\a in_begin, \a in_end) to its Welford state, accumulated in \a T.
+*/
+template < typename T, typename InputIt >
+inline WelfordState<T> cuda_welford( InputIt in_begin, InputIt in_end )
+{
+   BLAZE_CUDA_RANGE( "cuda_welford" );
+
+   return cuda_transform_reduce( in_begin, in_end, WelfordState<T>{ 0UL, T( 0 ), T( 0 ) }
+                               , WelfordMerge(), WelfordLoad<T>() );
+}
+
+/*!\brief Reduces the m x n block at \a in_begin, given as for cuda_reduce_2d(), to its Welford
+// state, accumulated in \a T.
+*/
+template < typename T, typename InputIt >
+inline WelfordState<T> cuda_welford_2d( std::size_t m, std::size_t n
+                                      , InputIt in_begin, std::size_t in_spacing )
+{
+   using Load = cuda_reduce_detail::TransformIterator< InputIt, WelfordLoad<T> >;
+
+   BLAZE_CUDA_RANGE( "cuda_welford" );
+
+   return cuda_reduce_2d( m, n, Load( in_begin, WelfordLoad<T>() ), in_spacing
+                        , WelfordState<T>{ 0UL, T( 0 ), T( 0 ) }, WelfordMerge() );
+}
+
+/*!\brief Stores \a f of the Welford state of each of the m contiguous segments of the block at
+// \a in_begin into \a out_begin, with the kernels of cuda_reduce_segments().
+*/
+template < typename T, typename InputIt, typename OutputIt, typename F >
+inline void cuda_welford_segments( std::size_t m, std::size_t n
+                                 , InputIt in_begin, std::size_t in_spacing
+                                 , OutputIt out_begin, F f )
+{
+   using Load   = cuda_reduce_detail::TransformIterator< InputIt, WelfordLoad<T> >;
+   using Output = cuda_welford_detail::FinalizeIterator< OutputIt, F >;
+
+   BLAZE_CUDA_RANGE( "cuda_welford" );
+
+   cuda_reduce_segments( m, n, Load( in_begin, WelfordLoad<T>() ), in_spacing
+                       , Output( out_begin, f ), WelfordMerge() );
+}
+
+/*!\brief Stores \a f of the Welford state of each of the n strided columns of the block at
+// \a in_begin into \a out_begin, with the kernels of cuda_reduce_strided().
+*/
+template < typename T, typename InputIt, typename OutputIt, typename F >
+inline void cuda_welford_strided( std::size_t m, std::size_t n
+                                , InputIt in_begin, std::size_t in_spacing
+                                , OutputIt out_begin, F f )
+{
+   using Load   = cuda_reduce_detail::TransformIterator< InputIt, WelfordLoad<T> >;
+   using Output = cuda_welford_detail::FinalizeIterator< OutputIt, F >;
+
+   BLAZE_CUDA_RANGE( "cuda_welford" );
+
+   cuda_reduce_strided( m, n, Load( in_begin, WelfordLoad<T>() ), in_spacing
+                      , Output( out_begin, f ), WelfordMerge() );
+}
+
+}  // namespace blaze
+
+#endif
@@ -0,0 +1,171 @@
+//=================================================================================================
+/*!
+//  \file blaze_cuda/util/algorithms/HostParallel.h
+//  \brief Header file for the host execution backend's parallel loop
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZE_CUDA_UTIL_ALGORITHMS_HOSTPARALLEL_H_
+#define _BLAZE_CUDA_UTIL_ALGORITHMS_HOSTPARALLEL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#if defined(_OPENMP)
+#  include <omp.h>
+#endif
+
+#include <blaze/system/Inline.h>
+
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+
+
+//*************************************************************************************************
+/*!\brief Loop vectorization hint for the host execution backend.
+// \ingroup util
+//
+// Expands to an OpenMP \c simd pragma when OpenMP is enabled, and to nothing otherwise. Loops
+// of the host backend are kept simple enough for the compiler to auto-vectorize them anyway.
+*/
+#if defined(_OPENMP)
+#  define BLAZE_CUDA_HOST_SIMD _Pragma("omp simd")
+#else
+#  define BLAZE_CUDA_HOST_SIMD
+#endif
+//*************************************************************************************************
+
+
+namespace blaze {
+
+//*************************************************************************************************
+/*!\brief Minimum number of elements processed by a single host thread.
+// \ingroup util
+*/
+constexpr std::size_t host_min_chunk_size = 16384UL;
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the number of chunks a host-side parallel loop over \a n elements is split into.
+// \ingroup util
+//
+// \param n The number of iterations of the loop.
+// \param weight The number of elements processed per iteration.
+// \return The number of chunks, between 1 and the number of available hardware threads.
+*/
+inline std::size_t host_chunk_count( std::size_t n, std::size_t weight = 1UL )
+{
+#if defined(_OPENMP)
+   const std::size_t threads( omp_get_max_threads() );
+#else
+   const std::size_t threads( std::max( std::thread::hardware_concurrency(), 1U ) );
+#endif
+
+   return std::max( std::min( { threads, n, ( n * weight ) / host_min_chunk_size } ), std::size_t( 1 ) );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Host-side parallel loop used by the host execution backend.
+// \ingroup util
+//
+// \param n The number of iterations of the loop.
+// \param weight The number of elements processed per iteration.
+// \param f The chunk function, called as \c f(chunk,begin,end).
+// \return void
+//
+// The range \f$[0..n)\f$ is split into host_chunk_count(n,weight) contiguous chunks of near
+// equal size, which are processed in parallel either by an OpenMP team or by \c std::thread
+// workers. The partitioning only depends on \a n, \a weight and the thread count, which keeps
+// reductions built on top of it reproducible from one call to the next. The loop counts as a
+// kernel launch for the instrumentation (see CUDAInstrumentation).
+*/
+template< typename F >
+inline void host_parallel_for( std::size_t n, std::size_t weight, F const& f )
+{
+   if( n == 0UL ) return;
+
+   BLAZE_CUDA_COUNT( launches, 1UL );
+
+   const std::size_t chunks( host_chunk_count( n, weight ) );
+
+   auto run_chunk = [&]( std::size_t c ) {
+      f( c, ( c * n ) / chunks, ( ( c + 1UL ) * n ) / chunks );
+   };
+
+   if( chunks == 1UL ) {
+      run_chunk( 0UL );
+      return;
+   }
+
+#if defined(_OPENMP)
+   #pragma omp parallel for schedule(static)
+   for( std::ptrdiff_t c = 0; c < std::ptrdiff_t( chunks ); ++c ) {
+      run_chunk( c );
+   }
+#else
+   std::vector<std::thread> workers;
+   workers.reserve( chunks - 1UL );
+
+   for( std::size_t c = 1UL; c < chunks; ++c ) {
+      workers.emplace_back( run_chunk, c );
+   }
+
+   run_chunk( 0UL );
+
+   for( auto& w : workers ) {
+      w.join();
+   }
+#endif
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Host-side parallel loop over \a n single elements.
+// \ingroup util
+//
+// \param n The number of elements of the loop.
+// \param f The chunk function, called as \c f(chunk,begin,end).
+// \return void
+*/
+template< typename F >
+inline void host_parallel_for( std::size_t n, F const& f )
+{
+   host_parallel_for( n, 1UL, f );
+}
+//*************************************************************************************************
+
+}  // namespace blaze
+
+#endif
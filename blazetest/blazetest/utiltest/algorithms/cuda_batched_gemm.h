@@ -0,0 +1,220 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_batched_gemm.h
+//  \brief Tests for the batched CUDA matrix/matrix multiplication
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_BATCHED_GEMM_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_BATCHED_GEMM_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <blaze/Blaze.h>
+
+#include <blaze_cuda/math/cuda/BatchedGemm.h>
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDABatchedGemm.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_batched_gemm {
+
+// Small integers, so that all products are exact in floating point
+template<typename T>
+T value( std::size_t p, std::size_t i, std::size_t j, std::size_t seed )
+{
+   return T( int( ( p * 7 + i * 3 + j * 5 + seed ) % 9 ) - 4 );
+}
+
+// Product 'p' of 'C_p = alpha*A_p*B_p + beta*C_p', with C_p initialized to value( p, i, j, 2 )
+template<typename T>
+T reference( std::size_t p, std::size_t i, std::size_t j, std::size_t k, T alpha, T beta )
+{
+   T acc( 0 );
+   for( std::size_t l = 0; l < k; ++l )
+      acc += value<T>( p, i, l, 0 ) * value<T>( p, l, j, 1 );
+   return alpha * acc + beta * value<T>( p, i, j, 2 );
+}
+
+// Strided batches addressed through explicit row/column strides: A is row-major and B and C
+// are column-major, with a gap after every matrix that must be left untouched
+template<typename T>
+void test_case( std::size_t count, std::size_t m, std::size_t n, std::size_t k, T beta )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   size_t const sa = m * k + 1, sb = k * n + 2, sc = m * n + 3;
+   T const alpha( 2 );
+
+   vtype a( count * sa, T(0) ), b( count * sb, T(0) ), c( count * sc, T(-9) );
+
+   for( size_t p = 0; p < count; ++p ) {
+      for( size_t i = 0; i < m; ++i )
+         for( size_t l = 0; l < k; ++l )
+            a[p*sa+i*k+l] = value<T>( p, i, l, 0 );
+      for( size_t l = 0; l < k; ++l )
+         for( size_t j = 0; j < n; ++j )
+            b[p*sb+j*k+l] = value<T>( p, l, j, 1 );
+      for( size_t i = 0; i < m; ++i )
+         for( size_t j = 0; j < n; ++j )
+            c[p*sc+j*m+i] = value<T>( p, i, j, 2 );
+   }
+
+   blaze::cuda_gemm_batched_small( count, m, n, k, alpha
+                                 , blaze::CUDAStridedBatch<const T>{ a.data(), sa }, k, 1
+                                 , blaze::CUDAStridedBatch<const T>{ b.data(), sb }, 1, k
+                                 , beta
+                                 , blaze::CUDAStridedBatch<T>{ c.data(), sc }, 1, m );
+   blaze::cuda_synchronize();
+
+   for( size_t p = 0; p < count; ++p ) {
+      for( size_t i = 0; i < m; ++i ) {
+         for( size_t j = 0; j < n; ++j ) {
+            if( c[p*sc+j*m+i] != reference<T>( p, i, j, k, alpha, beta ) ) {
+               // TODO: Better error reporting
+               throw std::runtime_error( "Invalid batched gemm result.\n" );
+            }
+         }
+      }
+
+      for( size_t e = m * n; e < sc; ++e ) {
+         if( c[p*sc+e] != T(-9) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Batched gemm wrote between the matrices.\n" );
+         }
+      }
+   }
+}
+
+template<typename MT>
+void fill( MT& A, std::size_t p, std::size_t seed )
+{
+   for( std::size_t i = 0; i < A.rows(); ++i )
+      for( std::size_t j = 0; j < A.columns(); ++j )
+         A(i,j) = value<blaze::ElementType_t<MT>>( p, i, j, seed );
+}
+
+template<typename MT, typename T>
+void check( MT const& C, std::size_t p, std::size_t k, T alpha, T beta )
+{
+   for( std::size_t i = 0; i < C.rows(); ++i ) {
+      for( std::size_t j = 0; j < C.columns(); ++j ) {
+         if( C(i,j) != reference<T>( p, i, j, k, alpha, beta ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid batched_gemm result.\n" );
+         }
+      }
+   }
+}
+
+// batched_gemm() on matrix batches (strided) and on vectors of matrices (pointer arrays), both
+// below and above the size limit of the small matrix kernel
+template<typename T, bool SO1, bool SO2, bool SO3>
+void expression_test_case( std::size_t count, std::size_t m, std::size_t n, std::size_t k )
+{
+   using std::size_t;
+
+   T const alpha( 2 ), beta( 3 );
+
+   blaze::CUDAMatrixBatch<T,SO1> C( count, m, n );
+   blaze::CUDAMatrixBatch<T,SO2> A( count, m, k );
+   blaze::CUDAMatrixBatch<T,SO3> B( count, k, n );
+
+   std::vector< blaze::CUDADynamicMatrix<T,SO1> > Cs( count, blaze::CUDADynamicMatrix<T,SO1>( m, n ) );
+   std::vector< blaze::CUDADynamicMatrix<T,SO2> > As( count, blaze::CUDADynamicMatrix<T,SO2>( m, k ) );
+   std::vector< blaze::CUDADynamicMatrix<T,SO3> > Bs( count, blaze::CUDADynamicMatrix<T,SO3>( k, n ) );
+
+   for( size_t p = 0; p < count; ++p ) {
+      auto Cp( C[p] );
+      auto Ap( A[p] );
+      auto Bp( B[p] );
+      fill( Cp, p, 2 ); fill( Cs[p], p, 2 );
+      fill( Ap, p, 0 ); fill( As[p], p, 0 );
+      fill( Bp, p, 1 ); fill( Bs[p], p, 1 );
+   }
+
+   blaze::batched_gemm( C, A, B, alpha, beta );
+   blaze::batched_gemm( Cs, As, Bs, alpha, beta );
+   blaze::cuda_synchronize();
+
+   for( size_t p = 0; p < count; ++p ) {
+      check( C[p], p, k, alpha, beta );
+      check( Cs[p], p, k, alpha, beta );
+   }
+
+   blaze::CUDAMatrixBatch<T,SO1> D( count, m, n + 1 );
+
+   try {
+      blaze::batched_gemm( D, A, B );
+   }
+   catch( std::invalid_argument& ) {
+      return;
+   }
+
+   // TODO: Better error reporting
+   throw std::runtime_error( "Mismatching batched_gemm sizes were not detected.\n" );
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( auto const& count : { 0, 1, 5, 300 } ) {
+      test_case<T>( count, 1, 1, 1, T(0) );
+      test_case<T>( count, 8, 8, 8, T(0) );
+      test_case<T>( count, 3, 7, 5, T(3) );
+      test_case<T>( count, 32, 32, 32, T(3) );
+      test_case<T>( count, 32, 1, 17, T(0) );
+      test_case<T>( count, 4, 4, 0, T(3) );
+   }
+
+   for( auto const& s : { 8, 16, 33, 64 } ) {
+      expression_test_case<T, blaze::rowMajor   , blaze::rowMajor   , blaze::rowMajor   >( 50, s, s, s );
+      expression_test_case<T, blaze::columnMajor, blaze::columnMajor, blaze::columnMajor>( 50, s, s, s );
+      expression_test_case<T, blaze::rowMajor   , blaze::columnMajor, blaze::rowMajor   >( 20, s, s + 3, s - 1 );
+      expression_test_case<T, blaze::columnMajor, blaze::rowMajor   , blaze::columnMajor>( 20, s + 1, s, s );
+   }
+}
+
+} // cuda_batched_gemm
+
+} // utiltest
+
+} // blazetest
+
+#endif
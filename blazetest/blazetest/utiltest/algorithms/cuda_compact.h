@@ -0,0 +1,156 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_compact.h
+//  \brief Test cases for the CUDA counting and stream compaction algorithms
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_COMPACT_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_COMPACT_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <blaze/Blaze.h>
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/math/cuda/Compact.h>
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDACompact.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_compact {
+
+template<typename T>
+void test_case( std::size_t size )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+   using itype = blaze::CUDADynamicVector<size_t>;
+
+   auto const pred = [] BLAZE_DEVICE_CALLABLE ( T const& x ) { return x > T(4); };
+
+   vtype a( size );
+
+   size_t ref_nnz( 0 ), ref_count( 0 );
+
+   for( size_t i = 0; i < size; ++i ) {
+      a[i] = T( ( 5*i ) % 7 );
+      ref_nnz   += a[i] != T(0) ? 1 : 0;
+      ref_count += a[i] > T(4) ? 1 : 0;
+   }
+
+   if( a.nonZeros() != ref_nnz || blaze::cuda_count_if( a.begin(), a.end(), pred ) != ref_count ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid count.\n" );
+   }
+
+   vtype values( size );
+   itype indices( size );
+
+   size_t const nvalues ( blaze::cuda_copy_if( a.begin(), a.end(), values.begin(), pred ) );
+   size_t const nindices( blaze::cuda_copy_index_if( a.begin(), a.end(), indices.begin(), pred ) );
+
+   vtype const c( blaze::compact( a, pred ) );
+   itype const f( blaze::find_indices( a, pred ) );
+   blaze::cuda_synchronize();
+
+   if( nvalues != ref_count || nindices != ref_count || c.size() != ref_count || f.size() != ref_count ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid compaction size.\n" );
+   }
+
+   for( size_t i = 0, k = 0; i < size; ++i ) {
+      if( a[i] > T(4) ) {
+         if( indices[k] != i || f[k] != i || values[k] != a[i] || c[k] != a[i] ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid compaction result.\n" );
+         }
+         ++k;
+      }
+   }
+}
+
+template<typename T, bool SO>
+void matrix_test_case( std::size_t m, std::size_t n )
+{
+   using std::size_t;
+
+   // Matrix type parameters
+   using mtype = blaze::CUDADynamicMatrix<T,SO>;
+
+   mtype A( m, n );
+
+   size_t ref( 0 );
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         A(i,j) = T( ( 7*i + 3*j ) % 5 );
+         ref += A(i,j) != T(0) ? 1 : 0;
+      }
+   }
+
+   size_t lines( 0 );
+
+   for( size_t k = 0; k < ( SO == blaze::rowMajor ? m : n ); ++k )
+      lines += A.nonZeros( k );
+
+   if( A.nonZeros() != ref || lines != ref ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid number of non-zero elements.\n" );
+   }
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( auto const& size : { 0, 1, 7, 256, 257, 1000, 2048 + 7, 100000, 3000000 } )
+      test_case<T>( size );
+
+   for( auto const& s : { 1, 17, 300 } ) {
+      matrix_test_case<T, blaze::rowMajor   >( s, 2*s + 1 );
+      matrix_test_case<T, blaze::columnMajor>( s, 2*s + 1 );
+   }
+}
+
+} // cuda_compact
+
+} // utiltest
+
+} // blazetest
+
+#endif
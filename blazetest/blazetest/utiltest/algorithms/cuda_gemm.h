@@ -0,0 +1,353 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_gemm.h
+//  \brief Tests for the CUDA matrix/matrix multiplication with epilogue
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_GEMM_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_GEMM_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <blaze/Blaze.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDAGemm.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_gemm {
+
+// Small integers, so that all products are exact in floating point
+template<typename T>
+T value( std::size_t i, std::size_t j, std::size_t seed )
+{
+   return T( int( ( i * 3 + j * 5 + seed ) % 9 ) - 4 );
+}
+
+template<typename T>
+T product( std::size_t i, std::size_t j, std::size_t k )
+{
+   T acc( 0 );
+   for( std::size_t l = 0; l < k; ++l )
+      acc += value<T>( i, l, 0 ) * value<T>( l, j, 1 );
+   return acc;
+}
+
+struct relu_op
+{
+   template<typename T>
+   BLAZE_DEVICE_CALLABLE T operator()( T const& x ) const { return x < T(0) ? T(0) : x; }
+};
+
+struct max_op
+{
+   template<typename T>
+   BLAZE_DEVICE_CALLABLE T operator()( T const& x, T const& y ) const { return x < y ? y : x; }
+};
+
+// 'relu( alpha*acc + bias[j] )', a typical fully connected layer
+template<typename T>
+struct bias_relu_epilogue
+{
+   T const* bias;
+   T alpha;
+
+   BLAZE_DEVICE_CALLABLE T operator()( std::size_t, std::size_t j, T const& acc ) const {
+      return relu_op()( alpha * acc + bias[j] );
+   }
+};
+
+// Operands and output addressed through explicit strides: 'so' selects the storage order of
+// A, B and the output bit by bit
+template<typename T>
+void test_case( std::size_t m, std::size_t n, std::size_t k, unsigned so )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   size_t const a_rs = ( so & 1U ) ? 1 : k, a_cs = ( so & 1U ) ? m : 1;
+   size_t const b_rs = ( so & 2U ) ? 1 : n, b_cs = ( so & 2U ) ? k : 1;
+   size_t const c_rs = ( so & 4U ) ? 1 : n, c_cs = ( so & 4U ) ? m : 1;
+
+   vtype a( m * k ), b( k * n ), c( m * n, T(-9) ), bias( n );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t l = 0; l < k; ++l )
+         a[i*a_rs+l*a_cs] = value<T>( i, l, 0 );
+   for( size_t l = 0; l < k; ++l )
+      for( size_t j = 0; j < n; ++j )
+         b[l*b_rs+j*b_cs] = value<T>( l, j, 1 );
+   for( size_t j = 0; j < n; ++j )
+      bias[j] = value<T>( 0, j, 2 );
+
+   blaze::cuda_gemm( m, n, k, a.data(), a_rs, a_cs, b.data(), b_rs, b_cs, c.data(), c_rs, c_cs
+                   , bias_relu_epilogue<T>{ bias.data(), T(2) } );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         if( c[i*c_rs+j*c_cs] != relu_op()( T(2) * product<T>( i, j, k ) + bias[j] ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid gemm result.\n" );
+         }
+      }
+   }
+}
+
+template<typename MT, typename F>
+void check( MT const& C, F const& reference )
+{
+   for( std::size_t i = 0; i < C.rows(); ++i ) {
+      for( std::size_t j = 0; j < C.columns(); ++j ) {
+         if( C(i,j) != reference( i, j ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid fused gemm result.\n" );
+         }
+      }
+   }
+}
+
+// Products with scaling, addends and maps assigned to CUDA matrices of either storage order
+template<typename T, bool SO>
+void expression_test_case( std::size_t m, std::size_t n, std::size_t k )
+{
+   using std::size_t;
+
+   blaze::CUDADynamicMatrix<T,blaze::rowMajor> A( m, k ), B( k, n );
+   blaze::CUDADynamicMatrix<T,SO> C( m, n ), D( m, n );
+   blaze::CUDADynamicVector<T,blaze::rowVector> bias( n );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t l = 0; l < k; ++l )
+         A(i,l) = value<T>( i, l, 0 );
+   for( size_t l = 0; l < k; ++l )
+      for( size_t j = 0; j < n; ++j )
+         B(l,j) = value<T>( l, j, 1 );
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         D(i,j) = value<T>( i, j, 3 );
+   for( size_t j = 0; j < n; ++j )
+      bias[j] = value<T>( 0, j, 2 );
+
+   C = blaze::map( A * B + blaze::expand( bias, m ), relu_op() );
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return relu_op()( product<T>( i, j, k ) + bias[j] ); } );
+
+   C = blaze::map( T(3) * ( A * B ), relu_op() );
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return relu_op()( T(3) * product<T>( i, j, k ) ); } );
+
+   C = T(2) * ( A * B ) + D;
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return T(2) * product<T>( i, j, k ) + D(i,j); } );
+
+   C = D - A * B;
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return D(i,j) - product<T>( i, j, k ); } );
+
+   C = A * B - C;
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return T(2) * product<T>( i, j, k ) - D(i,j); } );
+
+   C += T(2) * ( A * B );
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return T(4) * product<T>( i, j, k ) - D(i,j); } );
+}
+
+// Products of operands of all storage orders, assigned to targets of either storage order,
+// and the matrix/vector products of both storage orders
+template<typename T, bool SO1, bool SO2, bool SO3>
+void storage_order_test_case( std::size_t m, std::size_t n, std::size_t k )
+{
+   using std::size_t;
+
+   blaze::CUDADynamicMatrix<T,SO2> A( m, k ), D( m, n );
+   blaze::CUDADynamicMatrix<T,SO3> B( k, n );
+   blaze::CUDADynamicMatrix<T,SO1> C( m, n );
+   blaze::CUDADynamicVector<T,blaze::columnVector> x( k ), y( m );
+   blaze::CUDADynamicVector<T,blaze::rowVector> z( m ), w( k );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t l = 0; l < k; ++l )
+         A(i,l) = value<T>( i, l, 0 );
+   for( size_t l = 0; l < k; ++l )
+      for( size_t j = 0; j < n; ++j )
+         B(l,j) = value<T>( l, j, 1 );
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         D(i,j) = value<T>( i, j, 3 );
+   for( size_t l = 0; l < k; ++l )
+      x[l] = value<T>( l, 0, 1 );
+   for( size_t i = 0; i < m; ++i )
+      z[i] = value<T>( 0, i, 0 );
+
+   C = A * B;
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return product<T>( i, j, k ); } );
+
+   C += A * B;
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return T(2) * product<T>( i, j, k ); } );
+
+   C -= T(3) * ( A * B );
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return -product<T>( i, j, k ); } );
+
+   C = blaze::map( A * B - D, relu_op() );
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return relu_op()( product<T>( i, j, k ) - D(i,j) ); } );
+
+   // Fused expressions, of the storage order of D, evaluated into C
+   C = blaze::map( A * B, D, max_op() );
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return max_op()( product<T>( i, j, k ), D(i,j) ); } );
+
+   C -= blaze::map( A * B, D, max_op() );
+   blaze::cuda_synchronize();
+   check( C, []( size_t, size_t ) { return T(0); } );
+
+   y = A * x;
+   w = z * A;
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      T ref( 0 );
+      for( size_t l = 0; l < k; ++l )
+         ref += A(i,l) * x[l];
+      if( y[i] != ref ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid matrix/vector product.\n" );
+      }
+   }
+
+   for( size_t l = 0; l < k; ++l ) {
+      T ref( 0 );
+      for( size_t i = 0; i < m; ++i )
+         ref += z[i] * A(i,l);
+      if( w[l] != ref ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid vector/matrix product.\n" );
+      }
+   }
+}
+
+// Gram matrices, computed by a rank-k update of one triangle followed by the mirror kernel
+template<typename T, bool SO1, bool SO2>
+void gram_test_case( std::size_t n, std::size_t k )
+{
+   using std::size_t;
+
+   blaze::CUDADynamicMatrix<T,SO2> A( n, k );
+   blaze::CUDADynamicMatrix<T,SO1> C( n, n ), D( k, k );
+
+   for( size_t i = 0; i < n; ++i )
+      for( size_t l = 0; l < k; ++l )
+         A(i,l) = value<T>( i, l, 0 );
+
+   const auto gram = [&]( size_t i, size_t j ) {
+      T acc( 0 );
+      for( size_t l = 0; l < k; ++l )
+         acc += A(i,l) * A(j,l);
+      return acc;
+   };
+
+   C = A * blaze::trans( A );
+   blaze::cuda_synchronize();
+   check( C, gram );
+
+   C = blaze::declsym( A * blaze::trans( A ) );
+   blaze::cuda_synchronize();
+   check( C, gram );
+
+   C = T(2) * ( A * blaze::trans( A ) );
+   blaze::cuda_synchronize();
+   check( C, [&]( size_t i, size_t j ) { return T(2) * gram( i, j ); } );
+
+   D = blaze::trans( A ) * A;
+   blaze::cuda_synchronize();
+   check( D, [&]( size_t i, size_t j ) {
+      T acc( 0 );
+      for( size_t l = 0; l < n; ++l )
+         acc += A(l,i) * A(l,j);
+      return acc;
+   } );
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( unsigned so = 0; so < 8; ++so ) {
+      test_case<T>( 1, 1, 1, so );
+      test_case<T>( 64, 64, 16, so );
+      test_case<T>( 65, 130, 17, so );
+      test_case<T>( 7, 3, 100, so );
+      test_case<T>( 5, 9, 0, so );
+   }
+
+   for( auto const& s : { 1, 16, 63, 100 } ) {
+      expression_test_case<T, blaze::rowMajor   >( s, s, s );
+      expression_test_case<T, blaze::columnMajor>( s, s, s );
+      expression_test_case<T, blaze::rowMajor   >( s + 1, s + 5, s + 2 );
+      expression_test_case<T, blaze::columnMajor>( s + 3, s, s + 1 );
+   }
+
+   for( auto const& s : { 1, 17, 64 } ) {
+      storage_order_test_case<T, blaze::rowMajor   , blaze::rowMajor   , blaze::columnMajor>( s, s + 2, s + 5 );
+      storage_order_test_case<T, blaze::rowMajor   , blaze::columnMajor, blaze::rowMajor   >( s, s + 2, s + 5 );
+      storage_order_test_case<T, blaze::rowMajor   , blaze::columnMajor, blaze::columnMajor>( s, s + 2, s + 5 );
+      storage_order_test_case<T, blaze::columnMajor, blaze::rowMajor   , blaze::rowMajor   >( s + 3, s, s + 1 );
+      storage_order_test_case<T, blaze::columnMajor, blaze::rowMajor   , blaze::columnMajor>( s + 3, s, s + 1 );
+      storage_order_test_case<T, blaze::columnMajor, blaze::columnMajor, blaze::rowMajor   >( s + 3, s, s + 1 );
+      storage_order_test_case<T, blaze::columnMajor, blaze::columnMajor, blaze::columnMajor>( s + 3, s, s + 1 );
+   }
+
+   for( auto const& s : { 1, 31, 70 } ) {
+      gram_test_case<T, blaze::rowMajor   , blaze::rowMajor   >( s, s + 9 );
+      gram_test_case<T, blaze::rowMajor   , blaze::columnMajor>( s + 9, s );
+      gram_test_case<T, blaze::columnMajor, blaze::rowMajor   >( s + 9, s );
+      gram_test_case<T, blaze::columnMajor, blaze::columnMajor>( s, s + 9 );
+   }
+}
+
+} // cuda_gemm
+
+} // utiltest
+
+} // blazetest
+
+#endif
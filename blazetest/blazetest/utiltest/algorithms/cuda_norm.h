@@ -0,0 +1,226 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_norm.h
+//  \brief Tests for the CUDA norm reductions
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_NORM_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_NORM_H_
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include <blaze/Blaze.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/math/expressions/DMatNormExpr.h>
+#include <blaze_cuda/math/expressions/DVecNormExpr.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/CUDAValue.h>
+#include <blaze_cuda/util/algorithms/CUDANorm.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_norm {
+
+template<typename T>
+T value( std::size_t i, std::size_t j )
+{
+   return T( int( ( 7*i + 3*j ) % 11 ) - 5 ) / T( 2 );
+}
+
+template<typename T>
+bool close( T x, T ref )
+{
+   T const eps = sizeof(T) < sizeof(double) ? T( 1e-4 ) : T( 1e-12 );
+   return std::abs( x - ref ) <= eps * ( T( 1 ) + std::abs( ref ) );
+}
+
+// Reference norms of an m x n block
+template<typename T>
+struct reference
+{
+   T l1 = 0, sqr = 0, max = 0, l3 = 0;
+
+   reference( std::size_t m, std::size_t n )
+   {
+      double l1_( 0 ), sqr_( 0 ), max_( 0 ), l3_( 0 );
+
+      for( std::size_t i = 0; i < m; ++i ) {
+         for( std::size_t j = 0; j < n; ++j ) {
+            double const a = std::abs( double( value<T>( i, j ) ) );
+            l1_ += a; sqr_ += a*a; l3_ += a*a*a;
+            max_ = std::max( max_, a );
+         }
+      }
+
+      l1 = T( l1_ ); sqr = T( sqr_ ); max = T( max_ ); l3 = T( std::cbrt( l3_ ) );
+   }
+};
+
+// Norms of an m x n block stored with spacing 'sp' whose padding is filled with a value larger
+// than any element, which must never be read.
+template<typename T>
+void test_case( std::size_t m, std::size_t n, std::size_t sp )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype a( m * sp, T(100) ), c( m * n );
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         a[i*sp+j] = value<T>( i, j );
+         c[i*n+j]  = value<T>( i, j );
+      }
+   }
+
+   blaze::CUDAManagedValue<T> l2;
+
+   blaze::cuda_norm_2d_into( m, n, a.begin(), sp, blaze::CUDAL2Norm<T>(), l2.ptr() );
+   T const l1  = blaze::cuda_norm_2d( m, n, a.begin(), sp, blaze::CUDAL1Norm<T>() );
+   T const max = blaze::cuda_norm_2d( m, n, a.begin(), sp, blaze::CUDAMaxNorm<T>() );
+   T const sqr = blaze::cuda_norm( c.begin(), c.end(), blaze::CUDASqrNorm<T>() );
+   T const l3  = blaze::cuda_norm( c.begin(), c.end(), blaze::CUDALpNorm<T>{ T(3) } );
+   blaze::cuda_synchronize();
+
+   reference<T> const ref( m, n );
+
+   if( !close( *l2, T( std::sqrt( ref.sqr ) ) ) || !close( l1, ref.l1 ) || max != ref.max ||
+       !close( sqr, ref.sqr ) || !close( l3, ref.l3 ) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid norm result.\n" );
+   }
+}
+
+// The scaled Euclidean norm neither overflows nor underflows
+template<typename T>
+void scaling_test_case( std::size_t size )
+{
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   T const large = std::sqrt( std::numeric_limits<T>::max() );
+   T const small = std::numeric_limits<T>::min();
+
+   vtype a( size, large ), b( size, small );
+
+   T const na = blaze::cuda_norm( a.begin(), a.end(), blaze::CUDAL2Norm<T>() );
+   T const nb = blaze::cuda_norm( b.begin(), b.end(), blaze::CUDAL2Norm<T>() );
+
+   if( !close( na / large, T( std::sqrt( T( size ) ) ) ) ||
+       !close( nb / small, T( std::sqrt( T( size ) ) ) ) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid scaled norm result.\n" );
+   }
+}
+
+// Norms of vectors and of matrices of both storage orders
+template<typename T, bool SO>
+void expression_test_case( std::size_t m, std::size_t n )
+{
+   using std::size_t;
+
+   // Matrix and vector type parameters
+   using mtype = blaze::CUDADynamicMatrix<T,SO>;
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   mtype A( m, n );
+   vtype v( m * n );
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         A(i,j)   = value<T>( i, j );
+         v[i*n+j] = value<T>( i, j );
+      }
+   }
+
+   reference<T> const ref( m, n );
+
+   if( !close( blaze::norm( v ), T( std::sqrt( ref.sqr ) ) ) || !close( blaze::sqrNorm( v ), ref.sqr ) ||
+       !close( blaze::l1Norm( v ), ref.l1 ) || blaze::maxNorm( v ) != ref.max ||
+       !close( blaze::lpNorm<3>( v ), ref.l3 ) || !close( blaze::lpNorm( v, 3 ), ref.l3 ) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid vector norm.\n" );
+   }
+
+   if( !close( blaze::norm( A ), T( std::sqrt( ref.sqr ) ) ) || !close( blaze::sqrNorm( A ), ref.sqr ) ||
+       !close( blaze::l1Norm( A ), ref.l1 ) || blaze::maxNorm( A ) != ref.max ||
+       !close( blaze::l3Norm( A ), ref.l3 ) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid matrix norm.\n" );
+   }
+
+   blaze::CUDAManagedValue<T> vnorm, anorm;
+
+   blaze::norm( v, vnorm.ptr() );
+   blaze::l1Norm( A, anorm.ptr() );
+   blaze::cuda_synchronize();
+
+   if( !close( *vnorm, T( std::sqrt( ref.sqr ) ) ) || !close( *anorm, ref.l1 ) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid device norm.\n" );
+   }
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( auto const& m : { 0, 1, 5, 33, 300, 5000 } ) {
+      for( auto const& n : { 0, 1, 3, 32, 100, 1500 } ) {
+         test_case<T>( m, n, n );
+         test_case<T>( m, n, n + 5 );
+      }
+   }
+
+   for( auto const& s : { 1, 1000, 1000000 } ) {
+      scaling_test_case<T>( s );
+   }
+
+   for( auto const& s : { 1, 17, 300 } ) {
+      expression_test_case<T, blaze::rowMajor   >( s, 2*s + 1 );
+      expression_test_case<T, blaze::columnMajor>( s, 2*s + 1 );
+   }
+}
+
+} // cuda_norm
+
+} // utiltest
+
+} // blazetest
+
+#endif
@@ -0,0 +1,168 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_packed_transform.h
+//  \brief Test cases for the CUDA packed transform and packed assignments
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_PACKED_TRANSFORM_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_PACKED_TRANSFORM_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <blaze/Blaze.h>
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDAPackedTransform.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_packed_transform {
+
+template< typename T >
+struct Axpy
+{
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& x, T const& y ) const { return T(2) * x + y; }
+};
+
+template< typename T >
+struct Triple
+{
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& x ) const { return T(3) * x; }
+};
+
+// Ranges starting at the given offsets from an aligned allocation, to cover the head and tail
+// elements as well as ranges whose alignments differ
+template<typename T>
+void test_case( std::size_t size, std::size_t out_offset, std::size_t in_offset )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype x( size + 4 ), y( size + 4 ), z( size + 4, T(-1) );
+
+   for( size_t i = 0; i < size + 4; ++i ) {
+      x[i] = T( i % 13 );
+      y[i] = T( i % 5 );
+   }
+
+   blaze::cuda_packed_transform( size, z.data() + out_offset, Axpy<T>()
+                               , static_cast<T const*>( x.data() + in_offset )
+                               , static_cast<T const*>( y.data() + out_offset ) );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < size + 4; ++i ) {
+      bool const inside = i >= out_offset && i < out_offset + size;
+      T const ref = inside ? T(2) * x[ i - out_offset + in_offset ] + y[i] : T(-1);
+
+      if( z[i] != ref ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid packed transform result.\n" );
+      }
+   }
+}
+
+template<typename T>
+void assign_test_case( std::size_t size )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+   using mtype = blaze::CUDADynamicMatrix<T>;
+
+   vtype a( size ), b( size ), c( size );
+
+   for( size_t i = 0; i < size; ++i ) {
+      a[i] = T( i % 7 );
+      b[i] = T( i % 3 );
+   }
+
+   c = blaze::map( a, Triple<T>() );
+   c += a + b;
+   c -= a * b;
+
+   for( size_t i = 0; i < size; ++i ) {
+      if( c[i] != T(3) * a[i] + a[i] + b[i] - a[i] * b[i] ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid packed vector assignment.\n" );
+      }
+   }
+
+   // Unpadded and padded matrices
+   for( size_t n : { size_t( 4 ), size_t( 5 ) } )
+   {
+      mtype A( size, n ), B( size, n );
+
+      for( size_t i = 0; i < size; ++i )
+         for( size_t j = 0; j < n; ++j )
+            A(i,j) = T( ( i + j ) % 7 );
+
+      B = blaze::map( A, Triple<T>() );
+      B += A;
+
+      for( size_t i = 0; i < size; ++i )
+         for( size_t j = 0; j < n; ++j )
+            if( B(i,j) != T(4) * A(i,j) ) {
+               // TODO: Better error reporting
+               throw std::runtime_error( "Invalid packed matrix assignment.\n" );
+            }
+   }
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( auto const& size : { 0, 1, 3, 7, 256, 1000, 100000, 3000001 } ) {
+      test_case<T>( size, 0, 0 );
+      test_case<T>( size, 1, 1 );
+      test_case<T>( size, 3, 3 );
+      test_case<T>( size, 0, 1 );
+   }
+
+   for( auto const& size : { 0, 1, 7, 1000, 100000 } )
+      assign_test_case<T>( size );
+}
+
+} // cuda_packed_transform
+
+} // utiltest
+
+} // blazetest
+
+#endif
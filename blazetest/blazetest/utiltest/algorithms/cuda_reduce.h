@@ -1,7 +1,7 @@
 //=================================================================================================
 /*!
-//  \file src/utiltest/alignedallocator/ClassTest.cpp
-//  \brief Source file for the AlignedAllocator class test
+//  \file blazetest/utiltest/algorithms/cuda_reduce.h
+//  \brief Test cases for the cuda_reduce algorithm
 //
 //  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
 //
@@ -40,6 +40,7 @@
 #include <stdexcept>
 
 #include <blaze/Blaze.h>
+#include <blaze/system/HostDevice.h>
 
 #include <blaze_cuda/math/dense/CUDADynamicVector.h>
 #include <blaze_cuda/util/algorithms/CUDAReduce.h>
@@ -71,7 +72,7 @@ void propagation_test_case(std::size_t size)
 
    // Checking that elements get reduced correctly
    auto val = blaze::cuda_reduce < U, B > ( a.begin(), a.end(), T(1)
-      , [] __device__ ( T const& a, T const& b ) { return a * b; } );
+      , [] BLAZE_DEVICE_CALLABLE ( T const& a, T const& b ) { return a * b; } );
 
    for(auto const& v : a) if( v != T(1) ) {
       // TODO: Better error reporting
@@ -104,7 +105,7 @@ void count_test_case(std::size_t size)
 
    // Checking that elements get reduced correctly
    auto val = blaze::cuda_reduce < U, B > ( a.begin(), a.end(), T(0)
-      , [] __device__ ( T const& a, T const& b ) { return a + b; } );
+      , [] BLAZE_DEVICE_CALLABLE ( T const& a, T const& b ) { return a + b; } );
 
    for(auto const& v : a) if( v != T(1) ) {
       // TODO: Better error reporting
@@ -117,11 +118,45 @@ void count_test_case(std::size_t size)
    }
 }
 
+template<typename T, std::size_t U, std::size_t B>
+void workspace_test_case(std::size_t size)
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype a( size, T(1) );
+
+   auto const sum = [] BLAZE_DEVICE_CALLABLE ( T const& a, T const& b ) { return a + b; };
+
+   // Few blocks, so that every block reduces several slices; reused across calls
+   blaze::CUDAReduceWorkspace<T> workspace( 3 );
+
+   for( size_t i = 0; i < 3; ++i ) {
+      auto val = blaze::cuda_reduce < U, B > ( a.begin(), a.end(), T(0), sum, workspace );
+
+      if( val != T( size ) ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid workspace result.\n" );
+      }
+   }
+
+   // Result kept on the device
+   blaze::cuda_reduce_into < U, B > ( a.begin(), a.end(), T(0), sum, workspace.result(), workspace );
+
+   if( workspace.value() != T( size ) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid device scalar result.\n" );
+   }
+}
+
 template<typename T, std::size_t U, std::size_t B>
 void test_case( std::size_t size )
 {
    propagation_test_case< T, U, B >( size );
    count_test_case< T, U, B >( size );
+   workspace_test_case< T, U, B >( size );
 }
 
 template<typename T>
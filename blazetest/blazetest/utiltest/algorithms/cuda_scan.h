@@ -0,0 +1,148 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_scan.h
+//  \brief Test cases for the CUDA scan algorithms
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_SCAN_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_SCAN_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <blaze/Blaze.h>
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/math/cuda/Scan.h>
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDAScan.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_scan {
+
+template<typename T>
+void test_case( std::size_t size )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   auto const add = [] BLAZE_DEVICE_CALLABLE ( T const& x, T const& y ) { return x + y; };
+
+   vtype a( size ), inc( size ), exc( size ), inplace( size );
+
+   for( size_t i = 0; i < size; ++i ) {
+      a[i] = T( i % 7 );
+      inplace[i] = a[i];
+   }
+
+   blaze::cuda_inclusive_scan( a.begin(), a.end(), inc.begin(), add );
+   blaze::cuda_exclusive_scan( a.begin(), a.end(), exc.begin(), T(3), add );
+   blaze::cuda_inclusive_scan( inplace.begin(), inplace.end(), inplace.begin(), add );
+   vtype const sums( blaze::cumsum( a ) );
+   blaze::cuda_synchronize();
+
+   T acc( 3 );
+
+   for( size_t i = 0; i < size; ++i ) {
+      if( exc[i] != acc ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid exclusive scan result.\n" );
+      }
+
+      acc += a[i];
+
+      if( inc[i] != acc - T(3) || inplace[i] != inc[i] || sums[i] != inc[i] ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid inclusive scan result.\n" );
+      }
+   }
+}
+
+// Row-wise and column-wise cumulative sums of matrices of both storage orders
+template<typename T, bool SO>
+void matrix_test_case( std::size_t m, std::size_t n )
+{
+   using std::size_t;
+
+   // Matrix type parameters
+   using mtype = blaze::CUDADynamicMatrix<T,SO>;
+
+   mtype A( m, n );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         A(i,j) = T( ( 7*i + 3*j ) % 11 );
+
+   mtype const R( blaze::cumsum<blaze::rowwise>( A ) );
+   mtype const C( blaze::cumsum<blaze::columnwise>( A ) );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         T rref( 0 ), cref( 0 );
+
+         for( size_t k = 0; k <= j; ++k ) rref += A(i,k);
+         for( size_t k = 0; k <= i; ++k ) cref += A(k,j);
+
+         if( R(i,j) != rref || C(i,j) != cref ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid cumulative sum.\n" );
+         }
+      }
+   }
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( auto const& size : { 0, 1, 7, 256, 257, 1000, 2048 + 7, 100000, 3000000 } )
+      test_case<T>( size );
+
+   for( auto const& s : { 1, 17, 300 } ) {
+      matrix_test_case<T, blaze::rowMajor   >( s, 2*s + 1 );
+      matrix_test_case<T, blaze::columnMajor>( s, 2*s + 1 );
+   }
+}
+
+} // cuda_scan
+
+} // utiltest
+
+} // blazetest
+
+#endif
@@ -0,0 +1,205 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_segmented_reduce.h
+//  \brief Tests for the CUDA segmented and 2D reductions
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_SEGMENTED_REDUCE_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_SEGMENTED_REDUCE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+#include <blaze/Blaze.h>
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/math/expressions/DMatReduceExpr.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDASegmentedReduce.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_segmented_reduce {
+
+template<typename T>
+T value( std::size_t i, std::size_t j )
+{
+   return T( ( 7*i + 3*j ) % 11 );
+}
+
+// Reduces an m x n block stored with spacing 'sp' whose padding is filled with a value larger
+// than any element, which must never be read.
+template<typename T>
+void test_case( std::size_t m, std::size_t n, std::size_t sp )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   auto const add = [] BLAZE_DEVICE_CALLABLE ( T const& x, T const& y ) { return x + y; };
+   auto const max = [] BLAZE_DEVICE_CALLABLE ( T const& x, T const& y ) { return x < y ? y : x; };
+
+   vtype a( m * sp, T(100) );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         a[i*sp+j] = value<T>( i, j );
+
+   vtype rsum( m, T(-1) ), rmax( m, T(-1) ), csum( n, T(-1) ), cmax( n, T(-1) );
+
+   blaze::cuda_reduce_segments( m, n, a.begin(), sp, rsum.begin(), add );
+   blaze::cuda_reduce_segments( m, n, a.begin(), sp, rmax.begin(), max );
+   blaze::cuda_reduce_strided ( m, n, a.begin(), sp, csum.begin(), add );
+   blaze::cuda_reduce_strided ( m, n, a.begin(), sp, cmax.begin(), max );
+   T const total = blaze::cuda_reduce_2d( m, n, a.begin(), sp, T(0), add );
+   blaze::cuda_synchronize();
+
+   T ref_total( 0 );
+
+   for( size_t i = 0; i < m; ++i ) {
+      T ref_sum( value<T>( i, 0 ) ), ref_max( value<T>( i, 0 ) );
+
+      for( size_t j = 1; j < n; ++j ) {
+         ref_sum += value<T>( i, j );
+         ref_max = std::max( ref_max, value<T>( i, j ) );
+      }
+
+      if( n > 0 && ( rsum[i] != ref_sum || rmax[i] != ref_max ) ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid segmented reduction result.\n" );
+      }
+
+      ref_total += n > 0 ? ref_sum : T(0);
+   }
+
+   for( size_t j = 0; j < n; ++j ) {
+      T ref_sum( value<T>( 0, j ) ), ref_max( value<T>( 0, j ) );
+
+      for( size_t i = 1; i < m; ++i ) {
+         ref_sum += value<T>( i, j );
+         ref_max = std::max( ref_max, value<T>( i, j ) );
+      }
+
+      if( m > 0 && ( csum[j] != ref_sum || cmax[j] != ref_max ) ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid strided reduction result.\n" );
+      }
+   }
+
+   if( total != ref_total ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid 2D reduction result.\n" );
+   }
+}
+
+// Partial and total reductions of matrices of both storage orders
+template<typename T, bool SO>
+void expression_test_case( std::size_t m, std::size_t n )
+{
+   using std::size_t;
+
+   // Matrix and vector type parameters
+   using mtype = blaze::CUDADynamicMatrix<T,SO>;
+   using ctype = blaze::CUDADynamicVector<T,blaze::columnVector>;
+   using rtype = blaze::CUDADynamicVector<T,blaze::rowVector>;
+
+   mtype A( m, n );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         A(i,j) = value<T>( i, j );
+
+   ctype rows = blaze::sum<blaze::rowwise>( A );
+   rtype cols = blaze::sum<blaze::columnwise>( A );
+   T const total = blaze::sum( A );
+   blaze::cuda_synchronize();
+
+   T ref_total( 0 );
+
+   for( size_t i = 0; i < m; ++i ) {
+      T ref( 0 );
+      for( size_t j = 0; j < n; ++j )
+         ref += value<T>( i, j );
+
+      if( rows[i] != ref ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid rowwise reduction result.\n" );
+      }
+
+      ref_total += ref;
+   }
+
+   for( size_t j = 0; j < n; ++j ) {
+      T ref( 0 );
+      for( size_t i = 0; i < m; ++i )
+         ref += value<T>( i, j );
+
+      if( cols[j] != ref ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid columnwise reduction result.\n" );
+      }
+   }
+
+   if( total != ref_total ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid total reduction result.\n" );
+   }
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( auto const& m : { 0, 1, 5, 33, 300, 5000 } ) {
+      for( auto const& n : { 0, 1, 3, 32, 100, 1500 } ) {
+         test_case<T>( m, n, n );
+         test_case<T>( m, n, n + 5 );
+      }
+   }
+
+   for( auto const& s : { 1, 17, 300 } ) {
+      expression_test_case<T, blaze::rowMajor   >( s, 2*s + 1 );
+      expression_test_case<T, blaze::columnMajor>( s, 2*s + 1 );
+   }
+}
+
+} // cuda_segmented_reduce
+
+} // utiltest
+
+} // blazetest
+
+#endif
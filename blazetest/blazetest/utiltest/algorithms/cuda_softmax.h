@@ -0,0 +1,229 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_softmax.h
+//  \brief Tests for the cuda_softmax algorithms
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_SOFTMAX_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_SOFTMAX_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <blaze/Blaze.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/math/expressions/DMatSoftmaxExpr.h>
+#include <blaze_cuda/math/expressions/DVecSoftmaxExpr.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDASoftmax.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_softmax {
+
+// Large values, whose exponentials overflow unless they are shifted by the maximum
+template<typename T>
+T value( std::size_t i, std::size_t j )
+{
+   return T( 500 ) + T( ( 7*i + 3*j ) % 11 ) / T( 2 );
+}
+
+template<typename T>
+bool close( T x, T ref )
+{
+   T const eps = sizeof(T) < sizeof(double) ? T( 1e-4 ) : T( 1e-10 );
+   return std::abs( x - ref ) <= eps * std::abs( ref );
+}
+
+// Two pass reference softmax of a range
+template<typename T>
+std::vector<T> reference( std::vector<T> const& v )
+{
+   if( v.empty() ) return v;
+
+   double const m( *std::max_element( v.begin(), v.end() ) );
+   double s( 0 );
+   for( auto const& x : v ) s += std::exp( x - m );
+
+   std::vector<T> res;
+   for( auto const& x : v ) res.push_back( T( std::exp( x - m ) / s ) );
+   return res;
+}
+
+// Normalizes the rows, the columns and the whole of an m x n block stored with spacing 'sp'.
+// The padding of the output must be left untouched.
+template<typename T>
+void test_case( std::size_t m, std::size_t n, std::size_t sp )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype a( m * sp, T(-1) ), rows( m * sp, T(-1) ), cols( m * sp, T(-1) ), all( m * sp, T(-1) );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         a[i*sp+j] = value<T>( i, j );
+
+   blaze::cuda_softmax_segments<T>( m, n, a.begin(), sp, rows.begin(), sp );
+   blaze::cuda_softmax_strided <T>( m, n, a.begin(), sp, cols.begin(), sp );
+   blaze::cuda_softmax_2d      <T>( m, n, a.begin(), sp, all.begin(), sp );
+   blaze::cuda_synchronize();
+
+   std::vector<T> block;
+
+   for( size_t i = 0; i < m; ++i ) {
+      std::vector<T> row;
+      for( size_t j = 0; j < n; ++j )
+         row.push_back( value<T>( i, j ) );
+
+      auto const ref = reference( row );
+
+      for( size_t j = 0; j < n; ++j ) {
+         if( !close( rows[i*sp+j], ref[j] ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid segmented softmax result.\n" );
+         }
+      }
+
+      block.insert( block.end(), row.begin(), row.end() );
+   }
+
+   for( size_t j = 0; j < n; ++j ) {
+      std::vector<T> col;
+      for( size_t i = 0; i < m; ++i )
+         col.push_back( value<T>( i, j ) );
+
+      auto const ref = reference( col );
+
+      for( size_t i = 0; i < m; ++i ) {
+         if( !close( cols[i*sp+j], ref[i] ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid strided softmax result.\n" );
+         }
+      }
+   }
+
+   auto const ref = reference( block );
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         if( !close( all[i*sp+j], ref[i*n+j] ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid 2D softmax result.\n" );
+         }
+      }
+
+      for( size_t j = n; j < sp; ++j ) {
+         if( rows[i*sp+j] != T(-1) || cols[i*sp+j] != T(-1) || all[i*sp+j] != T(-1) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Softmax wrote into the padding.\n" );
+         }
+      }
+   }
+}
+
+// Total and rowwise softmax of vectors and of matrices of both storage orders
+template<typename T, bool SO>
+void expression_test_case( std::size_t m, std::size_t n )
+{
+   using std::size_t;
+
+   // Matrix and vector type parameters
+   using mtype = blaze::CUDADynamicMatrix<T,SO>;
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   mtype A( m, n );
+   vtype v( m * n );
+   std::vector<T> all;
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         A(i,j) = value<T>( i, j );
+         v[i*n+j] = value<T>( i, j );
+         all.push_back( value<T>( i, j ) );
+      }
+   }
+
+   vtype const sv = blaze::softmax( v );
+   mtype const SA = blaze::softmax( A );
+   mtype const SR = blaze::softmax<blaze::rowwise>( A );
+   blaze::cuda_synchronize();
+
+   auto const ref = reference( all );
+
+   for( size_t i = 0; i < m; ++i ) {
+      auto const rref = reference( std::vector<T>( all.begin() + i*n, all.begin() + (i+1)*n ) );
+
+      for( size_t j = 0; j < n; ++j ) {
+         if( !close( sv[i*n+j], ref[i*n+j] ) || !close( SA(i,j), ref[i*n+j] ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid total softmax.\n" );
+         }
+
+         if( !close( SR(i,j), rref[j] ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid rowwise softmax.\n" );
+         }
+      }
+   }
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( auto const& m : { 0, 1, 5, 33, 300 } ) {
+      for( auto const& n : { 0, 1, 3, 32, 100, 1500, 9000 } ) {
+         test_case<T>( m, n, n );
+         test_case<T>( m, n, n + 5 );
+      }
+   }
+
+   for( auto const& s : { 2, 17, 300 } ) {
+      expression_test_case<T, blaze::rowMajor   >( s, 2*s + 1 );
+      expression_test_case<T, blaze::columnMajor>( s, 2*s + 1 );
+   }
+}
+
+} // cuda_softmax
+
+} // utiltest
+
+} // blazetest
+
+#endif
@@ -0,0 +1,214 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_sort.h
+//  \brief Test cases for the CUDA sort, argsort and top-k algorithms
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_SORT_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_SORT_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <blaze/Blaze.h>
+
+#include <blaze_cuda/math/cuda/Sort.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDASort.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_sort {
+
+template<typename T>
+void test_case( std::size_t size, bool descending )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+   using itype = blaze::CUDADynamicVector<size_t>;
+
+   vtype a( size ), keys( size ), sorted( size );
+   itype values( size );
+
+   // Many duplicates of both signs, to check stability
+   for( size_t i = 0; i < size; ++i ) {
+      a[i] = T( int( ( 37*i ) % 101 ) - 50 );
+      keys[i] = a[i];
+      sorted[i] = a[i];
+      values[i] = i;
+   }
+
+   std::vector<size_t> ref( size );
+   std::iota( ref.begin(), ref.end(), size_t( 0 ) );
+   std::stable_sort( ref.begin(), ref.end(), [&]( size_t x, size_t y ) {
+      return descending ? a[y] < a[x] : a[x] < a[y];
+   } );
+
+   blaze::cuda_sort( sorted, descending );
+   blaze::cuda_sort_by_key( keys.begin(), keys.end(), values.begin(), descending );
+   itype const perm( blaze::argsort( a, descending ) );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < size; ++i ) {
+      if( sorted[i] != a[ ref[i] ] || keys[i] != a[ ref[i] ] || values[i] != ref[i] || perm[i] != ref[i] ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid sort result.\n" );
+      }
+   }
+}
+
+template<typename T>
+void top_k_test_case( std::size_t size, std::size_t k )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype a( size );
+
+   for( size_t i = 0; i < size; ++i )
+      a[i] = T( int( ( 37*i ) % 101 ) - 50 );
+
+   std::vector<size_t> ref( size );
+   std::iota( ref.begin(), ref.end(), size_t( 0 ) );
+   std::stable_sort( ref.begin(), ref.end(), [&]( size_t x, size_t y ) { return a[y] < a[x]; } );
+
+   auto const res( blaze::top_k( a, k ) );
+   blaze::cuda_synchronize();
+
+   size_t const n( std::min( k, size ) );
+
+   if( res.first.size() != n || res.second.size() != n ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid top-k size.\n" );
+   }
+
+   for( size_t i = 0; i < n; ++i ) {
+      if( res.first[i] != a[ ref[i] ] || res.second[i] != ref[i] ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid top-k result.\n" );
+      }
+   }
+}
+
+// Signed zeros compare equal: they keep their input order and their sign, as on the host
+template<typename T>
+void signed_zero_test_case( std::size_t size, bool descending )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+   using itype = blaze::CUDADynamicVector<size_t>;
+
+   vtype a( size ), keys( size ), sorted( size );
+   itype values( size );
+
+   for( size_t i = 0; i < size; ++i ) {
+      a[i] = ( i % 3 == 2 ) ? T( int( i % 7 ) - 3 ) : ( ( i * 5 ) % 4 < 2 ? -T(0) : T(0) );
+      keys[i] = a[i];
+      sorted[i] = a[i];
+      values[i] = i;
+   }
+
+   std::vector<size_t> ref( size );
+   std::iota( ref.begin(), ref.end(), size_t( 0 ) );
+   std::stable_sort( ref.begin(), ref.end(), [&]( size_t x, size_t y ) {
+      return descending ? a[y] < a[x] : a[x] < a[y];
+   } );
+
+   const auto same = [&]( T x, size_t j ) {
+      return x == a[j] && std::signbit( x ) == std::signbit( a[j] );
+   };
+
+   blaze::cuda_sort( sorted, descending );
+   blaze::cuda_sort_by_key( keys.begin(), keys.end(), values.begin(), descending );
+   itype const perm( blaze::argsort( a, descending ) );
+   auto const top( blaze::top_k( a, size / 2 ) );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < size; ++i ) {
+      if( !same( sorted[i], ref[i] ) || !same( keys[i], ref[i] ) ||
+          values[i] != ref[i] || perm[i] != ref[i] ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid sort result with signed zeros.\n" );
+      }
+   }
+
+   std::iota( ref.begin(), ref.end(), size_t( 0 ) );
+   std::stable_sort( ref.begin(), ref.end(), [&]( size_t x, size_t y ) { return a[y] < a[x]; } );
+
+   for( size_t i = 0; i < size / 2; ++i ) {
+      if( !same( top.first[i], ref[i] ) || top.second[i] != ref[i] ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid top-k result with signed zeros.\n" );
+      }
+   }
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( auto const& size : { 0, 1, 7, 256, 257, 1000, 2048 + 7, 100000, 1000000 } ) {
+      test_case<T>( size, false );
+      test_case<T>( size, true  );
+   }
+
+   for( auto const& size : { 1, 257, 100000 } )
+      for( auto const& k : { 0, 1, 10, 101, 1000, 200000 } )
+         top_k_test_case<T>( size, k );
+
+   if constexpr( std::is_floating_point<T>::value ) {
+      for( auto const& size : { 2, 257, 100000 } ) {
+         signed_zero_test_case<T>( size, false );
+         signed_zero_test_case<T>( size, true  );
+      }
+   }
+}
+
+} // cuda_sort
+
+} // utiltest
+
+} // blazetest
+
+#endif
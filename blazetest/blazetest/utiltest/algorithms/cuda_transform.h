@@ -0,0 +1,132 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_transform.h
+//  \brief Test cases for the cuda_transform algorithm
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_TRANSFORM_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_TRANSFORM_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <blaze/Blaze.h>
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDATransform.h>
+#include <blaze_cuda/util/algorithms/Unroll.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_transform {
+
+template<typename T, std::size_t U>
+void unary_test_case(std::size_t size)
+{
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype a( size, T(1) );
+   vtype b( size, T(0) );
+
+   blaze::cuda_transform < U > ( a.begin(), a.end(), b.begin()
+      , [] BLAZE_DEVICE_CALLABLE ( T const& x ) { return T( x + x ); } );
+   blaze::cuda_synchronize();
+
+   for(auto const& v : a) if( v != T(1) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error("Altered input");
+   }
+
+   for(auto const& v : b) if( v != T(2) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error("Invalid result.\n");
+   }
+}
+
+template<typename T, std::size_t U>
+void binary_test_case(std::size_t size)
+{
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype a( size, T(1) );
+   vtype b( size, T(2) );
+   vtype c( size, T(0) );
+
+   blaze::cuda_transform < U > ( a.begin(), a.end(), b.begin(), c.begin()
+      , [] BLAZE_DEVICE_CALLABLE ( T const& x, T const& y ) { return T( x + y ); } );
+   blaze::cuda_synchronize();
+
+   for(auto const& v : c) if( v != T(3) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error("Invalid result.\n");
+   }
+}
+
+template<typename T, std::size_t U>
+void test_case( std::size_t size )
+{
+   unary_test_case< T, U >( size );
+   binary_test_case< T, U >( size );
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   auto size_factors = { 0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 65536 };
+
+   blaze::unroll< 4 >( [&]( auto I )
+   {
+      // Unroll factors 1, 2, 4, 8
+      auto constexpr U = std::size_t( 1 ) << I();
+
+      // Even sizes
+      for( auto const& size : size_factors )
+         test_case< T, U >( size );
+
+      // Odd sizes
+      for( auto const& size : size_factors )
+         test_case< T, U >( size + 7 );
+   } );
+}
+
+} // cuda_transform
+
+} // utiltest
+
+} // blazetest
+
+#endif
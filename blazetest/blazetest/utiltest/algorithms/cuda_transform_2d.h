@@ -0,0 +1,146 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_transform_2d.h
+//  \brief Test cases for the cuda_transform_2d algorithm
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_TRANSFORM_2D_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_TRANSFORM_2D_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <blaze/Blaze.h>
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDATransform2D.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_transform_2d {
+
+// Transforms an m x n block stored with spacing 'sp' into a block stored with spacing 'sp + 3'
+// and checks that the padding elements of both blocks are left untouched.
+template<typename T>
+void test_case( std::size_t m, std::size_t n, std::size_t sp )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   size_t const out_sp = sp + 3;
+
+   vtype a( m * sp, T(1) );
+   vtype b( m * sp, T(2) );
+   vtype c( m * out_sp, T(0) );
+
+   blaze::cuda_transform_2d( m, n, a.begin(), sp, b.begin(), sp, c.begin(), out_sp
+      , [] BLAZE_DEVICE_CALLABLE ( T const& x, T const& y ) { return T( x + y ); } );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < out_sp; ++j ) {
+         if( c[i*out_sp+j] != ( j < n ? T(3) : T(0) ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error("Invalid result.\n");
+         }
+      }
+   }
+
+   blaze::cuda_transform_2d( m, n, a.begin(), sp, a.begin(), sp
+      , [] BLAZE_DEVICE_CALLABLE ( T const& x ) { return T( x + x ); } );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < sp; ++j ) {
+         if( a[i*sp+j] != ( j < n ? T(2) : T(1) ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error("Invalid in-place result.\n");
+         }
+      }
+   }
+}
+
+// Generates an m x n block stored with spacing 'sp' from the element indices
+template<typename T>
+void generate_test_case( std::size_t m, std::size_t n, std::size_t sp )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype a( m * sp, T(0) );
+
+   blaze::cuda_generate_2d( m, n, a.begin(), sp
+      , [] BLAZE_DEVICE_CALLABLE ( size_t i, size_t j ) { return T( i % 7 + j % 5 ); } );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < sp; ++j ) {
+         if( a[i*sp+j] != ( j < n ? T( i % 7 + j % 5 ) : T(0) ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error("Invalid generated result.\n");
+         }
+      }
+   }
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   auto rows    = { 0, 1, 3, 64, 1000, 10000 };
+   auto columns = { 1, 7, 32, 64, 100, 1031 };
+
+   for( auto const& m : rows ) {
+      for( auto const& n : columns ) {
+         // Tall and skinny matrices only
+         if( m * n > 2000000 ) continue;
+
+         test_case<T>( m, n, n );
+         test_case<T>( m, n, n + 5 );
+         generate_test_case<T>( m, n, n + 5 );
+      }
+   }
+}
+
+} // cuda_transform_2d
+
+} // utiltest
+
+} // blazetest
+
+#endif
@@ -0,0 +1,144 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_transform_reduce.h
+//  \brief Test cases for the fused CUDA transform-reduce algorithm
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_TRANSFORM_REDUCE_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_TRANSFORM_REDUCE_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <blaze/Blaze.h>
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/math/expressions/DVecDVecInnerExpr.h>
+#include <blaze_cuda/util/algorithms/CUDATransformReduce.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_transform_reduce {
+
+template<typename T, std::size_t U, std::size_t B>
+void unary_test_case(std::size_t size)
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype a( size );
+
+   for( size_t i = 0; i < size; ++i )
+      a[i] = T( i % 7 );
+
+   // Sum of squares
+   auto val = blaze::cuda_transform_reduce < U, B > ( a.begin(), a.end(), T(0)
+      , [] BLAZE_DEVICE_CALLABLE ( T const& x, T const& y ) { return x + y; }
+      , [] BLAZE_DEVICE_CALLABLE ( T const& x ) { return x * x; } );
+
+   T ref( 0 );
+   for( size_t i = 0; i < size; ++i )
+      ref += T( i % 7 ) * T( i % 7 );
+
+   if( val != ref ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid unary transform-reduce result.\n" );
+   }
+}
+
+template<typename T, std::size_t U, std::size_t B>
+void binary_test_case(std::size_t size)
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype a( size ), b( size );
+
+   for( size_t i = 0; i < size; ++i ) {
+      a[i] = T( i % 5 );
+      b[i] = T( ( 3*i ) % 4 );
+   }
+
+   T ref( 0 );
+   for( size_t i = 0; i < size; ++i )
+      ref += T( i % 5 ) * T( ( 3*i ) % 4 );
+
+   // Dot product, result kept on the device
+   blaze::CUDAReduceWorkspace<T> workspace( 2 );
+
+   blaze::cuda_transform_reduce_into < U, B > ( a.begin(), a.end(), b.begin(), T(0)
+      , [] BLAZE_DEVICE_CALLABLE ( T const& x, T const& y ) { return x + y; }
+      , [] BLAZE_DEVICE_CALLABLE ( T const& x, T const& y ) { return x * y; }
+      , workspace.result(), workspace );
+
+   if( workspace.value() != ref ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid binary transform-reduce result.\n" );
+   }
+
+   // Inner product expression
+   if( T( trans( a ) * b ) != ref ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid inner product.\n" );
+   }
+}
+
+template<typename T, std::size_t U, std::size_t B>
+void test_case( std::size_t size )
+{
+   unary_test_case< T, U, B >( size );
+   binary_test_case< T, U, B >( size );
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( auto const& size : { 0, 1, 7, 256, 1000, 4096 + 7, 100000 } ) {
+      test_case< T, 1 , 0 >( size );
+      test_case< T, 4 , 5 >( size );
+      test_case< T, 16, 8 >( size );
+   }
+}
+
+} // cuda_transform_reduce
+
+} // utiltest
+
+} // blazetest
+
+#endif
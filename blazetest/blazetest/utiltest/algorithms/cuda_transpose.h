@@ -0,0 +1,305 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_transpose.h
+//  \brief Tests for the cuda_transpose algorithms
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_TRANSPOSE_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_TRANSPOSE_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <blaze/Blaze.h>
+
+#include <blaze_cuda/math/dense/CUDACustomMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/math/expressions/DMatTransExpr.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDATranspose.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_transpose {
+
+template<typename T>
+T value( std::size_t i, std::size_t j )
+{
+   return T( i * 1000 + j );
+}
+
+struct assign_op
+{
+   template<typename T>
+   BLAZE_DEVICE_CALLABLE T operator()( T const&, T const& e ) const { return e; }
+};
+
+struct add_op
+{
+   template<typename T>
+   BLAZE_DEVICE_CALLABLE T operator()( T const& l, T const& r ) const { return l + r; }
+};
+
+struct negate_op
+{
+   template<typename T>
+   BLAZE_DEVICE_CALLABLE T operator()( T const& e ) const { return -e; }
+};
+
+// Transposes an m x n block stored with spacing 'sp' into an n x m block with spacing 'tsp',
+// and back in place for square blocks, whose lower triangle is then mirrored. Padding elements
+// must be left untouched.
+template<typename T>
+void test_case( std::size_t m, std::size_t n, std::size_t sp, std::size_t tsp )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype a( m * sp, T(-1) ), b( n * tsp, T(-1) ), c( n * tsp, T(-1) );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         a[i*sp+j] = value<T>( i, j );
+
+   for( size_t j = 0; j < n; ++j )
+      for( size_t i = 0; i < m; ++i )
+         c[j*tsp+i] = T( 1 );
+
+   blaze::cuda_transpose( m, n, a.begin(), sp, b.begin(), tsp, assign_op() );
+   blaze::cuda_transpose( m, n, a.begin(), sp, c.begin(), tsp, add_op() );
+   blaze::cuda_synchronize();
+
+   for( size_t j = 0; j < n; ++j ) {
+      for( size_t i = 0; i < m; ++i ) {
+         if( b[j*tsp+i] != value<T>( i, j ) || c[j*tsp+i] != value<T>( i, j ) + T( 1 ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid transpose result.\n" );
+         }
+      }
+
+      for( size_t i = m; i < tsp; ++i ) {
+         if( b[j*tsp+i] != T(-1) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Transpose wrote into the padding.\n" );
+         }
+      }
+   }
+
+   if( m != n ) return;
+
+   blaze::cuda_transpose_inplace( n, a.begin(), sp, negate_op() );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < n; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         if( a[i*sp+j] != -value<T>( j, i ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid in-place transpose result.\n" );
+         }
+      }
+
+      for( size_t j = n; j < sp; ++j ) {
+         if( a[i*sp+j] != T(-1) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "In-place transpose wrote into the padding.\n" );
+         }
+      }
+   }
+
+   // Mirrors the (negated) lower triangle onto the upper one, leaving the diagonal untouched
+   blaze::cuda_mirror_lower( n, a.begin(), sp, negate_op() );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < n; ++i ) {
+      for( size_t j = 0; j < sp; ++j ) {
+         const T expected( j >= n ? T(-1) : j > i ? value<T>( i, j ) : -value<T>( j, i ) );
+         if( a[i*sp+j] != expected ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid mirror result.\n" );
+         }
+      }
+   }
+}
+
+// Transpose assignments into both storage orders and in-place transposes
+template<typename T, bool SO>
+void expression_test_case( std::size_t m, std::size_t n )
+{
+   using std::size_t;
+
+   // Matrix type parameters
+   using mtype = blaze::CUDADynamicMatrix<T,SO>;
+   using otype = blaze::CUDADynamicMatrix<T,!SO>;
+
+   mtype A( m, n );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         A(i,j) = value<T>( i, j );
+
+   mtype B( n, m );
+   otype C( n, m );
+   mtype D( A );
+
+   B = blaze::trans( A );
+   C = blaze::trans( A );
+   B += blaze::trans( A );
+   D.transpose();
+   blaze::cuda_synchronize();
+
+   if( D.rows() != n || D.columns() != m ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid in-place transpose size.\n" );
+   }
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         if( B(j,i) != T( 2 ) * value<T>( i, j ) || C(j,i) != value<T>( i, j ) ||
+             D(j,i) != value<T>( i, j ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid transpose expression result.\n" );
+         }
+      }
+   }
+}
+
+// Copies and compound assignments between matrices of opposite storage orders
+template<typename T, bool SO>
+void storage_order_test_case( std::size_t m, std::size_t n )
+{
+   using std::size_t;
+
+   // Matrix type parameters
+   using mtype = blaze::CUDADynamicMatrix<T,SO>;
+   using otype = blaze::CUDADynamicMatrix<T,!SO>;
+
+   mtype A( m, n ), D( m, n, T( 2 ) );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         A(i,j) = value<T>( i, j );
+
+   otype B( A ), C( m, n );
+
+   C = A;
+   C += A;
+   C %= D;
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         if( B(i,j) != value<T>( i, j ) || C(i,j) != T( 4 ) * value<T>( i, j ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid mixed storage order assignment result.\n" );
+         }
+      }
+   }
+}
+
+// Element-wise expressions whose operands have different spacings, assigned to targets of both
+// storage orders and transposed
+template<typename T, bool SO>
+void padded_operand_test_case( std::size_t m, std::size_t n )
+{
+   using std::size_t;
+
+   // Matrix type parameters
+   using ctype = blaze::CUDACustomMatrix<T,blaze::unaligned,blaze::unpadded,SO>;
+   using mtype = blaze::CUDADynamicMatrix<T,SO>;
+   using otype = blaze::CUDADynamicMatrix<T,!SO>;
+
+   const size_t lines ( SO == blaze::rowMajor ? m : n );
+   const size_t length( SO == blaze::rowMajor ? n : m );
+   const size_t sp( length + 3 );
+
+   blaze::CUDADynamicVector<T> v( lines * sp, T(-1) );
+   ctype A( v.data(), m, n, sp );
+   mtype B( m, n ), C( m, n ), E( n, m );
+   otype D( m, n );
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         A(i,j) = value<T>( i, j );
+         B(i,j) = T( 2 );
+      }
+   }
+
+   C = A + B;
+   C += B + A;
+   C -= A - B;
+   D = A + B;
+   E = blaze::trans( B - A );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         if( C(i,j) != value<T>( i, j ) + T( 6 ) || D(i,j) != value<T>( i, j ) + T( 2 ) ||
+             E(j,i) != T( 2 ) - value<T>( i, j ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error( "Invalid padded operand assignment result.\n" );
+         }
+      }
+   }
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( auto const& m : { 0, 1, 5, 32, 33, 300 } ) {
+      for( auto const& n : { 0, 1, 5, 32, 33, 300 } ) {
+         test_case<T>( m, n, n, m );
+         test_case<T>( m, n, n + 3, m + 7 );
+      }
+   }
+
+   for( auto const& s : { 1, 31, 64, 257 } ) {
+      expression_test_case<T, blaze::rowMajor   >( s, s );
+      expression_test_case<T, blaze::rowMajor   >( s, s + 9 );
+      expression_test_case<T, blaze::columnMajor>( s, s );
+      expression_test_case<T, blaze::columnMajor>( s + 9, s );
+      storage_order_test_case<T, blaze::rowMajor   >( s, s + 9 );
+      storage_order_test_case<T, blaze::columnMajor>( s + 9, s );
+      padded_operand_test_case<T, blaze::rowMajor   >( s, s + 9 );
+      padded_operand_test_case<T, blaze::columnMajor>( s + 9, s );
+   }
+}
+
+} // cuda_transpose
+
+} // utiltest
+
+} // blazetest
+
+#endif
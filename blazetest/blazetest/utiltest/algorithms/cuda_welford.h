@@ -0,0 +1,238 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/algorithms/cuda_welford.h
+//  \brief Tests for the CUDA Welford reductions and the mean, variance and standard deviation
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_WELFORD_H_
+#define _BLAZETEST_UTILTEST_ALGORITHMS_CUDA_WELFORD_H_
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <blaze/Blaze.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/math/expressions/DMatStdDevExpr.h>
+#include <blaze_cuda/math/expressions/DVecStdDevExpr.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDAWelford.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cuda_welford {
+
+// Small deviations around a large mean, which the naive sum of squares formula would cancel
+template<typename T>
+T value( std::size_t i, std::size_t j )
+{
+   return T( 1000 ) + T( ( 7*i + 3*j ) % 11 ) / T( 4 );
+}
+
+template<typename T>
+bool close( T x, T ref )
+{
+   T const eps = sizeof(T) < sizeof(double) ? T( 1e-3 ) : T( 1e-9 );
+   return std::abs( x - ref ) <= eps * ( T( 1 ) + std::abs( ref ) );
+}
+
+// Two pass reference statistics of a range
+template<typename T>
+struct reference
+{
+   T mean, var;
+
+   explicit reference( std::vector<T> const& v )
+   {
+      double m( 0 ), s( 0 );
+      for( auto const& x : v ) m += x;
+      m /= v.size();
+      for( auto const& x : v ) s += ( x - m ) * ( x - m );
+
+      mean = T( m );
+      var  = T( s / ( v.size() - 1 ) );
+   }
+};
+
+// Reduces an m x n block stored with spacing 'sp' whose padding is filled with a value far from
+// the elements, which must never be read.
+template<typename T>
+void test_case( std::size_t m, std::size_t n, std::size_t sp )
+{
+   using std::size_t;
+
+   // Vector type parameters
+   using vtype = blaze::CUDADynamicVector<T>;
+
+   vtype a( m * sp, T(-1e6) );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         a[i*sp+j] = value<T>( i, j );
+
+   vtype rvar( m, T(-1) ), cmean( n, T(-1) );
+
+   blaze::cuda_welford_segments<T>( m, n, a.begin(), sp, rvar.begin(), blaze::WelfordVariance() );
+   blaze::cuda_welford_strided <T>( m, n, a.begin(), sp, cmean.begin(), blaze::WelfordMean() );
+   auto const total = blaze::cuda_welford_2d<T>( m, n, a.begin(), sp );
+   blaze::cuda_synchronize();
+
+   std::vector<T> all;
+
+   for( size_t i = 0; i < m && n > 1; ++i ) {
+      std::vector<T> row;
+      for( size_t j = 0; j < n; ++j )
+         row.push_back( value<T>( i, j ) );
+
+      if( !close( rvar[i], reference<T>( row ).var ) ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid segmented Welford reduction result.\n" );
+      }
+   }
+
+   for( size_t j = 0; j < n && m > 0; ++j ) {
+      std::vector<T> col;
+      for( size_t i = 0; i < m; ++i )
+         col.push_back( value<T>( i, j ) );
+
+      if( !close( cmean[j], reference<T>( col ).mean ) ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid strided Welford reduction result.\n" );
+      }
+   }
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         all.push_back( value<T>( i, j ) );
+
+   if( total.count != all.size() ||
+       ( all.size() > 1 && ( !close( total.mean, reference<T>( all ).mean ) ||
+                             !close( blaze::WelfordVariance()( total ), reference<T>( all ).var ) ) ) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid 2D Welford reduction result.\n" );
+   }
+}
+
+// Total and partial statistics of vectors and of matrices of both storage orders
+template<typename T, bool SO>
+void expression_test_case( std::size_t m, std::size_t n )
+{
+   using std::size_t;
+
+   // Matrix and vector type parameters
+   using mtype = blaze::CUDADynamicMatrix<T,SO>;
+   using vtype = blaze::CUDADynamicVector<T>;
+   using ctype = blaze::CUDADynamicVector<T,blaze::columnVector>;
+   using rtype = blaze::CUDADynamicVector<T,blaze::rowVector>;
+
+   mtype A( m, n );
+   vtype v( m * n );
+   std::vector<T> all;
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         A(i,j) = value<T>( i, j );
+         v[i*n+j] = value<T>( i, j );
+         all.push_back( value<T>( i, j ) );
+      }
+   }
+
+   reference<T> const ref( all );
+
+   if( !close( blaze::mean( v ), ref.mean ) || !close( blaze::var( v ), ref.var ) ||
+       !close( blaze::stddev( v ), T( std::sqrt( ref.var ) ) ) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid vector statistics.\n" );
+   }
+
+   if( !close( blaze::mean( A ), ref.mean ) || !close( blaze::var( A ), ref.var ) ||
+       !close( blaze::stddev( A ), T( std::sqrt( ref.var ) ) ) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid matrix statistics.\n" );
+   }
+
+   ctype const rmean = blaze::mean<blaze::rowwise>( A );
+   ctype const rvar  = blaze::var<blaze::rowwise>( A );
+   rtype const cmean = blaze::mean<blaze::columnwise>( A );
+   rtype const cdev  = blaze::stddev<blaze::columnwise>( A );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      reference<T> const r( std::vector<T>( all.begin() + i*n, all.begin() + (i+1)*n ) );
+
+      if( !close( rmean[i], r.mean ) || !close( rvar[i], r.var ) ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid rowwise statistics.\n" );
+      }
+   }
+
+   for( size_t j = 0; j < n; ++j ) {
+      std::vector<T> col;
+      for( size_t i = 0; i < m; ++i )
+         col.push_back( value<T>( i, j ) );
+
+      reference<T> const r( col );
+
+      if( !close( cmean[j], r.mean ) || !close( cdev[j], T( std::sqrt( r.var ) ) ) ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid columnwise statistics.\n" );
+      }
+   }
+}
+
+template<typename T>
+void launch_tests_for_type()
+{
+   for( auto const& m : { 0, 1, 5, 33, 300, 5000 } ) {
+      for( auto const& n : { 0, 1, 3, 32, 100, 1500 } ) {
+         test_case<T>( m, n, n );
+         test_case<T>( m, n, n + 5 );
+      }
+   }
+
+   for( auto const& s : { 2, 17, 300 } ) {
+      expression_test_case<T, blaze::rowMajor   >( s, 2*s + 1 );
+      expression_test_case<T, blaze::columnMajor>( s, 2*s + 1 );
+   }
+}
+
+} // cuda_welford
+
+} // utiltest
+
+} // blazetest
+
+#endif
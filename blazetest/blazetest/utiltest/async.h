@@ -0,0 +1,120 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/async.h
+//  \brief Test cases for the asynchronous assignments and reductions
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_ASYNC_H_
+#define _BLAZETEST_UTILTEST_ASYNC_H_
+
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include <blaze/Blaze.h>
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/math/cuda/Async.h>
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace async {
+
+template< typename T >
+void assign_test_case( std::size_t size )
+{
+   using std::size_t;
+
+   blaze::CUDADynamicVector<T> a( size, T(1) ), b( size, T(2) ), c( size );
+
+   std::future<void> done = blaze::async_assign( c, a + b );
+   done.get();
+
+   for( auto const& v : c ) if( v != T(3) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error("Invalid asynchronous vector assignment");
+   }
+
+   blaze::CUDADynamicMatrix<T> A( size, size + 1, T(2) ), B( size, size + 1 );
+
+   blaze::async_assign( B, A - A + A ).get();
+
+   for( size_t i = 0; i < size; ++i )
+      for( size_t j = 0; j < size + 1; ++j )
+         if( B(i,j) != T(2) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error("Invalid asynchronous matrix assignment");
+         }
+}
+
+template< typename T >
+void reduce_test_case( std::size_t size )
+{
+   blaze::CUDADynamicVector<T> a( size, T(1) );
+
+   auto const sum = [] BLAZE_DEVICE_CALLABLE ( T const& x, T const& y ) { return x + y; };
+
+   // Several reductions in flight at the same time
+   std::vector< std::future<T> > results;
+
+   for( std::size_t i = 0; i < 4; ++i )
+      results.push_back( blaze::async_reduce( a, T(0), sum ) );
+
+   for( auto& r : results ) if( r.get() != T( size ) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error("Invalid asynchronous reduction");
+   }
+}
+
+template< typename T >
+void launch_tests_for_type()
+{
+   for( auto const& size : { 1, 7, 1000, 100000 } ) {
+      reduce_test_case<T>( size );
+   }
+
+   for( auto const& size : { 1, 7, 100 } ) {
+      assign_test_case<T>( size );
+   }
+}
+
+} // async
+
+} // utiltest
+
+} // blazetest
+
+#endif
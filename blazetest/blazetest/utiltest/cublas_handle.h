@@ -0,0 +1,289 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/cublas_handle.h
+//  \brief Test cases for the cuBLAS handle registry and the gemm dispatch
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_CUBLAS_HANDLE_H_
+#define _BLAZETEST_UTILTEST_CUBLAS_HANDLE_H_
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+
+#include <blaze/Blaze.h>
+
+#include <blaze_cuda/math/cublas/gemm.h>
+#include <blaze_cuda/math/cublas/gemv.h>
+#include <blaze_cuda/math/cublas/syrk.h>
+#include <blaze_cuda/math/dense/CUDADynamicMatrix.h>
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/CUBLASHandle.h>
+#include <blaze_cuda/util/CUDAExecutionContext.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace cublas_handle {
+
+inline void registry_test()
+{
+   cublasHandle_t const h1 = blaze::cublas_handle();
+   cublasHandle_t const h2 = blaze::cublas_handle();
+
+   if( h1 != h2 ) {
+      throw std::runtime_error("Handle not reused");
+   }
+
+   // Every thread gets its own handle
+   cublasHandle_t h3 = nullptr;
+   std::thread( [&]{ h3 = blaze::cublas_handle(); } ).join();
+
+   if( h3 == h1 ) {
+      throw std::runtime_error("Handle shared between threads");
+   }
+
+   // Configuration is applied lazily and restored by the guard
+   {
+      blaze::CUBLASConfig config;
+      config.mathMode = CUBLAS_DEFAULT_MATH;
+      blaze::CUBLASConfigGuard guard( config );
+
+      if( blaze::cublas_handle() != h1 ) {
+         throw std::runtime_error("Handle changed by configuration");
+      }
+   }
+
+   // The handle follows the stream of the execution context
+   blaze::CUDAExecutionContext const ctx( blaze::CUDAExecutionContext::create() );
+   cudaStream_t current = nullptr;
+   {
+      blaze::CUDAExecutionContextGuard guard( ctx );
+      cublasGetStream_v2( blaze::cublas_handle(), &current );
+
+      if( current != ctx.stream() ) {
+         throw std::runtime_error("Execution context stream not applied");
+      }
+   }
+
+   cublasGetStream_v2( blaze::cublas_handle(), &current );
+
+   if( current != nullptr ) {
+      throw std::runtime_error("Execution context not restored");
+   }
+}
+
+template< typename T, bool SO1, bool SO2, bool SO3 >
+void gemm_test_case( std::size_t m, std::size_t n, std::size_t k )
+{
+   using std::size_t;
+
+   blaze::DynamicMatrix<T,SO2> refA( m, k );
+   blaze::DynamicMatrix<T,SO3> refB( k, n );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < k; ++j )
+         refA(i,j) = T( ( i + 2*j ) % 5 );
+
+   for( size_t i = 0; i < k; ++i )
+      for( size_t j = 0; j < n; ++j )
+         refB(i,j) = T( ( 3*i + j ) % 7 );
+
+   blaze::DynamicMatrix<T,SO1> const ref( refA * refB );
+
+   blaze::CUDADynamicMatrix<T,SO2> A( m, k );
+   blaze::CUDADynamicMatrix<T,SO3> B( k, n );
+   blaze::CUDADynamicMatrix<T,SO1> C( m, n );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < k; ++j )
+         A(i,j) = refA(i,j);
+
+   for( size_t i = 0; i < k; ++i )
+      for( size_t j = 0; j < n; ++j )
+         B(i,j) = refB(i,j);
+
+   blaze::cugemm( C, A, B, T(1), T(0) );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         if( std::abs( C(i,j) - ref(i,j) ) > 1e-3 ) {
+            // TODO: Better error reporting
+            throw std::runtime_error("Invalid gemm result.\n");
+         }
+      }
+   }
+}
+
+// Both gemv wrappers, with non-square matrices so that the leading dimension is checked
+template< typename T, bool SO >
+void gemv_test_case( std::size_t m, std::size_t n )
+{
+   using std::size_t;
+
+   blaze::DynamicMatrix<T,SO> refA( m, n );
+   blaze::DynamicVector<T,blaze::columnVector> refx( n );
+   blaze::DynamicVector<T,blaze::rowVector> refz( m );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         refA(i,j) = T( ( i + 2*j ) % 5 );
+
+   for( size_t j = 0; j < n; ++j )
+      refx[j] = T( j % 3 );
+
+   for( size_t i = 0; i < m; ++i )
+      refz[i] = T( ( i + 1 ) % 4 );
+
+   blaze::DynamicVector<T,blaze::columnVector> const refy( refA * refx );
+   blaze::DynamicVector<T,blaze::rowVector> const refw( refz * refA );
+
+   blaze::CUDADynamicMatrix<T,SO> A( m, n );
+   blaze::CUDADynamicVector<T,blaze::columnVector> x( n ), y( m );
+   blaze::CUDADynamicVector<T,blaze::rowVector> z( m ), w( n );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         A(i,j) = refA(i,j);
+
+   for( size_t j = 0; j < n; ++j )
+      x[j] = refx[j];
+
+   for( size_t i = 0; i < m; ++i )
+      z[i] = refz[i];
+
+   blaze::cugemv( y, A, x, T(1), T(0) );
+   blaze::cugemv( w, z, A, T(1), T(0) );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      if( std::abs( y[i] - refy[i] ) > 1e-3 ) {
+         // TODO: Better error reporting
+         throw std::runtime_error("Invalid gemv result.\n");
+      }
+   }
+
+   for( size_t j = 0; j < n; ++j ) {
+      if( std::abs( w[j] - refw[j] ) > 1e-3 ) {
+         // TODO: Better error reporting
+         throw std::runtime_error("Invalid transpose gemv result.\n");
+      }
+   }
+}
+
+// Rank-k updates of either triangle, whose other triangle must be left untouched, and the
+// Hermitian update of a complex matrix of the same storage order
+template< typename T, bool SO1, bool SO2 >
+void rankk_test_case( std::size_t n, std::size_t k )
+{
+   using std::size_t;
+   using CT = blaze::complex<T>;
+
+   blaze::CUDADynamicMatrix<T,SO2> A( n, k );
+   blaze::CUDADynamicMatrix<CT,SO2> Z( n, k );
+   blaze::CUDADynamicMatrix<T,SO1> L( n, n, T(-1) ), U( n, n, T(-1) );
+   blaze::CUDADynamicMatrix<CT,SO1> H( n, n, CT(-1) );
+
+   for( size_t i = 0; i < n; ++i ) {
+      for( size_t j = 0; j < k; ++j ) {
+         A(i,j) = T( ( i + 2*j ) % 5 );
+         Z(i,j) = CT( T( ( i + 2*j ) % 5 ), T( ( 3*i + j ) % 7 ) );
+      }
+   }
+
+   blaze::cusyrk( L, A, T(1), T(0), true );
+   blaze::cusyrk( U, A, T(1), T(0), false );
+   if constexpr( SO1 == SO2 ) {
+      blaze::cuherk( H, Z, T(1), T(0), true );
+   }
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < n; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         T ref( 0 );
+         CT href( 0 );
+         for( size_t l = 0; l < k; ++l ) {
+            ref  += A(i,l) * A(j,l);
+            href += Z(i,l) * blaze::conj( Z(j,l) );
+         }
+
+         if( L(i,j) != ( j <= i ? ref : T(-1) ) || U(i,j) != ( j >= i ? ref : T(-1) ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error("Invalid syrk result.\n");
+         }
+
+         if( SO1 == SO2 && std::abs( H(i,j) - ( j <= i ? href : CT(-1) ) ) > 1e-3 ) {
+            // TODO: Better error reporting
+            throw std::runtime_error("Invalid herk result.\n");
+         }
+      }
+   }
+}
+
+template< typename T >
+void launch_tests_for_type()
+{
+   using blaze::rowMajor;
+   using blaze::columnMajor;
+
+   for( auto const& size : { 1, 7, 33, 64 } ) {
+      gemm_test_case< T, rowMajor   , rowMajor   , rowMajor    >( size, size + 3, size + 1 );
+      gemm_test_case< T, rowMajor   , columnMajor, rowMajor    >( size, size + 3, size + 1 );
+      gemm_test_case< T, rowMajor   , rowMajor   , columnMajor >( size, size + 3, size + 1 );
+      gemm_test_case< T, rowMajor   , columnMajor, columnMajor >( size, size + 3, size + 1 );
+      gemm_test_case< T, columnMajor, rowMajor   , rowMajor    >( size, size + 3, size + 1 );
+      gemm_test_case< T, columnMajor, columnMajor, rowMajor    >( size, size + 3, size + 1 );
+      gemm_test_case< T, columnMajor, rowMajor   , columnMajor >( size, size + 3, size + 1 );
+      gemm_test_case< T, columnMajor, columnMajor, columnMajor >( size, size + 3, size + 1 );
+
+      gemv_test_case< T, rowMajor    >( size, size + 5 );
+      gemv_test_case< T, rowMajor    >( size + 5, size );
+      gemv_test_case< T, columnMajor >( size, size + 5 );
+      gemv_test_case< T, columnMajor >( size + 5, size );
+
+      rankk_test_case< T, rowMajor   , rowMajor    >( size, size + 4 );
+      rankk_test_case< T, rowMajor   , columnMajor >( size, size + 4 );
+      rankk_test_case< T, columnMajor, rowMajor    >( size, size + 4 );
+      rankk_test_case< T, columnMajor, columnMajor >( size, size + 4 );
+   }
+}
+
+} // cublas_handle
+
+} // utiltest
+
+} // blazetest
+
+#endif
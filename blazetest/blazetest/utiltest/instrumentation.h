@@ -0,0 +1,253 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/instrumentation.h
+//  \brief Test cases for the kernel launch and data movement instrumentation
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_INSTRUMENTATION_H_
+#define _BLAZETEST_UTILTEST_INSTRUMENTATION_H_
+
+#if !defined(BLAZE_CUDA_INSTRUMENTATION)
+#  error "The instrumentation tests require BLAZE_CUDA_INSTRUMENTATION"
+#endif
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <blaze/Blaze.h>
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/CUDAInstrumentation.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDAReduce.h>
+#include <blaze_cuda/util/algorithms/CUDATransform.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace instrumentation {
+
+template< typename T >
+struct Sum
+{
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& x, T const& y ) const { return x + y; }
+};
+
+template< typename T >
+void stats_test_case( std::size_t size )
+{
+   using std::size_t;
+
+   blaze::CUDADynamicVector<T> a( size ), b( size ), c( size );
+
+   for( size_t i = 0; i < size; ++i ) {
+      a[i] = T( i % 7 );
+      b[i] = T( i % 5 );
+   }
+
+   auto stats( std::make_shared<blaze::CUDAStatsSink>() );
+   blaze::CUDACounters const before( blaze::cuda_instrumentation().totals() );
+
+   blaze::cuda_instrumentation().attach( stats );
+
+   T sum( 0 );
+
+   {
+      BLAZE_CUDA_RANGE( "outer" );
+
+      blaze::cuda_transform( a.begin(), a.end(), b.begin(), c.begin(), Sum<T>() );
+      sum = blaze::cuda_reduce( c.begin(), c.end(), T(0), Sum<T>(), blaze::cuda_reduce_workspace<T>() );
+      blaze::cuda_synchronize();
+   }
+
+   blaze::cuda_instrumentation().detach( stats );
+
+   // Not recorded once detached
+   blaze::cuda_transform( a.begin(), a.end(), b.begin(), c.begin(), Sum<T>() );
+   blaze::cuda_synchronize();
+
+   blaze::CUDARangeStats const transform( stats->stats( "cuda_transform" ) );
+   blaze::CUDARangeStats const reduce   ( stats->stats( "cuda_reduce" ) );
+   blaze::CUDARangeStats const outer    ( stats->stats( "outer" ) );
+
+   if( transform.calls != 1 || transform.counters.launches == 0 ||
+       transform.counters.bytes != 3 * size * sizeof(T) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid transform statistics.\n" );
+   }
+
+   if( reduce.calls != 1 || reduce.counters.launches == 0 || reduce.counters.bytes != size * sizeof(T) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid reduction statistics.\n" );
+   }
+
+   // Nested ranges are included in the enclosing one
+   if( outer.calls != 1 ||
+       outer.counters.launches < transform.counters.launches + reduce.counters.launches ||
+       outer.counters.bytes != transform.counters.bytes + reduce.counters.bytes ||
+       outer.counters.synchronizations == 0 || outer.seconds < transform.seconds ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid nested range statistics.\n" );
+   }
+
+   blaze::CUDACounters totals( blaze::cuda_instrumentation().totals() );
+   totals -= before;
+
+   if( totals.launches < outer.counters.launches + transform.counters.launches ||
+       totals.bytes != outer.counters.bytes + transform.counters.bytes ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid counter totals.\n" );
+   }
+
+   T ref( 0 );
+
+   for( size_t i = 0; i < size; ++i )
+      ref += T( i % 7 ) + T( i % 5 );
+
+   if( sum != ref ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid reduction result.\n" );
+   }
+}
+
+template< typename T >
+void allocation_test()
+{
+   auto stats( std::make_shared<blaze::CUDAStatsSink>() );
+   blaze::cuda_instrumentation().attach( stats );
+
+   {
+      blaze::CUDADynamicVector<T> v( 1000 );
+      (void)v;
+   }
+
+   blaze::cuda_instrumentation().detach( stats );
+
+   blaze::CUDARangeStats const allocation( stats->stats( "cuda_managed_allocate" ) );
+
+   if( allocation.calls == 0 || allocation.counters.allocations != allocation.calls ||
+       allocation.counters.allocatedBytes < 1000 * sizeof(T) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid allocation statistics.\n" );
+   }
+}
+
+template< typename T >
+void trace_test()
+{
+   std::string const path( "blazetest_instrumentation_trace.json" );
+
+   blaze::CUDADynamicVector<T> a( 1000, T(1) ), b( 1000 );
+
+   {
+      auto trace( std::make_shared<blaze::CUDATraceSink>( path ) );
+      blaze::cuda_instrumentation().attach( trace );
+
+      {
+         BLAZE_CUDA_RANGE( "quoted \"range\"" );
+         blaze::cuda_transform( a.begin(), a.end(), a.begin(), b.begin(), Sum<T>() );
+      }
+
+      blaze::cuda_instrumentation().detach( trace );
+   }
+
+   std::ifstream in( path );
+   std::string const json( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+   in.close();
+   std::remove( path.c_str() );
+
+   if( json.find( "{\"traceEvents\":[" ) != 0 ||
+       json.find( "\"name\":\"cuda_transform\"" ) == std::string::npos ||
+       json.find( "\"name\":\"quoted \\\"range\\\"\"" ) == std::string::npos ||
+       json.find( "\"ph\":\"X\"" ) == std::string::npos ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid Chrome trace.\n" );
+   }
+}
+
+// Plain packed assignments only write the target, compound ones also read it
+template< typename T >
+void packed_test_case( std::size_t size )
+{
+   using std::size_t;
+
+   blaze::CUDADynamicVector<T> a( size, T(1) ), b( size, T(2) ), c( size );
+
+   auto stats( std::make_shared<blaze::CUDAStatsSink>() );
+
+   blaze::cuda_instrumentation().attach( stats );
+   c = a + b;
+   blaze::CUDARangeStats const assign( stats->stats( "cuda_packed_transform" ) );
+   c += a;
+   blaze::CUDARangeStats const addAssign( stats->stats( "cuda_packed_transform" ) );
+   blaze::cuda_synchronize();
+   blaze::cuda_instrumentation().detach( stats );
+
+   if( assign.calls != 1 || assign.counters.bytes != 3 * size * sizeof(T) ||
+       addAssign.calls != 2 || addAssign.counters.bytes != 6 * size * sizeof(T) ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid packed assignment statistics.\n" );
+   }
+
+   for( size_t i = 0; i < size; ++i ) {
+      if( c[i] != T(4) ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid packed assignment result.\n" );
+      }
+   }
+}
+
+template< typename T >
+void launch_tests_for_type()
+{
+   for( auto const& size : { 1, 1000, 100000, 3000000 } ) {
+      stats_test_case<T>( size );
+      packed_test_case<T>( size );
+   }
+
+   allocation_test<T>();
+   trace_test<T>();
+}
+
+} // instrumentation
+
+} // utiltest
+
+} // blazetest
+
+#endif
@@ -0,0 +1,207 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/launch_tuning.h
+//  \brief Test cases for the tuned launch configurations
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_LAUNCH_TUNING_H_
+#define _BLAZETEST_UTILTEST_LAUNCH_TUNING_H_
+
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <blaze/Blaze.h>
+#include <blaze/system/HostDevice.h>
+
+#include <blaze_cuda/math/dense/CUDADynamicVector.h>
+#include <blaze_cuda/util/CUDALaunchTuning.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDAReduce.h>
+#include <blaze_cuda/util/algorithms/CUDATransform.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace launch_tuning {
+
+inline void bucket_test()
+{
+   using Table = blaze::CUDALaunchTable;
+
+   if( Table::bucket( 0 ) != 0 || Table::bucket( 1 ) != 0 || Table::bucket( 2 ) != 1 ||
+       Table::bucket( 1023 ) != 9 || Table::bucket( 1024 ) != 10 || Table::bucket( 1025 ) != 10 ) {
+      throw std::runtime_error("Invalid size bucket");
+   }
+}
+
+inline void table_test()
+{
+   std::string const path( "blazetest_launch_table.txt" );
+
+   blaze::CUDALaunchConfig config{ 0, 0 };
+
+   {
+      blaze::CUDALaunchTable table;
+
+      table.insert( "reduce", "f32", 1000, { 512, 4 } );
+      table.insert( "reduce", "f64", 1 << 20, { 128, 16 } );
+
+      if( !table.find( "reduce", "f32", 600, config ) || config.blockSize != 512 || config.unroll != 4 ) {
+         throw std::runtime_error("Configuration not found in its bucket");
+      }
+
+      if( table.find( "reduce", "f32", 2000, config ) || table.find( "reduce", "i32", 1000, config ) ) {
+         throw std::runtime_error("Configuration found in the wrong bucket");
+      }
+
+      if( !table.save( path ) ) {
+         throw std::runtime_error("Launch table not saved");
+      }
+   }
+
+   // Tuning on first use, saved to the file of the table
+   {
+      blaze::CUDALaunchTable table( path, true );
+
+      if( !table.find( "reduce", "f64", ( 1 << 20 ) + 5, config ) || config.blockSize != 128 || config.unroll != 16 ) {
+         throw std::runtime_error("Configuration not loaded");
+      }
+
+      std::size_t tunings( 0 );
+      auto const tune = [&] { ++tunings; return blaze::CUDALaunchConfig{ 256, 1 }; };
+
+      config = table.lookup( "unary_transform", "f32", 100, { 512, 4 }, tune );
+      config = table.lookup( "unary_transform", "f32", 127, { 512, 4 }, tune );
+
+      if( tunings != 1 || config.blockSize != 256 || config.unroll != 1 ) {
+         throw std::runtime_error("Invalid tuning on first use");
+      }
+
+      table.setTuning( false );
+      config = table.lookup( "unary_transform", "f32", 1 << 12, { 512, 4 }, tune );
+
+      if( tunings != 1 || config.blockSize != 512 || config.unroll != 4 ) {
+         throw std::runtime_error("Fallback configuration not used");
+      }
+   }
+
+   {
+      blaze::CUDALaunchTable table( path );
+
+      if( !table.find( "unary_transform", "f32", 64, config ) || config.blockSize != 256 ||
+          !table.find( "reduce", "f32", 1000, config ) || config.blockSize != 512 ) {
+         throw std::runtime_error("Tuned configuration not saved");
+      }
+   }
+
+   std::remove( path.c_str() );
+}
+
+template< typename T >
+struct Twice
+{
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& x ) const { return x + x; }
+};
+
+template< typename T >
+struct Sum
+{
+   inline BLAZE_DEVICE_CALLABLE T operator()( T const& x, T const& y ) const { return x + y; }
+};
+
+template< typename T >
+void kernel_test_case( std::size_t size )
+{
+   using std::size_t;
+
+   blaze::CUDADynamicVector<T> a( size ), b( size ), c( size );
+
+   for( size_t i = 0; i < size; ++i )
+      a[i] = T( i % 7 );
+
+   // Explicit and tuned configurations
+   blaze::cuda_transform<16>( a.begin(), a.end(), b.begin(), Twice<T>() );
+   blaze::cuda_transform( a.begin(), a.end(), b.begin(), c.begin(), Sum<T>() );
+
+   T const explicit_sum( blaze::cuda_reduce< 1, 7 >( a.begin(), a.end(), T(0), Sum<T>()
+                                                   , blaze::cuda_reduce_workspace<T>() ) );
+   T const tuned_sum( blaze::cuda_reduce( a.begin(), a.end(), T(0), Sum<T>()
+                                        , blaze::cuda_reduce_workspace<T>() ) );
+   blaze::cuda_synchronize();
+
+   T ref( 0 );
+
+   for( size_t i = 0; i < size; ++i ) {
+      ref += a[i];
+
+      if( b[i] != a[i] + a[i] || c[i] != b[i] + a[i] ) {
+         // TODO: Better error reporting
+         throw std::runtime_error( "Invalid transform result.\n" );
+      }
+   }
+
+   if( explicit_sum != ref || tuned_sum != ref ) {
+      // TODO: Better error reporting
+      throw std::runtime_error( "Invalid reduction result.\n" );
+   }
+}
+
+template< typename T >
+void launch_tests_for_type()
+{
+   for( auto const& size : { 1, 1000, 100000, 3000000 } )
+      kernel_test_case<T>( size );
+
+   // Configurations tuned on first use, without any file
+   blaze::cuda_launch_table().setTuning( true );
+
+   for( auto const& size : { 1, 1000, 100000, 3000000 } )
+      kernel_test_case<T>( size );
+
+   blaze::cuda_launch_table().setTuning( false );
+}
+
+inline void launch_tests()
+{
+   bucket_test();
+   table_test();
+}
+
+} // launch_tuning
+
+} // utiltest
+
+} // blazetest
+
+#endif
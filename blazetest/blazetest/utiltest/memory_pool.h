@@ -0,0 +1,241 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/memory_pool.h
+//  \brief Test cases for the caching CUDA memory pool
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_MEMORY_POOL_H_
+#define _BLAZETEST_UTILTEST_MEMORY_POOL_H_
+
+#include <cstddef>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <blaze_cuda/util/CUDAMemoryPool.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace memory_pool {
+
+using Pool = blaze::BasicCUDAMemoryPool<blaze::HostMallocMemoryBackend>;
+
+inline void size_class_test()
+{
+   const std::size_t min = Pool::minBlockSize;
+
+   if( Pool::sizeClass( 0 ) != min || Pool::sizeClass( min ) != min ) {
+      throw std::runtime_error("Invalid minimum size class");
+   }
+
+   if( Pool::sizeClass( min + 1 ) != min + min / 4 ||
+       Pool::sizeClass( 2 * min ) != 2 * min ||
+       Pool::sizeClass( 2 * min + 1 ) != 2 * min + min / 2 ) {
+      throw std::runtime_error("Invalid size class");
+   }
+
+   for( std::size_t size = 1; size < ( 1UL << 20 ); size += 997 ) {
+      const std::size_t bytes = Pool::sizeClass( size );
+      if( bytes < size || ( size > min && 4 * bytes > 5 * size + 4 * min ) ) {
+         throw std::runtime_error("Size class out of bounds");
+      }
+   }
+}
+
+inline void reuse_test()
+{
+   Pool pool;
+
+   void* const a = pool.allocate( 1000 );
+   pool.deallocate( a );
+
+   // Same size class: served from the cache
+   void* const b = pool.allocate( 1020 );
+
+   if( a != b ) {
+      throw std::runtime_error("Block not reused");
+   }
+
+   auto stats = pool.statistics();
+
+   if( stats.allocations != 2 || stats.hits != 1 || stats.backendAllocations != 1 ||
+       stats.bytesInUse != Pool::sizeClass( 1000 ) || stats.bytesCached != 0 ) {
+      throw std::runtime_error("Invalid statistics after reuse");
+   }
+
+   // Different size class: new block
+   void* const c = pool.allocate( 5000 );
+
+   if( c == b ) {
+      throw std::runtime_error("Block shared between live allocations");
+   }
+
+   pool.deallocate( b );
+   pool.deallocate( c );
+
+   stats = pool.statistics();
+
+   if( stats.bytesInUse != 0 || stats.bytesCached != Pool::sizeClass( 1000 ) + Pool::sizeClass( 5000 ) ||
+       stats.peakBytesInUse != Pool::sizeClass( 1000 ) + Pool::sizeClass( 5000 ) ) {
+      throw std::runtime_error("Invalid statistics after deallocation");
+   }
+
+   pool.trim();
+
+   stats = pool.statistics();
+
+   if( stats.bytesCached != 0 || stats.backendDeallocations != 2 ) {
+      throw std::runtime_error("Cache not trimmed");
+   }
+}
+
+inline void limit_test()
+{
+   Pool pool;
+
+   std::vector<void*> blocks;
+   for( std::size_t i = 0; i < 8; ++i )
+      blocks.push_back( pool.allocate( 4096 ) );
+
+   pool.setCacheLimit( 4 * 4096 );
+
+   for( void* block : blocks )
+      pool.deallocate( block );
+
+   auto stats = pool.statistics();
+
+   if( stats.bytesCached != 4 * 4096 || stats.backendDeallocations != 4 ) {
+      throw std::runtime_error("Cache limit not enforced");
+   }
+
+   pool.setCacheLimit( 4096 );
+
+   stats = pool.statistics();
+
+   if( stats.bytesCached != 4096 || stats.backendDeallocations != 7 ) {
+      throw std::runtime_error("Cache not trimmed to the new limit");
+   }
+}
+
+//! Backend whose events are recorded on fake streams, and pending while their stream is busy.
+struct EventBackend : public blaze::HostMallocMemoryBackend
+{
+   static inline std::set<const void*>& busy() { static std::set<const void*> streams; return streams; }
+   static inline std::vector< std::pair<Event,const void*> >& waits() {
+      static std::vector< std::pair<Event,const void*> > waits;
+      return waits;
+   }
+
+   static inline bool record( Event& event, const void* stream ) noexcept { event = stream; return true; }
+   static inline bool ready( Event event ) noexcept { return busy().count( event ) == 0; }
+   static inline void wait( Event event, const void* stream ) { waits().emplace_back( event, stream ); }
+};
+
+inline void stream_test()
+{
+   Pool pool;
+
+   int s1, s2;
+
+   void* const a = pool.allocate( 1000, &s1 );
+   pool.deallocate( a );
+
+   // Blocks freed on one stream serve allocations on the others
+   void* const b = pool.allocate( 1000, &s2 );
+
+   if( b != a || pool.statistics().waits != 0 ) {
+      throw std::runtime_error("Block not reused across streams");
+   }
+
+   pool.deallocate( b );
+}
+
+inline void pending_test()
+{
+   blaze::BasicCUDAMemoryPool<EventBackend> pool;
+
+   int s1, s2;
+
+   EventBackend::busy().insert( &s1 );
+
+   // A block freed on the busy stream A and reallocated on stream B waits for its event
+   void* const a = pool.allocate( 1000, &s1 );
+   pool.deallocate( a );
+
+   void* const b = pool.allocate( 1000, &s2 );
+
+   if( b != a || pool.statistics().waits != 1 || EventBackend::waits().size() != 1 ||
+       EventBackend::waits()[0].first != &s1 || EventBackend::waits()[0].second != &s2 ) {
+      throw std::runtime_error("Pending block reused without waiting");
+   }
+
+   // Blocks whose kernels are done are preferred
+   void* const c = pool.allocate( 1000, &s1 );
+   pool.deallocate( b );
+   pool.deallocate( c );
+
+   void* const d = pool.allocate( 1000, &s1 );
+
+   if( d != b || pool.statistics().waits != 1 ) {
+      throw std::runtime_error("Ready block not preferred");
+   }
+
+   // The event is recorded on the stream the block was last used on
+   pool.deallocate( d, &s1 );
+   pool.deallocate( pool.allocate( 1000, &s2 ) );
+
+   if( pool.statistics().waits != 2 || EventBackend::waits().back().first != &s1 ) {
+      throw std::runtime_error("Event not recorded on the freeing stream");
+   }
+
+   EventBackend::busy().clear();
+   EventBackend::waits().clear();
+}
+
+inline void launch_tests()
+{
+   size_class_test();
+   reuse_test();
+   limit_test();
+   stream_test();
+   pending_test();
+}
+
+} // memory_pool
+
+} // utiltest
+
+} // blazetest
+
+#endif
@@ -0,0 +1,144 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/mirrored_array.h
+//  \brief Test cases for the device array with a host mirror
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_MIRRORED_ARRAY_H_
+#define _BLAZETEST_UTILTEST_MIRRORED_ARRAY_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include <blaze_cuda/util/CUDAMirroredArray.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+#include <blaze_cuda/util/algorithms/CUDATransform.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace mirrored_array {
+
+template< typename T >
+void check( const blaze::CUDAMirroredArray<T>& a, T offset )
+{
+   const T* h = a.host();
+
+   for( std::size_t i = 0; i < a.size(); ++i ) {
+      if( h[i] != T( i ) + offset ) {
+         // TODO: Better error reporting
+         throw std::runtime_error("Invalid mirrored array value");
+      }
+   }
+}
+
+template< typename T >
+void sync_test( std::size_t n )
+{
+   blaze::CUDAMirroredArray<T> a( n );
+
+   if( a.hasHostMirror() ) {
+      throw std::runtime_error("Host mirror allocated eagerly");
+   }
+
+   T* h = a.host();
+   for( std::size_t i = 0; i < n; ++i )
+      h[i] = T( i );
+
+   if( !a.isHostModified() ) {
+      throw std::runtime_error("Host modification not tracked");
+   }
+
+   // Device access uploads the mirror once, then the device side is the reference
+   T* d = a.device();
+   blaze::cuda_transform( d, d + n, d, [] BLAZE_DEVICE_CALLABLE ( T const& v ) { return v + T(1); } );
+   blaze::cuda_synchronize();
+
+   if( !a.isDeviceModified() ) {
+      throw std::runtime_error("Device modification not tracked");
+   }
+
+   check( a, T(1) );
+
+   if( a.isHostModified() || a.isDeviceModified() ) {
+      throw std::runtime_error("Read access modified the array state");
+   }
+
+   // Copies and resizes are performed on the device
+   blaze::CUDAMirroredArray<T> b( a );
+
+   if( b.hasHostMirror() ) {
+      throw std::runtime_error("Host mirror copied");
+   }
+
+   check( b, T(1) );
+
+   b.resize( n + 5 );
+   b.resize( n / 2 );
+
+   check( b, T(1) );
+
+   blaze::CUDAMirroredArray<T> c( std::move( a ) );
+
+   if( a.size() != 0 || c.size() != n ) {
+      throw std::runtime_error("Invalid move");
+   }
+
+   h = c.host();
+   for( std::size_t i = 0; i < n; ++i )
+      h[i] = T( i ) + T(2);
+
+   c.releaseHostMirror();
+
+   if( c.hasHostMirror() ) {
+      throw std::runtime_error("Host mirror not released");
+   }
+
+   check( c, T(2) );
+}
+
+template< typename T >
+void launch_tests_for_type()
+{
+   for( auto const& size : { 1, 7, 1000, 100000 } ) {
+      sync_test<T>( size );
+   }
+}
+
+} // mirrored_array
+
+} // utiltest
+
+} // blazetest
+
+#endif
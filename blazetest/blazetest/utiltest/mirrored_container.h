@@ -0,0 +1,200 @@
+//=================================================================================================
+/*!
+//  \file blazetest/utiltest/mirrored_container.h
+//  \brief Test cases for the device memory containers with a host mirror
+//
+//  Copyright (C) 2019 Jules Penuchot - All Rights Reserved
+//
+//  This file is part of the Blaze library. You can redistribute it and/or modify it under
+//  the terms of the New (Revised) BSD License. Redistribution and use in source and binary
+//  forms, with or without modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//     conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//     of conditions and the following disclaimer in the documentation and/or other materials
+//     provided with the distribution.
+//  3. Neither the names of the Blaze development group nor the names of its contributors
+//     may be used to endorse or promote products derived from this software without specific
+//     prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//  TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//  BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+*/
+//=================================================================================================
+
+#ifndef _BLAZETEST_UTILTEST_MIRRORED_CONTAINER_H_
+#define _BLAZETEST_UTILTEST_MIRRORED_CONTAINER_H_
+
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+
+#include <blaze/Blaze.h>
+
+#include <blaze_cuda/math/CUDAMirroredMatrix.h>
+#include <blaze_cuda/math/CUDAMirroredVector.h>
+#include <blaze_cuda/util/CUDASynchronize.h>
+
+namespace blazetest {
+
+namespace utiltest {
+
+namespace mirrored_container {
+
+template< typename T >
+void vector_test( std::size_t n )
+{
+   using std::size_t;
+
+   blaze::CUDAMirroredVector<T> v( n, T(1) ), w( n );
+   const auto& cv( v );
+   const auto& cw( w );
+
+   if( v.hasHostMirror() || w.hasHostMirror() ) {
+      throw std::runtime_error("Host mirror allocated eagerly");
+   }
+
+   for( size_t i = 0; i < n; ++i ) {
+      if( cv[i] != T(1) ) {
+         // TODO: Better error reporting
+         throw std::runtime_error("Invalid initialization");
+      }
+      v[i] = T( i );
+   }
+
+   // The host values are uploaded once, the result is downloaded once
+   w.device() = v.cdevice() + v.cdevice();
+   blaze::cuda_synchronize();
+
+   blaze::DynamicVector<T> ref( n );
+
+   for( size_t i = 0; i < n; ++i ) {
+      if( cw[i] != T( 2*i ) ) {
+         // TODO: Better error reporting
+         throw std::runtime_error("Invalid device expression result");
+      }
+      ref[i] = T( 2*i );
+   }
+
+   std::ostringstream os, ref_os;
+   os << w;
+   ref_os << ref;
+
+   if( os.str() != ref_os.str() ) {
+      throw std::runtime_error("Invalid output");
+   }
+
+   // Resizes preserve the values on the device and release the host mirror
+   w.resize( n + 5 );
+
+   if( w.hasHostMirror() || w.size() != n + 5 ) {
+      throw std::runtime_error("Invalid resize");
+   }
+
+   w.resize( n / 2 );
+
+   for( size_t i = 0; i < w.size(); ++i ) {
+      if( cw[i] != T( 2*i ) ) {
+         throw std::runtime_error("Values not preserved by resize");
+      }
+   }
+
+   // Conversions and assignments evaluate on the device
+   blaze::CUDAMirroredVector<T> x( v.cdevice() );
+   x = x.cdevice() * T(3);
+   blaze::cuda_synchronize();
+
+   blaze::randomize( v, T(2), T(5) );
+
+   for( size_t i = 0; i < n; ++i ) {
+      if( x[i] != T( 3*i ) ) {
+         throw std::runtime_error("Invalid conversion or assignment");
+      }
+
+      if( cv[i] < T(2) || cv[i] > T(5) ) {
+         throw std::runtime_error("Invalid randomization");
+      }
+   }
+}
+
+template< typename T, bool SO >
+void matrix_test( std::size_t m, std::size_t n )
+{
+   using std::size_t;
+
+   blaze::CUDAMirroredMatrix<T,SO> A( m, n ), B( n, m );
+   const auto& cA( A );
+   const auto& cB( B );
+
+   for( size_t i = 0; i < m; ++i )
+      for( size_t j = 0; j < n; ++j )
+         A(i,j) = T( i*100 + j );
+
+   B.device() = blaze::trans( A.cdevice() );
+   blaze::cuda_synchronize();
+
+   for( size_t i = 0; i < m; ++i ) {
+      for( size_t j = 0; j < n; ++j ) {
+         if( cB(j,i) != T( i*100 + j ) ) {
+            // TODO: Better error reporting
+            throw std::runtime_error("Invalid device expression result");
+         }
+      }
+   }
+
+   // Resizes preserve the values on the device and release the host mirror
+   A.resize( m + 3, n + 2 );
+
+   if( A.hasHostMirror() || A.rows() != m + 3 || A.columns() != n + 2 ) {
+      throw std::runtime_error("Invalid resize");
+   }
+
+   A.resize( m / 2, n / 2 );
+
+   for( size_t i = 0; i < m / 2; ++i ) {
+      for( size_t j = 0; j < n / 2; ++j ) {
+         if( cA(i,j) != T( i*100 + j ) ) {
+            throw std::runtime_error("Values not preserved by resize");
+         }
+      }
+   }
+
+   std::ostringstream os, ref_os;
+   os << A;
+   ref_os << blaze::DynamicMatrix<T,SO>( A.chost() );
+
+   if( os.str() != ref_os.str() ) {
+      throw std::runtime_error("Invalid output");
+   }
+}
+
+template< typename T >
+void launch_tests_for_type()
+{
+   for( auto const& size : { 1, 7, 1000, 100000 } ) {
+      vector_test<T>( size );
+   }
+
+   for( auto const& size : { 1, 7, 65 } ) {
+      matrix_test<T, blaze::rowMajor   >( size, size + 4 );
+      matrix_test<T, blaze::columnMajor>( size + 4, size );
+   }
+}
+
+} // mirrored_container
+
+} // utiltest
+
+} // blazetest
+
+#endif
@@ -0,0 +1,14 @@
+#include <blazetest/utiltest/algorithms/cuda_batched_gemm.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::cuda_batched_gemm::launch_tests_for_type;
+
+   launch_tests_for_type<float >();
+   launch_tests_for_type<double>();
+}
+
+int main()
+{
+   launch_tests();
+}
@@ -0,0 +1,14 @@
+#include <blazetest/utiltest/algorithms/cuda_norm.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::cuda_norm::launch_tests_for_type;
+
+   launch_tests_for_type<float >();
+   launch_tests_for_type<double>();
+}
+
+int main()
+{
+   launch_tests();
+}
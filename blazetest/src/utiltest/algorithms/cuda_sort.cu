@@ -0,0 +1,15 @@
+#include <blazetest/utiltest/algorithms/cuda_sort.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::cuda_sort::launch_tests_for_type;
+
+   launch_tests_for_type<int   >();
+   launch_tests_for_type<float >();
+   launch_tests_for_type<double>();
+}
+
+int main()
+{
+   launch_tests();
+}
@@ -0,0 +1,20 @@
+#include <blazetest/utiltest/algorithms/cuda_transform.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::cuda_transform::launch_tests_for_type;
+
+   launch_tests_for_type<short         >();
+   launch_tests_for_type<unsigned short>();
+   launch_tests_for_type<int           >();
+   launch_tests_for_type<unsigned int  >();
+   launch_tests_for_type<long          >();
+   launch_tests_for_type<unsigned long >();
+   launch_tests_for_type<float         >();
+   launch_tests_for_type<double        >();
+}
+
+int main()
+{
+   launch_tests();
+}
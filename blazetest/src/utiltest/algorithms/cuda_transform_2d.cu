@@ -0,0 +1,16 @@
+#include <blazetest/utiltest/algorithms/cuda_transform_2d.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::cuda_transform_2d::launch_tests_for_type;
+
+   launch_tests_for_type<int          >();
+   launch_tests_for_type<unsigned long>();
+   launch_tests_for_type<float        >();
+   launch_tests_for_type<double       >();
+}
+
+int main()
+{
+   launch_tests();
+}
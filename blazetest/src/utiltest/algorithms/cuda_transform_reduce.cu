@@ -0,0 +1,15 @@
+#include <blazetest/utiltest/algorithms/cuda_transform_reduce.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::cuda_transform_reduce::launch_tests_for_type;
+
+   launch_tests_for_type<int   >();
+   launch_tests_for_type<float >();
+   launch_tests_for_type<double>();
+}
+
+int main()
+{
+   launch_tests();
+}
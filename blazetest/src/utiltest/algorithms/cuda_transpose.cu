@@ -0,0 +1,14 @@
+#include <blazetest/utiltest/algorithms/cuda_transpose.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::cuda_transpose::launch_tests_for_type;
+
+   launch_tests_for_type<int   >();
+   launch_tests_for_type<double>();
+}
+
+int main()
+{
+   launch_tests();
+}
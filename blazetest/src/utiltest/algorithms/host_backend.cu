@@ -0,0 +1,95 @@
+// Runs the algorithm tests against the host execution backend, with the instrumentation hooks
+// compiled in.
+#define BLAZE_CUDA_HOST_BACKEND
+#define BLAZE_CUDA_INSTRUMENTATION
+
+#include <blazetest/utiltest/algorithms/cuda_batched_gemm.h>
+#include <blazetest/utiltest/algorithms/cuda_compact.h>
+#include <blazetest/utiltest/algorithms/cuda_gemm.h>
+#include <blazetest/utiltest/algorithms/cuda_norm.h>
+#include <blazetest/utiltest/algorithms/cuda_packed_transform.h>
+#include <blazetest/utiltest/algorithms/cuda_reduce.h>
+#include <blazetest/utiltest/algorithms/cuda_scan.h>
+#include <blazetest/utiltest/algorithms/cuda_segmented_reduce.h>
+#include <blazetest/utiltest/algorithms/cuda_softmax.h>
+#include <blazetest/utiltest/algorithms/cuda_sort.h>
+#include <blazetest/utiltest/algorithms/cuda_transform.h>
+#include <blazetest/utiltest/algorithms/cuda_transform_2d.h>
+#include <blazetest/utiltest/algorithms/cuda_transform_reduce.h>
+#include <blazetest/utiltest/algorithms/cuda_transpose.h>
+#include <blazetest/utiltest/algorithms/cuda_welford.h>
+#include <blazetest/utiltest/async.h>
+#include <blazetest/utiltest/cublas_handle.h>
+#include <blazetest/utiltest/instrumentation.h>
+#include <blazetest/utiltest/launch_tuning.h>
+#include <blazetest/utiltest/mirrored_array.h>
+
+void launch_tests()
+{
+   blazetest::utiltest::cuda_batched_gemm::launch_tests_for_type<float >();
+   blazetest::utiltest::cuda_batched_gemm::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_compact::launch_tests_for_type<int   >();
+   blazetest::utiltest::cuda_compact::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_gemm::launch_tests_for_type<float >();
+   blazetest::utiltest::cuda_gemm::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_norm::launch_tests_for_type<float >();
+   blazetest::utiltest::cuda_norm::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_packed_transform::launch_tests_for_type<int   >();
+   blazetest::utiltest::cuda_packed_transform::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_reduce::launch_tests_for_type<int   >();
+   blazetest::utiltest::cuda_reduce::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_scan::launch_tests_for_type<int   >();
+   blazetest::utiltest::cuda_scan::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_segmented_reduce::launch_tests_for_type<int   >();
+   blazetest::utiltest::cuda_segmented_reduce::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_softmax::launch_tests_for_type<float >();
+   blazetest::utiltest::cuda_softmax::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_sort::launch_tests_for_type<int   >();
+   blazetest::utiltest::cuda_sort::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_transform::launch_tests_for_type<int   >();
+   blazetest::utiltest::cuda_transform::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_transform_2d::launch_tests_for_type<int   >();
+   blazetest::utiltest::cuda_transform_2d::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_transform_reduce::launch_tests_for_type<int   >();
+   blazetest::utiltest::cuda_transform_reduce::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_transpose::launch_tests_for_type<int   >();
+   blazetest::utiltest::cuda_transpose::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cuda_welford::launch_tests_for_type<float >();
+   blazetest::utiltest::cuda_welford::launch_tests_for_type<double>();
+
+   blazetest::utiltest::cublas_handle::registry_test();
+   blazetest::utiltest::cublas_handle::launch_tests_for_type<float >();
+   blazetest::utiltest::cublas_handle::launch_tests_for_type<double>();
+
+   blazetest::utiltest::instrumentation::launch_tests_for_type<int   >();
+   blazetest::utiltest::instrumentation::launch_tests_for_type<double>();
+
+   blazetest::utiltest::launch_tuning::launch_tests();
+   blazetest::utiltest::launch_tuning::launch_tests_for_type<int   >();
+   blazetest::utiltest::launch_tuning::launch_tests_for_type<double>();
+
+   blazetest::utiltest::mirrored_array::launch_tests_for_type<int   >();
+   blazetest::utiltest::mirrored_array::launch_tests_for_type<double>();
+
+   blazetest::utiltest::async::launch_tests_for_type<int   >();
+   blazetest::utiltest::async::launch_tests_for_type<double>();
+}
+
+int main()
+{
+   launch_tests();
+}
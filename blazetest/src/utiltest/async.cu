@@ -0,0 +1,14 @@
+#include <blazetest/utiltest/async.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::async::launch_tests_for_type;
+
+   launch_tests_for_type<int   >();
+   launch_tests_for_type<double>();
+}
+
+int main()
+{
+   launch_tests();
+}
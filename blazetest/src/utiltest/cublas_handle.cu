@@ -0,0 +1,16 @@
+#include <blazetest/utiltest/cublas_handle.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::cublas_handle::launch_tests_for_type;
+
+   blazetest::utiltest::cublas_handle::registry_test();
+
+   launch_tests_for_type<float >();
+   launch_tests_for_type<double>();
+}
+
+int main()
+{
+   launch_tests();
+}
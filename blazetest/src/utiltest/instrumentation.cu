@@ -0,0 +1,17 @@
+#define BLAZE_CUDA_INSTRUMENTATION
+
+#include <blazetest/utiltest/instrumentation.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::instrumentation::launch_tests_for_type;
+
+   launch_tests_for_type<int   >();
+   launch_tests_for_type<float >();
+   launch_tests_for_type<double>();
+}
+
+int main()
+{
+   launch_tests();
+}
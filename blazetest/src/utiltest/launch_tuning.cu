@@ -0,0 +1,17 @@
+#include <blazetest/utiltest/launch_tuning.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::launch_tuning::launch_tests_for_type;
+
+   blazetest::utiltest::launch_tuning::launch_tests();
+
+   launch_tests_for_type<int   >();
+   launch_tests_for_type<float >();
+   launch_tests_for_type<double>();
+}
+
+int main()
+{
+   launch_tests();
+}
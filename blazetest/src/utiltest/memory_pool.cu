@@ -0,0 +1,11 @@
+#include <blazetest/utiltest/memory_pool.h>
+
+void launch_tests()
+{
+   blazetest::utiltest::memory_pool::launch_tests();
+}
+
+int main()
+{
+   launch_tests();
+}
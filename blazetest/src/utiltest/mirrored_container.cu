@@ -0,0 +1,14 @@
+#include <blazetest/utiltest/mirrored_container.h>
+
+void launch_tests()
+{
+   using blazetest::utiltest::mirrored_container::launch_tests_for_type;
+
+   launch_tests_for_type<int   >();
+   launch_tests_for_type<double>();
+}
+
+int main()
+{
+   launch_tests();
+}